@@ -1350,6 +1350,45 @@ unsigned int get_length_of_empty_data_buffer(const circular_buffer_t *buffer)
     return buffer->empty_buffer_length_byte;
 }
 
+unsigned int get_empty_regions_of_circular_buffer(circular_buffer_t *buffer,
+                                                  char **first_region, unsigned int *first_region_length,
+                                                  char **second_region, unsigned int *second_region_length)
+{
+    const unsigned int length_to_buffer_end =
+        (unsigned int)(buffer->data_start_point + buffer->length_byte - buffer->destination_point);
+
+    *first_region = buffer->destination_point;
+    *second_region = buffer->data_start_point;
+
+    if (buffer->empty_buffer_length_byte > length_to_buffer_end) {
+        *first_region_length = length_to_buffer_end;
+        *second_region_length = buffer->empty_buffer_length_byte - length_to_buffer_end;
+    } else {
+        *first_region_length = buffer->empty_buffer_length_byte;
+        *second_region_length = 0;
+    }
+
+    return buffer->empty_buffer_length_byte;
+}
+
+unsigned int move_destination_point_of_circular_buffer(circular_buffer_t *buffer,
+                                                       unsigned int written_length)
+{
+    unsigned int moved_data_byte = written_length;
+
+    if (moved_data_byte > buffer->empty_buffer_length_byte) {
+        moved_data_byte = buffer->empty_buffer_length_byte;
+    }
+
+    buffer->destination_point =
+        calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length_byte,
+                                                     buffer->destination_point, moved_data_byte);
+
+    buffer->empty_buffer_length_byte = buffer->empty_buffer_length_byte - moved_data_byte;
+
+    return moved_data_byte;
+}
+
 unsigned int copy_byte_to_circular_buffer(const char *source, unsigned int source_length,
                                           circular_buffer_t *buffer)
 {
@@ -395,6 +395,23 @@ extern bool release_memory_of_circular_buffer(circular_buffer_t *buffer);
 */
 extern unsigned int get_length_of_empty_data_buffer(const circular_buffer_t *buffer);
 
+/*!
+  \brief function to get empty regions of circular buffer to write data directly
+  \return total length of empty regions
+  \attention empty region is split into two regions at the end of buffer (second_region_length is 0 if not split)
+  \attention written data should be committed by move_destination_point_of_circular_buffer
+*/
+extern unsigned int get_empty_regions_of_circular_buffer(circular_buffer_t *buffer,
+                                                         char **first_region, unsigned int *first_region_length,
+                                                         char **second_region, unsigned int *second_region_length);
+
+/*!
+  \brief function to move destination pointer after data is written in empty regions directly
+  \return moved size (limited to empty buffer length)
+*/
+extern unsigned int move_destination_point_of_circular_buffer(circular_buffer_t *buffer,
+                                                              unsigned int written_length);
+
 /*!
   \brief function to copy data to circular buffer
   \attention this function copy data which is equals empty buffer length when the empty size is not enough
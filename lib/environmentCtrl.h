@@ -101,6 +101,64 @@ struct build_environment_t {
     char executing_architecture[MAXIMUM_LENGTH_OF_ARCHITECTURE_NAME];
 };
 
+/*!
+  \brief function to load unsigned int shared among threads
+  \attention memory accesses after this function are not moved before it (acquire)
+*/
+inline unsigned int load_shared_unsigned_int(const volatile unsigned int *shared_value)
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(shared_value, __ATOMIC_ACQUIRE);
+#else
+    const unsigned int value = *shared_value;
+    __sync_synchronize();
+    return value;
+#endif
+}
+
+/*!
+  \brief function to store unsigned int shared among threads
+  \attention memory accesses before this function are not moved after it (release)
+*/
+inline void store_shared_unsigned_int(volatile unsigned int *shared_value, unsigned int value)
+{
+#if defined(__ATOMIC_RELEASE)
+    __atomic_store_n(shared_value, value, __ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+    *shared_value = value;
+#endif
+    return;
+}
+
+/*!
+  \brief function to load bool shared among threads (acquire)
+*/
+inline bool load_shared_bool(const volatile bool *shared_value)
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(shared_value, __ATOMIC_ACQUIRE);
+#else
+    const bool value = *shared_value;
+    __sync_synchronize();
+    return value;
+#endif
+}
+
+/*!
+  \brief function to store bool shared among threads (release)
+*/
+inline void store_shared_bool(volatile bool *shared_value, bool value)
+{
+#if defined(__ATOMIC_RELEASE)
+    __atomic_store_n(shared_value, value, __ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+    *shared_value = value;
+#endif
+    return;
+}
+
 /*!
   \brief function to clear build environment parameter
 */
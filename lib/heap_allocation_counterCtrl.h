@@ -0,0 +1,131 @@
+#ifndef HEAP_ALLOCATION_COUNTER_CONTROL_H
+#define HEAP_ALLOCATION_COUNTER_CONTROL_H
+/*!
+  \file
+  \brief hooks of heap allocators to count heap allocations of program (glibc on Linux OS)
+  \author Kiyoshi MATSUO
+  $Id$
+
+  This header defines malloc, calloc, realloc, posix_memalign and global operator new and
+  delete, so it should be included in only one source file of each program. If hooks are
+  available, HEAP_ALLOCATION_COUNTER_AVAILABLE is defined and number_of_heap_allocations
+  counts calls of these allocators.
+*/
+
+#include "environmentCtrl.h"
+
+#if defined(LINUX_OS) && defined(__GLIBC__)
+
+// for declarations of malloc, calloc, realloc and posix_memalign (hooks are defined after them)
+#include <stdlib.h>
+
+// for EINVAL, ENOMEM
+#include <errno.h>
+
+// for std::bad_alloc
+#include <new>
+
+//! heap allocators of glibc
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t number_of_elements, size_t element_size);
+extern "C" void *__libc_realloc(void *pointer, size_t size);
+extern "C" void *__libc_memalign(size_t alignment, size_t size);
+extern "C" void __libc_free(void *pointer);
+
+//! number of heap allocations
+static volatile unsigned long number_of_heap_allocations = 0;
+
+//! hook to count heap allocations of malloc
+extern "C" void *malloc(size_t size)
+{
+    __sync_fetch_and_add(&number_of_heap_allocations, 1);
+    return __libc_malloc(size);
+}
+
+//! hook to count heap allocations of calloc
+extern "C" void *calloc(size_t number_of_elements, size_t element_size)
+{
+    __sync_fetch_and_add(&number_of_heap_allocations, 1);
+    return __libc_calloc(number_of_elements, element_size);
+}
+
+//! hook to count heap allocations of realloc (reallocation may move block)
+extern "C" void *realloc(void *pointer, size_t size)
+{
+    __sync_fetch_and_add(&number_of_heap_allocations, 1);
+    return __libc_realloc(pointer, size);
+}
+
+//! hook to count heap allocations of posix_memalign
+extern "C" int posix_memalign(void **pointer, size_t alignment, size_t size)
+{
+    // alignment should be power of two multiple of sizeof(void *)
+    if (((alignment % sizeof(void *)) != 0) || ((alignment & (alignment - 1)) != 0) || (alignment == 0)) {
+        return EINVAL;
+    }
+
+    __sync_fetch_and_add(&number_of_heap_allocations, 1);
+
+    void *allocated_pointer = __libc_memalign(alignment, size);
+    if (allocated_pointer == NULL) {
+        return ENOMEM;
+    }
+    *pointer = allocated_pointer;
+
+    return 0;
+}
+
+// exception specifications of global operator new and delete differ before C++11
+#if __cplusplus < 201103L
+#define HEAP_ALLOCATION_COUNTER_THROW_BAD_ALLOC throw (std::bad_alloc)
+#define HEAP_ALLOCATION_COUNTER_NO_THROW throw ()
+#else
+#define HEAP_ALLOCATION_COUNTER_THROW_BAD_ALLOC
+#define HEAP_ALLOCATION_COUNTER_NO_THROW noexcept
+#endif
+
+/*!
+  \brief function to allocate memory of operator new
+  \attention new handler is not called, and std::bad_alloc is thrown if allocation fails
+*/
+static void *allocate_memory_of_operator_new(size_t size)
+{
+    __sync_fetch_and_add(&number_of_heap_allocations, 1);
+
+    // zero byte allocation returns unique pointer
+    void *pointer = __libc_malloc((size != 0) ? size : 1);
+    if (pointer == NULL) {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+//! hook to count heap allocations of operator new
+void *operator new(size_t size) HEAP_ALLOCATION_COUNTER_THROW_BAD_ALLOC
+{
+    return allocate_memory_of_operator_new(size);
+}
+
+//! hook to count heap allocations of operator new[]
+void *operator new[](size_t size) HEAP_ALLOCATION_COUNTER_THROW_BAD_ALLOC
+{
+    return allocate_memory_of_operator_new(size);
+}
+
+//! operator delete paired with hooked operator new
+void operator delete(void *pointer) HEAP_ALLOCATION_COUNTER_NO_THROW
+{
+    __libc_free(pointer);
+}
+
+//! operator delete[] paired with hooked operator new[]
+void operator delete[](void *pointer) HEAP_ALLOCATION_COUNTER_NO_THROW
+{
+    __libc_free(pointer);
+}
+
+#define HEAP_ALLOCATION_COUNTER_AVAILABLE
+#endif
+
+#endif // HEAP_ALLOCATION_COUNTER_CONTROL_H
@@ -726,6 +726,274 @@ void calculate_region_adjusted_histogram_and_statistics_array(const std::vector<
     return;
 }
 
+double calculate_step_coefficient_of_histogram(const histogram_t *histogram)
+{
+    if ((histogram->data_count.size() == 0) ||
+        (histogram->maximum_value == histogram->minimum_value)) {
+        return 0.0;
+    }
+
+    return (double)(histogram->data_count.size() - 1) /
+        (histogram->maximum_value - histogram->minimum_value);
+}
+
+void add_value_to_histogram(histogram_t *histogram, double value)
+{
+    add_value_to_histogram(histogram, value, calculate_step_coefficient_of_histogram(histogram));
+
+    return;
+}
+
+void add_value_to_histogram(histogram_t *histogram, double value, double step_coefficient)
+{
+    if (histogram->data_count.size() == 0) {
+        return;
+    }
+
+    if (value < histogram->minimum_value) {
+
+        value = histogram->minimum_value;
+
+    } else if (value > histogram->maximum_value) {
+
+        value = histogram->maximum_value;
+
+    }
+
+    const unsigned int quantized_value =
+        (unsigned int)((value - histogram->minimum_value) * step_coefficient);
+
+    if (histogram->data_count.size() > quantized_value) {
+        ++histogram->data_count[quantized_value];
+    }
+
+    return;
+}
+
+bool merge_histograms(histogram_t *destination, const histogram_t *source)
+{
+    if ((destination->minimum_value != source->minimum_value) ||
+        (destination->maximum_value != source->maximum_value) ||
+        (destination->data_count.size() != source->data_count.size())) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < source->data_count.size(); ++i) {
+        destination->data_count[i] += source->data_count[i];
+    }
+
+    return true;
+}
+
+void clear_streaming_statistics(streaming_statistics_t *statistics)
+{
+    statistics->number_of_data = 0;
+
+    statistics->average = 0.0;
+    statistics->sum_of_squared_difference = 0.0;
+
+    statistics->minimum = 0.0;
+    statistics->maximum = 0.0;
+
+    return;
+}
+
+void add_value_to_streaming_statistics(streaming_statistics_t *statistics, double value)
+{
+    if (statistics->number_of_data == 0) {
+
+        statistics->number_of_data = 1;
+
+        statistics->average = value;
+        statistics->sum_of_squared_difference = 0.0;
+
+        statistics->minimum = value;
+        statistics->maximum = value;
+
+        return;
+    }
+
+    ++statistics->number_of_data;
+
+    const double difference_from_past_average = value - statistics->average;
+
+    statistics->average +=
+        difference_from_past_average / (double)statistics->number_of_data;
+
+    statistics->sum_of_squared_difference +=
+        difference_from_past_average * (value - statistics->average);
+
+    if (value < statistics->minimum) {
+        statistics->minimum = value;
+    }
+
+    if (value > statistics->maximum) {
+        statistics->maximum = value;
+    }
+
+    return;
+}
+
+void add_values_to_streaming_statistics_array(streaming_statistics_t *statistics_array,
+                                              const double *value_array, unsigned int number_of_statistics)
+{
+    unsigned int number_of_data_of_reciprocal = 0;
+    double reciprocal_of_number_of_data = 0.0;
+
+    for (unsigned int i = 0; i < number_of_statistics; ++i) {
+
+        streaming_statistics_t *statistics = &statistics_array[i];
+        const double value = value_array[i];
+
+        if (statistics->number_of_data == 0) {
+            add_value_to_streaming_statistics(statistics, value);
+            continue;
+        }
+
+        ++statistics->number_of_data;
+
+        // one division is shared by statistics of same number of data
+        if (statistics->number_of_data != number_of_data_of_reciprocal) {
+            number_of_data_of_reciprocal = statistics->number_of_data;
+            reciprocal_of_number_of_data = 1.0 / (double)number_of_data_of_reciprocal;
+        }
+
+        const double difference_from_past_average = value - statistics->average;
+
+        statistics->average += difference_from_past_average * reciprocal_of_number_of_data;
+
+        statistics->sum_of_squared_difference +=
+            difference_from_past_average * (value - statistics->average);
+
+        if (value < statistics->minimum) {
+            statistics->minimum = value;
+        }
+
+        if (value > statistics->maximum) {
+            statistics->maximum = value;
+        }
+    }
+
+    return;
+}
+
+void add_value_array_to_streaming_statistics(streaming_statistics_t *statistics,
+                                             const double *value_array, unsigned int number_of_values)
+{
+    if (number_of_values == 0) {
+        return;
+    }
+
+    streaming_statistics_t array_statistics;
+    array_statistics.number_of_data = number_of_values;
+
+    double sum = 0.0;
+    double minimum = value_array[0];
+    double maximum = value_array[0];
+    for (unsigned int i = 0; i < number_of_values; ++i) {
+        sum += value_array[i];
+        minimum = (value_array[i] < minimum) ? value_array[i] : minimum;
+        maximum = (value_array[i] > maximum) ? value_array[i] : maximum;
+    }
+    array_statistics.average = sum / (double)number_of_values;
+    array_statistics.minimum = minimum;
+    array_statistics.maximum = maximum;
+
+    double sum_of_squared_difference = 0.0;
+    for (unsigned int i = 0; i < number_of_values; ++i) {
+        const double difference = value_array[i] - array_statistics.average;
+        sum_of_squared_difference += difference * difference;
+    }
+    array_statistics.sum_of_squared_difference = sum_of_squared_difference;
+
+    merge_streaming_statistics(statistics, &array_statistics);
+
+    return;
+}
+
+void merge_streaming_statistics(streaming_statistics_t *destination,
+                                const streaming_statistics_t *source)
+{
+    if (source->number_of_data == 0) {
+        return;
+    }
+
+    if (destination->number_of_data == 0) {
+        *destination = *source;
+        return;
+    }
+
+    const double destination_number_of_data = (double)destination->number_of_data;
+    const double source_number_of_data = (double)source->number_of_data;
+    const double total_number_of_data = destination_number_of_data + source_number_of_data;
+
+    const double difference_of_average = source->average - destination->average;
+
+    destination->average +=
+        difference_of_average * (source_number_of_data / total_number_of_data);
+
+    destination->sum_of_squared_difference +=
+        source->sum_of_squared_difference +
+        difference_of_average * difference_of_average *
+        (destination_number_of_data * source_number_of_data / total_number_of_data);
+
+    destination->number_of_data += source->number_of_data;
+
+    if (source->minimum < destination->minimum) {
+        destination->minimum = source->minimum;
+    }
+
+    if (source->maximum > destination->maximum) {
+        destination->maximum = source->maximum;
+    }
+
+    return;
+}
+
+double calculate_variance_of_streaming_statistics(const streaming_statistics_t *statistics)
+{
+    if (statistics->number_of_data == 0) {
+        return 0.0;
+    }
+
+    return statistics->sum_of_squared_difference / (double)statistics->number_of_data;
+}
+
+void set_histogram_and_statistics_from_streaming_statistics(histogram_and_statistics_t *histogram,
+                                                            const streaming_statistics_t *statistics,
+                                                            double one_step_value, int small_bin_threshold)
+{
+    clear_histogram_and_statistics(histogram);
+
+    histogram->small_bin_threshold = small_bin_threshold;
+    histogram->total_number_of_data = statistics->number_of_data;
+
+    histogram->average = statistics->average;
+    histogram->variance = calculate_variance_of_streaming_statistics(statistics);
+
+    histogram->minimum = statistics->minimum;
+    histogram->maximum = statistics->maximum;
+
+    set_parameters_of_histogram(&histogram->histogram,
+                                histogram->minimum, histogram->maximum,
+                                one_step_value);
+
+    clear_data_count_of_histogram(&histogram->histogram);
+
+    return;
+}
+
+void find_large_bins_of_histogram_and_statistics(histogram_and_statistics_t *histogram)
+{
+    get_large_bin_values_of_histogram(&histogram->histogram,
+                                      histogram->small_bin_threshold,
+                                      histogram->large_bin_value_array,
+                                      histogram->large_bin_count_array,
+                                      &histogram->total_count_of_small_bin_count);
+
+    return;
+}
+
 void set_parameters_of_histogram(two_dimensional_histogram_t *histogram,
                                  double minimum_value1, double maximum_value1,
                                  int number_of_bin1,
@@ -177,6 +177,100 @@ extern void calculate_region_adjusted_histogram_and_statistics_array(const std::
                                                                      const std::vector< std::vector<double> > &value_table,
                                                                      std::vector<histogram_and_statistics_t *> &histogram_and_statistics_array);
 
+/*!
+  \brief function to add a value to histogram
+  \attention the value out of range is counted in the boundary bin as make_histogram
+*/
+extern void add_value_to_histogram(histogram_t *histogram, double value);
+
+/*!
+  \brief function to calculate coefficient to convert value to bin index of histogram
+*/
+extern double calculate_step_coefficient_of_histogram(const histogram_t *histogram);
+
+/*!
+  \brief function to add a value to histogram with step coefficient calculated before
+  \attention step_coefficient should be calculated by calculate_step_coefficient_of_histogram after parameters are set
+*/
+extern void add_value_to_histogram(histogram_t *histogram, double value, double step_coefficient);
+
+/*!
+  \brief function to merge data count of source histogram into destination histogram
+  \attention this function returns false if parameters of two histograms are not equal
+*/
+extern bool merge_histograms(histogram_t *destination, const histogram_t *source);
+
+//! structure for single pass statistics (Welford's online algorithm)
+struct streaming_statistics_t {
+
+    //! number of data
+    unsigned int number_of_data;
+
+    //! average
+    double average;
+
+    //! sum of squared differences from average
+    double sum_of_squared_difference;
+
+    //! minimum
+    double minimum;
+    //! maximum
+    double maximum;
+
+};
+
+/*!
+  \brief function to clear streaming statistics
+*/
+extern void clear_streaming_statistics(streaming_statistics_t *statistics);
+
+/*!
+  \brief function to add a value to streaming statistics
+*/
+extern void add_value_to_streaming_statistics(streaming_statistics_t *statistics, double value);
+
+/*!
+  \brief function to add values to array of streaming statistics
+  \attention value_array[i] is added to statistics_array[i], and reciprocal of number of data is shared by statistics of same number of data
+*/
+extern void add_values_to_streaming_statistics_array(streaming_statistics_t *statistics_array,
+                                                     const double *value_array, unsigned int number_of_statistics);
+
+/*!
+  \brief function to add value array to streaming statistics
+  \attention statistics of array are calculated in two loops without dependency between values, and merged into statistics
+*/
+extern void add_value_array_to_streaming_statistics(streaming_statistics_t *statistics,
+                                                    const double *value_array, unsigned int number_of_values);
+
+/*!
+  \brief function to merge source statistics into destination statistics
+  \attention partial results of threads or packets can be combined by this function
+*/
+extern void merge_streaming_statistics(streaming_statistics_t *destination,
+                                       const streaming_statistics_t *source);
+
+/*!
+  \brief function to calculate variance of streaming statistics
+  \attention the variance is divided by number of data as calculate_region_adjusted_histogram
+*/
+extern double calculate_variance_of_streaming_statistics(const streaming_statistics_t *statistics);
+
+/*!
+  \brief function to set histogram and statistics from streaming statistics
+  \attention range of histogram is decided by minimum and maximum of statistics, and values are counted by add_value_to_histogram
+  \attention memory of histogram and large bin arrays is reused if it is large enough
+*/
+extern void set_histogram_and_statistics_from_streaming_statistics(histogram_and_statistics_t *histogram,
+                                                                   const streaming_statistics_t *statistics,
+                                                                   double one_step_value, int small_bin_threshold);
+
+/*!
+  \brief function to find large bins of histogram and statistics
+  \attention this function should be used after all values are counted in histogram
+*/
+extern void find_large_bins_of_histogram_and_statistics(histogram_and_statistics_t *histogram);
+
 //! structure for parameters of two dimensional histogram
 struct two_dimensional_histogram_t {
 
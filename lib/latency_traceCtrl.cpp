@@ -0,0 +1,286 @@
+#include "latency_traceCtrl.h"
+
+// for log
+#include <math.h>
+
+#if defined(WINDOWS_OS)
+#define LATENCY_TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define LATENCY_TRACE_THREAD_LOCAL __thread
+#endif
+
+//! structure of traces of one thread
+struct latency_trace_thread_buffer_t {
+
+    //! histogram of log2 of latency [nsec] of each stage
+    histogram_t histogram[NUMBER_OF_LATENCY_TRACE_STAGES];
+
+    //! statistics of latency [nsec] of each stage
+    streaming_statistics_t statistics[NUMBER_OF_LATENCY_TRACE_STAGES];
+
+    //! sequence of writes (odd while owner thread writes histograms and statistics)
+    volatile unsigned int write_sequence;
+
+    //! next buffer in list
+    latency_trace_thread_buffer_t *next;
+
+};
+
+//! list of buffers of all threads (buffers are only prepended)
+static latency_trace_thread_buffer_t *volatile latency_trace_buffer_list = NULL;
+
+//! buffer of calling thread
+static LATENCY_TRACE_THREAD_LOCAL latency_trace_thread_buffer_t *latency_trace_thread_buffer = NULL;
+
+//! inverse of natural logarithm of 2
+static const double LATENCY_TRACE_LOG2_COEFFICIENT = 1.4426950408889634;
+
+static void set_parameters_of_latency_trace_histogram(histogram_t *histogram)
+{
+    set_parameters_of_histogram(histogram, 0.0, (double)LATENCY_TRACE_MAXIMUM_OCTAVE,
+                                1.0 / (double)NUMBER_OF_LATENCY_TRACE_BINS_PER_OCTAVE);
+
+    return;
+}
+
+//! function to get head of list of buffers (buffers prepended by other threads are visible with their contents)
+static latency_trace_thread_buffer_t *get_head_of_latency_trace_buffer_list(void)
+{
+#if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(&latency_trace_buffer_list, __ATOMIC_ACQUIRE);
+#else
+    latency_trace_thread_buffer_t *head = latency_trace_buffer_list;
+    __sync_synchronize();
+    return head;
+#endif
+}
+
+/*!
+  \brief function to start writing of buffer by owner thread (sequence becomes odd)
+  \attention write is ordered after odd sequence, so reader retries if it reads value being written
+*/
+static unsigned int begin_writing_latency_trace_thread_buffer(latency_trace_thread_buffer_t *buffer)
+{
+    // only owner thread changes sequence
+    const unsigned int sequence = buffer->write_sequence + 1;
+
+    buffer->write_sequence = sequence;
+#if defined(__ATOMIC_RELEASE)
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+#endif
+
+    return sequence;
+}
+
+//! function to finish writing of buffer by owner thread (written values are published with even sequence)
+static void end_writing_latency_trace_thread_buffer(latency_trace_thread_buffer_t *buffer, unsigned int sequence)
+{
+    store_shared_unsigned_int(&buffer->write_sequence, sequence + 1);
+
+    return;
+}
+
+/*!
+  \brief function to copy histogram and statistics of stage of buffer written by other thread
+  \attention values are copied again until they are not written during copy (seqlock)
+*/
+static void copy_latency_trace_of_stage(const latency_trace_thread_buffer_t *buffer, enum LATENCY_TRACE_STAGE stage,
+                                        histogram_t *histogram, streaming_statistics_t *statistics)
+{
+    unsigned int sequence = 0;
+
+    do {
+        sequence = load_shared_unsigned_int(&buffer->write_sequence);
+        if ((sequence % 2) != 0) {
+            continue;
+        }
+
+        // bins are copied without reallocation because all histograms have same bins
+        *histogram = buffer->histogram[stage];
+        *statistics = buffer->statistics[stage];
+
+#if defined(__ATOMIC_ACQUIRE)
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+#else
+        __sync_synchronize();
+#endif
+    } while (((sequence % 2) != 0) || (buffer->write_sequence != sequence));
+
+    return;
+}
+
+static latency_trace_thread_buffer_t *get_latency_trace_thread_buffer(void)
+{
+    if (latency_trace_thread_buffer != NULL) {
+        return latency_trace_thread_buffer;
+    }
+
+    latency_trace_thread_buffer_t *buffer = new latency_trace_thread_buffer_t;
+
+    for (unsigned int i = 0; i < NUMBER_OF_LATENCY_TRACE_STAGES; ++i) {
+        set_parameters_of_latency_trace_histogram(&buffer->histogram[i]);
+        clear_streaming_statistics(&buffer->statistics[i]);
+    }
+    buffer->write_sequence = 0;
+
+    // prepend buffer to list without lock (compare and swap publishes cleared buffer)
+    latency_trace_thread_buffer_t *head = NULL;
+    do {
+        head = latency_trace_buffer_list;
+        buffer->next = head;
+    } while (__sync_bool_compare_and_swap(&latency_trace_buffer_list, head, buffer) == false);
+
+    latency_trace_thread_buffer = buffer;
+
+    return buffer;
+}
+
+void add_latency_to_trace(enum LATENCY_TRACE_STAGE stage, double latency_nsec)
+{
+    if ((stage < 0) ||
+        (stage >= NUMBER_OF_LATENCY_TRACE_STAGES)) {
+        return;
+    }
+
+    latency_trace_thread_buffer_t *buffer = get_latency_trace_thread_buffer();
+
+    // latency shorter than 1 nsec is counted in first bin
+    double octave = 0.0;
+    if (latency_nsec > 1.0) {
+        octave = log(latency_nsec) * LATENCY_TRACE_LOG2_COEFFICIENT;
+    }
+
+    const unsigned int sequence = begin_writing_latency_trace_thread_buffer(buffer);
+
+    add_value_to_histogram(&buffer->histogram[stage], octave);
+    add_value_to_streaming_statistics(&buffer->statistics[stage], latency_nsec);
+
+    end_writing_latency_trace_thread_buffer(buffer, sequence);
+
+    return;
+}
+
+static double calculate_percentile_of_latency_trace_histogram(const histogram_t *histogram,
+                                                              unsigned int number_of_data,
+                                                              double percentile)
+{
+    const double step_width = calculate_step_width_of_histogram(histogram);
+
+    const double threshold_count = percentile * (double)number_of_data;
+
+    double cumulative_count = 0.0;
+    unsigned int bin_index = 0;
+    for (bin_index = 0; bin_index < histogram->data_count.size(); ++bin_index) {
+
+        cumulative_count += (double)histogram->data_count[bin_index];
+
+        if (cumulative_count >= threshold_count) {
+            break;
+        }
+    }
+
+    // upper bound of bin
+    return pow(2.0, histogram->minimum_value + step_width * (double)(bin_index + 1));
+}
+
+bool summarize_latency_trace(enum LATENCY_TRACE_STAGE stage, latency_trace_summary_t *summary)
+{
+    summary->number_of_data = 0;
+    summary->average_usec = 0.0;
+    summary->p50_usec = 0.0;
+    summary->p99_usec = 0.0;
+    summary->p999_usec = 0.0;
+    summary->maximum_usec = 0.0;
+
+    if ((stage < 0) ||
+        (stage >= NUMBER_OF_LATENCY_TRACE_STAGES)) {
+        return false;
+    }
+
+    histogram_t histogram;
+    set_parameters_of_latency_trace_histogram(&histogram);
+
+    streaming_statistics_t statistics;
+    clear_streaming_statistics(&statistics);
+
+    // traces of other threads are copied consistently before they are merged
+    histogram_t thread_histogram;
+    set_parameters_of_latency_trace_histogram(&thread_histogram);
+    streaming_statistics_t thread_statistics;
+
+    for (const latency_trace_thread_buffer_t *buffer = get_head_of_latency_trace_buffer_list(); buffer != NULL;
+         buffer = buffer->next) {
+
+        copy_latency_trace_of_stage(buffer, stage, &thread_histogram, &thread_statistics);
+
+        merge_histograms(&histogram, &thread_histogram);
+        merge_streaming_statistics(&statistics, &thread_statistics);
+    }
+
+    if (statistics.number_of_data == 0) {
+        return false;
+    }
+
+    const double nsec_to_usec = 0.001;
+
+    summary->number_of_data = statistics.number_of_data;
+    summary->average_usec = statistics.average * nsec_to_usec;
+    summary->maximum_usec = statistics.maximum * nsec_to_usec;
+
+    summary->p50_usec =
+        calculate_percentile_of_latency_trace_histogram(&histogram, statistics.number_of_data, 0.5) * nsec_to_usec;
+    summary->p99_usec =
+        calculate_percentile_of_latency_trace_histogram(&histogram, statistics.number_of_data, 0.99) * nsec_to_usec;
+    summary->p999_usec =
+        calculate_percentile_of_latency_trace_histogram(&histogram, statistics.number_of_data, 0.999) * nsec_to_usec;
+
+    if (summary->p50_usec > summary->maximum_usec) {
+        summary->p50_usec = summary->maximum_usec;
+    }
+    if (summary->p99_usec > summary->maximum_usec) {
+        summary->p99_usec = summary->maximum_usec;
+    }
+    if (summary->p999_usec > summary->maximum_usec) {
+        summary->p999_usec = summary->maximum_usec;
+    }
+
+    return true;
+}
+
+void output_latency_trace_to_stream(std::ostream &stream, const char separator)
+{
+    latency_trace_summary_t summary;
+
+    for (unsigned int i = 0; i < NUMBER_OF_LATENCY_TRACE_STAGES; ++i) {
+
+        if (summarize_latency_trace((enum LATENCY_TRACE_STAGE)i, &summary) == false) {
+            continue;
+        }
+
+        stream << LATENCY_TRACE_STAGE_NAME[i] << separator
+               << summary.number_of_data << separator
+               << summary.average_usec << separator
+               << summary.p50_usec << separator
+               << summary.p99_usec << separator
+               << summary.p999_usec << separator
+               << summary.maximum_usec << "\n";
+    }
+
+    return;
+}
+
+void clear_latency_trace(void)
+{
+    for (latency_trace_thread_buffer_t *buffer = get_head_of_latency_trace_buffer_list(); buffer != NULL;
+         buffer = buffer->next) {
+
+        for (unsigned int i = 0; i < NUMBER_OF_LATENCY_TRACE_STAGES; ++i) {
+            clear_data_count_of_histogram(&buffer->histogram[i]);
+            clear_streaming_statistics(&buffer->statistics[i]);
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,122 @@
+#ifndef LATENCY_TRACE_CONTROL_H
+#define LATENCY_TRACE_CONTROL_H
+/*!
+  \file
+  \brief functions to trace latency of processing stages in log-bucketed histograms
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+#include "histogramCtrl.h"
+
+#include "timeCtrl.h"
+
+//! processing stages of latency trace
+enum LATENCY_TRACE_STAGE {
+
+    //! invalid stage
+    LATENCY_TRACE_INVALID_STAGE = -1,
+
+    //! receiving packets
+    LATENCY_TRACE_RECEIVE_STAGE = 0,
+
+    //! decoding one packet
+    LATENCY_TRACE_DECODE_STAGE,
+
+    //! getting pointers of latest lines
+    LATENCY_TRACE_GET_LINES_STAGE,
+
+    //! filtering echoes in regions
+    LATENCY_TRACE_REGION_FILTER_STAGE,
+
+    //! number of stages
+    NUMBER_OF_LATENCY_TRACE_STAGES,
+};
+
+//! constants for latency trace
+enum LATENCY_TRACE_CONSTANT {
+
+    //! number of histogram bins in one octave of latency
+    NUMBER_OF_LATENCY_TRACE_BINS_PER_OCTAVE = 4,
+
+    //! maximum octave of latency (2^32 nsec, about 4 sec)
+    LATENCY_TRACE_MAXIMUM_OCTAVE = 32,
+
+    //! maximum length of stage name
+    MAXIMUM_LENGTH_OF_LATENCY_TRACE_STAGE_NAME = 16,
+};
+
+//! table of stage names
+const char LATENCY_TRACE_STAGE_NAME[NUMBER_OF_LATENCY_TRACE_STAGES][MAXIMUM_LENGTH_OF_LATENCY_TRACE_STAGE_NAME] =
+    { "receive", "decode", "get_lines", "region_filter" };
+
+//! structure of summary of latency of one stage
+struct latency_trace_summary_t {
+
+    //! number of traced latencies
+    unsigned int number_of_data;
+
+    //! average [usec]
+    double average_usec;
+
+    //! 50 percentile [usec]
+    double p50_usec;
+
+    //! 99 percentile [usec]
+    double p99_usec;
+
+    //! 99.9 percentile [usec]
+    double p999_usec;
+
+    //! maximum [usec]
+    double maximum_usec;
+
+};
+
+//! trace macros are compiled only if LATENCY_TRACE_ENABLED is defined (make WITH_LATENCY_TRACE=1)
+#if defined(LATENCY_TRACE_ENABLED)
+
+//! macro to start timer of stage
+#define LATENCY_TRACE_BEGIN(timer) const double timer = GetNowTimeNanoSec()
+
+//! macro to add latency from LATENCY_TRACE_BEGIN(timer) to trace of stage
+#define LATENCY_TRACE_END(timer, stage) add_latency_to_trace(stage, GetNowTimeNanoSec() - timer)
+
+#else
+
+#define LATENCY_TRACE_BEGIN(timer)
+
+#define LATENCY_TRACE_END(timer, stage)
+
+#endif
+
+/*!
+  \brief function to add latency of stage to trace of calling thread
+  \attention each thread has its own histograms, which are allocated on first call of thread and never released
+  \attention latency is counted in bins of 1 / NUMBER_OF_LATENCY_TRACE_BINS_PER_OCTAVE octave
+*/
+extern void add_latency_to_trace(enum LATENCY_TRACE_STAGE stage, double latency_nsec);
+
+/*!
+  \brief function to summarize latency of stage traced by all threads
+  \attention percentiles are upper bounds of histogram bins (limited by maximum)
+  \attention this function returns false if no latency of stage is traced
+  \attention histogram and statistics of each thread are copied with seqlock, so summary is consistent for each thread while traced threads are running
+*/
+extern bool summarize_latency_trace(enum LATENCY_TRACE_STAGE stage, latency_trace_summary_t *summary);
+
+/*!
+  \brief function to output summaries of all stages to stream
+  \attention one line is output for each traced stage: name, count, average, p50, p99, p999, maximum [usec]
+*/
+extern void output_latency_trace_to_stream(std::ostream &stream, const char separator);
+
+/*!
+  \brief function to clear traces of all threads
+  \attention this function should be used while traced threads are idle
+*/
+extern void clear_latency_trace(void);
+
+#endif // LATENCY_TRACE_CONTROL_H
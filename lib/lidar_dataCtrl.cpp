@@ -1,6 +1,8 @@
 
 #include "lidar_dataCtrl.h"
 
+#include "latency_traceCtrl.h"
+
 // for NULL, malloc, free
 #include <stdlib.h>
 
@@ -16,6 +18,9 @@
 // for sscanf
 #include <stdio.h>
 
+// for std::min, std::max
+#include <algorithm>
+
 void copy_lidar_echo_data(const lidar_echo_data_t *source,
                           lidar_echo_data_t *destination)
 {
@@ -32,6 +37,11 @@ void copy_lidar_echo_data(const lidar_echo_data_t *source,
     destination->distance = source->distance;
     destination->intensity = source->intensity;
 
+    destination->cartesian_coordinates_available = source->cartesian_coordinates_available;
+    destination->x_component = source->x_component;
+    destination->y_component = source->y_component;
+    destination->z_component = source->z_component;
+
     return;
 }
 
@@ -84,6 +94,8 @@ void clear_lidar_line_data(lidar_line_data_t *line)
     line->calibrated_start_time = 0;
     line->calibrated_end_time = 0;
 
+    line->receive_time_usec = 0.0;
+
     line->minimum_horizontal_angle = 0.0;
     line->maximum_horizontal_angle = 0.0;
 
@@ -120,6 +132,11 @@ static void clear_lidar_echo_data(lidar_echo_data_t *echo)
     echo->distance = 0;
     echo->intensity = 0;
 
+    echo->cartesian_coordinates_available = false;
+    echo->x_component = 0.0;
+    echo->y_component = 0.0;
+    echo->z_component = 0.0;
+
     return;
 }
 
@@ -196,6 +213,8 @@ bool copy_lidar_line_data(const lidar_line_data_t *source, lidar_line_data_t *de
     destination->calibrated_start_time = source->calibrated_start_time;
     destination->calibrated_end_time = source->calibrated_end_time;
 
+    destination->receive_time_usec = source->receive_time_usec;
+
     memcpy((void *)destination->spot, (void *)source->spot,
            sizeof(lidar_spot_accessor_t) * source->number_of_spots);
 
@@ -211,6 +230,8 @@ bool copy_lidar_line_data(const lidar_line_data_t *source, lidar_line_data_t *de
 void initialize_lidar_line_circular_buffer(lidar_line_circular_buffer_t *buffer)
 {
     buffer->length = 0;
+    buffer->index_mask = 0;
+    buffer->number_of_overwritten_unused_lines = 0;
 
     buffer->data_start_point = NULL;
     buffer->destination_point = NULL;
@@ -231,13 +252,32 @@ void clear_memory_of_lidar_line_circular_buffer(lidar_line_circular_buffer_t *bu
     buffer->used_data_end_out_point = buffer->data_start_point;
 
     buffer->empty_buffer_length = buffer->length;
+    buffer->number_of_overwritten_unused_lines = 0;
 
     return;
 }
 
+unsigned int calculate_length_of_lidar_line_circular_buffer(unsigned int number_of_lines)
+{
+    if ((number_of_lines == 0) ||
+        (number_of_lines > LIDAR_LINE_CIRCULAR_BUFFER_MAXIMUM_LENGTH)) {
+        return 0;
+    }
+
+    unsigned int length = 1;
+    while (length < number_of_lines) {
+        length = length << 1;
+    }
+
+    return length;
+}
+
 bool allocate_memory_for_lidar_line_circular_buffer(lidar_line_circular_buffer_t *buffer,
                                                     unsigned int number_of_spots, unsigned int buffer_length)
 {
+    // lines are indexed with mask instead of comparison of pointers
+    buffer_length = calculate_length_of_lidar_line_circular_buffer(buffer_length);
+
     if (buffer_length == 0) {
         return false;
     }
@@ -249,6 +289,7 @@ bool allocate_memory_for_lidar_line_circular_buffer(lidar_line_circular_buffer_t
         return false;
     }
     buffer->length = buffer_length;
+    buffer->index_mask = buffer_length - 1;
 
     clear_memory_of_lidar_line_circular_buffer(buffer);
 
@@ -322,20 +363,44 @@ unsigned int calculate_number_of_remaining_lidar_lines(const lidar_line_circular
 
 }
 
-static lidar_line_data_t *calculate_shifted_pointer_in_circular_buffer(lidar_line_data_t *buffer, unsigned int buffer_length,
-                                                                       lidar_line_data_t *pointer, int shift_amount)
+unsigned int get_number_of_overwritten_unused_lidar_lines(const lidar_line_circular_buffer_t *buffer)
+{
+    return buffer->number_of_overwritten_unused_lines;
+}
+
+/*!
+  \brief function to shift pointer in circular buffer with index mask
+  \attention negative shift_amount wraps around with unsigned arithmetic, because length is power of two
+*/
+static inline lidar_line_data_t *shift_pointer_in_lidar_line_circular_buffer(const lidar_line_circular_buffer_t *buffer,
+                                                                             const lidar_line_data_t *pointer,
+                                                                             int shift_amount)
 {
-    lidar_line_data_t *shifted_pointer = pointer + shift_amount;
+    const unsigned int index =
+        ((unsigned int)(pointer - buffer->data_start_point) + (unsigned int)shift_amount) & buffer->index_mask;
 
-    if (shifted_pointer < buffer) {
-        shifted_pointer = shifted_pointer + buffer_length;
-    }
+    return buffer->data_start_point + index;
+}
 
-    if (shifted_pointer >= buffer + buffer_length) {
-        shifted_pointer = shifted_pointer - buffer_length;
+/*!
+  \brief function to count unused lines overwritten by writing lines and to move oldest unused line after them
+*/
+static void overwrite_unused_lidar_lines(lidar_line_circular_buffer_t *buffer, unsigned int number_of_writing_lines)
+{
+    if (number_of_writing_lines <= buffer->empty_buffer_length) {
+        buffer->empty_buffer_length -= number_of_writing_lines;
+        return;
     }
 
-    return shifted_pointer;
+    const unsigned int number_of_overwritten_lines = number_of_writing_lines - buffer->empty_buffer_length;
+
+    buffer->number_of_overwritten_unused_lines += number_of_overwritten_lines;
+    buffer->used_data_end_out_point =
+        shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->used_data_end_out_point,
+                                                    (int)number_of_overwritten_lines);
+    buffer->empty_buffer_length = 0;
+
+    return;
 }
 
 void move_used_data_end_out_point(lidar_line_circular_buffer_t *buffer,
@@ -343,8 +408,7 @@ void move_used_data_end_out_point(lidar_line_circular_buffer_t *buffer,
 {
 
     buffer->used_data_end_out_point =
-        calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length,
-                                                     buffer->used_data_end_out_point, move_amount);
+        shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->used_data_end_out_point, (int)move_amount);
 
     if (buffer->empty_buffer_length + move_amount > buffer->length) {
         buffer->empty_buffer_length = buffer->length;
@@ -359,15 +423,11 @@ void move_copy_destination_point(lidar_line_circular_buffer_t *buffer,
                                  unsigned int move_amount)
 {
 
-    buffer->destination_point =
-        calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length,
-                                                     buffer->destination_point, move_amount);
+    // written lines are counted here (not on getting pointers to copy)
+    overwrite_unused_lidar_lines(buffer, move_amount);
 
-    if (buffer->empty_buffer_length < move_amount) {
-        buffer->empty_buffer_length = 0;
-    } else {
-        buffer->empty_buffer_length = buffer->empty_buffer_length - move_amount;
-    }
+    buffer->destination_point =
+        shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->destination_point, (int)move_amount);
 
     return;
 }
@@ -434,42 +494,10 @@ unsigned int get_pointers_to_copy_lidar_line_data(lidar_line_circular_buffer_t *
         destination_array.resize(writable_size);
     }
 
-    const lidar_line_data_t *buffer_end_out = buffer->data_start_point + buffer->length;
-
-    unsigned int remaining_length = writable_size;
-
-    lidar_line_data_t *destination = buffer->destination_point;
-    unsigned int array_index = 0;
-
-    while(1) {
-
-        if (destination + remaining_length > buffer_end_out) {
-
-            const unsigned int copy_size = buffer_end_out - destination;
-
-            for (unsigned int i = 0; i < copy_size; ++i) {
-                destination_array.at(array_index + i) = destination + i;
-            }
-            remaining_length -= copy_size;
-
-            array_index += copy_size;
-            destination = calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length,
-                                                                       destination, copy_size);
-
-        } else {
-
-            for (unsigned int i = 0; i < remaining_length; ++i) {
-                destination_array.at(array_index + i) = destination + i;
-            }
-
-            remaining_length = 0;
-            break;
-        }
-
+    for (unsigned int i = 0; i < writable_size; ++i) {
+        destination_array.at(i) = shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->destination_point, (int)i);
     }
 
-    buffer->empty_buffer_length = buffer->empty_buffer_length - writable_size;
-
     return destination_array.size();
 }
 
@@ -484,9 +512,8 @@ lidar_line_data_t *get_pointer_to_copy_lidar_line_data(lidar_line_circular_buffe
 
         }
 
-    } else {
-        buffer->empty_buffer_length = buffer->empty_buffer_length- 1;
     }
+
     lidar_line_data_t *pointer = buffer->destination_point;
 
     return pointer;
@@ -502,8 +529,7 @@ const lidar_line_data_t *get_pointer_of_latest_unused_lidar_line_data(const lida
         return pointer;
     }
     const int shift_amount = -1;
-    pointer = calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length,
-                                                           buffer->destination_point, shift_amount);
+    pointer = shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->destination_point, shift_amount);
     return pointer;
 }
 
@@ -511,6 +537,8 @@ unsigned int get_pointers_of_latest_unused_lidar_line_data(const lidar_line_circ
                                                            unsigned int capture_size,
                                                            std::vector<const lidar_line_data_t *> &latest_lines)
 {
+    LATENCY_TRACE_BEGIN(get_lines_start_time_nsec);
+
     const lidar_line_data_t *pointer = NULL;
 
     unsigned int capturing_size = capture_size;
@@ -520,6 +548,7 @@ unsigned int get_pointers_of_latest_unused_lidar_line_data(const lidar_line_circ
     }
 
     if (buffer->empty_buffer_length == buffer->length) {
+        LATENCY_TRACE_END(get_lines_start_time_nsec, LATENCY_TRACE_GET_LINES_STAGE);
         return 0;
     }
     const unsigned int remaining_size =
@@ -537,13 +566,14 @@ unsigned int get_pointers_of_latest_unused_lidar_line_data(const lidar_line_circ
 
         shift_amount = (int)i - (int)capturing_size;
 
-        pointer = calculate_shifted_pointer_in_circular_buffer(buffer->data_start_point, buffer->length,
-                                                               buffer->destination_point, shift_amount);
+        pointer = shift_pointer_in_lidar_line_circular_buffer(buffer, buffer->destination_point, shift_amount);
 
         latest_lines.at(i) = pointer;
 
     }
 
+    LATENCY_TRACE_END(get_lines_start_time_nsec, LATENCY_TRACE_GET_LINES_STAGE);
+
     return latest_lines.size();
 }
 
@@ -881,8 +911,8 @@ unsigned int copy_lidar_echo_data_in_a_single_region(const lidar_line_data_t *li
 
             if (is_lidar_echo_in_single_region(echo, region) == true) {
 
+                copy_lidar_echo_data(echo, &temporal_echo_data);
                 echoes_in_region.push_back(temporal_echo_data);
-                copy_lidar_echo_data(echo, &echoes_in_region.at(echoes_in_region.size() - 1));
 
             }
 
@@ -920,8 +950,8 @@ unsigned int add_lidar_echo_data_in_a_single_region(const lidar_line_data_t *lin
 
             if (is_lidar_echo_in_single_region(echo, region) == true) {
 
+                copy_lidar_echo_data(echo, &temporal_echo_data);
                 echoes_in_region.push_back(temporal_echo_data);
-                copy_lidar_echo_data(echo, &echoes_in_region.at(echoes_in_region.size() - 1));
                 ++number_of_added_echoes;
 
             }
@@ -965,6 +995,8 @@ unsigned int add_lidar_echo_data_in_each_single_region(const std::vector< const
         return total_added_size;
     }
 
+    LATENCY_TRACE_BEGIN(region_filter_start_time_nsec);
+
     for (unsigned int line_index = 0; line_index < line_array.size(); ++line_index) {
 
         total_added_size += add_lidar_echo_data_in_each_single_region(line_array.at(line_index),
@@ -972,6 +1004,210 @@ unsigned int add_lidar_echo_data_in_each_single_region(const std::vector< const
 
     }
 
+    LATENCY_TRACE_END(region_filter_start_time_nsec, LATENCY_TRACE_REGION_FILTER_STAGE);
+
+    return total_added_size;
+}
+
+static unsigned int calculate_azimuth_bucket_of_region_set(const lidar_echo_region_set_t *region_set,
+                                                          double horizontal_angle)
+{
+    const double normalized_angle = horizontal_angle -
+        LIDAR_DATA_MAXIMUM_ANGLE_RADIAN * floor(horizontal_angle / LIDAR_DATA_MAXIMUM_ANGLE_RADIAN);
+
+    unsigned int bucket = (unsigned int)(normalized_angle * region_set->azimuth_bucket_width_inverse);
+    if (bucket >= region_set->number_of_azimuth_buckets) {
+        bucket = region_set->number_of_azimuth_buckets - 1;
+    }
+
+    return bucket;
+}
+
+bool compile_lidar_echo_region_set(const std::vector<lidar_echo_single_region_t> &regions,
+                                   const std::vector<double> &laser_elevation_angle_array,
+                                   unsigned int number_of_azimuth_buckets,
+                                   lidar_echo_region_set_t *region_set)
+{
+    if (number_of_azimuth_buckets == 0) {
+        return false;
+    }
+
+    const unsigned int number_of_regions = regions.size();
+    const unsigned int number_of_lasers = laser_elevation_angle_array.size();
+
+    region_set->regions = regions;
+    region_set->number_of_azimuth_buckets = number_of_azimuth_buckets;
+    region_set->azimuth_bucket_width_inverse = (double)number_of_azimuth_buckets / LIDAR_DATA_MAXIMUM_ANGLE_RADIAN;
+    region_set->number_of_lasers = number_of_lasers;
+
+    const double azimuth_bucket_width = LIDAR_DATA_MAXIMUM_ANGLE_RADIAN / (double)number_of_azimuth_buckets;
+
+    // margin of bucket boundary for rounding error
+    const double azimuth_bucket_margin = azimuth_bucket_width * 1.0e-3;
+
+    // flags of buckets and lasers which can be in each region
+    std::vector<char> bucket_in_region(number_of_regions * number_of_azimuth_buckets, 0);
+    std::vector<char> laser_in_region(number_of_regions * number_of_lasers, 0);
+
+    for (unsigned int region_index = 0; region_index < number_of_regions; ++region_index) {
+
+        const lidar_echo_single_region_t *region = &regions.at(region_index);
+
+        for (unsigned int bucket = 0; bucket < number_of_azimuth_buckets; ++bucket) {
+
+            const double bucket_start = azimuth_bucket_width * (double)bucket - azimuth_bucket_margin;
+            const double bucket_end = azimuth_bucket_width * (double)(bucket + 1) + azimuth_bucket_margin;
+
+            // horizontal angle of echo may be shifted by rotations in region test
+            for (int rotation = -3; rotation <= 3; ++rotation) {
+
+                const double shift = LIDAR_DATA_MAXIMUM_ANGLE_RADIAN * (double)rotation;
+
+                if (are_intervals_intersect(bucket_start + shift, bucket_end + shift,
+                                            region->minimum_horizontal_angle,
+                                            region->maximum_horizontal_angle) == true) {
+                    bucket_in_region[region_index * number_of_azimuth_buckets + bucket] = 1;
+                    break;
+                }
+
+            }
+
+        }
+
+        for (unsigned int laser_id = 0; laser_id < number_of_lasers; ++laser_id) {
+
+            if (is_angle_in_angle_interval(region->minimum_elevation_angle,
+                                           region->maximum_elevation_angle,
+                                           laser_elevation_angle_array.at(laser_id)) == true) {
+                laser_in_region[region_index * number_of_lasers + laser_id] = 1;
+            }
+
+        }
+
+    }
+
+    // candidate lists in compressed row form
+    region_set->candidate_list_start.assign(number_of_azimuth_buckets * number_of_lasers + 1, 0);
+    region_set->candidate_region_index.clear();
+
+    for (unsigned int bucket = 0; bucket < number_of_azimuth_buckets; ++bucket) {
+
+        for (unsigned int laser_id = 0; laser_id < number_of_lasers; ++laser_id) {
+
+            const unsigned int key = bucket * number_of_lasers + laser_id;
+            region_set->candidate_list_start.at(key) = region_set->candidate_region_index.size();
+
+            for (unsigned int region_index = 0; region_index < number_of_regions; ++region_index) {
+
+                if ((bucket_in_region[region_index * number_of_azimuth_buckets + bucket] == 1) &&
+                    (laser_in_region[region_index * number_of_lasers + laser_id] == 1)) {
+                    region_set->candidate_region_index.push_back(region_index);
+                }
+
+            }
+
+        }
+
+    }
+    region_set->candidate_list_start.at(number_of_azimuth_buckets * number_of_lasers) =
+        region_set->candidate_region_index.size();
+
+    return true;
+}
+
+unsigned int add_lidar_echo_data_in_each_region_of_region_set(const lidar_line_data_t *line,
+                                                              const lidar_echo_region_set_t *region_set,
+                                                              std::vector< std::vector<lidar_echo_data_t> > &echoes_in_region)
+{
+    unsigned int total_added_size = 0;
+
+    const unsigned int number_of_regions = region_set->regions.size();
+
+    if (echoes_in_region.size() != number_of_regions) {
+        return total_added_size;
+    }
+
+    lidar_echo_data_t temporal_echo_data;
+
+    for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
+
+        const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+
+        for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+
+            if (spot->echo[echo_index] ==  LIDAR_SPOT_ACCESSOR_INVALID_ECHO_INDEX) {
+                continue;
+            }
+
+            const lidar_echo_data_t *echo =
+                &line->echo_buffer[spot->echo[echo_index]];
+
+            // all regions are candidates if laser is not indexed
+            unsigned int candidate_start = 0;
+            unsigned int candidate_end = number_of_regions;
+            const unsigned int *candidate_region_index = NULL;
+
+            if (spot_index < region_set->number_of_lasers) {
+
+                const unsigned int key =
+                    calculate_azimuth_bucket_of_region_set(region_set, echo->horizontal_angle) * region_set->number_of_lasers
+                    + spot_index;
+
+                candidate_start = region_set->candidate_list_start[key];
+                candidate_end = region_set->candidate_list_start[key + 1];
+                candidate_region_index = &region_set->candidate_region_index[0];
+            }
+
+            for (unsigned int candidate = candidate_start; candidate < candidate_end; ++candidate) {
+
+                unsigned int region_index = candidate;
+                if (candidate_region_index != NULL) {
+                    region_index = candidate_region_index[candidate];
+                }
+
+                const lidar_echo_single_region_t *region = &region_set->regions[region_index];
+
+                // line condition is evaluated only for candidate regions (same result as add_lidar_echo_data_in_a_single_region)
+                if ((is_lidar_echo_in_single_region(echo, region) == true) &&
+                    (are_intersect_lidar_echo_single_region_and_line(region, line) == true)) {
+
+                    std::vector<lidar_echo_data_t> &echoes = echoes_in_region[region_index];
+                    copy_lidar_echo_data(echo, &temporal_echo_data);
+                    echoes.push_back(temporal_echo_data);
+                    ++total_added_size;
+
+                }
+
+            }
+
+        }
+
+    }
+
+    return total_added_size;
+}
+
+unsigned int add_lidar_echo_data_in_each_region_of_region_set(const std::vector< const lidar_line_data_t *> &line_array,
+                                                              const lidar_echo_region_set_t *region_set,
+                                                              std::vector< std::vector<lidar_echo_data_t> > &echoes_in_region)
+{
+    unsigned int total_added_size = 0;
+
+    if (echoes_in_region.size() != region_set->regions.size()) {
+        return total_added_size;
+    }
+
+    LATENCY_TRACE_BEGIN(region_filter_start_time_nsec);
+
+    for (unsigned int line_index = 0; line_index < line_array.size(); ++line_index) {
+
+        total_added_size += add_lidar_echo_data_in_each_region_of_region_set(line_array.at(line_index),
+                                                                             region_set, echoes_in_region);
+
+    }
+
+    LATENCY_TRACE_END(region_filter_start_time_nsec, LATENCY_TRACE_REGION_FILTER_STAGE);
+
     return total_added_size;
 }
 
@@ -1095,152 +1331,1007 @@ enum LIDAR_ECHO_STATISTICS_DATA_INDEX {
     NUMBER_OF_LIDAR_ECHO_STATISTICS,
 };
 
-void calculate_statistics_of_lidar_echoes(const std::vector<lidar_echo_data_t> &echoes,
-                                          double one_step_angle_value,
-                                          double one_step_distance_value, double one_step_intensity_value,
-                                          int small_bin_threshold,
-                                          double horizontal_center, double elevation_center,
-                                          lidar_echo_statistics_t &statistics)
+static histogram_and_statistics_t *select_histogram_of_lidar_echo_statistics(enum LIDAR_ECHO_STATISTICS_DATA_INDEX statistics_index,
+                                                                             double one_step_angle_value,
+                                                                             double one_step_distance_value,
+                                                                             double one_step_intensity_value,
+                                                                             lidar_echo_statistics_t &statistics,
+                                                                             double *one_step_value)
 {
-    std::vector<histogram_and_statistics_t *> histogram_array(NUMBER_OF_LIDAR_ECHO_STATISTICS, NULL);
+    switch (statistics_index) {
+
+        case LIDAR_ECHO_INDEX_STATISTICS_INDEX:
+            *one_step_value = 1.5;
+            return &statistics.echo_index;
+
+        case LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX:
+            *one_step_value = 1.5;
+            return &statistics.number_of_echoes;
+
+        case LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX:
+            *one_step_value = one_step_angle_value;
+            return &statistics.horizontal_angle;
+
+        case LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX:
+            *one_step_value = one_step_angle_value;
+            return &statistics.elevation_angle;
+
+        case LIDAR_DISTANCE_STATISTICS_INDEX:
+            *one_step_value = one_step_distance_value;
+            return &statistics.distance;
+
+        case LIDAR_INTENSITY_STATISTICS_INDEX:
+            *one_step_value = one_step_intensity_value;
+            return &statistics.intensity;
+
+        case LIDAR_X_COMPONENT_STATISTICS_INDEX:
+            *one_step_value = one_step_distance_value;
+            return &statistics.x_component;
+        case LIDAR_Y_COMPONENT_STATISTICS_INDEX:
+            *one_step_value = one_step_distance_value;
+            return &statistics.y_component;
+        case LIDAR_Z_COMPONENT_STATISTICS_INDEX:
+            *one_step_value = one_step_distance_value;
+            return &statistics.z_component;
+
+        case NUMBER_OF_LIDAR_ECHO_STATISTICS:
+            break;
+    }
 
-    std::vector<double> one_step_value_array(NUMBER_OF_LIDAR_ECHO_STATISTICS, 0.0);
-    std::vector<int> small_bin_threshold_array(NUMBER_OF_LIDAR_ECHO_STATISTICS, small_bin_threshold);
+    *one_step_value = 0.0;
+    return NULL;
+}
 
-    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+static double wrap_angle_around_calculation_center(double angle, double center)
+{
+    const double difference = angle - center;
 
-        enum LIDAR_ECHO_STATISTICS_DATA_INDEX statistics_index =
-            (enum LIDAR_ECHO_STATISTICS_DATA_INDEX) i;
+    if (difference < -M_PI) {
+        return angle + 2.0 * M_PI;
+    }
 
-        switch (statistics_index) {
+    if (difference >= M_PI) {
+        return angle - 2.0 * M_PI;
+    }
 
-            case LIDAR_ECHO_INDEX_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.echo_index;
-                one_step_value_array.at(i) = 1.5;
-                break;
+    return angle;
+}
 
-            case LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.number_of_echoes;
-                one_step_value_array.at(i) = 1.5;
-                break;
+/*!
+  \brief function to calculate statistics values of lidar echo
+  \attention angles are wrapped around centers, and cartesian coordinates calculated by decoder are used if available
+*/
+static void calculate_statistics_values_of_lidar_echo(const lidar_echo_data_t *echo,
+                                                      double horizontal_center, double elevation_center,
+                                                      double *value_array)
+{
+    value_array[LIDAR_ECHO_INDEX_STATISTICS_INDEX] = echo->index;
+    value_array[LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX] = echo->number_of_echoes_at_same_time;
 
-            case LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.horizontal_angle;
-                one_step_value_array.at(i) = one_step_angle_value;
-                break;
+    value_array[LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX] =
+        wrap_angle_around_calculation_center(echo->horizontal_angle, horizontal_center);
+    value_array[LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX] =
+        wrap_angle_around_calculation_center(echo->elevation_angle, elevation_center);
 
-            case LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.elevation_angle;
-                one_step_value_array.at(i) = one_step_angle_value;
-                break;
+    value_array[LIDAR_DISTANCE_STATISTICS_INDEX] = echo->distance;
+    value_array[LIDAR_INTENSITY_STATISTICS_INDEX] = echo->intensity;
 
-            case LIDAR_DISTANCE_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.distance;
-                one_step_value_array.at(i) = one_step_distance_value;
-                break;
+    if (echo->cartesian_coordinates_available == true) {
 
-            case LIDAR_INTENSITY_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.intensity;
-                one_step_value_array.at(i) = one_step_intensity_value;
-                break;
+        value_array[LIDAR_X_COMPONENT_STATISTICS_INDEX] = echo->x_component;
+        value_array[LIDAR_Y_COMPONENT_STATISTICS_INDEX] = echo->y_component;
+        value_array[LIDAR_Z_COMPONENT_STATISTICS_INDEX] = echo->z_component;
 
-            case LIDAR_X_COMPONENT_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.x_component;
-                one_step_value_array.at(i) = one_step_distance_value;
-                break;
-            case LIDAR_Y_COMPONENT_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.y_component;
-                one_step_value_array.at(i) = one_step_distance_value;
-                break;
-            case LIDAR_Z_COMPONENT_STATISTICS_INDEX:
-                histogram_array.at(i) = &statistics.z_component;
-                one_step_value_array.at(i) = one_step_distance_value;
-                break;
+        return;
+    }
 
-            case NUMBER_OF_LIDAR_ECHO_STATISTICS:
-                break;
-        }
+    const double cosine = cos(echo->elevation_angle);
 
-    }
+    value_array[LIDAR_X_COMPONENT_STATISTICS_INDEX] = echo->distance * cosine * cos(echo->horizontal_angle);
+    value_array[LIDAR_Y_COMPONENT_STATISTICS_INDEX] = echo->distance * cosine * sin(echo->horizontal_angle);
+    value_array[LIDAR_Z_COMPONENT_STATISTICS_INDEX] = echo->distance * sin(echo->elevation_angle);
+
+    return;
+}
 
+void calculate_statistics_of_lidar_echoes(const std::vector<lidar_echo_data_t> &echoes,
+                                          double one_step_angle_value,
+                                          double one_step_distance_value, double one_step_intensity_value,
+                                          int small_bin_threshold,
+                                          double horizontal_center, double elevation_center,
+                                          lidar_echo_statistics_t &statistics)
+{
     const unsigned int number_of_echoes = echoes.size();
 
-    std::vector< std::vector<double> > value_table(NUMBER_OF_LIDAR_ECHO_STATISTICS);
+    if (number_of_echoes == 0) {
+        return;
+    }
+
+    double value_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+
+    // first pass accumulates statistics which decide range of histograms
+    streaming_statistics_t streaming_statistics[NUMBER_OF_LIDAR_ECHO_STATISTICS];
 
     for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
-        value_table.at(i).resize(number_of_echoes);
+        clear_streaming_statistics(&streaming_statistics[i]);
     }
 
-    double horizontal_difference = 0.0;
-    double elevation_difference = 0.0;
+    for (unsigned int echo_index = 0; echo_index < number_of_echoes; ++echo_index) {
 
-    double cosine = 0.0;
+        calculate_statistics_values_of_lidar_echo(&echoes[echo_index], horizontal_center, elevation_center,
+                                                  value_array);
 
-    for (unsigned int i = 0; i < number_of_echoes; ++i) {
-
-        const lidar_echo_data_t *echo = &echoes.at(i);
+        add_values_to_streaming_statistics_array(streaming_statistics, value_array, NUMBER_OF_LIDAR_ECHO_STATISTICS);
+    }
 
-        value_table.at(LIDAR_ECHO_INDEX_STATISTICS_INDEX).at(i) = echo->index;
-        value_table.at(LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX).at(i) = echo->number_of_echoes_at_same_time;
+    histogram_and_statistics_t *histogram_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+    double step_coefficient_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+    double one_step_value = 0.0;
 
-        horizontal_difference = echo->horizontal_angle - horizontal_center;
+    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
 
-        if (horizontal_difference < -M_PI) {
+        histogram_array[i] =
+            select_histogram_of_lidar_echo_statistics((enum LIDAR_ECHO_STATISTICS_DATA_INDEX)i,
+                                                      one_step_angle_value,
+                                                      one_step_distance_value, one_step_intensity_value,
+                                                      statistics, &one_step_value);
 
-            value_table.at(LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->horizontal_angle + 2.0 * M_PI;
+        set_histogram_and_statistics_from_streaming_statistics(histogram_array[i], &streaming_statistics[i],
+                                                               one_step_value, small_bin_threshold);
 
-        } else if (horizontal_difference >= M_PI) {
+        step_coefficient_array[i] = calculate_step_coefficient_of_histogram(&histogram_array[i]->histogram);
+    }
 
-            value_table.at(LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->horizontal_angle - 2.0 * M_PI;
+    // second pass counts values in histograms
+    for (unsigned int echo_index = 0; echo_index < number_of_echoes; ++echo_index) {
 
-        } else {
+        calculate_statistics_values_of_lidar_echo(&echoes[echo_index], horizontal_center, elevation_center,
+                                                  value_array);
 
-            value_table.at(LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->horizontal_angle;
+        for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+            add_value_to_histogram(&histogram_array[i]->histogram, value_array[i], step_coefficient_array[i]);
         }
+    }
+
+    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+        find_large_bins_of_histogram_and_statistics(histogram_array[i]);
+    }
+
+    return;
+}
 
-        elevation_difference = echo->elevation_angle - elevation_center;
+void clear_lidar_echo_streaming_statistics(lidar_echo_streaming_statistics_t *statistics,
+                                           double horizontal_center, double elevation_center)
+{
+    clear_streaming_statistics(&statistics->echo_index);
+    clear_streaming_statistics(&statistics->number_of_echoes);
 
-        if (elevation_difference < -M_PI) {
+    statistics->horizontal_angle_calculation_center = horizontal_center;
+    clear_streaming_statistics(&statistics->horizontal_angle);
 
-            value_table.at(LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->elevation_angle + 2.0 * M_PI;
+    statistics->elevation_angle_calculation_center = elevation_center;
+    clear_streaming_statistics(&statistics->elevation_angle);
 
-        } else if (elevation_difference >= M_PI) {
+    clear_streaming_statistics(&statistics->distance);
+    clear_streaming_statistics(&statistics->intensity);
 
-            value_table.at(LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->elevation_angle - 2.0 * M_PI;
+    clear_streaming_statistics(&statistics->x_component);
+    clear_streaming_statistics(&statistics->y_component);
+    clear_streaming_statistics(&statistics->z_component);
 
-        } else {
+    return;
+}
+
+void add_lidar_echo_to_streaming_statistics(lidar_echo_streaming_statistics_t *statistics,
+                                            const lidar_echo_data_t *echo)
+{
+    double value_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
 
-            value_table.at(LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX).at(i) =
-                echo->elevation_angle;
+    calculate_statistics_values_of_lidar_echo(echo,
+                                              statistics->horizontal_angle_calculation_center,
+                                              statistics->elevation_angle_calculation_center,
+                                              value_array);
 
-        }
+    add_value_to_streaming_statistics(&statistics->echo_index, value_array[LIDAR_ECHO_INDEX_STATISTICS_INDEX]);
+    add_value_to_streaming_statistics(&statistics->number_of_echoes, value_array[LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX]);
 
-        value_table.at(LIDAR_DISTANCE_STATISTICS_INDEX).at(i) = echo->distance;
-        value_table.at(LIDAR_INTENSITY_STATISTICS_INDEX).at(i) = echo->intensity;
+    add_value_to_streaming_statistics(&statistics->horizontal_angle, value_array[LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX]);
+    add_value_to_streaming_statistics(&statistics->elevation_angle, value_array[LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX]);
 
-        cosine = cos(echo->elevation_angle);
+    add_value_to_streaming_statistics(&statistics->distance, value_array[LIDAR_DISTANCE_STATISTICS_INDEX]);
+    add_value_to_streaming_statistics(&statistics->intensity, value_array[LIDAR_INTENSITY_STATISTICS_INDEX]);
 
-        value_table.at(LIDAR_X_COMPONENT_STATISTICS_INDEX).at(i) =
-            echo->distance * cosine * cos(echo->horizontal_angle);
+    add_value_to_streaming_statistics(&statistics->x_component, value_array[LIDAR_X_COMPONENT_STATISTICS_INDEX]);
+    add_value_to_streaming_statistics(&statistics->y_component, value_array[LIDAR_Y_COMPONENT_STATISTICS_INDEX]);
+    add_value_to_streaming_statistics(&statistics->z_component, value_array[LIDAR_Z_COMPONENT_STATISTICS_INDEX]);
 
-        value_table.at(LIDAR_Y_COMPONENT_STATISTICS_INDEX).at(i) =
-            echo->distance * cosine * sin(echo->horizontal_angle);
+    return;
+}
 
-        value_table.at(LIDAR_Z_COMPONENT_STATISTICS_INDEX).at(i) =
-            echo->distance * sin(echo->elevation_angle);
+unsigned int add_lidar_echo_data_in_a_single_region_to_streaming_statistics(const lidar_line_data_t *line,
+                                                                            const lidar_echo_single_region_t *region,
+                                                                            lidar_echo_streaming_statistics_t *statistics)
+{
+    unsigned int number_of_added_echoes = 0;
 
+    if (are_intersect_lidar_echo_single_region_and_line(region, line) == false) {
+        return number_of_added_echoes;
     }
 
-    calculate_region_adjusted_histogram_and_statistics_array(one_step_value_array,
-                                                             small_bin_threshold_array,
-                                                             value_table, histogram_array);
+    for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
 
-    return;
+        const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+
+        for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+
+            if (spot->echo[echo_index] ==  LIDAR_SPOT_ACCESSOR_INVALID_ECHO_INDEX) {
+                continue;
+            }
+
+            const lidar_echo_data_t *echo =
+                &line->echo_buffer[spot->echo[echo_index]];
+
+            if (is_lidar_echo_in_single_region(echo, region) == true) {
+
+                add_lidar_echo_to_streaming_statistics(statistics, echo);
+                ++number_of_added_echoes;
+
+            }
+
+        }
+
+    }
+
+    return number_of_added_echoes;
+}
+
+bool merge_lidar_echo_streaming_statistics(lidar_echo_streaming_statistics_t *destination,
+                                           const lidar_echo_streaming_statistics_t *source)
+{
+    if ((destination->horizontal_angle_calculation_center != source->horizontal_angle_calculation_center) ||
+        (destination->elevation_angle_calculation_center != source->elevation_angle_calculation_center)) {
+        return false;
+    }
+
+    merge_streaming_statistics(&destination->echo_index, &source->echo_index);
+    merge_streaming_statistics(&destination->number_of_echoes, &source->number_of_echoes);
+
+    merge_streaming_statistics(&destination->horizontal_angle, &source->horizontal_angle);
+    merge_streaming_statistics(&destination->elevation_angle, &source->elevation_angle);
+
+    merge_streaming_statistics(&destination->distance, &source->distance);
+    merge_streaming_statistics(&destination->intensity, &source->intensity);
+
+    merge_streaming_statistics(&destination->x_component, &source->x_component);
+    merge_streaming_statistics(&destination->y_component, &source->y_component);
+    merge_streaming_statistics(&destination->z_component, &source->z_component);
+
+    return true;
+}
+
+static void copy_streaming_statistics_to_histogram_and_statistics(const streaming_statistics_t *streaming_statistics,
+                                                                  histogram_and_statistics_t *statistics)
+{
+    statistics->total_number_of_data = streaming_statistics->number_of_data;
+
+    statistics->average = streaming_statistics->average;
+    statistics->variance = calculate_variance_of_streaming_statistics(streaming_statistics);
+
+    statistics->minimum = streaming_statistics->minimum;
+    statistics->maximum = streaming_statistics->maximum;
+
+    return;
+}
+
+void copy_lidar_echo_streaming_statistics(const lidar_echo_streaming_statistics_t *streaming_statistics,
+                                          lidar_echo_statistics_t *statistics)
+{
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->echo_index,
+                                                          &statistics->echo_index);
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->number_of_echoes,
+                                                          &statistics->number_of_echoes);
+
+    statistics->horizontal_angle_calculation_center =
+        streaming_statistics->horizontal_angle_calculation_center;
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->horizontal_angle,
+                                                          &statistics->horizontal_angle);
+
+    statistics->elevation_angle_calculation_center =
+        streaming_statistics->elevation_angle_calculation_center;
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->elevation_angle,
+                                                          &statistics->elevation_angle);
+
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->distance,
+                                                          &statistics->distance);
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->intensity,
+                                                          &statistics->intensity);
+
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->x_component,
+                                                          &statistics->x_component);
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->y_component,
+                                                          &statistics->y_component);
+    copy_streaming_statistics_to_histogram_and_statistics(&streaming_statistics->z_component,
+                                                          &statistics->z_component);
+
+    return;
+}
+
+void clear_lidar_point_block(lidar_point_block_t *block)
+{
+    block->capacity = 0;
+    block->number_of_points = 0;
+    block->number_of_dropped_points = 0;
+
+    block->horizontal_angle = NULL;
+    block->elevation_angle = NULL;
+    block->distance = NULL;
+    block->intensity = NULL;
+    block->laser_id = NULL;
+    block->echo_index = NULL;
+    block->number_of_echoes_at_same_time = NULL;
+    block->measured_time = NULL;
+
+    return;
+}
+
+bool allocate_memory_for_lidar_point_block(lidar_point_block_t *block, unsigned int capacity)
+{
+    if (capacity == 0) {
+        return false;
+    }
+
+    block->horizontal_angle = (float *)malloc(capacity * sizeof(float));
+    block->elevation_angle = (float *)malloc(capacity * sizeof(float));
+    block->distance = (float *)malloc(capacity * sizeof(float));
+    block->intensity = (unsigned short *)malloc(capacity * sizeof(unsigned short));
+    block->laser_id = (unsigned short *)malloc(capacity * sizeof(unsigned short));
+    block->echo_index = (unsigned char *)malloc(capacity * sizeof(unsigned char));
+    block->number_of_echoes_at_same_time = (unsigned char *)malloc(capacity * sizeof(unsigned char));
+    block->measured_time = (unsigned int *)malloc(capacity * sizeof(unsigned int));
+
+    if ((block->horizontal_angle == NULL) ||
+        (block->elevation_angle == NULL) ||
+        (block->distance == NULL) ||
+        (block->intensity == NULL) ||
+        (block->laser_id == NULL) ||
+        (block->echo_index == NULL) ||
+        (block->number_of_echoes_at_same_time == NULL) ||
+        (block->measured_time == NULL)) {
+        block->capacity = capacity;
+        release_memory_of_lidar_point_block(block);
+        return false;
+    }
+
+    block->capacity = capacity;
+    block->number_of_points = 0;
+    block->number_of_dropped_points = 0;
+
+    return true;
+}
+
+bool release_memory_of_lidar_point_block(lidar_point_block_t *block)
+{
+    if (block->capacity == 0) {
+        return false;
+    }
+
+    // free(NULL) does nothing
+    free(block->horizontal_angle);
+    free(block->elevation_angle);
+    free(block->distance);
+    free(block->intensity);
+    free(block->laser_id);
+    free(block->echo_index);
+    free(block->number_of_echoes_at_same_time);
+    free(block->measured_time);
+
+    clear_lidar_point_block(block);
+
+    return true;
+}
+
+bool is_allocated_memory_of_lidar_point_block(const lidar_point_block_t *block)
+{
+    if (block->capacity == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+void erase_all_points_of_lidar_point_block(lidar_point_block_t *block)
+{
+    block->number_of_points = 0;
+    block->number_of_dropped_points = 0;
+
+    return;
+}
+
+bool append_point_to_lidar_point_block(lidar_point_block_t *block,
+                                       double horizontal_angle, double elevation_angle,
+                                       unsigned int distance, unsigned int intensity,
+                                       unsigned int laser_id, unsigned int echo_index,
+                                       unsigned int number_of_echoes_at_same_time,
+                                       unsigned int measured_time)
+{
+    if (block->number_of_points >= block->capacity) {
+        ++block->number_of_dropped_points;
+        return false;
+    }
+
+    const unsigned int point_index = block->number_of_points;
+
+    block->horizontal_angle[point_index] = (float)horizontal_angle;
+    block->elevation_angle[point_index] = (float)elevation_angle;
+    block->distance[point_index] = (float)distance;
+    block->intensity[point_index] = (unsigned short)intensity;
+    block->laser_id[point_index] = (unsigned short)laser_id;
+    block->echo_index[point_index] = (unsigned char)echo_index;
+    block->number_of_echoes_at_same_time[point_index] = (unsigned char)number_of_echoes_at_same_time;
+    block->measured_time[point_index] = measured_time;
+
+    ++block->number_of_points;
+
+    return true;
+}
+
+unsigned int append_lidar_line_data_to_point_block(const lidar_line_data_t *line,
+                                                   lidar_point_block_t *block)
+{
+    unsigned int number_of_appended_points = 0;
+
+    for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
+
+        const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+
+        for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+
+            if (spot->echo[echo_index] ==  LIDAR_SPOT_ACCESSOR_INVALID_ECHO_INDEX) {
+                continue;
+            }
+
+            const lidar_echo_data_t *echo =
+                &line->echo_buffer[spot->echo[echo_index]];
+
+            if (append_point_to_lidar_point_block(block, echo->horizontal_angle, echo->elevation_angle,
+                                                  echo->distance, echo->intensity, spot_index,
+                                                  echo->index, echo->number_of_echoes_at_same_time,
+                                                  echo->measured_time) == false) {
+                // rest of echoes are also counted in number_of_dropped_points
+                continue;
+            }
+            ++number_of_appended_points;
+
+        }
+
+    }
+
+    return number_of_appended_points;
+}
+
+void copy_lidar_point_to_echo_data(const lidar_point_block_t *block, unsigned int point_index,
+                                   lidar_echo_data_t *echo)
+{
+    echo->index = block->echo_index[point_index];
+    echo->number_of_echoes_at_same_time = block->number_of_echoes_at_same_time[point_index];
+
+    echo->horizontal_angle = block->horizontal_angle[point_index];
+    echo->elevation_angle = block->elevation_angle[point_index];
+
+    echo->measured_time = block->measured_time[point_index];
+    echo->calibrated_time = echo->measured_time;
+
+    echo->distance = (unsigned int)block->distance[point_index];
+    echo->intensity = block->intensity[point_index];
+
+    echo->cartesian_coordinates_available = false;
+    echo->x_component = 0.0;
+    echo->y_component = 0.0;
+    echo->z_component = 0.0;
+
+    return;
+}
+
+/*!
+  \brief function to evaluate angle interval condition without branch
+  \attention this function is same as is_angle_in_angle_interval
+*/
+static inline unsigned int is_angle_in_angle_interval_without_branch(float start, float end, float angle)
+{
+    const float offsetted_angle = angle
+        + (float)LIDAR_DATA_MAXIMUM_ANGLE_RADIAN * (float)(angle < start)
+        - (float)LIDAR_DATA_MAXIMUM_ANGLE_RADIAN * (float)((angle > end) & (angle >= start));
+
+    return (unsigned int)(offsetted_angle >= start) & (unsigned int)(offsetted_angle <= end);
+}
+
+unsigned int select_lidar_points_in_a_single_region(const lidar_point_block_t *block,
+                                                    const lidar_echo_single_region_t *region,
+                                                    unsigned int *selected_point_index_array)
+{
+    const unsigned int number_of_points = block->number_of_points;
+
+    const float minimum_horizontal_angle = (float)region->minimum_horizontal_angle;
+    const float maximum_horizontal_angle = (float)region->maximum_horizontal_angle;
+    const float minimum_elevation_angle = (float)region->minimum_elevation_angle;
+    const float maximum_elevation_angle = (float)region->maximum_elevation_angle;
+
+    // limits are clamped in float range (regions using only direction have +-DBL_MAX)
+    const float minimum_distance = (float)std::max(region->minimum_distance, -(double)FLT_MAX);
+    const float maximum_distance = (float)std::min(region->maximum_distance, (double)FLT_MAX);
+    const float minimum_intensity = (float)std::max(region->minimum_intensity, -(double)FLT_MAX);
+    const float maximum_intensity = (float)std::min(region->maximum_intensity, (double)FLT_MAX);
+
+    const float *horizontal_angle = block->horizontal_angle;
+    const float *elevation_angle = block->elevation_angle;
+    const float *distance = block->distance;
+    const unsigned short *intensity = block->intensity;
+
+    unsigned int number_of_selected_points = 0;
+
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+
+        const float point_intensity = (float)intensity[i];
+
+        const unsigned int in_region =
+            is_angle_in_angle_interval_without_branch(minimum_horizontal_angle, maximum_horizontal_angle,
+                                                      horizontal_angle[i])
+            & is_angle_in_angle_interval_without_branch(minimum_elevation_angle, maximum_elevation_angle,
+                                                        elevation_angle[i])
+            & (unsigned int)(distance[i] >= minimum_distance) & (unsigned int)(distance[i] <= maximum_distance)
+            & (unsigned int)(point_intensity >= minimum_intensity) & (unsigned int)(point_intensity <= maximum_intensity);
+
+        // index is always written, and kept only if point is in region
+        selected_point_index_array[number_of_selected_points] = i;
+        number_of_selected_points += in_region;
+    }
+
+    return number_of_selected_points;
+}
+
+//! number of points selected at once (index array is on stack)
+const unsigned int LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH = 256;
+
+unsigned int add_lidar_point_block_data_in_a_single_region(const lidar_point_block_t *block,
+                                                           const lidar_echo_single_region_t *region,
+                                                           std::vector<lidar_echo_data_t> &echoes_in_region)
+{
+    unsigned int selected_point_index_array[LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH];
+
+    unsigned int number_of_added_points = 0;
+
+    for (unsigned int chunk_start = 0; chunk_start < block->number_of_points;
+         chunk_start += LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH) {
+
+        // view of chunk (arrays are not copied)
+        lidar_point_block_t chunk = *block;
+        chunk.horizontal_angle += chunk_start;
+        chunk.elevation_angle += chunk_start;
+        chunk.distance += chunk_start;
+        chunk.intensity += chunk_start;
+        chunk.laser_id += chunk_start;
+        chunk.echo_index += chunk_start;
+        chunk.number_of_echoes_at_same_time += chunk_start;
+        chunk.measured_time += chunk_start;
+        chunk.number_of_points = std::min(block->number_of_points - chunk_start,
+                                          LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH);
+
+        const unsigned int number_of_selected_points =
+            select_lidar_points_in_a_single_region(&chunk, region, selected_point_index_array);
+
+        lidar_echo_data_t temporal_echo_data;
+
+        for (unsigned int i = 0; i < number_of_selected_points; ++i) {
+            copy_lidar_point_to_echo_data(&chunk, selected_point_index_array[i], &temporal_echo_data);
+            echoes_in_region.push_back(temporal_echo_data);
+        }
+
+        number_of_added_points += number_of_selected_points;
+    }
+
+    return number_of_added_points;
+}
+
+static void adjust_angle_array_around_center(const float *angle, unsigned int number_of_angles,
+                                             double center, double *adjusted_angle)
+{
+    for (unsigned int i = 0; i < number_of_angles; ++i) {
+
+        const double difference = (double)angle[i] - center;
+
+        adjusted_angle[i] = (double)angle[i]
+            + 2.0 * M_PI * (double)(difference < -M_PI)
+            - 2.0 * M_PI * (double)(difference >= M_PI);
+    }
+
+    return;
+}
+
+//! number of elevation angles cached in statistics of point block (indexed by laser id)
+const unsigned int LIDAR_POINT_ELEVATION_CACHE_LENGTH = 64;
+
+//! cosine and sine of elevation angle of each laser id (elevation angle repeats for each laser)
+struct lidar_point_elevation_cache_t {
+
+    //! elevation angle [rad]
+    float elevation_angle[LIDAR_POINT_ELEVATION_CACHE_LENGTH];
+    //! cosine of elevation angle
+    double cosine[LIDAR_POINT_ELEVATION_CACHE_LENGTH];
+    //! sine of elevation angle
+    double sine[LIDAR_POINT_ELEVATION_CACHE_LENGTH];
+    //! whether elevation angle is cached
+    bool cached[LIDAR_POINT_ELEVATION_CACHE_LENGTH];
+
+};
+
+static void clear_lidar_point_elevation_cache(lidar_point_elevation_cache_t *cache)
+{
+    for (unsigned int i = 0; i < LIDAR_POINT_ELEVATION_CACHE_LENGTH; ++i) {
+        cache->cached[i] = false;
+    }
+
+    return;
+}
+
+/*!
+  \brief function to calculate statistics values of points in chunk of point block
+  \attention each column of value_table is filled from one array, and cosine and sine of elevation angles are reused from cache
+*/
+static void calculate_statistics_values_of_lidar_point_chunk(const lidar_point_block_t *block,
+                                                             unsigned int chunk_start, unsigned int number_of_points,
+                                                             double horizontal_center, double elevation_center,
+                                                             lidar_point_elevation_cache_t *cache,
+                                                             double value_table[][LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH])
+{
+    const unsigned char *block_echo_index = block->echo_index + chunk_start;
+    const unsigned char *block_number_of_echoes = block->number_of_echoes_at_same_time + chunk_start;
+    const float *block_distance = block->distance + chunk_start;
+    const unsigned short *block_intensity = block->intensity + chunk_start;
+    const unsigned short *block_laser_id = block->laser_id + chunk_start;
+    const float *block_horizontal_angle = block->horizontal_angle + chunk_start;
+    const float *block_elevation_angle = block->elevation_angle + chunk_start;
+
+    double *echo_index = value_table[LIDAR_ECHO_INDEX_STATISTICS_INDEX];
+    double *number_of_echoes = value_table[LIDAR_NUMBER_OF_ECHOES_STATISTICS_INDEX];
+    double *distance = value_table[LIDAR_DISTANCE_STATISTICS_INDEX];
+    double *intensity = value_table[LIDAR_INTENSITY_STATISTICS_INDEX];
+
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+        echo_index[i] = block_echo_index[i];
+    }
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+        number_of_echoes[i] = block_number_of_echoes[i];
+    }
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+        distance[i] = block_distance[i];
+    }
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+        intensity[i] = block_intensity[i];
+    }
+
+    adjust_angle_array_around_center(block_horizontal_angle, number_of_points, horizontal_center,
+                                     value_table[LIDAR_HORIZONTAL_ANGLE_STATISTICS_INDEX]);
+    adjust_angle_array_around_center(block_elevation_angle, number_of_points, elevation_center,
+                                     value_table[LIDAR_ELEVATION_ANGLE_STATISTICS_INDEX]);
+
+    double *x_component = value_table[LIDAR_X_COMPONENT_STATISTICS_INDEX];
+    double *y_component = value_table[LIDAR_Y_COMPONENT_STATISTICS_INDEX];
+    double *z_component = value_table[LIDAR_Z_COMPONENT_STATISTICS_INDEX];
+
+    for (unsigned int i = 0; i < number_of_points; ++i) {
+
+        const float elevation_angle = block_elevation_angle[i];
+        const unsigned int cache_index = block_laser_id[i] % LIDAR_POINT_ELEVATION_CACHE_LENGTH;
+
+        if ((cache->cached[cache_index] == false) || (cache->elevation_angle[cache_index] != elevation_angle)) {
+            cache->elevation_angle[cache_index] = elevation_angle;
+            cache->cosine[cache_index] = cos((double)elevation_angle);
+            cache->sine[cache_index] = sin((double)elevation_angle);
+            cache->cached[cache_index] = true;
+        }
+
+        const double horizontal_distance = distance[i] * cache->cosine[cache_index];
+
+        x_component[i] = horizontal_distance * cos((double)block_horizontal_angle[i]);
+        y_component[i] = horizontal_distance * sin((double)block_horizontal_angle[i]);
+        z_component[i] = distance[i] * cache->sine[cache_index];
+    }
+
+    return;
+}
+
+void calculate_statistics_of_lidar_point_block(const lidar_point_block_t *block,
+                                               double one_step_angle_value,
+                                               double one_step_distance_value, double one_step_intensity_value,
+                                               int small_bin_threshold,
+                                               double horizontal_center, double elevation_center,
+                                               lidar_echo_statistics_t &statistics)
+{
+    const unsigned int number_of_points = block->number_of_points;
+
+    if (number_of_points == 0) {
+        return;
+    }
+
+    // values of one chunk are on stack
+    double value_table[NUMBER_OF_LIDAR_ECHO_STATISTICS][LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH];
+
+    lidar_point_elevation_cache_t elevation_cache;
+    clear_lidar_point_elevation_cache(&elevation_cache);
+
+    // first pass merges statistics of chunks, and they decide range of histograms
+    streaming_statistics_t streaming_statistics[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+
+    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+        clear_streaming_statistics(&streaming_statistics[i]);
+    }
+
+    for (unsigned int chunk_start = 0; chunk_start < number_of_points;
+         chunk_start += LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH) {
+
+        const unsigned int number_of_points_in_chunk =
+            std::min(number_of_points - chunk_start, LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH);
+
+        calculate_statistics_values_of_lidar_point_chunk(block, chunk_start, number_of_points_in_chunk,
+                                                         horizontal_center, elevation_center,
+                                                         &elevation_cache, value_table);
+
+        for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+            add_value_array_to_streaming_statistics(&streaming_statistics[i], value_table[i],
+                                                    number_of_points_in_chunk);
+        }
+    }
+
+    histogram_and_statistics_t *histogram_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+    double step_coefficient_array[NUMBER_OF_LIDAR_ECHO_STATISTICS];
+    double one_step_value = 0.0;
+
+    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+
+        histogram_array[i] =
+            select_histogram_of_lidar_echo_statistics((enum LIDAR_ECHO_STATISTICS_DATA_INDEX)i,
+                                                      one_step_angle_value,
+                                                      one_step_distance_value, one_step_intensity_value,
+                                                      statistics, &one_step_value);
+
+        set_histogram_and_statistics_from_streaming_statistics(histogram_array[i], &streaming_statistics[i],
+                                                               one_step_value, small_bin_threshold);
+
+        step_coefficient_array[i] = calculate_step_coefficient_of_histogram(&histogram_array[i]->histogram);
+    }
+
+    // second pass counts values of chunks in histograms
+    for (unsigned int chunk_start = 0; chunk_start < number_of_points;
+         chunk_start += LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH) {
+
+        const unsigned int number_of_points_in_chunk =
+            std::min(number_of_points - chunk_start, LIDAR_POINT_BLOCK_SELECTION_CHUNK_LENGTH);
+
+        calculate_statistics_values_of_lidar_point_chunk(block, chunk_start, number_of_points_in_chunk,
+                                                         horizontal_center, elevation_center,
+                                                         &elevation_cache, value_table);
+
+        for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+            for (unsigned int point_index = 0; point_index < number_of_points_in_chunk; ++point_index) {
+                add_value_to_histogram(&histogram_array[i]->histogram, value_table[i][point_index],
+                                       step_coefficient_array[i]);
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < NUMBER_OF_LIDAR_ECHO_STATISTICS; ++i) {
+        find_large_bins_of_histogram_and_statistics(histogram_array[i]);
+    }
+
+    return;
+}
+
+void clear_lidar_frame(lidar_frame_t *frame)
+{
+    clear_lidar_point_block(&frame->points);
+
+    frame->maximum_number_of_lines = 0;
+    frame->number_of_lines = 0;
+    frame->line_start_point_index = NULL;
+    frame->line_start_time = NULL;
+
+    frame->frame_number = 0;
+    frame->overflow_occurs = false;
+
+    return;
+}
+
+bool allocate_memory_for_lidar_frame(lidar_frame_t *frame,
+                                     unsigned int maximum_number_of_lines, unsigned int maximum_number_of_points)
+{
+    if (maximum_number_of_lines == 0) {
+        return false;
+    }
+
+    if (allocate_memory_for_lidar_point_block(&frame->points, maximum_number_of_points) == false) {
+        return false;
+    }
+
+    frame->line_start_point_index = (unsigned int *)malloc(maximum_number_of_lines * sizeof(unsigned int));
+    frame->line_start_time = (unsigned int *)malloc(maximum_number_of_lines * sizeof(unsigned int));
+
+    if ((frame->line_start_point_index == NULL) ||
+        (frame->line_start_time == NULL)) {
+        free(frame->line_start_point_index);
+        free(frame->line_start_time);
+        release_memory_of_lidar_point_block(&frame->points);
+        clear_lidar_frame(frame);
+        return false;
+    }
+
+    frame->maximum_number_of_lines = maximum_number_of_lines;
+    erase_all_lines_of_lidar_frame(frame);
+
+    return true;
+}
+
+bool release_memory_of_lidar_frame(lidar_frame_t *frame)
+{
+    if (frame->maximum_number_of_lines == 0) {
+        return false;
+    }
+
+    free(frame->line_start_point_index);
+    free(frame->line_start_time);
+    release_memory_of_lidar_point_block(&frame->points);
+
+    clear_lidar_frame(frame);
+
+    return true;
+}
+
+void erase_all_lines_of_lidar_frame(lidar_frame_t *frame)
+{
+    erase_all_points_of_lidar_point_block(&frame->points);
+
+    frame->number_of_lines = 0;
+    frame->overflow_occurs = false;
+
+    return;
+}
+
+void initialize_lidar_frame_assembler(lidar_frame_assembler_t *assembler)
+{
+    clear_lidar_frame(&assembler->frame_buffer[0]);
+    clear_lidar_frame(&assembler->frame_buffer[1]);
+
+    assembler->filling_frame = &assembler->frame_buffer[0];
+    assembler->completed_frame = &assembler->frame_buffer[1];
+    assembler->completed_frame_unread = false;
+
+    assembler->number_of_completed_frames = 0;
+    assembler->number_of_overwritten_frames = 0;
+
+    return;
+}
+
+bool allocate_memory_for_lidar_frame_assembler(lidar_frame_assembler_t *assembler,
+                                               unsigned int maximum_number_of_lines,
+                                               unsigned int maximum_number_of_points)
+{
+    if (allocate_memory_for_lidar_frame(&assembler->frame_buffer[0],
+                                        maximum_number_of_lines, maximum_number_of_points) == false) {
+        return false;
+    }
+
+    if (allocate_memory_for_lidar_frame(&assembler->frame_buffer[1],
+                                        maximum_number_of_lines, maximum_number_of_points) == false) {
+        release_memory_of_lidar_frame(&assembler->frame_buffer[0]);
+        return false;
+    }
+
+    assembler->filling_frame = &assembler->frame_buffer[0];
+    assembler->completed_frame = &assembler->frame_buffer[1];
+    assembler->completed_frame_unread = false;
+
+    assembler->number_of_completed_frames = 0;
+    assembler->number_of_overwritten_frames = 0;
+
+    return true;
+}
+
+bool release_memory_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler)
+{
+    if (is_allocated_memory_of_lidar_frame_assembler(assembler) == false) {
+        return false;
+    }
+
+    release_memory_of_lidar_frame(&assembler->frame_buffer[0]);
+    release_memory_of_lidar_frame(&assembler->frame_buffer[1]);
+
+    initialize_lidar_frame_assembler(assembler);
+
+    return true;
+}
+
+bool is_allocated_memory_of_lidar_frame_assembler(const lidar_frame_assembler_t *assembler)
+{
+    if (assembler->frame_buffer[0].maximum_number_of_lines == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool start_line_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler, unsigned int line_start_time)
+{
+    lidar_frame_t *frame = assembler->filling_frame;
+
+    if (frame->number_of_lines >= frame->maximum_number_of_lines) {
+        frame->overflow_occurs = true;
+        return false;
+    }
+
+    frame->line_start_point_index[frame->number_of_lines] = frame->points.number_of_points;
+    frame->line_start_time[frame->number_of_lines] = line_start_time;
+    ++frame->number_of_lines;
+
+    return true;
+}
+
+bool append_point_to_lidar_frame_assembler(lidar_frame_assembler_t *assembler,
+                                           double horizontal_angle, double elevation_angle,
+                                           unsigned int distance, unsigned int intensity,
+                                           unsigned int laser_id, unsigned int echo_index,
+                                           unsigned int number_of_echoes_at_same_time,
+                                           unsigned int measured_time)
+{
+    lidar_frame_t *frame = assembler->filling_frame;
+
+    // points of line which could not be started are not stored
+    if ((frame->number_of_lines == 0) ||
+        (frame->overflow_occurs == true)) {
+        return false;
+    }
+
+    if (append_point_to_lidar_point_block(&frame->points, horizontal_angle, elevation_angle,
+                                          distance, intensity, laser_id, echo_index,
+                                          number_of_echoes_at_same_time, measured_time) == false) {
+        frame->overflow_occurs = true;
+        return false;
+    }
+
+    return true;
+}
+
+void complete_frame_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler)
+{
+    if (assembler->filling_frame->number_of_lines == 0) {
+        return;
+    }
+
+    if (assembler->completed_frame_unread == true) {
+        ++assembler->number_of_overwritten_frames;
+    }
+
+    assembler->filling_frame->frame_number = assembler->number_of_completed_frames;
+    ++assembler->number_of_completed_frames;
+
+    // swap frames
+    lidar_frame_t *completed_frame = assembler->filling_frame;
+    assembler->filling_frame = assembler->completed_frame;
+    assembler->completed_frame = completed_frame;
+    assembler->completed_frame_unread = true;
+
+    erase_all_lines_of_lidar_frame(assembler->filling_frame);
+
+    return;
+}
+
+const lidar_frame_t *get_completed_frame_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler)
+{
+    if (assembler->completed_frame_unread == false) {
+        return NULL;
+    }
+
+    assembler->completed_frame_unread = false;
+
+    return assembler->completed_frame;
 }
 
 void output_lidar_echo_statistics_to_stream(std::ostream &stream, const char separator,
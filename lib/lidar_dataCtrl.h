@@ -48,6 +48,16 @@ struct lidar_echo_data_t {
 
     //! measured intensity (or reflectivity)
     unsigned int intensity;
+
+    //! flag of cartesian coordinates (x_component, y_component, and z_component are valid if true)
+    bool cartesian_coordinates_available;
+
+    //! x component (distance * cos(elevation_angle) * cos(horizontal_angle))
+    double x_component;
+    //! y component (distance * cos(elevation_angle) * sin(horizontal_angle))
+    double y_component;
+    //! z component (distance * sin(elevation_angle))
+    double z_component;
 };
 
 /*!
@@ -109,6 +119,9 @@ struct lidar_line_data_t {
     //! calibrated time at line end
     unsigned int calibrated_end_time;
 
+    //! host receive time of packet which completes line [usec from 1970-01-01] (kernel receive timestamp on Linux OS)
+    double receive_time_usec;
+
     //! minimum horizontal angle
     double minimum_horizontal_angle;
     //! maximum horizontal angle
@@ -152,12 +165,26 @@ extern bool release_memory_of_lidar_line_data(lidar_line_data_t *line);
 */
 extern bool copy_lidar_line_data(const lidar_line_data_t *source, lidar_line_data_t *destination);
 
+//! constants for lidar line circular buffer
+enum LIDAR_LINE_CIRCULAR_BUFFER_CONSTANT {
+
+    //! maximum length of lidar line circular buffer (power of two)
+    LIDAR_LINE_CIRCULAR_BUFFER_MAXIMUM_LENGTH = 1 << 20,
+
+};
+
 //! structure for circular buffer of line data
 struct lidar_line_circular_buffer_t {
 
-    //! buffer size
+    //! buffer size (power of two)
     unsigned int length;
 
+    //! mask of line index in buffer (length - 1)
+    unsigned int index_mask;
+
+    //! number of unused lines overwritten by new lines
+    unsigned int number_of_overwritten_unused_lines;
+
     //! remaining empty buffer
     unsigned int empty_buffer_length;
 
@@ -184,9 +211,16 @@ extern void initialize_lidar_line_circular_buffer(lidar_line_circular_buffer_t *
 */
 extern void clear_memory_of_lidar_line_circular_buffer(lidar_line_circular_buffer_t *buffer);
 
+/*!
+  \brief function to calculate length of lidar line circular buffer which stores number_of_lines
+  \return smallest power of two which is not less than number_of_lines (0 if number_of_lines is 0 or too large)
+*/
+extern unsigned int calculate_length_of_lidar_line_circular_buffer(unsigned int number_of_lines);
+
 /*!
   \brief function to allocate memory for circular line buffer
   \attention this function does not check whether buffer is initialized
+  \attention buffer_length is rounded up to power of two (see calculate_length_of_lidar_line_circular_buffer())
 */
 extern bool allocate_memory_for_lidar_line_circular_buffer(lidar_line_circular_buffer_t *buffer,
                                                            unsigned int number_of_spots, unsigned int buffer_length);
@@ -217,6 +251,12 @@ extern unsigned int get_length_of_empty_lidar_line(const lidar_line_circular_buf
 */
 extern unsigned int calculate_number_of_remaining_lidar_lines(const lidar_line_circular_buffer_t *buffer);
 
+/*!
+  \brief function to get number of unused lines overwritten by new lines
+  \attention lines are overwritten on LIDAR_LINE_CIRCULAR_BUFFER_OVERWRITE modes if buffer is full, and counter is reset on clear_memory_of_lidar_line_circular_buffer()
+*/
+extern unsigned int get_number_of_overwritten_unused_lidar_lines(const lidar_line_circular_buffer_t *buffer);
+
 /*!
   \brief function to move used data end out pointer
   \attention this function does not work if used_data_end_out_point is not in buffer or move_amount size is larget than buffer_length
@@ -227,6 +267,7 @@ extern void move_used_data_end_out_point(lidar_line_circular_buffer_t *buffer,
 /*!
   \brief function to move copy-destination pointer
   \attention this function does not work if destination_point is not in buffer or move_amount size is larget than buffer_length
+  \attention lines are counted as written on this function, and oldest unused lines are overwritten if buffer is full
 */
 extern void move_copy_destination_point(lidar_line_circular_buffer_t *buffer,
                                         unsigned int move_amount);
@@ -418,6 +459,65 @@ extern unsigned int add_lidar_echo_data_in_each_single_region(const std::vector<
                                                               const std::vector<lidar_echo_single_region_t> &regions,
                                                               std::vector< std::vector<lidar_echo_data_t> > &echoes_in_region);
 
+//! constants of compiled region set
+enum LIDAR_ECHO_REGION_SET_CONSTANT {
+
+    //! default number of azimuth buckets (1 degree)
+    LIDAR_ECHO_REGION_SET_DEFAULT_NUMBER_OF_AZIMUTH_BUCKETS = 360,
+
+};
+
+//! structure of regions compiled into index keyed by (azimuth bucket, laser id)
+struct lidar_echo_region_set_t {
+
+    //! regions
+    std::vector<lidar_echo_single_region_t> regions;
+
+    //! number of azimuth buckets in one rotation
+    unsigned int number_of_azimuth_buckets;
+
+    //! inverse of azimuth bucket width [1/rad]
+    double azimuth_bucket_width_inverse;
+
+    //! number of lasers (spots in line)
+    unsigned int number_of_lasers;
+
+    //! start of candidate list of each (azimuth bucket, laser id) in candidate_region_index (bucket * number_of_lasers + laser id)
+    std::vector<unsigned int> candidate_list_start;
+
+    //! indices of candidate regions of all buckets
+    std::vector<unsigned int> candidate_region_index;
+
+};
+
+/*!
+  \brief function to compile regions into region set
+  \attention laser_elevation_angle_array is elevation angle of each spot index in line
+  \attention regions which can contain echoes of each (azimuth bucket, laser id) are listed in advance
+*/
+extern bool compile_lidar_echo_region_set(const std::vector<lidar_echo_single_region_t> &regions,
+                                          const std::vector<double> &laser_elevation_angle_array,
+                                          unsigned int number_of_azimuth_buckets,
+                                          lidar_echo_region_set_t *region_set);
+
+/*!
+  \brief function to add lidar echo data of each region in region set
+  \attention this funtion returns total size of echoes which are added
+  \attention this function does not add echoes if size of echoes_in_region and regions are not equal.
+  \attention result is same as add_lidar_echo_data_in_each_single_region, and each echo is tested only with candidate regions
+  \attention echoes of spots whose index is not less than number_of_lasers are tested with all regions
+*/
+extern unsigned int add_lidar_echo_data_in_each_region_of_region_set(const lidar_line_data_t *line,
+                                                                     const lidar_echo_region_set_t *region_set,
+                                                                     std::vector< std::vector<lidar_echo_data_t> > &echoes_in_region);
+
+/*!
+  \brief function to add lidar echo data of each region in region set
+*/
+extern unsigned int add_lidar_echo_data_in_each_region_of_region_set(const std::vector< const lidar_line_data_t *> &line_array,
+                                                                     const lidar_echo_region_set_t *region_set,
+                                                                     std::vector< std::vector<lidar_echo_data_t> > &echoes_in_region);
+
 /*!
   \brief function to calculate average and covariance of echoes
 */
@@ -468,6 +568,8 @@ struct lidar_echo_statistics_t {
 
 /*!
   \brief function to calculate statistics of lidar echoes
+  \attention statistics are accumulated in two passes over echoes without intermediate value arrays (Welford's online algorithm)
+  \attention memory of histograms in statistics is reused, and no memory is allocated if statistics is reused for similar echoes
 */
 extern void calculate_statistics_of_lidar_echoes(const std::vector<lidar_echo_data_t> &echoes,
                                                  double one_step_angle_value,
@@ -494,6 +596,322 @@ extern void output_lidar_echo_histogram_to_stream(std::ostream &stream, const ch
 extern void copy_lidar_echo_statistics(const lidar_echo_statistics_t *statistics,
                                        bool angle_unit_degree, std::vector<double> &value_array);
 
+//! structure for single pass statistics of lidar echoes (no intermediate value arrays)
+struct lidar_echo_streaming_statistics_t {
+
+    //! echo index
+    streaming_statistics_t echo_index;
+
+    //! number of echoes
+    streaming_statistics_t number_of_echoes;
+
+    //! horizontal angle center
+    double horizontal_angle_calculation_center;
+
+    //! horizontal angle
+    streaming_statistics_t horizontal_angle;
+
+    //! elevation angle center
+    double elevation_angle_calculation_center;
+
+    //! elevation angle
+    streaming_statistics_t elevation_angle;
+
+    //! distance
+    streaming_statistics_t distance;
+
+    //! intensity
+    streaming_statistics_t intensity;
+
+    //! x_component
+    streaming_statistics_t x_component;
+    //! y_component
+    streaming_statistics_t y_component;
+    //! z_component
+    streaming_statistics_t z_component;
+
+};
+
+/*!
+  \brief function to clear streaming statistics of lidar echoes
+  \attention angles are wrapped around horizontal_center and elevation_center as calculate_statistics_of_lidar_echoes
+*/
+extern void clear_lidar_echo_streaming_statistics(lidar_echo_streaming_statistics_t *statistics,
+                                                  double horizontal_center, double elevation_center);
+
+/*!
+  \brief function to add lidar echo to streaming statistics
+*/
+extern void add_lidar_echo_to_streaming_statistics(lidar_echo_streaming_statistics_t *statistics,
+                                                   const lidar_echo_data_t *echo);
+
+/*!
+  \brief function to add lidar echoes in a single region of line to streaming statistics
+  \attention this function returns number of added echoes
+*/
+extern unsigned int add_lidar_echo_data_in_a_single_region_to_streaming_statistics(const lidar_line_data_t *line,
+                                                                                   const lidar_echo_single_region_t *region,
+                                                                                   lidar_echo_streaming_statistics_t *statistics);
+
+/*!
+  \brief function to merge source statistics into destination statistics
+  \attention this function returns false if calculation centers of two statistics are not equal
+*/
+extern bool merge_lidar_echo_streaming_statistics(lidar_echo_streaming_statistics_t *destination,
+                                                  const lidar_echo_streaming_statistics_t *source);
+
+/*!
+  \brief function to copy streaming statistics to average, variance, minimum and maximum of statistics
+  \attention histograms of statistics are not changed
+*/
+extern void copy_lidar_echo_streaming_statistics(const lidar_echo_streaming_statistics_t *streaming_statistics,
+                                                 lidar_echo_statistics_t *statistics);
+
+//! structure of points in structure-of-arrays layout (one array for each field)
+struct lidar_point_block_t {
+
+    //! maximum number of points
+    unsigned int capacity;
+
+    //! number of stored points
+    unsigned int number_of_points;
+
+    //! number of points which could not be appended because block is full (cleared with points)
+    unsigned int number_of_dropped_points;
+
+    //! horizontal angle of each point [rad]
+    float *horizontal_angle;
+
+    //! elevation angle of each point [rad]
+    float *elevation_angle;
+
+    //! distance of each point
+    float *distance;
+
+    //! intensity of each point
+    unsigned short *intensity;
+
+    //! laser id (spot index in line) of each point
+    unsigned short *laser_id;
+
+    //! echo index of each point
+    unsigned char *echo_index;
+
+    //! number of echoes at same time of each point
+    unsigned char *number_of_echoes_at_same_time;
+
+    //! measured time of each point
+    unsigned int *measured_time;
+
+};
+
+/*!
+  \brief function to clear point block
+  \attention this function set pointers null without checking whether memories are allocated
+*/
+extern void clear_lidar_point_block(lidar_point_block_t *block);
+
+/*!
+  \brief function to allocate memory for point block
+  \attention block should be cleared before it is set on this function
+*/
+extern bool allocate_memory_for_lidar_point_block(lidar_point_block_t *block, unsigned int capacity);
+
+/*!
+  \brief function to release memory of point block
+*/
+extern bool release_memory_of_lidar_point_block(lidar_point_block_t *block);
+
+/*!
+  \brief function to evaluate whether point block is allocated
+*/
+extern bool is_allocated_memory_of_lidar_point_block(const lidar_point_block_t *block);
+
+/*!
+  \brief function to erase all points in point block (memory is kept)
+  \attention number_of_dropped_points is also cleared
+*/
+extern void erase_all_points_of_lidar_point_block(lidar_point_block_t *block);
+
+/*!
+  \brief function to append one point to point block
+  \attention this function returns false if point block is full, and the point is counted in number_of_dropped_points
+*/
+extern bool append_point_to_lidar_point_block(lidar_point_block_t *block,
+                                              double horizontal_angle, double elevation_angle,
+                                              unsigned int distance, unsigned int intensity,
+                                              unsigned int laser_id, unsigned int echo_index,
+                                              unsigned int number_of_echoes_at_same_time,
+                                              unsigned int measured_time);
+
+/*!
+  \brief function to append echoes of line data to point block
+  \return number of appended points
+  \attention echoes are not appended when point block is full, and they are counted in number_of_dropped_points
+*/
+extern unsigned int append_lidar_line_data_to_point_block(const lidar_line_data_t *line,
+                                                          lidar_point_block_t *block);
+
+/*!
+  \brief function to copy one point of point block to echo data
+*/
+extern void copy_lidar_point_to_echo_data(const lidar_point_block_t *block, unsigned int point_index,
+                                          lidar_echo_data_t *echo);
+
+/*!
+  \brief function to select points in a single region
+  \return number of selected points
+  \attention indices of selected points are stored in selected_point_index_array (its length should be block->number_of_points or more)
+  \attention region conditions are evaluated without branches on each array, so that compiler can vectorize loop
+*/
+extern unsigned int select_lidar_points_in_a_single_region(const lidar_point_block_t *block,
+                                                           const lidar_echo_single_region_t *region,
+                                                           unsigned int *selected_point_index_array);
+
+/*!
+  \brief function to add points of point block in a single region to echo array
+*/
+extern unsigned int add_lidar_point_block_data_in_a_single_region(const lidar_point_block_t *block,
+                                                                  const lidar_echo_single_region_t *region,
+                                                                  std::vector<lidar_echo_data_t> &echoes_in_region);
+
+/*!
+  \brief function to calculate statistics of points in point block
+  \attention statistics are accumulated in two passes over point arrays without intermediate value arrays as calculate_statistics_of_lidar_echoes
+  \attention cartesian components are calculated from angles and distance, and cosine and sine are reused for same angles of lasers and echoes
+*/
+extern void calculate_statistics_of_lidar_point_block(const lidar_point_block_t *block,
+                                                      double one_step_angle_value,
+                                                      double one_step_distance_value, double one_step_intensity_value,
+                                                      int small_bin_threshold,
+                                                      double horizontal_center, double elevation_center,
+                                                      lidar_echo_statistics_t &statistics);
+
+//! structure of points measured in one revolution (frame)
+struct lidar_frame_t {
+
+    //! points of frame
+    lidar_point_block_t points;
+
+    //! maximum number of lines
+    unsigned int maximum_number_of_lines;
+
+    //! number of lines
+    unsigned int number_of_lines;
+
+    //! index of first point of each line in points
+    unsigned int *line_start_point_index;
+
+    //! measured time of each line start
+    unsigned int *line_start_time;
+
+    //! serial number of frame
+    unsigned int frame_number;
+
+    //! flag of overflow (lines or points which could not be stored exist)
+    bool overflow_occurs;
+
+};
+
+/*!
+  \brief function to clear frame
+  \attention this function set pointers null without checking whether memories are allocated
+*/
+extern void clear_lidar_frame(lidar_frame_t *frame);
+
+/*!
+  \brief function to allocate memory for frame
+*/
+extern bool allocate_memory_for_lidar_frame(lidar_frame_t *frame,
+                                            unsigned int maximum_number_of_lines, unsigned int maximum_number_of_points);
+
+/*!
+  \brief function to release memory of frame
+*/
+extern bool release_memory_of_lidar_frame(lidar_frame_t *frame);
+
+/*!
+  \brief function to erase all lines of frame (memory is kept)
+*/
+extern void erase_all_lines_of_lidar_frame(lidar_frame_t *frame);
+
+//! structure to assemble frames with double buffer
+struct lidar_frame_assembler_t {
+
+    //! frame buffers
+    lidar_frame_t frame_buffer[2];
+
+    //! frame being filled
+    lidar_frame_t *filling_frame;
+
+    //! last completed frame
+    lidar_frame_t *completed_frame;
+
+    //! flag of completed frame which is not got by consumer
+    bool completed_frame_unread;
+
+    //! number of completed frames
+    unsigned int number_of_completed_frames;
+
+    //! number of completed frames which are overwritten before consumer gets them
+    unsigned int number_of_overwritten_frames;
+
+};
+
+/*!
+  \brief function to initialize frame assembler
+  \attention this function should be used before allocation
+*/
+extern void initialize_lidar_frame_assembler(lidar_frame_assembler_t *assembler);
+
+/*!
+  \brief function to allocate memory for frame assembler
+*/
+extern bool allocate_memory_for_lidar_frame_assembler(lidar_frame_assembler_t *assembler,
+                                                      unsigned int maximum_number_of_lines,
+                                                      unsigned int maximum_number_of_points);
+
+/*!
+  \brief function to release memory of frame assembler
+*/
+extern bool release_memory_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler);
+
+/*!
+  \brief function to evaluate whether frame assembler is allocated
+*/
+extern bool is_allocated_memory_of_lidar_frame_assembler(const lidar_frame_assembler_t *assembler);
+
+/*!
+  \brief function to start new line in filling frame
+  \attention this function returns false if filling frame has no space for line
+*/
+extern bool start_line_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler, unsigned int line_start_time);
+
+/*!
+  \brief function to append one point to current line of filling frame
+  \attention this function returns false if point is not stored
+*/
+extern bool append_point_to_lidar_frame_assembler(lidar_frame_assembler_t *assembler,
+                                                  double horizontal_angle, double elevation_angle,
+                                                  unsigned int distance, unsigned int intensity,
+                                                  unsigned int laser_id, unsigned int echo_index,
+                                                  unsigned int number_of_echoes_at_same_time,
+                                                  unsigned int measured_time);
+
+/*!
+  \brief function to complete filling frame
+  \attention filling frame and completed frame are swapped (frame data are not copied)
+  \attention frame without lines is not completed
+*/
+extern void complete_frame_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler);
+
+/*!
+  \brief function to get completed frame which is not got yet
+  \return pointer to completed frame (NULL if no new frame is completed)
+  \attention returned frame is valid until next frame is completed
+*/
+extern const lidar_frame_t *get_completed_frame_of_lidar_frame_assembler(lidar_frame_assembler_t *assembler);
+
 //! tags of log file of LiDAR echo data
 enum LIDAR_ECHO_DATA_LOG_TAG {
 
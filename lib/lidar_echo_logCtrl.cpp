@@ -0,0 +1,460 @@
+
+#include "lidar_echo_logCtrl.h"
+
+// for malloc/free
+#include <stdlib.h>
+
+// for memcmp/memcpy/memset
+#include <string.h>
+
+// for floor
+#include <math.h>
+
+//! magic string of lidar echo log
+static const char LIDAR_ECHO_LOG_MAGIC[8] = {'L', 'I', 'D', 'A', 'R', 'L', 'O', 'G'};
+
+//! field positions in lidar echo log
+enum LIDAR_ECHO_LOG_FIELD_POSITION {
+
+    //! version in header
+    LIDAR_ECHO_LOG_VERSION_POSITION = 8,
+
+    //! record length in header
+    LIDAR_ECHO_LOG_RECORD_LENGTH_POSITION = 12,
+
+    //! distance scale in header
+    LIDAR_ECHO_LOG_DISTANCE_SCALE_POSITION = 16,
+
+    //! angle units per revolution in header
+    LIDAR_ECHO_LOG_ANGLE_UNITS_PER_REVOLUTION_POSITION = 20,
+
+    //! measured time in record (32 bit)
+    LIDAR_ECHO_LOG_MEASURED_TIME_POSITION = 0,
+
+    //! calibrated time in record (32 bit)
+    LIDAR_ECHO_LOG_CALIBRATED_TIME_POSITION = 4,
+
+    //! horizontal angle in record (unsigned 16 bit)
+    LIDAR_ECHO_LOG_HORIZONTAL_ANGLE_POSITION = 8,
+
+    //! elevation angle in record (signed 16 bit)
+    LIDAR_ECHO_LOG_ELEVATION_ANGLE_POSITION = 10,
+
+    //! raw distance in record (unsigned 16 bit)
+    LIDAR_ECHO_LOG_DISTANCE_POSITION = 12,
+
+    //! intensity in record (8 bit)
+    LIDAR_ECHO_LOG_INTENSITY_POSITION = 14,
+
+    //! echo index (lower 4 bit) and number of echoes (upper 4 bit) in record
+    LIDAR_ECHO_LOG_ECHO_INDEX_POSITION = 15,
+
+};
+
+static void put_little_endian_16bit_value(unsigned char *buffer, unsigned int value)
+{
+    buffer[0] = (unsigned char)(value & 0xff);
+    buffer[1] = (unsigned char)((value >> 8) & 0xff);
+
+    return;
+}
+
+static void put_little_endian_32bit_value(unsigned char *buffer, unsigned int value)
+{
+    buffer[0] = (unsigned char)(value & 0xff);
+    buffer[1] = (unsigned char)((value >> 8) & 0xff);
+    buffer[2] = (unsigned char)((value >> 16) & 0xff);
+    buffer[3] = (unsigned char)((value >> 24) & 0xff);
+
+    return;
+}
+
+static unsigned int get_little_endian_16bit_value(const unsigned char *buffer)
+{
+    return (unsigned int)buffer[0] | ((unsigned int)buffer[1] << 8);
+}
+
+static unsigned int get_little_endian_32bit_value(const unsigned char *buffer)
+{
+    return (unsigned int)buffer[0] | ((unsigned int)buffer[1] << 8) |
+        ((unsigned int)buffer[2] << 16) | ((unsigned int)buffer[3] << 24);
+}
+
+void clear_lidar_echo_log_writer(lidar_echo_log_writer_t *writer)
+{
+    writer->file = NULL;
+
+    writer->buffer = NULL;
+    writer->buffer_length = 0;
+    writer->buffered_length = 0;
+
+    writer->distance_scale = 1.0;
+    writer->distance_scale_inverse = 1.0;
+
+    writer->angle_units_per_revolution = LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION;
+    writer->angle_unit_coefficient = 0.0;
+
+    writer->number_of_records = 0;
+    writer->number_of_saturated_distances = 0;
+    writer->write_error_occurs = false;
+
+    return;
+}
+
+bool open_lidar_echo_log_writer(const char *file_path, double distance_scale,
+                                unsigned int angle_units_per_revolution, unsigned int buffer_length,
+                                lidar_echo_log_writer_t *writer)
+{
+    if (writer->file != NULL) {
+        return false;
+    }
+
+    // horizontal angle is stored in 16 bit
+    if ((distance_scale <= 0.0) ||
+        (angle_units_per_revolution == 0) || (angle_units_per_revolution > 0x10000)) {
+        return false;
+    }
+
+    // buffer keeps at least one record
+    if (buffer_length < LIDAR_ECHO_LOG_RECORD_LENGTH) {
+        buffer_length = LIDAR_ECHO_LOG_RECORD_LENGTH;
+    }
+
+    clear_lidar_echo_log_writer(writer);
+
+    writer->buffer = (unsigned char *)malloc(buffer_length);
+    if (writer->buffer == NULL) {
+        return false;
+    }
+    writer->buffer_length = buffer_length - (buffer_length % LIDAR_ECHO_LOG_RECORD_LENGTH);
+
+    writer->file = fopen(file_path, "wb");
+    if (writer->file == NULL) {
+        free((void *)writer->buffer);
+        clear_lidar_echo_log_writer(writer);
+        return false;
+    }
+
+    // records are buffered by writer, and stdio buffer is not used
+    setvbuf(writer->file, NULL, _IONBF, 0);
+
+    writer->distance_scale = distance_scale;
+    writer->distance_scale_inverse = 1.0 / distance_scale;
+
+    writer->angle_units_per_revolution = angle_units_per_revolution;
+    writer->angle_unit_coefficient = (double)angle_units_per_revolution / (2.0 * M_PI);
+
+    unsigned char header[LIDAR_ECHO_LOG_HEADER_LENGTH];
+    memset((void *)header, 0, LIDAR_ECHO_LOG_HEADER_LENGTH);
+    memcpy((void *)header, (const void *)LIDAR_ECHO_LOG_MAGIC, sizeof(LIDAR_ECHO_LOG_MAGIC));
+
+    put_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_VERSION_POSITION], LIDAR_ECHO_LOG_VERSION);
+    put_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_RECORD_LENGTH_POSITION], LIDAR_ECHO_LOG_RECORD_LENGTH);
+    put_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_DISTANCE_SCALE_POSITION],
+                                  (unsigned int)(distance_scale * LIDAR_ECHO_LOG_DISTANCE_SCALE_DENOMINATOR + 0.5));
+    put_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_ANGLE_UNITS_PER_REVOLUTION_POSITION],
+                                  angle_units_per_revolution);
+
+    if (fwrite((const void *)header, 1, LIDAR_ECHO_LOG_HEADER_LENGTH, writer->file) != LIDAR_ECHO_LOG_HEADER_LENGTH) {
+        fclose(writer->file);
+        free((void *)writer->buffer);
+        clear_lidar_echo_log_writer(writer);
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+  \brief function to encode lidar echo to record
+  \return true if distance is saturated
+*/
+static bool encode_lidar_echo_to_log_record(const lidar_echo_log_writer_t *writer,
+                                            const lidar_echo_data_t *echo, unsigned char *record)
+{
+    put_little_endian_32bit_value(&record[LIDAR_ECHO_LOG_MEASURED_TIME_POSITION], echo->measured_time);
+    put_little_endian_32bit_value(&record[LIDAR_ECHO_LOG_CALIBRATED_TIME_POSITION], echo->calibrated_time);
+
+    // horizontal angle is wrapped in one revolution
+    const int units_per_revolution = (int)writer->angle_units_per_revolution;
+
+    int horizontal_angle = (int)floor(echo->horizontal_angle * writer->angle_unit_coefficient + 0.5);
+    horizontal_angle %= units_per_revolution;
+    if (horizontal_angle < 0) {
+        horizontal_angle += units_per_revolution;
+    }
+    put_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_HORIZONTAL_ANGLE_POSITION], (unsigned int)horizontal_angle);
+
+    int elevation_angle = (int)floor(echo->elevation_angle * writer->angle_unit_coefficient + 0.5);
+    if (elevation_angle < -0x8000) {
+        elevation_angle = -0x8000;
+    } else if (elevation_angle > 0x7fff) {
+        elevation_angle = 0x7fff;
+    }
+    put_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_ELEVATION_ANGLE_POSITION], (unsigned int)elevation_angle & 0xffff);
+
+    unsigned int raw_distance = (unsigned int)(echo->distance * writer->distance_scale_inverse + 0.5);
+    const bool distance_saturated = (raw_distance > LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE);
+    if (distance_saturated == true) {
+        raw_distance = LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE;
+    }
+    put_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_DISTANCE_POSITION], raw_distance);
+
+    unsigned int intensity = echo->intensity;
+    if (intensity > LIDAR_ECHO_LOG_MAXIMUM_INTENSITY) {
+        intensity = LIDAR_ECHO_LOG_MAXIMUM_INTENSITY;
+    }
+    record[LIDAR_ECHO_LOG_INTENSITY_POSITION] = (unsigned char)intensity;
+
+    unsigned int echo_index = echo->index;
+    if (echo_index > LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX) {
+        echo_index = LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX;
+    }
+    unsigned int number_of_echoes = echo->number_of_echoes_at_same_time;
+    if (number_of_echoes > LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX) {
+        number_of_echoes = LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX;
+    }
+    record[LIDAR_ECHO_LOG_ECHO_INDEX_POSITION] = (unsigned char)(echo_index | (number_of_echoes << 4));
+
+    return distance_saturated;
+}
+
+bool flush_lidar_echo_log_writer(lidar_echo_log_writer_t *writer)
+{
+    if (writer->file == NULL) {
+        return false;
+    }
+
+    if (writer->buffered_length == 0) {
+        return true;
+    }
+
+    if (fwrite((const void *)writer->buffer, 1, writer->buffered_length, writer->file) != writer->buffered_length) {
+        writer->write_error_occurs = true;
+    }
+    writer->buffered_length = 0;
+
+    return (writer->write_error_occurs == false);
+}
+
+bool write_lidar_echo_to_log(lidar_echo_log_writer_t *writer, const lidar_echo_data_t *echo)
+{
+    if (writer->file == NULL) {
+        return false;
+    }
+
+    if (writer->buffered_length + LIDAR_ECHO_LOG_RECORD_LENGTH > writer->buffer_length) {
+        if (flush_lidar_echo_log_writer(writer) == false) {
+            return false;
+        }
+    }
+
+    if (encode_lidar_echo_to_log_record(writer, echo, writer->buffer + writer->buffered_length) == true) {
+        ++writer->number_of_saturated_distances;
+    }
+
+    writer->buffered_length += LIDAR_ECHO_LOG_RECORD_LENGTH;
+    ++writer->number_of_records;
+
+    return true;
+}
+
+bool write_lidar_echo_array_to_log(lidar_echo_log_writer_t *writer,
+                                   const std::vector<lidar_echo_data_t> &echo_array)
+{
+    for (unsigned int i = 0; i < echo_array.size(); ++i) {
+
+        if (write_lidar_echo_to_log(writer, &echo_array[i]) == false) {
+            return false;
+        }
+
+    }
+
+    return true;
+}
+
+bool close_lidar_echo_log_writer(lidar_echo_log_writer_t *writer)
+{
+    if (writer->file == NULL) {
+        return false;
+    }
+
+    flush_lidar_echo_log_writer(writer);
+
+    const bool return_bool = (writer->write_error_occurs == false);
+
+    fclose(writer->file);
+    free((void *)writer->buffer);
+
+    clear_lidar_echo_log_writer(writer);
+
+    return return_bool;
+}
+
+void clear_lidar_echo_log_reader(lidar_echo_log_reader_t *reader)
+{
+    reader->file = NULL;
+
+    reader->buffer = NULL;
+    reader->buffer_length = 0;
+    reader->buffered_length = 0;
+    reader->read_position = 0;
+
+    reader->distance_scale = 1.0;
+
+    reader->angle_units_per_revolution = LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION;
+    reader->angle_coefficient = 0.0;
+
+    reader->number_of_records = 0;
+
+    return;
+}
+
+bool open_lidar_echo_log_reader(const char *file_path, unsigned int buffer_length,
+                                lidar_echo_log_reader_t *reader)
+{
+    if (reader->file != NULL) {
+        return false;
+    }
+
+    if (buffer_length < LIDAR_ECHO_LOG_RECORD_LENGTH) {
+        buffer_length = LIDAR_ECHO_LOG_RECORD_LENGTH;
+    }
+
+    clear_lidar_echo_log_reader(reader);
+
+    reader->file = fopen(file_path, "rb");
+    if (reader->file == NULL) {
+        return false;
+    }
+    setvbuf(reader->file, NULL, _IONBF, 0);
+
+    unsigned char header[LIDAR_ECHO_LOG_HEADER_LENGTH];
+
+    if ((fread((void *)header, 1, LIDAR_ECHO_LOG_HEADER_LENGTH, reader->file) != LIDAR_ECHO_LOG_HEADER_LENGTH) ||
+        (memcmp((const void *)header, (const void *)LIDAR_ECHO_LOG_MAGIC, sizeof(LIDAR_ECHO_LOG_MAGIC)) != 0) ||
+        (get_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_VERSION_POSITION]) != LIDAR_ECHO_LOG_VERSION) ||
+        (get_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_RECORD_LENGTH_POSITION]) != LIDAR_ECHO_LOG_RECORD_LENGTH)) {
+        fclose(reader->file);
+        clear_lidar_echo_log_reader(reader);
+        return false;
+    }
+
+    reader->distance_scale =
+        (double)get_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_DISTANCE_SCALE_POSITION]) /
+        (double)LIDAR_ECHO_LOG_DISTANCE_SCALE_DENOMINATOR;
+
+    reader->angle_units_per_revolution =
+        get_little_endian_32bit_value(&header[LIDAR_ECHO_LOG_ANGLE_UNITS_PER_REVOLUTION_POSITION]);
+
+    if (reader->angle_units_per_revolution == 0) {
+        fclose(reader->file);
+        clear_lidar_echo_log_reader(reader);
+        return false;
+    }
+    reader->angle_coefficient = (2.0 * M_PI) / (double)reader->angle_units_per_revolution;
+
+    reader->buffer = (unsigned char *)malloc(buffer_length);
+    if (reader->buffer == NULL) {
+        fclose(reader->file);
+        clear_lidar_echo_log_reader(reader);
+        return false;
+    }
+    reader->buffer_length = buffer_length - (buffer_length % LIDAR_ECHO_LOG_RECORD_LENGTH);
+
+    return true;
+}
+
+static void decode_lidar_echo_of_log_record(const lidar_echo_log_reader_t *reader,
+                                            const unsigned char *record, lidar_echo_data_t *echo)
+{
+    echo->measured_time = get_little_endian_32bit_value(&record[LIDAR_ECHO_LOG_MEASURED_TIME_POSITION]);
+    echo->calibrated_time = get_little_endian_32bit_value(&record[LIDAR_ECHO_LOG_CALIBRATED_TIME_POSITION]);
+
+    echo->horizontal_angle =
+        (double)get_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_HORIZONTAL_ANGLE_POSITION]) *
+        reader->angle_coefficient;
+
+    // sign of 16 bit value is extended
+    int elevation_angle = (int)get_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_ELEVATION_ANGLE_POSITION]);
+    if (elevation_angle >= 0x8000) {
+        elevation_angle -= 0x10000;
+    }
+    echo->elevation_angle = (double)elevation_angle * reader->angle_coefficient;
+
+    echo->distance =
+        (unsigned int)((double)get_little_endian_16bit_value(&record[LIDAR_ECHO_LOG_DISTANCE_POSITION]) *
+                       reader->distance_scale + 0.5);
+
+    echo->intensity = record[LIDAR_ECHO_LOG_INTENSITY_POSITION];
+
+    echo->index = record[LIDAR_ECHO_LOG_ECHO_INDEX_POSITION] & LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX;
+    echo->number_of_echoes_at_same_time = record[LIDAR_ECHO_LOG_ECHO_INDEX_POSITION] >> 4;
+
+    echo->cartesian_coordinates_available = false;
+    echo->x_component = 0.0;
+    echo->y_component = 0.0;
+    echo->z_component = 0.0;
+
+    return;
+}
+
+bool read_lidar_echo_from_log(lidar_echo_log_reader_t *reader, lidar_echo_data_t *echo)
+{
+    if (reader->file == NULL) {
+        return false;
+    }
+
+    if (reader->read_position + LIDAR_ECHO_LOG_RECORD_LENGTH > reader->buffered_length) {
+
+        // broken record at end of file is discarded
+        reader->buffered_length =
+            (unsigned int)fread((void *)reader->buffer, 1, reader->buffer_length, reader->file);
+        reader->read_position = 0;
+
+        if (reader->buffered_length < LIDAR_ECHO_LOG_RECORD_LENGTH) {
+            return false;
+        }
+    }
+
+    decode_lidar_echo_of_log_record(reader, reader->buffer + reader->read_position, echo);
+
+    reader->read_position += LIDAR_ECHO_LOG_RECORD_LENGTH;
+    ++reader->number_of_records;
+
+    return true;
+}
+
+void close_lidar_echo_log_reader(lidar_echo_log_reader_t *reader)
+{
+    if (reader->file != NULL) {
+        fclose(reader->file);
+    }
+
+    if (reader->buffer != NULL) {
+        free((void *)reader->buffer);
+    }
+
+    clear_lidar_echo_log_reader(reader);
+
+    return;
+}
+
+unsigned int convert_lidar_echo_log_to_stream(lidar_echo_log_reader_t *reader,
+                                              std::ostream &stream, const char separator, const char line_separator,
+                                              bool angle_unit_degree)
+{
+    unsigned int number_of_converted_echoes = 0;
+
+    lidar_echo_data_t echo;
+
+    while (read_lidar_echo_from_log(reader, &echo) == true) {
+
+        output_lidar_echo_data_to_stream(stream, separator, angle_unit_degree, &echo);
+        stream << line_separator;
+
+        ++number_of_converted_echoes;
+    }
+
+    return number_of_converted_echoes;
+}
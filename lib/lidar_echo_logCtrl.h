@@ -0,0 +1,187 @@
+#ifndef LIDAR_ECHO_LOG_CONTROL_H
+#define LIDAR_ECHO_LOG_CONTROL_H
+/*!
+  \file
+  \brief functions to write and read lidar echoes in compact binary log
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "lidar_dataCtrl.h"
+
+// for FILE
+#include <stdio.h>
+
+//! constants for lidar echo log
+enum LIDAR_ECHO_LOG_CONSTANT {
+
+    //! length of file header [byte]
+    LIDAR_ECHO_LOG_HEADER_LENGTH = 32,
+
+    //! length of one record [byte]
+    LIDAR_ECHO_LOG_RECORD_LENGTH = 16,
+
+    //! version of log
+    LIDAR_ECHO_LOG_VERSION = 1,
+
+    //! default length of write and read buffer [byte]
+    LIDAR_ECHO_LOG_DEFAULT_BUFFER_LENGTH = 1024 * 1024,
+
+    //! default number of angle units in one revolution (0.01 degree, resolution of sensor azimuth)
+    LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION = 36000,
+
+    //! scale of distance scale in header (distance scale is stored in 1/1000000 unit)
+    LIDAR_ECHO_LOG_DISTANCE_SCALE_DENOMINATOR = 1000000,
+
+    //! maximum raw distance
+    LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE = 0xffff,
+
+    //! maximum intensity
+    LIDAR_ECHO_LOG_MAXIMUM_INTENSITY = 0xff,
+
+    //! maximum echo index and number of echoes (4 bit for each)
+    LIDAR_ECHO_LOG_MAXIMUM_ECHO_INDEX = 0x0f,
+
+};
+
+//! structure of writer of lidar echo log
+struct lidar_echo_log_writer_t {
+
+    //! file
+    FILE *file;
+
+    //! write buffer
+    unsigned char *buffer;
+
+    //! length of write buffer [byte]
+    unsigned int buffer_length;
+
+    //! length of data in write buffer [byte]
+    unsigned int buffered_length;
+
+    //! distance scale (distance = raw distance * distance_scale)
+    double distance_scale;
+
+    //! inverse of distance scale
+    double distance_scale_inverse;
+
+    //! number of angle units in one revolution
+    unsigned int angle_units_per_revolution;
+
+    //! coefficient to convert angle [rad] to angle unit
+    double angle_unit_coefficient;
+
+    //! number of written records
+    unsigned int number_of_records;
+
+    //! number of written records whose distance is saturated to LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE
+    unsigned int number_of_saturated_distances;
+
+    //! flag of write error
+    bool write_error_occurs;
+
+};
+
+//! structure of reader of lidar echo log
+struct lidar_echo_log_reader_t {
+
+    //! file
+    FILE *file;
+
+    //! read buffer
+    unsigned char *buffer;
+
+    //! length of read buffer [byte]
+    unsigned int buffer_length;
+
+    //! length of data in read buffer [byte]
+    unsigned int buffered_length;
+
+    //! read position in read buffer [byte]
+    unsigned int read_position;
+
+    //! distance scale (distance = raw distance * distance_scale)
+    double distance_scale;
+
+    //! number of angle units in one revolution
+    unsigned int angle_units_per_revolution;
+
+    //! coefficient to convert angle unit to angle [rad]
+    double angle_coefficient;
+
+    //! number of read records
+    unsigned int number_of_records;
+
+};
+
+/*!
+  \brief function to clear writer of lidar echo log
+*/
+extern void clear_lidar_echo_log_writer(lidar_echo_log_writer_t *writer);
+
+/*!
+  \brief function to open lidar echo log to write
+  \attention distance of echo is stored as unsigned 16 bit raw distance (distance / distance_scale)
+  \attention distance longer than LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE * distance_scale (131.07 m at 2 mm scale) is saturated, and counted in number_of_saturated_distances
+  \attention angles are stored as 16 bit value in unit of one revolution / angle_units_per_revolution
+  \attention records are written to file when buffer_length byte are buffered
+*/
+extern bool open_lidar_echo_log_writer(const char *file_path, double distance_scale,
+                                       unsigned int angle_units_per_revolution, unsigned int buffer_length,
+                                       lidar_echo_log_writer_t *writer);
+
+/*!
+  \brief function to write lidar echo to log
+*/
+extern bool write_lidar_echo_to_log(lidar_echo_log_writer_t *writer, const lidar_echo_data_t *echo);
+
+/*!
+  \brief function to write lidar echo array to log
+*/
+extern bool write_lidar_echo_array_to_log(lidar_echo_log_writer_t *writer,
+                                          const std::vector<lidar_echo_data_t> &echo_array);
+
+/*!
+  \brief function to write buffered records to file
+*/
+extern bool flush_lidar_echo_log_writer(lidar_echo_log_writer_t *writer);
+
+/*!
+  \brief function to flush and close lidar echo log
+*/
+extern bool close_lidar_echo_log_writer(lidar_echo_log_writer_t *writer);
+
+/*!
+  \brief function to clear reader of lidar echo log
+*/
+extern void clear_lidar_echo_log_reader(lidar_echo_log_reader_t *reader);
+
+/*!
+  \brief function to open lidar echo log to read
+  \attention this function returns false if header of file is invalid
+*/
+extern bool open_lidar_echo_log_reader(const char *file_path, unsigned int buffer_length,
+                                       lidar_echo_log_reader_t *reader);
+
+/*!
+  \brief function to read lidar echo from log
+  \attention this function returns false on end of file
+  \attention cartesian coordinates are not stored in log, and cartesian_coordinates_available is false
+*/
+extern bool read_lidar_echo_from_log(lidar_echo_log_reader_t *reader, lidar_echo_data_t *echo);
+
+/*!
+  \brief function to close lidar echo log
+*/
+extern void close_lidar_echo_log_reader(lidar_echo_log_reader_t *reader);
+
+/*!
+  \brief function to convert lidar echo log to text stream
+  \return number of converted echoes
+  \attention each echo is output in layout of output_lidar_echo_data_to_stream
+*/
+extern unsigned int convert_lidar_echo_log_to_stream(lidar_echo_log_reader_t *reader,
+                                                     std::ostream &stream, const char separator, const char line_separator,
+                                                     bool angle_unit_degree);
+
+#endif // LIDAR_ECHO_LOG_CONTROL_H
@@ -0,0 +1,555 @@
+
+// off_t of open/posix_fallocate/ftruncate/mmap is 64 bit also on 32 bit Linux OS
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "packet_recorderCtrl.h"
+
+#include "timeCtrl.h"
+
+// for memcpy/memmove/memset
+#include <string.h>
+// for floor
+#include <math.h>
+
+#if defined(LINUX_OS)
+// for open/posix_fallocate/sync_file_range
+#include <fcntl.h>
+// for ftruncate/close
+#include <unistd.h>
+// for mmap/munmap/msync
+#include <sys/mman.h>
+// for fstat
+#include <sys/stat.h>
+#endif
+
+//! magic string of packet record file
+static const char PACKET_RECORD_FILE_MAGIC[8] = {'P', 'K', 'T', 'R', 'E', 'C', '0', '1'};
+
+//! flag of record in which revolution starts
+static const unsigned int PACKET_RECORD_REVOLUTION_START_FLAG = 0x1;
+
+//! header of one record
+struct packet_record_header_t {
+
+    //! receive time [sec]
+    unsigned int receive_time_sec;
+
+    //! receive time [usec]
+    unsigned int receive_time_usec;
+
+    //! length of packet [byte]
+    unsigned int packet_length;
+
+    //! flags of record
+    unsigned int flags;
+
+};
+
+void initialize_packet_recorder(packet_recorder_t *recorder)
+{
+    recorder->file_descriptor = -1;
+
+    recorder->mapped_file = NULL;
+    recorder->mapped_file_length = 0;
+
+    recorder->header = NULL;
+    recorder->revolution_index = NULL;
+    recorder->time_index = NULL;
+
+    recorder->number_of_written_records = 0;
+    recorder->number_of_flushed_records = 0;
+
+    recorder->flush_thread_running = false;
+
+    return;
+}
+
+bool is_opened_packet_recorder(const packet_recorder_t *recorder)
+{
+    return (recorder->mapped_file != NULL);
+}
+
+static unsigned int calculate_record_length(unsigned int maximum_packet_length)
+{
+    const unsigned int aligned_packet_length =
+        ((maximum_packet_length + PACKET_RECORDER_RECORD_ALIGNMENT_BYTE - 1) / PACKET_RECORDER_RECORD_ALIGNMENT_BYTE) *
+        PACKET_RECORDER_RECORD_ALIGNMENT_BYTE;
+
+    return PACKET_RECORDER_RECORD_HEADER_LENGTH + aligned_packet_length;
+}
+
+/*!
+  \brief function to evaluate whether area of area_length byte at offset is in file of file_length byte
+*/
+static bool is_area_in_packet_record_file(unsigned long long offset, unsigned long long area_length,
+                                          unsigned long long file_length)
+{
+    return (offset <= file_length) && (area_length <= file_length - offset);
+}
+
+static double calculate_elapsed_time_usec(const packet_record_file_header_t *header,
+                                          unsigned int time_sec, unsigned int time_usec)
+{
+    return ((double)time_sec - (double)header->first_receive_time_sec) * 1000000.0 +
+        ((double)time_usec - (double)header->first_receive_time_usec);
+}
+
+#if defined(LINUX_OS)
+
+static void flush_written_records_of_packet_recorder(packet_recorder_t *recorder)
+{
+    const unsigned int number_of_written_records = load_shared_unsigned_int(&recorder->number_of_written_records);
+
+    if (number_of_written_records == recorder->number_of_flushed_records) {
+        return;
+    }
+
+    // records are written back asynchronously (recording thread does not wait for disk)
+    const off_t flush_start =
+        (off_t)recorder->header->record_offset +
+        (off_t)recorder->number_of_flushed_records * recorder->header->record_length;
+    const off_t flush_length =
+        (off_t)(number_of_written_records - recorder->number_of_flushed_records) * recorder->header->record_length;
+
+    sync_file_range(recorder->file_descriptor, flush_start, flush_length, SYNC_FILE_RANGE_WRITE);
+
+    recorder->header->number_of_records = number_of_written_records;
+    recorder->number_of_flushed_records = number_of_written_records;
+
+    return;
+}
+
+static void *flush_packet_recorder_on_flush_thread(void *argument)
+{
+    packet_recorder_t *recorder = (packet_recorder_t *)argument;
+
+    while (load_shared_bool(&recorder->flush_thread_running) == true) {
+
+        sleep_milisecond(PACKET_RECORDER_FLUSH_INTERVAL_MSEC);
+
+        flush_written_records_of_packet_recorder(recorder);
+    }
+
+    return NULL;
+}
+
+bool open_packet_recorder(const char *file_path,
+                          unsigned int maximum_packet_length, unsigned int maximum_number_of_records,
+                          packet_recorder_t *recorder)
+{
+    if (is_opened_packet_recorder(recorder) == true) {
+        return false;
+    }
+
+    if ((maximum_packet_length == 0) || (maximum_number_of_records == 0)) {
+        return false;
+    }
+
+    initialize_packet_recorder(recorder);
+
+    const unsigned int record_length = calculate_record_length(maximum_packet_length);
+
+    // time index has one entry for each record at most
+    const unsigned long long record_offset = PACKET_RECORDER_FILE_HEADER_LENGTH;
+    const unsigned long long revolution_index_offset =
+        record_offset + (unsigned long long)record_length * maximum_number_of_records;
+    const unsigned long long time_index_offset =
+        revolution_index_offset + sizeof(unsigned int) * (unsigned long long)maximum_number_of_records;
+    const unsigned long long file_length =
+        time_index_offset + sizeof(packet_record_time_index_entry_t) * (unsigned long long)maximum_number_of_records;
+
+    // whole file is mapped in address space
+    if (file_length > (unsigned long long)((size_t)-1)) {
+        return false;
+    }
+
+    recorder->file_descriptor = open(file_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (recorder->file_descriptor < 0) {
+        recorder->file_descriptor = -1;
+        return false;
+    }
+
+    // blocks are reserved on opening not to allocate them on recording
+    if (posix_fallocate(recorder->file_descriptor, 0, (off_t)file_length) != 0) {
+        close(recorder->file_descriptor);
+        initialize_packet_recorder(recorder);
+        return false;
+    }
+
+    void *mapped_file = mmap(NULL, (size_t)file_length, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, recorder->file_descriptor, 0);
+
+    if (mapped_file == MAP_FAILED) {
+        close(recorder->file_descriptor);
+        initialize_packet_recorder(recorder);
+        return false;
+    }
+
+    recorder->mapped_file = (char *)mapped_file;
+    recorder->mapped_file_length = (size_t)file_length;
+
+    recorder->header = (packet_record_file_header_t *)recorder->mapped_file;
+    recorder->revolution_index = (unsigned int *)(recorder->mapped_file + revolution_index_offset);
+    recorder->time_index = (packet_record_time_index_entry_t *)(recorder->mapped_file + time_index_offset);
+
+    memset((void *)recorder->header, 0, sizeof(packet_record_file_header_t));
+    memcpy((void *)recorder->header->magic, (const void *)PACKET_RECORD_FILE_MAGIC, sizeof(PACKET_RECORD_FILE_MAGIC));
+
+    recorder->header->version = PACKET_RECORDER_FILE_VERSION;
+    recorder->header->record_length = record_length;
+    recorder->header->maximum_packet_length = maximum_packet_length;
+    recorder->header->maximum_number_of_records = maximum_number_of_records;
+    recorder->header->time_index_interval_usec = PACKET_RECORDER_TIME_INDEX_INTERVAL_USEC;
+
+    recorder->header->record_offset = record_offset;
+    recorder->header->revolution_index_offset = revolution_index_offset;
+    recorder->header->time_index_offset = time_index_offset;
+
+    store_shared_bool(&recorder->flush_thread_running, true);
+
+    if (pthread_create(&recorder->flush_thread, NULL,
+                       flush_packet_recorder_on_flush_thread, (void *)recorder) != 0) {
+        store_shared_bool(&recorder->flush_thread_running, false);
+        close_packet_recorder(recorder);
+        return false;
+    }
+
+    return true;
+}
+
+void close_packet_recorder(packet_recorder_t *recorder)
+{
+    if (is_opened_packet_recorder(recorder) == false) {
+        return;
+    }
+
+    if (load_shared_bool(&recorder->flush_thread_running) == true) {
+        store_shared_bool(&recorder->flush_thread_running, false);
+        pthread_join(recorder->flush_thread, NULL);
+    }
+
+    flush_written_records_of_packet_recorder(recorder);
+
+    packet_record_file_header_t *header = recorder->header;
+
+    // indexes are moved just after written records, and unused records are truncated
+    const unsigned long long revolution_index_offset =
+        header->record_offset + (unsigned long long)header->record_length * header->number_of_records;
+    const unsigned long long time_index_offset =
+        revolution_index_offset + sizeof(unsigned int) * (unsigned long long)header->number_of_revolutions;
+    const unsigned long long file_length =
+        time_index_offset + sizeof(packet_record_time_index_entry_t) * (unsigned long long)header->number_of_time_index_entries;
+
+    memmove((void *)(recorder->mapped_file + revolution_index_offset), (const void *)recorder->revolution_index,
+            sizeof(unsigned int) * header->number_of_revolutions);
+    memmove((void *)(recorder->mapped_file + time_index_offset), (const void *)recorder->time_index,
+            sizeof(packet_record_time_index_entry_t) * header->number_of_time_index_entries);
+
+    header->revolution_index_offset = revolution_index_offset;
+    header->time_index_offset = time_index_offset;
+
+    msync((void *)recorder->mapped_file, recorder->mapped_file_length, MS_SYNC);
+    munmap((void *)recorder->mapped_file, recorder->mapped_file_length);
+
+    if (ftruncate(recorder->file_descriptor, (off_t)file_length) != 0) {
+        // file keeps unused area, and it is still readable
+    }
+    close(recorder->file_descriptor);
+
+    initialize_packet_recorder(recorder);
+
+    return;
+}
+
+bool append_packet_to_packet_recorder(packet_recorder_t *recorder,
+                                      const char *packet, unsigned int packet_length,
+                                      double receive_time_usec, bool revolution_start)
+{
+    if (is_opened_packet_recorder(recorder) == false) {
+        return false;
+    }
+
+    packet_record_file_header_t *header = recorder->header;
+
+    const unsigned int record_index = recorder->number_of_written_records;
+
+    if ((record_index >= header->maximum_number_of_records) ||
+        (packet_length > header->maximum_packet_length)) {
+        ++header->number_of_dropped_packets;
+        return false;
+    }
+
+    const double receive_time_sec = floor(receive_time_usec / 1.0e6);
+
+    char *record =
+        recorder->mapped_file + (size_t)header->record_offset + (size_t)record_index * header->record_length;
+
+    packet_record_header_t *record_header = (packet_record_header_t *)record;
+
+    record_header->receive_time_sec = (unsigned int)receive_time_sec;
+    record_header->receive_time_usec = (unsigned int)(receive_time_usec - receive_time_sec * 1.0e6);
+    record_header->packet_length = packet_length;
+    record_header->flags = 0;
+
+    memcpy((void *)(record + PACKET_RECORDER_RECORD_HEADER_LENGTH), (const void *)packet, packet_length);
+
+    if (record_index == 0) {
+        header->first_receive_time_sec = record_header->receive_time_sec;
+        header->first_receive_time_usec = record_header->receive_time_usec;
+    }
+
+    if (revolution_start == true) {
+        record_header->flags |= PACKET_RECORD_REVOLUTION_START_FLAG;
+        recorder->revolution_index[header->number_of_revolutions] = record_index;
+        ++header->number_of_revolutions;
+    }
+
+    // entry is added only for interval in which first record is received (intervals without records are skipped on seek)
+    const double interval_index =
+        calculate_elapsed_time_usec(header, record_header->receive_time_sec, record_header->receive_time_usec) /
+        (double)header->time_index_interval_usec;
+
+    if ((interval_index >= 0.0) && (interval_index < 4294967295.0)) {
+
+        const unsigned int number_of_entries = header->number_of_time_index_entries;
+
+        if ((number_of_entries == 0) ||
+            (recorder->time_index[number_of_entries - 1].interval_index < (unsigned int)interval_index)) {
+            recorder->time_index[number_of_entries].interval_index = (unsigned int)interval_index;
+            recorder->time_index[number_of_entries].record_index = record_index;
+            ++header->number_of_time_index_entries;
+        }
+
+    }
+
+    // record is published to flush thread after it is written
+    store_shared_unsigned_int(&recorder->number_of_written_records, record_index + 1);
+
+    return true;
+}
+
+bool open_packet_record_file(const char *file_path, packet_record_file_reader_t *reader)
+{
+    reader->file_descriptor = open(file_path, O_RDONLY);
+    if (reader->file_descriptor < 0) {
+        reader->file_descriptor = -1;
+        return false;
+    }
+
+    struct stat file_status;
+    if ((fstat(reader->file_descriptor, &file_status) != 0) ||
+        ((unsigned long long)file_status.st_size < sizeof(packet_record_file_header_t)) ||
+        ((unsigned long long)file_status.st_size > (unsigned long long)((size_t)-1))) {
+        close(reader->file_descriptor);
+        reader->file_descriptor = -1;
+        return false;
+    }
+
+    void *mapped_file = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_SHARED,
+                             reader->file_descriptor, 0);
+
+    if (mapped_file == MAP_FAILED) {
+        close(reader->file_descriptor);
+        reader->file_descriptor = -1;
+        return false;
+    }
+
+    reader->mapped_file = (const char *)mapped_file;
+    reader->mapped_file_length = (size_t)file_status.st_size;
+    reader->header = (const packet_record_file_header_t *)reader->mapped_file;
+
+    const packet_record_file_header_t *header = reader->header;
+
+    const unsigned long long file_length = reader->mapped_file_length;
+
+    // records and indexes should be in file, and indexes should be aligned
+    if ((memcmp((const void *)header->magic, (const void *)PACKET_RECORD_FILE_MAGIC, sizeof(PACKET_RECORD_FILE_MAGIC)) != 0) ||
+        (header->version != PACKET_RECORDER_FILE_VERSION) ||
+        (header->time_index_interval_usec == 0) ||
+        ((unsigned long long)header->record_length <
+         (unsigned long long)PACKET_RECORDER_RECORD_HEADER_LENGTH + header->maximum_packet_length) ||
+        (is_area_in_packet_record_file(header->record_offset,
+                                       (unsigned long long)header->record_length * header->number_of_records,
+                                       file_length) == false) ||
+        (is_area_in_packet_record_file(header->revolution_index_offset,
+                                       sizeof(unsigned int) * (unsigned long long)header->number_of_revolutions,
+                                       file_length) == false) ||
+        (is_area_in_packet_record_file(header->time_index_offset,
+                                       sizeof(packet_record_time_index_entry_t) * (unsigned long long)header->number_of_time_index_entries,
+                                       file_length) == false) ||
+        ((header->revolution_index_offset % sizeof(unsigned int)) != 0) ||
+        ((header->time_index_offset % sizeof(unsigned int)) != 0)) {
+        close_packet_record_file(reader);
+        return false;
+    }
+
+    reader->revolution_index = (const unsigned int *)(reader->mapped_file + header->revolution_index_offset);
+    reader->time_index = (const packet_record_time_index_entry_t *)(reader->mapped_file + header->time_index_offset);
+
+    return true;
+}
+
+void close_packet_record_file(packet_record_file_reader_t *reader)
+{
+    if (reader->mapped_file != NULL) {
+        munmap((void *)reader->mapped_file, reader->mapped_file_length);
+    }
+
+    if (reader->file_descriptor >= 0) {
+        close(reader->file_descriptor);
+    }
+
+    reader->file_descriptor = -1;
+    reader->mapped_file = NULL;
+    reader->mapped_file_length = 0;
+    reader->header = NULL;
+    reader->revolution_index = NULL;
+    reader->time_index = NULL;
+
+    return;
+}
+
+#else
+
+bool open_packet_recorder(const char *file_path,
+                          unsigned int maximum_packet_length, unsigned int maximum_number_of_records,
+                          packet_recorder_t *recorder)
+{
+    return false;
+}
+
+void close_packet_recorder(packet_recorder_t *recorder)
+{
+    return;
+}
+
+bool append_packet_to_packet_recorder(packet_recorder_t *recorder,
+                                      const char *packet, unsigned int packet_length,
+                                      double receive_time_usec, bool revolution_start)
+{
+    return false;
+}
+
+bool open_packet_record_file(const char *file_path, packet_record_file_reader_t *reader)
+{
+    reader->file_descriptor = -1;
+    reader->mapped_file = NULL;
+    reader->mapped_file_length = 0;
+    reader->header = NULL;
+    reader->revolution_index = NULL;
+    reader->time_index = NULL;
+
+    return false;
+}
+
+void close_packet_record_file(packet_record_file_reader_t *reader)
+{
+    return;
+}
+
+#endif
+
+unsigned int get_number_of_records_of_packet_record_file(const packet_record_file_reader_t *reader)
+{
+    if (reader->header == NULL) {
+        return 0;
+    }
+
+    return reader->header->number_of_records;
+}
+
+bool get_record_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                      unsigned int record_index,
+                                      const char **packet, unsigned int *packet_length,
+                                      unsigned int *receive_time_sec, unsigned int *receive_time_usec)
+{
+    if ((reader->header == NULL) || (record_index >= reader->header->number_of_records)) {
+        return false;
+    }
+
+    const char *record =
+        reader->mapped_file + (size_t)reader->header->record_offset + (size_t)record_index * reader->header->record_length;
+
+    const packet_record_header_t *record_header = (const packet_record_header_t *)record;
+
+    if (record_header->packet_length > reader->header->maximum_packet_length) {
+        return false;
+    }
+
+    *packet = record + PACKET_RECORDER_RECORD_HEADER_LENGTH;
+    *packet_length = record_header->packet_length;
+
+    *receive_time_sec = record_header->receive_time_sec;
+    *receive_time_usec = record_header->receive_time_usec;
+
+    return true;
+}
+
+int seek_record_index_by_time_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                                    double elapsed_time_usec)
+{
+    if ((reader->header == NULL) || (elapsed_time_usec < 0.0)) {
+        return PACKET_RECORDER_INVALID_RECORD_INDEX;
+    }
+
+    const packet_record_file_header_t *header = reader->header;
+
+    const double interval_index = floor(elapsed_time_usec / (double)header->time_index_interval_usec);
+
+    // first entry of interval_index or later interval (entries are sorted by interval)
+    unsigned int lower_entry_index = 0;
+    unsigned int upper_entry_index = header->number_of_time_index_entries;
+
+    while (lower_entry_index < upper_entry_index) {
+
+        const unsigned int middle_entry_index = lower_entry_index + (upper_entry_index - lower_entry_index) / 2;
+
+        if ((double)reader->time_index[middle_entry_index].interval_index < interval_index) {
+            lower_entry_index = middle_entry_index + 1;
+        } else {
+            upper_entry_index = middle_entry_index;
+        }
+    }
+
+    if (lower_entry_index >= header->number_of_time_index_entries) {
+        return PACKET_RECORDER_INVALID_RECORD_INDEX;
+    }
+
+    const unsigned int first_record_index = reader->time_index[lower_entry_index].record_index;
+    if (first_record_index >= header->number_of_records) {
+        return PACKET_RECORDER_INVALID_RECORD_INDEX;
+    }
+
+    // scan records from first record of interval
+    for (unsigned int record_index = first_record_index; record_index < header->number_of_records; ++record_index) {
+
+        const packet_record_header_t *record_header =
+            (const packet_record_header_t *)(reader->mapped_file + (size_t)header->record_offset +
+                                             (size_t)record_index * header->record_length);
+
+        if (calculate_elapsed_time_usec(header, record_header->receive_time_sec,
+                                        record_header->receive_time_usec) >= elapsed_time_usec) {
+            return (int)record_index;
+        }
+
+    }
+
+    return PACKET_RECORDER_INVALID_RECORD_INDEX;
+}
+
+int seek_record_index_by_revolution_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                                          unsigned int revolution_number)
+{
+    if ((reader->header == NULL) || (revolution_number >= reader->header->number_of_revolutions)) {
+        return PACKET_RECORDER_INVALID_RECORD_INDEX;
+    }
+
+    const unsigned int record_index = reader->revolution_index[revolution_number];
+    if (record_index >= reader->header->number_of_records) {
+        return PACKET_RECORDER_INVALID_RECORD_INDEX;
+    }
+
+    return (int)record_index;
+}
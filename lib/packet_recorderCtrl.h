@@ -0,0 +1,253 @@
+#ifndef PACKET_RECORDER_CONTROL_H
+#define PACKET_RECORDER_CONTROL_H
+/*!
+  \file
+  \brief functions to record raw packets in memory-mapped file with index of revolutions and time
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+// for NULL
+#include <stddef.h>
+
+// for pthread_t
+#include <pthread.h>
+
+//! constants for packet record file
+enum PACKET_RECORDER_CONSTANT {
+
+    //! length of file header [byte]
+    PACKET_RECORDER_FILE_HEADER_LENGTH = 4096,
+
+    //! length of record header (receive time and packet length) [byte]
+    PACKET_RECORDER_RECORD_HEADER_LENGTH = 16,
+
+    //! alignment of one record [byte]
+    PACKET_RECORDER_RECORD_ALIGNMENT_BYTE = 16,
+
+    //! interval of time index [usec]
+    PACKET_RECORDER_TIME_INDEX_INTERVAL_USEC = 10 * 1000,
+
+    //! interval of flush by background thread [msec]
+    PACKET_RECORDER_FLUSH_INTERVAL_MSEC = 100,
+
+    //! version of packet record file (64 bit offsets and time index of intervals with records)
+    PACKET_RECORDER_FILE_VERSION = 2,
+
+    //! invalid record index
+    PACKET_RECORDER_INVALID_RECORD_INDEX = -1,
+
+};
+
+//! header of packet record file (placed at top of file)
+struct packet_record_file_header_t {
+
+    //! magic string
+    char magic[8];
+
+    //! version
+    unsigned int version;
+
+    //! length of one record [byte]
+    unsigned int record_length;
+
+    //! maximum length of packet [byte]
+    unsigned int maximum_packet_length;
+
+    //! maximum number of records
+    unsigned int maximum_number_of_records;
+
+    //! number of written records
+    unsigned int number_of_records;
+
+    //! number of revolution starts in revolution index
+    unsigned int number_of_revolutions;
+
+    //! number of entries in time index (intervals in which records are received)
+    unsigned int number_of_time_index_entries;
+
+    //! interval of time index [usec]
+    unsigned int time_index_interval_usec;
+
+    //! receive time of first record [sec]
+    unsigned int first_receive_time_sec;
+    //! receive time of first record [usec]
+    unsigned int first_receive_time_usec;
+
+    //! number of packets which are not recorded because file is full
+    unsigned int number_of_dropped_packets;
+
+    //! reserved (offsets are aligned to 8 byte)
+    unsigned int reserved;
+
+    //! offset of first record [byte]
+    unsigned long long record_offset;
+
+    //! offset of revolution index (record index of each revolution start) [byte]
+    unsigned long long revolution_index_offset;
+
+    //! offset of time index (entries of intervals in which records are received) [byte]
+    unsigned long long time_index_offset;
+
+};
+
+//! entry of time index of packet record file
+struct packet_record_time_index_entry_t {
+
+    //! index of interval from receive time of first record (elapsed time / time_index_interval_usec)
+    unsigned int interval_index;
+
+    //! index of first record received in interval
+    unsigned int record_index;
+
+};
+
+//! structure of packet recorder (writer of packet record file)
+struct packet_recorder_t {
+
+    //! file descriptor
+    int file_descriptor;
+
+    //! mapped file
+    char *mapped_file;
+
+    //! length of mapped file [byte]
+    size_t mapped_file_length;
+
+    //! header in mapped file
+    packet_record_file_header_t *header;
+
+    //! revolution index in mapped file
+    unsigned int *revolution_index;
+
+    //! time index in mapped file
+    packet_record_time_index_entry_t *time_index;
+
+    //! number of written records (written only by recording thread, and loaded by flush thread with load_shared_unsigned_int)
+    volatile unsigned int number_of_written_records;
+
+    //! number of records flushed to file
+    unsigned int number_of_flushed_records;
+
+    //! flag to keep flush thread running (accessed with load_shared_bool and store_shared_bool)
+    volatile bool flush_thread_running;
+
+    //! flush thread
+    pthread_t flush_thread;
+
+    //! recorder is constructed as closed so that owner can close it before initialization safely
+    packet_recorder_t()
+        : file_descriptor(-1), mapped_file(NULL), mapped_file_length(0), header(NULL),
+          revolution_index(NULL), time_index(NULL), number_of_written_records(0),
+          number_of_flushed_records(0), flush_thread_running(false)
+    {
+    }
+
+};
+
+//! structure of reader of packet record file
+struct packet_record_file_reader_t {
+
+    //! file descriptor
+    int file_descriptor;
+
+    //! mapped file
+    const char *mapped_file;
+
+    //! length of mapped file [byte]
+    size_t mapped_file_length;
+
+    //! header in mapped file
+    const packet_record_file_header_t *header;
+
+    //! revolution index in mapped file
+    const unsigned int *revolution_index;
+
+    //! time index in mapped file
+    const packet_record_time_index_entry_t *time_index;
+
+};
+
+/*!
+  \brief function to initialize packet recorder
+  \attention this function should be used before opening
+*/
+extern void initialize_packet_recorder(packet_recorder_t *recorder);
+
+/*!
+  \brief function to open packet record file and start flush thread
+  \attention file of maximum_number_of_records records is allocated and mapped on opening (no allocation on recording)
+  \attention this function works only on Linux OS, and offsets in file are 64 bit (file should be mapped in address space)
+*/
+extern bool open_packet_recorder(const char *file_path,
+                                 unsigned int maximum_packet_length, unsigned int maximum_number_of_records,
+                                 packet_recorder_t *recorder);
+
+/*!
+  \brief function to stop flush thread and close packet record file
+  \attention file is truncated to written records and indexes are kept
+*/
+extern void close_packet_recorder(packet_recorder_t *recorder);
+
+/*!
+  \brief function to evaluate whether packet recorder is opened
+*/
+extern bool is_opened_packet_recorder(const packet_recorder_t *recorder);
+
+/*!
+  \brief function to append packet to packet record file
+  \attention packet is stamped with receive_time_usec [usec from 1970-01-01], e.g. kernel receive timestamp of datagram
+  \attention revolution_start should be true if revolution of sensor starts in packet
+  \attention this function returns false if file is full, and number_of_dropped_packets is counted
+  \attention time index gets one entry when record is received in new interval, so intervals without records do not use index
+*/
+extern bool append_packet_to_packet_recorder(packet_recorder_t *recorder,
+                                             const char *packet, unsigned int packet_length,
+                                             double receive_time_usec, bool revolution_start);
+
+/*!
+  \brief function to open packet record file to read
+  \attention this function returns false if header, records or indexes do not fit in file
+*/
+extern bool open_packet_record_file(const char *file_path, packet_record_file_reader_t *reader);
+
+/*!
+  \brief function to close packet record file
+*/
+extern void close_packet_record_file(packet_record_file_reader_t *reader);
+
+/*!
+  \brief function to get number of records in packet record file
+*/
+extern unsigned int get_number_of_records_of_packet_record_file(const packet_record_file_reader_t *reader);
+
+/*!
+  \brief function to get record of packet record file
+  \attention packet points to mapped file, and it is valid until file is closed
+  \attention this function returns false if packet length of record is longer than maximum packet length
+*/
+extern bool get_record_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                             unsigned int record_index,
+                                             const char **packet, unsigned int *packet_length,
+                                             unsigned int *receive_time_sec, unsigned int *receive_time_usec);
+
+/*!
+  \brief function to seek first record received after elapsed_time_usec from first record
+  \return record index (PACKET_RECORDER_INVALID_RECORD_INDEX if time is out of record)
+  \attention record is found with binary search of time index and short scan in one index interval
+  \attention PACKET_RECORDER_INVALID_RECORD_INDEX is returned if entry of time index points outside of records
+*/
+extern int seek_record_index_by_time_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                                           double elapsed_time_usec);
+
+/*!
+  \brief function to seek record in which revolution of revolution_number starts
+  \return record index (PACKET_RECORDER_INVALID_RECORD_INDEX if revolution is out of record)
+  \attention PACKET_RECORDER_INVALID_RECORD_INDEX is returned if entry of revolution index points outside of records
+*/
+extern int seek_record_index_by_revolution_of_packet_record_file(const packet_record_file_reader_t *reader,
+                                                                 unsigned int revolution_number);
+
+#endif // PACKET_RECORDER_CONTROL_H
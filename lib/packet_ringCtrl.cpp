@@ -0,0 +1,466 @@
+
+#include "packet_ringCtrl.h"
+
+// for memcpy
+#include <string.h>
+
+// for malloc/free
+#include <stdlib.h>
+
+// for ETIMEDOUT
+#include <errno.h>
+
+// for clock_gettime
+#include <time.h>
+
+void initialize_packet_ring_buffer(packet_ring_buffer_t *ring)
+{
+    ring->slot_length_byte = 0;
+    ring->number_of_slots = 0;
+    ring->slot_index_mask = 0;
+
+    ring->slot_buffer = NULL;
+    ring->slot_data_length = NULL;
+    ring->slot_receive_time_usec = NULL;
+
+    ring->overflow_policy = PACKET_RING_INVALID_OVERFLOW_POLICY;
+
+    ring->maximum_number_of_held_slots = 0;
+    ring->queue_capacity = 0;
+
+    ring->write_count = 0;
+    ring->read_count = 0;
+
+    ring->held_slot_start_count = 0;
+    ring->number_of_held_slots = 0;
+
+    ring->number_of_overflows = 0;
+    ring->number_of_dropped_packets = 0;
+
+    ring->number_of_waiting_consumers = 0;
+
+    return;
+}
+
+static unsigned int round_up_to_power_of_two(unsigned int value)
+{
+    unsigned int rounded_value = 1;
+    while (rounded_value < value) {
+        rounded_value <<= 1;
+    }
+
+    return rounded_value;
+}
+
+bool allocate_memory_for_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                            unsigned int slot_length_byte, unsigned int number_of_slots,
+                                            unsigned int maximum_number_of_held_slots,
+                                            enum PACKET_RING_OVERFLOW_POLICY overflow_policy)
+{
+    if ((slot_length_byte == 0) ||
+        (number_of_slots == 0) ||
+        (maximum_number_of_held_slots == 0)) {
+        return false;
+    }
+
+    if ((overflow_policy < 0) ||
+        (overflow_policy >= NUMBER_OF_PACKET_RING_OVERFLOW_POLICIES)) {
+        return false;
+    }
+
+    if (is_allocated_memory_of_packet_ring_buffer(ring) == true) {
+        release_memory_of_packet_ring_buffer(ring);
+    }
+
+    // held slots and slots written while they are held are reserved in addition to queue
+    const unsigned int rounded_number_of_slots =
+        round_up_to_power_of_two(number_of_slots + 2 * maximum_number_of_held_slots);
+
+    ring->slot_buffer = (char *)malloc(rounded_number_of_slots * slot_length_byte * sizeof(char));
+    if (ring->slot_buffer == NULL) {
+        return false;
+    }
+
+    // mutex and condition live as long as slot_buffer, and timeout of condition is not changed by wall clock
+    pthread_mutex_init(&ring->mutex, NULL);
+
+    pthread_condattr_t condition_attribute;
+    pthread_condattr_init(&condition_attribute);
+    pthread_condattr_setclock(&condition_attribute, CLOCK_MONOTONIC);
+    pthread_cond_init(&ring->packet_arrival, &condition_attribute);
+    pthread_condattr_destroy(&condition_attribute);
+
+    ring->slot_data_length = (int *)malloc(rounded_number_of_slots * sizeof(int));
+    ring->slot_receive_time_usec = (double *)malloc(rounded_number_of_slots * sizeof(double));
+    if ((ring->slot_data_length == NULL) ||
+        (ring->slot_receive_time_usec == NULL)) {
+        release_memory_of_packet_ring_buffer(ring);
+        return false;
+    }
+
+    ring->slot_length_byte = slot_length_byte;
+    ring->number_of_slots = rounded_number_of_slots;
+    ring->slot_index_mask = rounded_number_of_slots - 1;
+    ring->overflow_policy = overflow_policy;
+
+    ring->maximum_number_of_held_slots = maximum_number_of_held_slots;
+    ring->queue_capacity = rounded_number_of_slots - 2 * maximum_number_of_held_slots;
+
+    ring->write_count = 0;
+    ring->read_count = 0;
+
+    ring->held_slot_start_count = 0;
+    ring->number_of_held_slots = 0;
+
+    ring->number_of_overflows = 0;
+    ring->number_of_dropped_packets = 0;
+
+    ring->number_of_waiting_consumers = 0;
+
+    return true;
+}
+
+void release_memory_of_packet_ring_buffer(packet_ring_buffer_t *ring)
+{
+    if (ring->slot_buffer != NULL) {
+        pthread_cond_destroy(&ring->packet_arrival);
+        pthread_mutex_destroy(&ring->mutex);
+        free(ring->slot_buffer);
+    }
+
+    if (ring->slot_data_length != NULL) {
+        free(ring->slot_data_length);
+    }
+
+    if (ring->slot_receive_time_usec != NULL) {
+        free(ring->slot_receive_time_usec);
+    }
+
+    initialize_packet_ring_buffer(ring);
+
+    return;
+}
+
+bool is_allocated_memory_of_packet_ring_buffer(const packet_ring_buffer_t *ring)
+{
+    if (ring->slot_buffer == NULL) {
+        return false;
+    }
+
+    return true;
+}
+
+unsigned int calculate_number_of_packets_in_packet_ring_buffer(const packet_ring_buffer_t *ring)
+{
+    const unsigned int read_count = load_shared_unsigned_int(&ring->read_count);
+    const unsigned int write_count = load_shared_unsigned_int(&ring->write_count);
+
+    return write_count - read_count;
+}
+
+/*!
+  \brief function to calculate read count of oldest slot which consumer may still read (producer only)
+  \attention read_count is loaded before held slots, so held slots claimed with read_count are not missed
+*/
+static unsigned int calculate_oldest_used_count_of_packet_ring_buffer(const packet_ring_buffer_t *ring,
+                                                                      unsigned int read_count)
+{
+    // pairs with full barrier of consumer between publishing held slots and claiming them
+    __sync_synchronize();
+
+    if (load_shared_unsigned_int(&ring->number_of_held_slots) == 0) {
+        return read_count;
+    }
+
+    const unsigned int held_slot_start_count = load_shared_unsigned_int(&ring->held_slot_start_count);
+
+    // start of later holding is newer than read_count, and slots before read_count are free then
+    if ((int)(read_count - held_slot_start_count) > 0) {
+        return held_slot_start_count;
+    }
+
+    return read_count;
+}
+
+char *reserve_slots_to_write_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                unsigned int maximum_number_of_slots,
+                                                unsigned int *number_of_reserved_slots,
+                                                int **data_length_array,
+                                                double **receive_time_usec_array)
+{
+    *number_of_reserved_slots = 0;
+
+    if ((ring->slot_buffer == NULL) ||
+        (maximum_number_of_slots == 0)) {
+        return NULL;
+    }
+
+    const unsigned int write_count = ring->write_count;
+
+    unsigned int read_count = 0;
+    unsigned int oldest_used_count = 0;
+    bool overflow_counted = false;
+
+    while (1) {
+
+        read_count = load_shared_unsigned_int(&ring->read_count);
+        oldest_used_count = calculate_oldest_used_count_of_packet_ring_buffer(ring, read_count);
+
+        const bool queue_full = (write_count - read_count >= ring->queue_capacity);
+        const bool slots_full = (write_count - oldest_used_count >= ring->number_of_slots);
+
+        if ((queue_full == false) && (slots_full == false)) {
+            break;
+        }
+
+        if (overflow_counted == false) {
+            __sync_fetch_and_add(&ring->number_of_overflows, 1);
+            overflow_counted = true;
+        }
+
+        // next slot is held by consumer, and dropping queued packets does not free it
+        if (slots_full == true) {
+            return NULL;
+        }
+
+        if (ring->overflow_policy != PACKET_RING_DROP_OLDEST) {
+            return NULL;
+        }
+
+        // oldest queued packet is dropped, unless consumer claims it at the same time
+        if (__sync_bool_compare_and_swap(&ring->read_count, read_count, read_count + 1) == true) {
+            __sync_fetch_and_add(&ring->number_of_dropped_packets, 1);
+        }
+    }
+
+    unsigned int number_of_empty_slots = ring->queue_capacity - (write_count - read_count);
+    if (number_of_empty_slots > ring->number_of_slots - (write_count - oldest_used_count)) {
+        number_of_empty_slots = ring->number_of_slots - (write_count - oldest_used_count);
+    }
+
+    const unsigned int slot_index = write_count & ring->slot_index_mask;
+
+    unsigned int number_of_slots = ring->number_of_slots - slot_index;
+    if (number_of_slots > number_of_empty_slots) {
+        number_of_slots = number_of_empty_slots;
+    }
+    if (number_of_slots > maximum_number_of_slots) {
+        number_of_slots = maximum_number_of_slots;
+    }
+
+    *number_of_reserved_slots = number_of_slots;
+    *data_length_array = ring->slot_data_length + slot_index;
+    *receive_time_usec_array = ring->slot_receive_time_usec + slot_index;
+
+    return ring->slot_buffer + slot_index * ring->slot_length_byte;
+}
+
+void commit_written_slots_of_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                unsigned int number_of_written_slots)
+{
+    // slots must be written before they are published
+    store_shared_unsigned_int(&ring->write_count, ring->write_count + number_of_written_slots);
+
+    // write_count must be published before waiting consumers are checked
+    __sync_synchronize();
+    if (ring->number_of_waiting_consumers > 0) {
+        pthread_mutex_lock(&ring->mutex);
+        pthread_cond_signal(&ring->packet_arrival);
+        pthread_mutex_unlock(&ring->mutex);
+    }
+
+    return;
+}
+
+void count_dropped_packets_of_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                 unsigned int number_of_dropped_packets)
+{
+    __sync_fetch_and_add(&ring->number_of_dropped_packets, number_of_dropped_packets);
+
+    return;
+}
+
+bool push_packet_to_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                       const char *packet, unsigned int packet_length,
+                                       double receive_time_usec)
+{
+    if (packet_length > ring->slot_length_byte) {
+        return false;
+    }
+
+    unsigned int number_of_reserved_slots = 0;
+    int *data_length = NULL;
+    double *receive_time = NULL;
+
+    char *slot =
+        reserve_slots_to_write_packet_ring_buffer(ring, 1, &number_of_reserved_slots, &data_length,
+                                                  &receive_time);
+
+    if (slot == NULL) {
+        count_dropped_packets_of_packet_ring_buffer(ring, 1);
+        return false;
+    }
+
+    memcpy(slot, packet, packet_length);
+    *data_length = (int)packet_length;
+    *receive_time = receive_time_usec;
+
+    commit_written_slots_of_packet_ring_buffer(ring, 1);
+
+    return true;
+}
+
+bool pop_packet_from_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                        char *destination_buffer, unsigned int destination_buffer_length,
+                                        int *packet_length, double *receive_time_usec)
+{
+    if (ring->slot_buffer == NULL) {
+        return false;
+    }
+
+    while (1) {
+
+        const unsigned int read_count = load_shared_unsigned_int(&ring->read_count);
+        const unsigned int write_count = load_shared_unsigned_int(&ring->write_count);
+
+        if (write_count == read_count) {
+            return false;
+        }
+
+        const unsigned int slot_index = read_count & ring->slot_index_mask;
+        const int data_length = ring->slot_data_length[slot_index];
+
+        if ((data_length < 0) ||
+            ((unsigned int)data_length > destination_buffer_length)) {
+            *packet_length = -1;
+        } else {
+            memcpy(destination_buffer, ring->slot_buffer + slot_index * ring->slot_length_byte,
+                   data_length);
+            *packet_length = data_length;
+        }
+        *receive_time_usec = ring->slot_receive_time_usec[slot_index];
+        __sync_synchronize();
+
+        // copied packet is valid only if producer did not drop it during copy
+        if (__sync_bool_compare_and_swap(&ring->read_count, read_count, read_count + 1) == true) {
+            return true;
+        }
+
+    }
+
+    return false;
+}
+
+bool wait_for_packets_in_packet_ring_buffer(packet_ring_buffer_t *ring, int wait_timeout_usec)
+{
+    if (ring->slot_buffer == NULL) {
+        return false;
+    }
+
+    if (calculate_number_of_packets_in_packet_ring_buffer(ring) > 0) {
+        return true;
+    }
+
+    struct timespec deadline;
+    if (wait_timeout_usec >= 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        const long deadline_nsec = deadline.tv_nsec + (long)(wait_timeout_usec % 1000000) * 1000;
+        deadline.tv_sec += (time_t)(wait_timeout_usec / 1000000 + deadline_nsec / 1000000000);
+        deadline.tv_nsec = deadline_nsec % 1000000000;
+    }
+
+    pthread_mutex_lock(&ring->mutex);
+
+    // producer checks waiting consumers after write_count is published
+    __sync_fetch_and_add(&ring->number_of_waiting_consumers, 1);
+
+    while (calculate_number_of_packets_in_packet_ring_buffer(ring) == 0) {
+
+        if (wait_timeout_usec < 0) {
+            pthread_cond_wait(&ring->packet_arrival, &ring->mutex);
+        } else if (pthread_cond_timedwait(&ring->packet_arrival, &ring->mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    __sync_fetch_and_sub(&ring->number_of_waiting_consumers, 1);
+
+    pthread_mutex_unlock(&ring->mutex);
+
+    return (calculate_number_of_packets_in_packet_ring_buffer(ring) > 0);
+}
+
+const char *hold_slots_to_read_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                  unsigned int maximum_number_of_slots,
+                                                  unsigned int *number_of_held_slots,
+                                                  const int **data_length_array,
+                                                  const double **receive_time_usec_array)
+{
+    *number_of_held_slots = 0;
+
+    if (ring->slot_buffer == NULL) {
+        return NULL;
+    }
+
+    release_held_slots_of_packet_ring_buffer(ring);
+
+    if (maximum_number_of_slots > ring->maximum_number_of_held_slots) {
+        maximum_number_of_slots = ring->maximum_number_of_held_slots;
+    }
+
+    unsigned int read_count = 0;
+    unsigned int number_of_slots = 0;
+
+    while (1) {
+
+        read_count = load_shared_unsigned_int(&ring->read_count);
+        const unsigned int write_count = load_shared_unsigned_int(&ring->write_count);
+
+        const unsigned int slot_index = read_count & ring->slot_index_mask;
+
+        number_of_slots = ring->number_of_slots - slot_index;
+        if (number_of_slots > write_count - read_count) {
+            number_of_slots = write_count - read_count;
+        }
+        if (number_of_slots > maximum_number_of_slots) {
+            number_of_slots = maximum_number_of_slots;
+        }
+
+        if (number_of_slots == 0) {
+            release_held_slots_of_packet_ring_buffer(ring);
+            return NULL;
+        }
+
+        // held slots are published before they are claimed, so producer does not overwrite them after claiming
+        store_shared_unsigned_int(&ring->held_slot_start_count, read_count);
+        store_shared_unsigned_int(&ring->number_of_held_slots, number_of_slots);
+        __sync_synchronize();
+
+        // producer may drop oldest packet at the same time
+        if (__sync_bool_compare_and_swap(&ring->read_count, read_count, read_count + number_of_slots) == true) {
+            break;
+        }
+    }
+
+    const unsigned int slot_index = read_count & ring->slot_index_mask;
+
+    *number_of_held_slots = number_of_slots;
+    *data_length_array = ring->slot_data_length + slot_index;
+    *receive_time_usec_array = ring->slot_receive_time_usec + slot_index;
+
+    return ring->slot_buffer + slot_index * ring->slot_length_byte;
+}
+
+void release_held_slots_of_packet_ring_buffer(packet_ring_buffer_t *ring)
+{
+    if ((ring->slot_buffer == NULL) ||
+        (ring->number_of_held_slots == 0)) {
+        return;
+    }
+
+    // held slots are read before they are released
+    store_shared_unsigned_int(&ring->number_of_held_slots, 0);
+
+    return;
+}
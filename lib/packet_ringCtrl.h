@@ -0,0 +1,201 @@
+#ifndef PACKET_RING_CONTROL_H
+#define PACKET_RING_CONTROL_H
+/*!
+  \file
+  \brief functions to handle lock-free packet ring between one producer and one consumer
+  \attention consumer may sleep until producer publishes packets, and producer wakes it only if it is waiting (mutex and condition are used only for sleeping)
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+// for NULL
+#include <stddef.h>
+
+#include <pthread.h>
+
+//! policy on overflow of packet ring
+enum PACKET_RING_OVERFLOW_POLICY {
+
+    //! invalid policy
+    PACKET_RING_INVALID_OVERFLOW_POLICY = -1,
+
+    //! oldest packet in ring is dropped to push new packet
+    PACKET_RING_DROP_OLDEST = 0,
+
+    //! new packet is dropped
+    PACKET_RING_DROP_NEWEST,
+
+    //! number of policies
+    NUMBER_OF_PACKET_RING_OVERFLOW_POLICIES,
+};
+
+//! structure of packet ring (single producer and single consumer)
+struct packet_ring_buffer_t {
+
+    //! length of one slot [byte]
+    unsigned int slot_length_byte;
+
+    //! number of slots (power of two)
+    unsigned int number_of_slots;
+
+    //! mask to convert count to slot index
+    unsigned int slot_index_mask;
+
+    //! slots
+    char *slot_buffer;
+
+    //! data length of each slot
+    int *slot_data_length;
+
+    //! receive time of each slot [usec]
+    double *slot_receive_time_usec;
+
+    //! policy on overflow
+    enum PACKET_RING_OVERFLOW_POLICY overflow_policy;
+
+    //! maximum number of slots held by consumer at once
+    unsigned int maximum_number_of_held_slots;
+
+    //! maximum number of queued packets (number_of_slots - 2 * maximum_number_of_held_slots)
+    unsigned int queue_capacity;
+
+    //! number of pushed packets (written only by producer)
+    volatile unsigned int write_count;
+
+    //! number of packets held or popped by consumer, or dropped by producer (advanced with compare and swap)
+    volatile unsigned int read_count;
+
+    //! read count of first held slot (written only by consumer, valid while number_of_held_slots > 0)
+    volatile unsigned int held_slot_start_count;
+
+    //! number of slots held by consumer to read packets in place (written only by consumer)
+    volatile unsigned int number_of_held_slots;
+
+    //! number of overflows
+    volatile unsigned int number_of_overflows;
+
+    //! number of dropped packets
+    volatile unsigned int number_of_dropped_packets;
+
+    //! number of consumers waiting for packet arrival
+    volatile unsigned int number_of_waiting_consumers;
+
+    //! mutex of packet_arrival (used only to sleep and wake consumer)
+    pthread_mutex_t mutex;
+
+    //! condition signaled when producer publishes packets to waiting consumer (CLOCK_MONOTONIC)
+    pthread_cond_t packet_arrival;
+
+};
+
+/*!
+  \brief function to initialize packet ring
+  \attention this function should be used before allocation
+*/
+extern void initialize_packet_ring_buffer(packet_ring_buffer_t *ring);
+
+/*!
+  \brief function to allocate memory for packet ring
+  \attention number_of_slots (queued packets) plus twice maximum_number_of_held_slots is rounded up to power of two
+  \attention slots are reserved for held slots and for maximum_number_of_held_slots packets written while they are held
+  \attention so PACKET_RING_DROP_OLDEST drops oldest queued packet while slots are held, until reserved slots are used up
+*/
+extern bool allocate_memory_for_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                   unsigned int slot_length_byte, unsigned int number_of_slots,
+                                                   unsigned int maximum_number_of_held_slots,
+                                                   enum PACKET_RING_OVERFLOW_POLICY overflow_policy);
+
+/*!
+  \brief function to release memory of packet ring
+*/
+extern void release_memory_of_packet_ring_buffer(packet_ring_buffer_t *ring);
+
+/*!
+  \brief function to evaluate whether packet ring is allocated
+*/
+extern bool is_allocated_memory_of_packet_ring_buffer(const packet_ring_buffer_t *ring);
+
+/*!
+  \brief function to calculate number of packets in packet ring
+  \attention held slots are not counted
+*/
+extern unsigned int calculate_number_of_packets_in_packet_ring_buffer(const packet_ring_buffer_t *ring);
+
+/*!
+  \brief function to reserve slots to write packets (producer only)
+  \return pointer to first reserved slot (NULL if there are no writable slots)
+  \attention reserved slots are continuous in memory, and number of them is stored in number_of_reserved_slots
+  \attention on PACKET_RING_DROP_OLDEST, oldest queued packet is dropped if queue is full
+  \attention held slots are never overwritten, so NULL is returned if next slot is held regardless of policy
+  \attention data length of i-th reserved slot should be written in *data_length_array + i
+  \attention receive time of i-th reserved slot should be written in *receive_time_usec_array + i
+*/
+extern char *reserve_slots_to_write_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                       unsigned int maximum_number_of_slots,
+                                                       unsigned int *number_of_reserved_slots,
+                                                       int **data_length_array,
+                                                       double **receive_time_usec_array);
+
+/*!
+  \brief function to publish written slots to consumer (producer only)
+  \attention consumer waiting in wait_for_packets_in_packet_ring_buffer is woken up
+*/
+extern void commit_written_slots_of_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                       unsigned int number_of_written_slots);
+
+/*!
+  \brief function to count packets dropped outside of ring (producer only)
+  \attention this function is used to count new packets which are dropped on PACKET_RING_DROP_NEWEST
+*/
+extern void count_dropped_packets_of_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                        unsigned int number_of_dropped_packets);
+
+/*!
+  \brief function to push one packet (producer only)
+  \attention this function returns false if packet is dropped
+*/
+extern bool push_packet_to_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                              const char *packet, unsigned int packet_length,
+                                              double receive_time_usec);
+
+/*!
+  \brief function to pop oldest packet (consumer only)
+  \attention this function returns false if ring is empty
+  \attention this function copies packet to destination buffer, because slot may be overwritten on PACKET_RING_DROP_OLDEST
+  \attention packet_length is -1 if packet is longer than destination_buffer_length (or its receiving failed)
+*/
+extern bool pop_packet_from_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                               char *destination_buffer, unsigned int destination_buffer_length,
+                                               int *packet_length, double *receive_time_usec);
+
+/*!
+  \brief function to wait until packets are published (consumer only)
+  \attention this function returns false if no packet arrives in wait_timeout_usec (wait_timeout_usec < 0 means infinite)
+  \attention consumer sleeps on condition variable instead of polling ring
+  \attention timeout is measured with CLOCK_MONOTONIC, and it is not changed by step of wall clock
+*/
+extern bool wait_for_packets_in_packet_ring_buffer(packet_ring_buffer_t *ring, int wait_timeout_usec);
+
+/*!
+  \brief function to hold oldest slots to read packets in place (consumer only)
+  \return pointer to first held slot (NULL if ring is empty)
+  \attention held slots are continuous in memory, and number of them is stored in number_of_held_slots
+  \attention maximum_number_of_slots is limited to maximum_number_of_held_slots of ring
+  \attention held slots are not overwritten by producer until release_held_slots_of_packet_ring_buffer
+  \attention slots held before are released in this function
+*/
+extern const char *hold_slots_to_read_packet_ring_buffer(packet_ring_buffer_t *ring,
+                                                         unsigned int maximum_number_of_slots,
+                                                         unsigned int *number_of_held_slots,
+                                                         const int **data_length_array,
+                                                         const double **receive_time_usec_array);
+
+/*!
+  \brief function to release held slots to producer (consumer only)
+  \attention held slots should be released as soon as their packets are decoded
+*/
+extern void release_held_slots_of_packet_ring_buffer(packet_ring_buffer_t *ring);
+
+#endif // PACKET_RING_CONTROL_H
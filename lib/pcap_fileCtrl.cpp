@@ -0,0 +1,400 @@
+
+#include "pcap_fileCtrl.h"
+
+// for malloc/free
+#include <stdlib.h>
+
+//! magic number of microsecond resolution file
+static const unsigned int PCAP_FILE_MAGIC_NUMBER_MICROSECOND = 0xa1b2c3d4;
+
+//! magic number of nanosecond resolution file
+static const unsigned int PCAP_FILE_MAGIC_NUMBER_NANOSECOND = 0xa1b23c4d;
+
+//! constants for packet headers in pcap record
+enum PCAP_FILE_PACKET_HEADER_CONSTANT {
+
+    //! length of ethernet header [byte]
+    PCAP_FILE_ETHERNET_HEADER_LENGTH = 14,
+
+    //! length of vlan tag [byte]
+    PCAP_FILE_VLAN_TAG_LENGTH = 4,
+
+    //! length of BSD loopback header [byte]
+    PCAP_FILE_NULL_HEADER_LENGTH = 4,
+
+    //! length of linux cooked header [byte]
+    PCAP_FILE_LINUX_SLL_HEADER_LENGTH = 16,
+
+    //! length of linux cooked header v2 [byte]
+    PCAP_FILE_LINUX_SLL2_HEADER_LENGTH = 20,
+
+    //! ethernet type of ipv4
+    PCAP_FILE_ETHERNET_TYPE_IPV4 = 0x0800,
+
+    //! ethernet type of vlan tag
+    PCAP_FILE_ETHERNET_TYPE_VLAN = 0x8100,
+
+    //! address family of ipv4 in BSD loopback header
+    PCAP_FILE_NULL_ADDRESS_FAMILY_IPV4 = 2,
+
+    //! minimum length of ipv4 header [byte]
+    PCAP_FILE_IPV4_MINIMUM_HEADER_LENGTH = 20,
+
+    //! protocol number of udp
+    PCAP_FILE_IPV4_PROTOCOL_UDP = 17,
+
+    //! mask of more fragments flag and fragment offset
+    PCAP_FILE_IPV4_FRAGMENT_MASK = 0x3fff,
+
+    //! length of udp header [byte]
+    PCAP_FILE_UDP_HEADER_LENGTH = 8,
+
+};
+
+static unsigned int get_big_endian_16bit_value(const unsigned char *data)
+{
+    return ((unsigned int)data[0] << 8) | (unsigned int)data[1];
+}
+
+static unsigned int get_file_order_32bit_value(const pcap_file_reader_t *reader,
+                                               const unsigned char *data)
+{
+    if (reader->byte_swapped == true) {
+        return ((unsigned int)data[0] << 24) | ((unsigned int)data[1] << 16) |
+            ((unsigned int)data[2] << 8) | (unsigned int)data[3];
+    }
+
+    return ((unsigned int)data[3] << 24) | ((unsigned int)data[2] << 16) |
+        ((unsigned int)data[1] << 8) | (unsigned int)data[0];
+}
+
+void clear_pcap_file_reader(pcap_file_reader_t *reader)
+{
+    reader->file = NULL;
+
+    reader->byte_swapped = false;
+    reader->nanosecond_resolution = false;
+    reader->link_type = PCAP_FILE_LINK_TYPE_ETHERNET;
+    reader->destination_port = PCAP_FILE_ANY_DESTINATION_PORT;
+
+    reader->record_buffer = NULL;
+    reader->record_buffer_length = 0;
+
+    reader->payload = NULL;
+    reader->payload_length = PCAP_FILE_INVALID_PAYLOAD_LENGTH;
+
+    reader->captured_time_sec = 0;
+    reader->captured_time_usec = 0;
+
+    reader->number_of_records = 0;
+    reader->number_of_skipped_records = 0;
+
+    reader->end_of_file_reached = false;
+
+    return;
+}
+
+static bool is_supported_link_type_of_pcap_file(unsigned int link_type)
+{
+    switch (link_type) {
+
+        case PCAP_FILE_LINK_TYPE_NULL:
+        case PCAP_FILE_LINK_TYPE_ETHERNET:
+        case PCAP_FILE_LINK_TYPE_RAW:
+        case PCAP_FILE_LINK_TYPE_LINUX_SLL:
+        case PCAP_FILE_LINK_TYPE_LINUX_SLL2:
+            return true;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+static bool read_global_header_of_pcap_file(pcap_file_reader_t *reader)
+{
+    unsigned char header[PCAP_FILE_GLOBAL_HEADER_LENGTH];
+
+    if (fread(header, 1, PCAP_FILE_GLOBAL_HEADER_LENGTH, reader->file) != PCAP_FILE_GLOBAL_HEADER_LENGTH) {
+        return false;
+    }
+
+    // magic number is written in byte order of capturing host
+    const unsigned int little_endian_magic_number =
+        ((unsigned int)header[3] << 24) | ((unsigned int)header[2] << 16) |
+        ((unsigned int)header[1] << 8) | (unsigned int)header[0];
+
+    const unsigned int big_endian_magic_number =
+        ((unsigned int)header[0] << 24) | ((unsigned int)header[1] << 16) |
+        ((unsigned int)header[2] << 8) | (unsigned int)header[3];
+
+    if ((little_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_MICROSECOND) ||
+        (little_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_NANOSECOND)) {
+
+        reader->byte_swapped = false;
+        reader->nanosecond_resolution =
+            (little_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_NANOSECOND);
+
+    } else if ((big_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_MICROSECOND) ||
+               (big_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_NANOSECOND)) {
+
+        reader->byte_swapped = true;
+        reader->nanosecond_resolution =
+            (big_endian_magic_number == PCAP_FILE_MAGIC_NUMBER_NANOSECOND);
+
+    } else {
+        return false;
+    }
+
+    // link type is lower 16 bits (upper bits are used for FCS information)
+    reader->link_type = get_file_order_32bit_value(reader, &header[20]) & 0xffff;
+
+    if (is_supported_link_type_of_pcap_file(reader->link_type) == false) {
+        return false;
+    }
+
+    return true;
+}
+
+bool open_pcap_file(const char *file_path, unsigned short destination_port,
+                    pcap_file_reader_t *reader)
+{
+    if (reader->file != NULL) {
+        return false;
+    }
+
+    clear_pcap_file_reader(reader);
+
+    reader->file = fopen(file_path, "rb");
+    if (reader->file == NULL) {
+        return false;
+    }
+
+    if (read_global_header_of_pcap_file(reader) == false) {
+        close_pcap_file(reader);
+        return false;
+    }
+
+    reader->record_buffer =
+        (unsigned char *)malloc(PCAP_FILE_MAXIMUM_RECORD_LENGTH);
+
+    if (reader->record_buffer == NULL) {
+        close_pcap_file(reader);
+        return false;
+    }
+    reader->record_buffer_length = PCAP_FILE_MAXIMUM_RECORD_LENGTH;
+
+    reader->destination_port = destination_port;
+
+    return true;
+}
+
+void close_pcap_file(pcap_file_reader_t *reader)
+{
+    if (reader->file != NULL) {
+        fclose(reader->file);
+    }
+
+    if (reader->record_buffer != NULL) {
+        free((void *)reader->record_buffer);
+    }
+
+    clear_pcap_file_reader(reader);
+
+    return;
+}
+
+bool rewind_pcap_file(pcap_file_reader_t *reader)
+{
+    if (reader->file == NULL) {
+        return false;
+    }
+
+    if (fseek(reader->file, PCAP_FILE_GLOBAL_HEADER_LENGTH, SEEK_SET) != 0) {
+        return false;
+    }
+
+    reader->payload = NULL;
+    reader->payload_length = PCAP_FILE_INVALID_PAYLOAD_LENGTH;
+    reader->end_of_file_reached = false;
+
+    return true;
+}
+
+static bool get_ipv4_packet_of_pcap_record(const pcap_file_reader_t *reader,
+                                           const unsigned char *record, unsigned int record_length,
+                                           const unsigned char **ip_packet, unsigned int *ip_packet_length)
+{
+    unsigned int header_length = 0;
+    bool ipv4_packet = false;
+
+    switch (reader->link_type) {
+
+        case PCAP_FILE_LINK_TYPE_NULL:
+            header_length = PCAP_FILE_NULL_HEADER_LENGTH;
+            if (record_length >= header_length) {
+                // address family is written in byte order of capturing host
+                ipv4_packet =
+                    (get_file_order_32bit_value(reader, record) == PCAP_FILE_NULL_ADDRESS_FAMILY_IPV4);
+            }
+            break;
+
+        case PCAP_FILE_LINK_TYPE_ETHERNET:
+            header_length = PCAP_FILE_ETHERNET_HEADER_LENGTH;
+            if (record_length < header_length) {
+                break;
+            }
+            if ((get_big_endian_16bit_value(&record[12]) == PCAP_FILE_ETHERNET_TYPE_VLAN) &&
+                (record_length >= header_length + PCAP_FILE_VLAN_TAG_LENGTH)) {
+                header_length += PCAP_FILE_VLAN_TAG_LENGTH;
+            }
+            ipv4_packet =
+                (get_big_endian_16bit_value(&record[header_length - 2]) == PCAP_FILE_ETHERNET_TYPE_IPV4);
+            break;
+
+        case PCAP_FILE_LINK_TYPE_RAW:
+            header_length = 0;
+            ipv4_packet = ((record_length > 0) && ((record[0] >> 4) == 4));
+            break;
+
+        case PCAP_FILE_LINK_TYPE_LINUX_SLL:
+            header_length = PCAP_FILE_LINUX_SLL_HEADER_LENGTH;
+            if (record_length >= header_length) {
+                ipv4_packet =
+                    (get_big_endian_16bit_value(&record[14]) == PCAP_FILE_ETHERNET_TYPE_IPV4);
+            }
+            break;
+
+        case PCAP_FILE_LINK_TYPE_LINUX_SLL2:
+            header_length = PCAP_FILE_LINUX_SLL2_HEADER_LENGTH;
+            if (record_length >= header_length) {
+                ipv4_packet =
+                    (get_big_endian_16bit_value(&record[0]) == PCAP_FILE_ETHERNET_TYPE_IPV4);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (ipv4_packet == false) {
+        return false;
+    }
+
+    *ip_packet = record + header_length;
+    *ip_packet_length = record_length - header_length;
+
+    return true;
+}
+
+static bool get_udp_payload_of_ipv4_packet(const pcap_file_reader_t *reader,
+                                           const unsigned char *ip_packet, unsigned int ip_packet_length,
+                                           const char **payload, int *payload_length)
+{
+    if (ip_packet_length < PCAP_FILE_IPV4_MINIMUM_HEADER_LENGTH) {
+        return false;
+    }
+
+    if ((ip_packet[0] >> 4) != 4) {
+        return false;
+    }
+
+    const unsigned int ip_header_length = (unsigned int)(ip_packet[0] & 0x0f) * 4;
+
+    if ((ip_header_length < PCAP_FILE_IPV4_MINIMUM_HEADER_LENGTH) ||
+        (ip_packet_length < ip_header_length + PCAP_FILE_UDP_HEADER_LENGTH)) {
+        return false;
+    }
+
+    if (ip_packet[9] != PCAP_FILE_IPV4_PROTOCOL_UDP) {
+        return false;
+    }
+
+    // fragments are not reassembled
+    if ((get_big_endian_16bit_value(&ip_packet[6]) & PCAP_FILE_IPV4_FRAGMENT_MASK) != 0) {
+        return false;
+    }
+
+    const unsigned char *udp_header = ip_packet + ip_header_length;
+
+    if ((reader->destination_port != PCAP_FILE_ANY_DESTINATION_PORT) &&
+        (get_big_endian_16bit_value(&udp_header[2]) != reader->destination_port)) {
+        return false;
+    }
+
+    const unsigned int udp_length = get_big_endian_16bit_value(&udp_header[4]);
+
+    // truncated packet (snapshot length is shorter than packet)
+    if ((udp_length < PCAP_FILE_UDP_HEADER_LENGTH) ||
+        (ip_packet_length < ip_header_length + udp_length)) {
+        return false;
+    }
+
+    *payload = (const char *)(udp_header + PCAP_FILE_UDP_HEADER_LENGTH);
+    *payload_length = (int)(udp_length - PCAP_FILE_UDP_HEADER_LENGTH);
+
+    return true;
+}
+
+bool read_next_udp_packet_of_pcap_file(pcap_file_reader_t *reader)
+{
+    reader->payload = NULL;
+    reader->payload_length = PCAP_FILE_INVALID_PAYLOAD_LENGTH;
+
+    if ((reader->file == NULL) || (reader->end_of_file_reached == true)) {
+        return false;
+    }
+
+    unsigned char record_header[PCAP_FILE_RECORD_HEADER_LENGTH];
+
+    const unsigned char *ip_packet = NULL;
+    unsigned int ip_packet_length = 0;
+
+    while (1) {
+
+        if (fread(record_header, 1, PCAP_FILE_RECORD_HEADER_LENGTH, reader->file) != PCAP_FILE_RECORD_HEADER_LENGTH) {
+            reader->end_of_file_reached = true;
+            return false;
+        }
+
+        const unsigned int captured_length = get_file_order_32bit_value(reader, &record_header[8]);
+
+        if (captured_length > reader->record_buffer_length) {
+            reader->end_of_file_reached = true;
+            return false;
+        }
+
+        if (fread(reader->record_buffer, 1, captured_length, reader->file) != captured_length) {
+            reader->end_of_file_reached = true;
+            return false;
+        }
+        ++reader->number_of_records;
+
+        if ((get_ipv4_packet_of_pcap_record(reader, reader->record_buffer, captured_length,
+                                            &ip_packet, &ip_packet_length) == false) ||
+            (get_udp_payload_of_ipv4_packet(reader, ip_packet, ip_packet_length,
+                                            &reader->payload, &reader->payload_length) == false)) {
+            ++reader->number_of_skipped_records;
+            continue;
+        }
+
+        break;
+    }
+
+    reader->captured_time_sec = get_file_order_32bit_value(reader, &record_header[0]);
+    reader->captured_time_usec = get_file_order_32bit_value(reader, &record_header[4]);
+
+    if (reader->nanosecond_resolution == true) {
+        reader->captured_time_usec /= 1000;
+    }
+
+    return true;
+}
+
+double calculate_captured_time_difference_usec(unsigned int start_time_sec, unsigned int start_time_usec,
+                                               unsigned int end_time_sec, unsigned int end_time_usec)
+{
+    return ((double)end_time_sec - (double)start_time_sec) * 1000000.0 +
+        ((double)end_time_usec - (double)start_time_usec);
+}
@@ -0,0 +1,138 @@
+#ifndef PCAP_FILE_CONTROL_H
+#define PCAP_FILE_CONTROL_H
+/*!
+  \file
+  \brief functions to read udp payloads from libpcap capture file (without libpcap)
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+// for FILE
+#include <stdio.h>
+
+//! constants for pcap file
+enum PCAP_FILE_CONSTANT {
+
+    //! length of global header [byte]
+    PCAP_FILE_GLOBAL_HEADER_LENGTH = 24,
+
+    //! length of record header [byte]
+    PCAP_FILE_RECORD_HEADER_LENGTH = 16,
+
+    //! maximum length of one record [byte]
+    PCAP_FILE_MAXIMUM_RECORD_LENGTH = 262144,
+
+    //! invalid payload length
+    PCAP_FILE_INVALID_PAYLOAD_LENGTH = -1,
+
+    //! any destination port is accepted
+    PCAP_FILE_ANY_DESTINATION_PORT = 0,
+
+};
+
+//! link layer types of pcap file
+enum PCAP_FILE_LINK_TYPE {
+
+    //! BSD loopback
+    PCAP_FILE_LINK_TYPE_NULL = 0,
+
+    //! ethernet
+    PCAP_FILE_LINK_TYPE_ETHERNET = 1,
+
+    //! raw ip
+    PCAP_FILE_LINK_TYPE_RAW = 101,
+
+    //! linux cooked capture
+    PCAP_FILE_LINK_TYPE_LINUX_SLL = 113,
+
+    //! linux cooked capture v2
+    PCAP_FILE_LINK_TYPE_LINUX_SLL2 = 276,
+
+};
+
+//! structure of pcap file reader
+struct pcap_file_reader_t {
+
+    //! file
+    FILE *file;
+
+    //! flag of byte swapped file
+    bool byte_swapped;
+
+    //! flag of nanosecond resolution timestamp
+    bool nanosecond_resolution;
+
+    //! link layer type
+    unsigned int link_type;
+
+    //! destination udp port of reading packets (PCAP_FILE_ANY_DESTINATION_PORT accepts all)
+    unsigned short destination_port;
+
+    //! buffer of one record
+    unsigned char *record_buffer;
+
+    //! length of record_buffer [byte]
+    unsigned int record_buffer_length;
+
+    //! udp payload of last read packet (pointer in record_buffer)
+    const char *payload;
+
+    //! length of payload [byte]
+    int payload_length;
+
+    //! captured time of last read packet [sec]
+    unsigned int captured_time_sec;
+    //! captured time of last read packet [usec]
+    unsigned int captured_time_usec;
+
+    //! number of read records
+    unsigned int number_of_records;
+
+    //! number of skipped records (not udp, other port, fragment or truncated)
+    unsigned int number_of_skipped_records;
+
+    //! flag of end of file
+    bool end_of_file_reached;
+
+};
+
+/*!
+  \brief function to clear pcap file reader
+*/
+extern void clear_pcap_file_reader(pcap_file_reader_t *reader);
+
+/*!
+  \brief function to open pcap file
+  \attention this function returns false if file is not libpcap format or link type is not supported
+  \attention packets of destination_port are read (PCAP_FILE_ANY_DESTINATION_PORT accepts all udp packets)
+*/
+extern bool open_pcap_file(const char *file_path, unsigned short destination_port,
+                           pcap_file_reader_t *reader);
+
+/*!
+  \brief function to close pcap file
+*/
+extern void close_pcap_file(pcap_file_reader_t *reader);
+
+/*!
+  \brief function to rewind pcap file to first record
+*/
+extern bool rewind_pcap_file(pcap_file_reader_t *reader);
+
+/*!
+  \brief function to read next udp packet in pcap file
+  \attention this function returns false on end of file or broken record, and end_of_file_reached is set
+  \attention payload, payload_length and captured time are valid until next call
+  \attention only ipv4 udp packets which are not fragmented are read
+*/
+extern bool read_next_udp_packet_of_pcap_file(pcap_file_reader_t *reader);
+
+/*!
+  \brief function to calculate difference of captured time [usec]
+*/
+extern double calculate_captured_time_difference_usec(unsigned int start_time_sec, unsigned int start_time_usec,
+                                                      unsigned int end_time_sec, unsigned int end_time_usec);
+
+#endif // PCAP_FILE_CONTROL_H
@@ -22,6 +22,14 @@
 // for ioctl
 #include <sys/ioctl.h>
 
+// for recvmmsg
+#include <sys/socket.h>
+
+#endif
+
+#if defined(LINUX_OS)
+// for epoll
+#include <sys/epoll.h>
 #endif
 
 // for errno
@@ -203,6 +211,10 @@ static bool set_block_mode_on_socket_client(socket_client_t *client, bool block_
 {
     //! this function only set receive descriptor (send_file_descriptor for UDP communication is not changed by this function)
 
+    if (client->past_blocking_mode_flag == block_mode) {
+        return true;
+    }
+
     if (block_mode == true) {
 
 #if defined (WINDOWS_OS)
@@ -309,6 +321,8 @@ bool open_socket_for_client(socket_client_t *client)
 	}
 #endif
 
+    client->number_of_dropped_datagrams = 0;
+
     struct sockaddr_in destination_server;
 
     // zero clear
@@ -356,6 +370,7 @@ bool open_socket_for_client(socket_client_t *client)
     descriptor_flag = fcntl(client->file_descriptor, F_GETFL, 0);
     fcntl(client->file_descriptor, F_SETFL, descriptor_flag | O_NONBLOCK);
 #endif
+    client->past_blocking_mode_flag = false;
 
     if (client->protocol == SOCKET_PROTOCOL_UDP) {
 
@@ -398,6 +413,22 @@ bool open_socket_for_client(socket_client_t *client)
             return false;
         }
 
+#if defined(LINUX_OS) && defined(SO_TIMESTAMPNS)
+        // kernel receive time is delivered with received datagrams
+        const int receive_timestamp_on = 1;
+        setsockopt(client->file_descriptor,
+                   SOL_SOCKET, SO_TIMESTAMPNS,
+                   (const void*)&receive_timestamp_on, (socklen_t)sizeof(receive_timestamp_on));
+#endif
+
+#if defined(LINUX_OS) && defined(SO_RXQ_OVFL)
+        // count of datagrams dropped by kernel is delivered with received datagrams
+        const int receive_queue_overflow_on = 1;
+        setsockopt(client->file_descriptor,
+                   SOL_SOCKET, SO_RXQ_OVFL,
+                   (const void*)&receive_queue_overflow_on, (socklen_t)sizeof(receive_queue_overflow_on));
+#endif
+
         client->send_file_descriptor = socket(AF_INET, socket_type, 0);
         if (client->send_file_descriptor < 0) {
             return false;
@@ -516,12 +547,8 @@ int query_readable_byte_size(socket_client_t *client)
 
 }
 
-int receive_data_using_socket_client(socket_client_t *client,
-                                     char *receive_buffer, unsigned int receive_buffer_size,
-                                     int timeout_usec)
+bool wait_until_socket_client_is_readable(socket_client_t *client, int timeout_usec)
 {
-    int received_size = -1;
-
     struct timeval timeout_value;
     fd_set receive_checking_file_descriptors;
     int return_of_select = 0;
@@ -538,7 +565,7 @@ int receive_data_using_socket_client(socket_client_t *client,
                    &timeout_value);
 
         if (return_of_select <= 0) {
-            return received_size;
+            return false;
         }
 
         set_block_mode_on_socket_client(client, false);
@@ -549,11 +576,344 @@ int receive_data_using_socket_client(socket_client_t *client,
 
     }
 
+    return true;
+}
+
+int receive_data_using_socket_client(socket_client_t *client,
+                                     char *receive_buffer, unsigned int receive_buffer_size,
+                                     int timeout_usec)
+{
+    int received_size = -1;
+
+    if (wait_until_socket_client_is_readable(client, timeout_usec) == false) {
+        return received_size;
+    }
+
     received_size = recv(client->file_descriptor, receive_buffer, receive_buffer_size, 0);
 
     return received_size;
 }
 
+#if defined(LINUX_OS)
+static double read_control_messages_of_datagram(socket_client_t *client, struct msghdr *message)
+{
+    double receive_time_usec = 0.0;
+
+    for (struct cmsghdr *control_message = CMSG_FIRSTHDR(message); control_message != NULL;
+         control_message = CMSG_NXTHDR(message, control_message)) {
+
+        if (control_message->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+
+#if defined(SO_TIMESTAMPNS)
+        if (control_message->cmsg_type == SCM_TIMESTAMPNS) {
+
+            struct timespec receive_time;
+            memcpy((void *)&receive_time, (const void *)CMSG_DATA(control_message), sizeof(receive_time));
+
+            receive_time_usec = (double)receive_time.tv_sec * 1000000.0 + (double)receive_time.tv_nsec * 0.001;
+        }
+#endif
+
+#if defined(SO_RXQ_OVFL)
+        //! kernel delivers cumulative number of dropped datagrams with each datagram
+        if (control_message->cmsg_type == SO_RXQ_OVFL) {
+
+            unsigned int number_of_dropped_datagrams = 0;
+            memcpy((void *)&number_of_dropped_datagrams, (const void *)CMSG_DATA(control_message),
+                   sizeof(number_of_dropped_datagrams));
+            client->number_of_dropped_datagrams = number_of_dropped_datagrams;
+        }
+#endif
+    }
+
+    return receive_time_usec;
+}
+#endif
+
+static int receive_datagrams_from_readable_socket_client(socket_client_t *client,
+                                                         char *receive_buffer, unsigned int datagram_slot_length_byte,
+                                                         unsigned int maximum_number_of_datagrams,
+                                                         int *received_length_array, double *receive_time_usec_array)
+{
+    int number_of_received_datagrams = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+#if defined(LINUX_OS)
+    struct mmsghdr messages[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE];
+    struct iovec vectors[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE];
+    // control message buffer is aligned for cmsghdr
+    size_t control_message_buffer[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE]
+        [SOCKET_CLIENT_CONTROL_MESSAGE_BUFFER_LENGTH / sizeof(size_t)];
+
+    memset(messages, 0, maximum_number_of_datagrams * sizeof(struct mmsghdr));
+
+    for (unsigned int i = 0; i < maximum_number_of_datagrams; ++i) {
+
+        vectors[i].iov_base = receive_buffer + i * datagram_slot_length_byte;
+        vectors[i].iov_len = datagram_slot_length_byte;
+
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+
+        messages[i].msg_hdr.msg_control = control_message_buffer[i];
+        messages[i].msg_hdr.msg_controllen = SOCKET_CLIENT_CONTROL_MESSAGE_BUFFER_LENGTH;
+    }
+
+    // MSG_WAITFORONE: only first datagram is awaited in block mode
+    number_of_received_datagrams =
+        recvmmsg(client->file_descriptor, messages, maximum_number_of_datagrams,
+                 MSG_WAITFORONE, NULL);
+
+    // time of datagram without kernel timestamp
+    double host_receive_time_usec = 0.0;
+    if (number_of_received_datagrams > 0) {
+        host_receive_time_usec = GetNowRealTimeMicroSec();
+    }
+
+    for (int i = 0; i < number_of_received_datagrams; ++i) {
+
+        if ((messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+            received_length_array[i] = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+        } else {
+            received_length_array[i] = (int)messages[i].msg_len;
+        }
+
+        const double receive_time_usec = read_control_messages_of_datagram(client, &messages[i].msg_hdr);
+
+        if (receive_time_usec_array != NULL) {
+            receive_time_usec_array[i] = (receive_time_usec > 0.0) ? receive_time_usec : host_receive_time_usec;
+        }
+    }
+
+#else
+    int received_size = recv(client->file_descriptor, receive_buffer, datagram_slot_length_byte, 0);
+
+    if (received_size < 0) {
+        return number_of_received_datagrams;
+    }
+
+    received_length_array[0] = received_size;
+    if (receive_time_usec_array != NULL) {
+        receive_time_usec_array[0] = GetNowRealTimeMicroSec();
+    }
+    number_of_received_datagrams = 1;
+
+    // receive remaining datagrams without waiting
+    set_block_mode_on_socket_client(client, false);
+
+    for (unsigned int i = 1; i < maximum_number_of_datagrams; ++i) {
+
+        received_size = recv(client->file_descriptor, receive_buffer + i * datagram_slot_length_byte,
+                             datagram_slot_length_byte, 0);
+
+        if (received_size < 0) {
+            break;
+        }
+
+        received_length_array[i] = received_size;
+        if (receive_time_usec_array != NULL) {
+            receive_time_usec_array[i] = GetNowRealTimeMicroSec();
+        }
+        ++number_of_received_datagrams;
+    }
+#endif
+
+    if (number_of_received_datagrams <= 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    return number_of_received_datagrams;
+}
+
+int receive_datagrams_using_socket_client(socket_client_t *client,
+                                          char *receive_buffer, unsigned int datagram_slot_length_byte,
+                                          unsigned int maximum_number_of_datagrams,
+                                          int *received_length_array, double *receive_time_usec_array,
+                                          int timeout_usec)
+{
+    int number_of_received_datagrams = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+    if (maximum_number_of_datagrams == 0) {
+        return number_of_received_datagrams;
+    }
+
+    if (maximum_number_of_datagrams > SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE) {
+        maximum_number_of_datagrams = SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE;
+    }
+
+    if (wait_until_socket_client_is_readable(client, timeout_usec) == false) {
+        return number_of_received_datagrams;
+    }
+
+    return receive_datagrams_from_readable_socket_client(client, receive_buffer, datagram_slot_length_byte,
+                                                         maximum_number_of_datagrams, received_length_array,
+                                                         receive_time_usec_array);
+}
+
+int receive_ready_datagrams_using_socket_client(socket_client_t *client,
+                                                char *receive_buffer, unsigned int datagram_slot_length_byte,
+                                                unsigned int maximum_number_of_datagrams,
+                                                int *received_length_array, double *receive_time_usec_array)
+{
+    if (maximum_number_of_datagrams == 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    if (maximum_number_of_datagrams > SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE) {
+        maximum_number_of_datagrams = SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE;
+    }
+
+    // readiness is already known, and receiving must not block
+    set_block_mode_on_socket_client(client, false);
+
+    return receive_datagrams_from_readable_socket_client(client, receive_buffer, datagram_slot_length_byte,
+                                                         maximum_number_of_datagrams, received_length_array,
+                                                         receive_time_usec_array);
+}
+
+void initialize_socket_client_poller(socket_client_poller_t *poller)
+{
+    poller->file_descriptor = SOCKET_CLIENT_INVALID_FILE_DESCRIPTOR;
+    poller->number_of_clients = 0;
+
+    for (unsigned int i = 0; i < SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS; ++i) {
+        poller->client[i] = NULL;
+    }
+
+    return;
+}
+
+bool open_socket_client_poller(socket_client_poller_t *poller)
+{
+    close_socket_client_poller(poller);
+
+#if defined(LINUX_OS)
+    poller->file_descriptor = epoll_create(SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS);
+    if (poller->file_descriptor < 0) {
+        poller->file_descriptor = SOCKET_CLIENT_INVALID_FILE_DESCRIPTOR;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+void close_socket_client_poller(socket_client_poller_t *poller)
+{
+#if defined(LINUX_OS)
+    if (poller->file_descriptor >= 0) {
+        close(poller->file_descriptor);
+    }
+#endif
+
+    initialize_socket_client_poller(poller);
+
+    return;
+}
+
+int add_socket_client_to_poller(socket_client_poller_t *poller, socket_client_t *client)
+{
+    if ((poller->number_of_clients >= SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS) ||
+        (client->file_descriptor < 0)) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    const unsigned int client_index = poller->number_of_clients;
+
+#if defined(LINUX_OS)
+    if (poller->file_descriptor < 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    // level triggered: client which is not drained in one turn is reported again
+    event.events = EPOLLIN;
+    event.data.u32 = client_index;
+
+    if (epoll_ctl(poller->file_descriptor, EPOLL_CTL_ADD, client->file_descriptor, &event) != 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+#endif
+
+    poller->client[client_index] = client;
+    ++poller->number_of_clients;
+
+    return (int)client_index;
+}
+
+int wait_for_readable_socket_clients(socket_client_poller_t *poller, int timeout_usec,
+                                     unsigned int *readable_client_index_array)
+{
+    if (poller->number_of_clients == 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    int number_of_readable_clients = 0;
+
+#if defined(LINUX_OS)
+    struct epoll_event events[SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS];
+
+    // epoll_wait waits in unit of millisecond (shorter timeout is rounded up)
+    int timeout_msec = -1;
+    if (timeout_usec >= 0) {
+        timeout_msec = (timeout_usec + 999) / 1000;
+    }
+
+    number_of_readable_clients =
+        epoll_wait(poller->file_descriptor, events, (int)poller->number_of_clients, timeout_msec);
+
+    if (number_of_readable_clients < 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    for (int i = 0; i < number_of_readable_clients; ++i) {
+        readable_client_index_array[i] = events[i].data.u32;
+    }
+
+#else
+    fd_set receive_checking_file_descriptors;
+    FD_ZERO(&receive_checking_file_descriptors);
+
+    int maximum_file_descriptor = 0;
+    for (unsigned int i = 0; i < poller->number_of_clients; ++i) {
+
+        FD_SET(poller->client[i]->file_descriptor, &receive_checking_file_descriptors);
+
+        if (poller->client[i]->file_descriptor > maximum_file_descriptor) {
+            maximum_file_descriptor = poller->client[i]->file_descriptor;
+        }
+    }
+
+    struct timeval timeout_value;
+    struct timeval *timeout_pointer = NULL;
+    if (timeout_usec >= 0) {
+        timeout_value.tv_sec = timeout_usec / 1000000;
+        timeout_value.tv_usec = timeout_usec % 1000000;
+        timeout_pointer = &timeout_value;
+    }
+
+    const int return_of_select =
+        select(maximum_file_descriptor + 1, &receive_checking_file_descriptors, NULL, NULL,
+               timeout_pointer);
+
+    if (return_of_select < 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    for (unsigned int i = 0; i < poller->number_of_clients; ++i) {
+
+        if (FD_ISSET(poller->client[i]->file_descriptor, &receive_checking_file_descriptors)) {
+            readable_client_index_array[number_of_readable_clients] = i;
+            ++number_of_readable_clients;
+        }
+    }
+#endif
+
+    return number_of_readable_clients;
+}
+
 int send_data_using_socket_client(socket_client_t *client,
                                   const char *send_buffer, unsigned int send_buffer_size,
                                   int timeout_usec)
@@ -592,6 +952,74 @@ int send_data_using_socket_client(socket_client_t *client,
     return sended_size;
 }
 
+/*!
+  \brief function to receive data in empty regions of circular receive buffer directly
+  \attention datagram is received in two empty regions at once (scatter read), when empty region is split at the end of buffer
+  \attention on windows, only first empty region is used
+*/
+static int receive_data_to_circular_buffer_using_socket_client(socket_client_t *client,
+                                                               unsigned int maximum_receive_length_byte,
+                                                               int timeout_usec,
+                                                               unsigned int *captured_data_length)
+{
+    char *first_region = NULL;
+    unsigned int first_region_length = 0;
+    char *second_region = NULL;
+    unsigned int second_region_length = 0;
+
+    get_empty_regions_of_circular_buffer(&client->buffer,
+                                         &first_region, &first_region_length,
+                                         &second_region, &second_region_length);
+
+    if (maximum_receive_length_byte <= first_region_length) {
+        first_region_length = maximum_receive_length_byte;
+        second_region_length = 0;
+    } else if (maximum_receive_length_byte < first_region_length + second_region_length) {
+        second_region_length = maximum_receive_length_byte - first_region_length;
+    }
+
+    int received_size = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+#if defined(WINDOWS_OS)
+    second_region_length = 0;
+#endif
+
+    if (second_region_length == 0) {
+
+        received_size =
+            receive_data_using_socket_client(client, first_region, first_region_length, timeout_usec);
+
+    } else {
+
+#if !defined(WINDOWS_OS)
+        if (wait_until_socket_client_is_readable(client, timeout_usec) == false) {
+            return received_size;
+        }
+
+        struct iovec vectors[2];
+        vectors[0].iov_base = first_region;
+        vectors[0].iov_len = first_region_length;
+        vectors[1].iov_base = second_region;
+        vectors[1].iov_len = second_region_length;
+
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = vectors;
+        message.msg_iovlen = 2;
+
+        received_size = recvmsg(client->file_descriptor, &message, 0);
+#endif
+
+    }
+
+    if (received_size > 0) {
+        *captured_data_length =
+            move_destination_point_of_circular_buffer(&client->buffer, (unsigned int)received_size);
+    }
+
+    return received_size;
+}
+
 int receive_constant_length_data(socket_client_t *client, int receive_timeout_usec,
                                  unsigned int data_length_byte, char *destination_buffer,
                                  unsigned int onetime_receive_length_byte,
@@ -623,28 +1051,10 @@ int receive_constant_length_data(socket_client_t *client, int receive_timeout_us
         receive_length_byte = client->buffer.empty_buffer_length_byte;
     }
 
-    char *temporal_buffer = NULL;
-
-    temporal_buffer = (char *)malloc(receive_length_byte * sizeof(char));
-
-    if (temporal_buffer == NULL) {
-        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
-    }
-
     received_size =
-        receive_data_using_socket_client(client, temporal_buffer,
-                                         receive_length_byte,
-                                         receive_timeout_usec);
-
-    if (received_size > 0) {
-
-        *captured_data_length =
-            copy_byte_to_circular_buffer(temporal_buffer, (unsigned int)received_size,
-                                         &client->buffer);
-
-    }
-
-    free(temporal_buffer);
+        receive_data_to_circular_buffer_using_socket_client(client, receive_length_byte,
+                                                            receive_timeout_usec,
+                                                            captured_data_length);
 
     remaining_data_length =
         calculate_remaining_data_length(&client->buffer);
@@ -675,14 +1085,6 @@ int receive_code_tailed_message(socket_client_t *client, int receive_timeout_use
     const unsigned int empty_buffer_length =
         get_length_of_empty_data_buffer(&client->buffer);
 
-    char *temporal_buffer = NULL;
-
-    temporal_buffer = (char *)malloc(empty_buffer_length * sizeof(char));
-
-    if (temporal_buffer == NULL) {
-        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
-    }
-
     int actual_receive_timeout_usec = receive_timeout_usec;
     const unsigned int remaining_data_length =
         calculate_remaining_data_length(&client->buffer);
@@ -692,19 +1094,9 @@ int receive_code_tailed_message(socket_client_t *client, int receive_timeout_use
     }
 
     received_size =
-        receive_data_using_socket_client(client, temporal_buffer,
-                                         empty_buffer_length,
-                                         actual_receive_timeout_usec);
-
-    if (received_size > 0) {
-
-        *captured_data_length =
-            copy_byte_to_circular_buffer(temporal_buffer, (unsigned int)received_size,
-                                         &client->buffer);
-
-    }
-
-    free(temporal_buffer);
+        receive_data_to_circular_buffer_using_socket_client(client, empty_buffer_length,
+                                                            actual_receive_timeout_usec,
+                                                            captured_data_length);
 
     *destination_copied_data_length =
         copy_first_tailed_byte_array_from_circular_buffer(&client->buffer,
@@ -39,6 +39,15 @@ enum SOCKET_CLIENT_CONSTANT {
 
     //! length of exceptional ip address of inet_addr
     LENGTH_OF_EXCEPTIONAL_IP_ADDRESS_STRING = 15,
+
+    //! maximum number of datagrams received by one system call
+    SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE = 64,
+
+    //! maximum number of socket clients watched by one poller
+    SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS = 64,
+
+    //! length of control message buffer for one datagram [byte]
+    SOCKET_CLIENT_CONTROL_MESSAGE_BUFFER_LENGTH = 64,
 };
 
 //! exceptional ip address of inet_addr
@@ -96,6 +105,24 @@ struct socket_client_t {
     //! receive circular buffer
     circular_buffer_t buffer;
 
+    //! number of datagrams dropped by kernel since opening (receive queue overflow, Linux OS only)
+    //! \attention drops are reported by kernel with datagram received after them
+    unsigned int number_of_dropped_datagrams;
+
+};
+
+//! structure to wait for readable socket clients in one thread
+struct socket_client_poller_t {
+
+    //! file descriptor of epoll (Linux OS)
+    int file_descriptor;
+
+    //! watched socket clients
+    socket_client_t *client[SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS];
+
+    //! number of watched socket clients
+    unsigned int number_of_clients;
+
 };
 
 /*!
@@ -153,6 +180,13 @@ extern void release_winsock2_dynamic_link_library(void);
 */
 extern int query_readable_byte_size(socket_client_t *client);
 
+/*!
+  \brief function to wait until data can be received
+  \attention this function does not wait if timeout_usec < 0, and set block mode on receiving
+  \attention this function returns false if timeout occurs
+*/
+extern bool wait_until_socket_client_is_readable(socket_client_t *client, int timeout_usec);
+
 /*!
   \brief function to receive data
 */
@@ -161,6 +195,66 @@ extern int receive_data_using_socket_client(socket_client_t *client,
                                             unsigned int receive_buffer_size,
                                             int timeout_usec);
 
+/*!
+  \brief function to receive datagrams at once
+  \return number of received datagrams (SOCKET_CLIENT_INVALID_RETURN_VALUE if no datagram is received)
+  \attention this function uses recvmmsg on Linux OS, and repeats recv on other OS
+  \attention i-th datagram is stored at receive_buffer + i * datagram_slot_length_byte, and its length is stored at received_length_array[i]
+  \attention received_length_array[i] is SOCKET_CLIENT_INVALID_RETURN_VALUE if i-th datagram is longer than datagram_slot_length_byte
+  \attention receive time of i-th datagram is stored at receive_time_usec_array[i] if receive_time_usec_array is not NULL
+  \attention receive time is kernel receive timestamp (SO_TIMESTAMPNS) on Linux OS, and time after receiving on other OS (GetNowRealTimeMicroSec)
+  \attention maximum_number_of_datagrams is limited to SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE
+*/
+extern int receive_datagrams_using_socket_client(socket_client_t *client,
+                                                 char *receive_buffer, unsigned int datagram_slot_length_byte,
+                                                 unsigned int maximum_number_of_datagrams,
+                                                 int *received_length_array, double *receive_time_usec_array,
+                                                 int timeout_usec);
+
+/*!
+  \brief function to receive datagrams at once from socket client which is known to be readable
+  \return number of received datagrams (SOCKET_CLIENT_INVALID_RETURN_VALUE if no datagram is received)
+  \attention this function does not wait, and it is used after wait_for_readable_socket_clients
+  \attention arguments are same as receive_datagrams_using_socket_client
+*/
+extern int receive_ready_datagrams_using_socket_client(socket_client_t *client,
+                                                       char *receive_buffer, unsigned int datagram_slot_length_byte,
+                                                       unsigned int maximum_number_of_datagrams,
+                                                       int *received_length_array, double *receive_time_usec_array);
+
+/*!
+  \brief function to initialize poller of socket clients
+  \attention this function should be used before opening
+*/
+extern void initialize_socket_client_poller(socket_client_poller_t *poller);
+
+/*!
+  \brief function to open poller of socket clients
+  \attention this function uses epoll on Linux OS, and select on other OS
+*/
+extern bool open_socket_client_poller(socket_client_poller_t *poller);
+
+/*!
+  \brief function to close poller of socket clients
+  \attention watched socket clients are not closed
+*/
+extern void close_socket_client_poller(socket_client_poller_t *poller);
+
+/*!
+  \brief function to add opened socket client to poller
+  \return index of client in poller (SOCKET_CLIENT_INVALID_RETURN_VALUE on failure)
+*/
+extern int add_socket_client_to_poller(socket_client_poller_t *poller, socket_client_t *client);
+
+/*!
+  \brief function to wait until some of socket clients in poller are readable
+  \return number of readable clients (0 on timeout, SOCKET_CLIENT_INVALID_RETURN_VALUE on error)
+  \attention indexes of readable clients are stored in readable_client_index_array (length of SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS)
+  \attention this function waits without timeout if timeout_usec < 0
+*/
+extern int wait_for_readable_socket_clients(socket_client_poller_t *poller, int timeout_usec,
+                                            unsigned int *readable_client_index_array);
+
 /*!
   \brief function to send data
 */
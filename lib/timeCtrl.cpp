@@ -23,12 +23,161 @@
 // include for ulseep
 #include <unistd.h>
 
+// include for EINTR
+#include <errno.h>
+
+#endif
+
+#if defined(LINUX_OS) && (defined(BUILDING_X86_64_SYSTEM) || defined(BUILDING_X86_32_SYSTEM))
+// include for __rdtsc
+#include <x86intrin.h>
+// include for __get_cpuid
+#include <cpuid.h>
+#define TIME_CLOCK_TSC_AVAILABLE
 #endif
 
 enum{
   DAY_TIME_LENGTH = 255,
 };
 
+enum TIME_CLOCK_CONSTANT {
+
+    //! calibration time of time stamp counter [nsec]
+    TIME_CLOCK_TSC_CALIBRATION_TIME_NSEC = 10 * 1000 * 1000,
+
+    //! cpuid leaf of advanced power management information
+    TIME_CLOCK_CPUID_ADVANCED_POWER_MANAGEMENT_LEAF = 0x80000007,
+
+    //! bit of invariant time stamp counter in edx of advanced power management information
+    TIME_CLOCK_CPUID_INVARIANT_TSC_BIT = 1 << 8,
+};
+
+//! selected clock backend
+#if defined(LINUX_OS)
+static enum TIME_CLOCK_BACKEND time_clock_backend = TIME_CLOCK_MONOTONIC_BACKEND;
+#else
+static enum TIME_CLOCK_BACKEND time_clock_backend = TIME_CLOCK_REAL_TIME_BACKEND;
+#endif
+
+#if defined(TIME_CLOCK_TSC_AVAILABLE)
+//! time stamp counter at calibration
+static unsigned long long tsc_count_at_calibration = 0;
+//! monotonic time at calibration [nsec]
+static double tsc_monotonic_time_at_calibration_nsec = 0.0;
+//! length of one count of time stamp counter [nsec]
+static double tsc_nanosec_per_count = 0.0;
+#endif
+
+#if defined(LINUX_OS)
+static double get_monotonic_time_nanosec(void)
+{
+    struct timespec time_spec;
+    clock_gettime(CLOCK_MONOTONIC, &time_spec);
+
+    return (double)time_spec.tv_sec * 1000000000.0 + (double)time_spec.tv_nsec;
+}
+#endif
+
+#if defined(TIME_CLOCK_TSC_AVAILABLE)
+static bool calibrate_time_stamp_counter(void)
+{
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+
+    // counter of CPU without invariant TSC changes its rate with CPU frequency
+    if ((__get_cpuid(TIME_CLOCK_CPUID_ADVANCED_POWER_MANAGEMENT_LEAF, &eax, &ebx, &ecx, &edx) == 0) ||
+        ((edx & TIME_CLOCK_CPUID_INVARIANT_TSC_BIT) == 0)) {
+        return false;
+    }
+
+    const double start_time_nsec = get_monotonic_time_nanosec();
+    const unsigned long long start_count = __rdtsc();
+
+    double end_time_nsec = start_time_nsec;
+    while (end_time_nsec - start_time_nsec < (double)TIME_CLOCK_TSC_CALIBRATION_TIME_NSEC) {
+        end_time_nsec = get_monotonic_time_nanosec();
+    }
+    const unsigned long long end_count = __rdtsc();
+
+    if (end_count <= start_count) {
+        return false;
+    }
+
+    tsc_nanosec_per_count = (end_time_nsec - start_time_nsec) / (double)(end_count - start_count);
+    tsc_count_at_calibration = end_count;
+    tsc_monotonic_time_at_calibration_nsec = end_time_nsec;
+
+    return true;
+}
+#endif
+
+bool set_time_clock_backend(enum TIME_CLOCK_BACKEND backend)
+{
+    switch (backend) {
+
+        case TIME_CLOCK_REAL_TIME_BACKEND:
+            break;
+
+#if defined(LINUX_OS)
+        case TIME_CLOCK_MONOTONIC_BACKEND:
+            break;
+#endif
+
+#if defined(TIME_CLOCK_TSC_AVAILABLE)
+        case TIME_CLOCK_TSC_BACKEND:
+            if (calibrate_time_stamp_counter() == false) {
+                return false;
+            }
+            break;
+#endif
+
+        default:
+            return false;
+    }
+
+    time_clock_backend = backend;
+
+    return true;
+}
+
+enum TIME_CLOCK_BACKEND get_time_clock_backend(void)
+{
+    return time_clock_backend;
+}
+
+double GetNowTimeNanoSec(void)
+{
+#ifdef WINDOWS_OS
+    return (double)GetNowTimeMicroSec() * 1000.0;
+#else
+
+    switch (time_clock_backend) {
+
+#if defined(TIME_CLOCK_TSC_AVAILABLE)
+        case TIME_CLOCK_TSC_BACKEND:
+            // signed difference keeps time of other cores slightly behind calibration
+            return tsc_monotonic_time_at_calibration_nsec +
+                (double)(long long)(__rdtsc() - tsc_count_at_calibration) * tsc_nanosec_per_count;
+#endif
+
+#if defined(LINUX_OS)
+        case TIME_CLOCK_MONOTONIC_BACKEND:
+            return get_monotonic_time_nanosec();
+#endif
+
+        default:
+            break;
+    }
+
+    struct timeval time_val;
+    gettimeofday(&time_val, NULL);
+
+    return (double)time_val.tv_sec * 1000000000.0 + (double)time_val.tv_usec * 1000.0;
+#endif
+}
+
 size_t GetNowTimeMicroSec(void)
 {
     size_t time = 0;
@@ -39,6 +188,10 @@ size_t GetNowTimeMicroSec(void)
 
     time = system_time.wSecond * 1000000 + system_time.wMilliseconds * 1000;
 #else
+    if (time_clock_backend != TIME_CLOCK_REAL_TIME_BACKEND) {
+        return (size_t)(GetNowTimeNanoSec() * 0.001);
+    }
+
     struct timeval time_val;
     gettimeofday(&time_val, NULL);
 
@@ -48,6 +201,31 @@ size_t GetNowTimeMicroSec(void)
     return time;
 }
 
+double GetNowRealTimeMicroSec(void)
+{
+    double time = 0.0;
+
+#ifdef WINDOWS_OS
+    // FILETIME counts 100 nsec from 1601-01-01
+    FILETIME file_time;
+    GetSystemTimeAsFileTime(&file_time);
+
+    ULARGE_INTEGER count;
+    count.LowPart = file_time.dwLowDateTime;
+    count.HighPart = file_time.dwHighDateTime;
+
+    const ULONGLONG count_from_1601_to_1970 = 116444736000000000ULL;
+    time = (double)(count.QuadPart - count_from_1601_to_1970) * 0.1;
+#else
+    struct timespec time_spec;
+    clock_gettime(CLOCK_REALTIME, &time_spec);
+
+    time = (double)time_spec.tv_sec * 1000000.0 + (double)time_spec.tv_nsec * 0.001;
+#endif
+
+    return time;
+}
+
 size_t GetNowTimeMicroSecRusage(void)
 {
     size_t time = 0;
@@ -82,6 +260,34 @@ void sleep_milisecond(unsigned int wait_time_msec)
 
 }
 
+void sleep_microsecond(double wait_time_usec)
+{
+    if (wait_time_usec <= 0.0) {
+        return;
+    }
+
+#if defined(WINDOWS_OS)
+    Sleep((DWORD)(wait_time_usec * 0.001));
+#elif defined(LINUX_OS)
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    const long long wait_time_nsec = (long long)(wait_time_usec * 1000.0);
+    const long long deadline_nsec = (long long)deadline.tv_nsec + wait_time_nsec % 1000000000LL;
+
+    deadline.tv_sec += (time_t)(wait_time_nsec / 1000000000LL + deadline_nsec / 1000000000LL);
+    deadline.tv_nsec = (long)(deadline_nsec % 1000000000LL);
+
+    // clock_nanosleep returns error number instead of setting errno
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+    }
+#else
+    usleep((useconds_t)wait_time_usec);
+#endif
+
+    return;
+}
+
 TimeTheInterval::TimeTheInterval()
 {
 
@@ -97,8 +303,10 @@ TimeTheInterval::TimeTheInterval()
     }
 
     QueryPerformanceCounter(&past_count);
+    past_time_nsec = 0.0;
 #else
-    past_time = GetNowTimeMicroSec();
+    past_time_nsec = GetNowTimeNanoSec();
+    past_time = (size_t)(past_time_nsec * 0.001);
 #endif
 
 }
@@ -159,8 +367,10 @@ void TimeTheInterval::SetIntervalStart(void)
     }
 
     QueryPerformanceCounter(&past_count);
+    past_time_nsec = 0.0;
 #else
-    past_time = GetNowTimeMicroSec();
+    past_time_nsec = GetNowTimeNanoSec();
+    past_time = (size_t)(past_time_nsec * 0.001);
 #endif
 
   return;
@@ -202,6 +412,20 @@ size_t TimeTheInterval::TimeInterval(void) const
     return time;
 }
 
+double TimeTheInterval::TimeIntervalNanoSec(void) const
+{
+#ifdef WINDOWS_OS
+    LARGE_INTEGER current_count;
+    QueryPerformanceCounter(&current_count);
+
+    const double time_scale_nsec = 1000000.0;
+
+    return (double)(current_count.QuadPart - past_count.QuadPart) * frequency_inverse * time_scale_nsec;
+#else
+    return GetNowTimeNanoSec() - past_time_nsec;
+#endif
+}
+
 size_t TimeTheInterval::TimeInterval(size_t start_time_usec) const
 {
     size_t time = 0;
@@ -284,6 +508,7 @@ void TimeTheInterval::SetPastTime(size_t time)
 
 #else
     past_time = time;
+    past_time_nsec = (double)time * 1000.0;
 #endif
     return;
 }
@@ -12,12 +12,59 @@
 
 #include <stddef.h>
 
+//! clock backends of GetNowTimeMicroSec and TimeTheInterval
+enum TIME_CLOCK_BACKEND {
+
+    //! invalid backend
+    TIME_CLOCK_INVALID_BACKEND = -1,
+
+    //! wall clock (gettimeofday), which is stepped by NTP
+    TIME_CLOCK_REAL_TIME_BACKEND = 0,
+
+    //! monotonic clock (clock_gettime with CLOCK_MONOTONIC, served by vDSO on Linux OS)
+    TIME_CLOCK_MONOTONIC_BACKEND,
+
+    //! time stamp counter calibrated with monotonic clock (x86 with invariant TSC only)
+    TIME_CLOCK_TSC_BACKEND,
+
+    //! number of backends
+    NUMBER_OF_TIME_CLOCK_BACKENDS,
+};
+
+/*!
+  \brief function to select clock backend
+  \attention TIME_CLOCK_MONOTONIC_BACKEND is selected by default on Linux OS, and TIME_CLOCK_REAL_TIME_BACKEND on other OS
+  \attention TIME_CLOCK_TSC_BACKEND is calibrated on selecting (about 10 msec), and this function returns false if it is not available
+  \attention backend should be selected before timers are started, because clocks of backends have different origins
+*/
+extern bool set_time_clock_backend(enum TIME_CLOCK_BACKEND backend);
+
+/*!
+  \brief function to get selected clock backend
+*/
+extern enum TIME_CLOCK_BACKEND get_time_clock_backend(void);
+
 /*!
   \brief function to get now time micro sec
+  \attention this function returns time of selected clock backend, and it is wall clock only on TIME_CLOCK_REAL_TIME_BACKEND
   \attention this function returns millisecond time on Windows OS
 */
 extern size_t GetNowTimeMicroSec(void);
 
+/*!
+  \brief function to get now time nano sec
+  \attention this function returns time of selected clock backend
+  \attention this function returns microsecond resolution time on TIME_CLOCK_REAL_TIME_BACKEND, and millisecond time on Windows OS
+*/
+extern double GetNowTimeNanoSec(void);
+
+/*!
+  \brief function to get now time of real time clock [usec from 1970-01-01]
+  \attention this function uses clock_gettime (CLOCK_REALTIME), and its clock is same as kernel receive timestamps of sockets
+  \attention this function returns millisecond resolution time on Windows OS
+*/
+extern double GetNowRealTimeMicroSec(void);
+
 /*!
   \brief function to get now time micro sec
   \attention this function returns millisecond time on Windows OS
@@ -32,6 +79,14 @@ extern size_t GetNowTimeMicroSecRusage(void);
 */
 extern void sleep_milisecond(unsigned int wait_time_msec);
 
+/*!
+  \brief function to sleep [microsecond]
+  \attention this function sleeps until absolute deadline of CLOCK_MONOTONIC with clock_nanosleep (TIMER_ABSTIME) on Linux OS, and interrupted sleep is resumed to same deadline
+  \attention this function uses Sleep (rounded down to millisecond) on Windows OS, and usleep on other OS
+  \attention wake-up is late by timer slack of kernel (about 50 usec on Linux OS), so caller should spin for precise timing
+*/
+extern void sleep_microsecond(double wait_time_usec);
+
 /*!
   \brief class to time the interval
 */
@@ -40,6 +95,9 @@ private:
     //! interval start time
     size_t past_time;
 
+    //! interval start time [nsec]
+    double past_time_nsec;
+
 #ifdef WINDOWS_OS
     LARGE_INTEGER frequency;
     double frequency_inverse;
@@ -86,6 +144,11 @@ public:
      */
     size_t TimeInterval(void) const;
 
+    /*!
+      \brief method to time the interval [nsec]
+     */
+    double TimeIntervalNanoSec(void) const;
+
     /*!
       \brief method to calculate interval
       \todo Check on windows
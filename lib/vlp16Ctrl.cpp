@@ -8,8 +8,52 @@
 // for DBL_MAX
 #include <float.h>
 
+// for cos/sin
+#include <math.h>
+
 #include "vlp16Ctrl.h"
 
+#include "vlp16_sensor_model_traitsCtrl.h"
+
+#include "latency_traceCtrl.h"
+
+//! traits are listed in order of VLP16_PACKET_SENSOR_MODEL in tables of this file (array of negative length is not compiled)
+typedef char vlp16_sensor_model_traits_order_check_t[((hdl_32e_sensor_model_traits_t::SENSOR_MODEL == 0) &&
+                                                      (vlp16_sensor_model_traits_t::SENSOR_MODEL == 1) &&
+                                                      (vlp_32c_sensor_model_traits_t::SENSOR_MODEL == 2) &&
+                                                      (puck_hi_res_sensor_model_traits_t::SENSOR_MODEL == 3) &&
+                                                      (NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET == 4)) ? 1 : -1];
+
+template <class SENSOR_MODEL_TRAITS>
+static vlp16_sensor_model_timing_t make_vlp16_sensor_model_timing(void)
+{
+    vlp16_sensor_model_timing_t timing;
+
+    timing.number_of_spots = SENSOR_MODEL_TRAITS::NUMBER_OF_SPOTS;
+    timing.number_of_firing_sequences_in_data_block = SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK;
+    timing.number_of_simultaneous_firings = SENSOR_MODEL_TRAITS::NUMBER_OF_SIMULTANEOUS_FIRINGS;
+    timing.one_laser_firing_interval_usec = SENSOR_MODEL_TRAITS::one_laser_firing_interval_usec();
+    timing.firing_sequence_usec = SENSOR_MODEL_TRAITS::firing_sequence_usec();
+    timing.data_block_usec = SENSOR_MODEL_TRAITS::data_block_usec();
+    timing.one_laser_firing_ratio_to_data_block = SENSOR_MODEL_TRAITS::one_firing_ratio_to_data_block();
+    timing.elevation_angle_degree_array = SENSOR_MODEL_TRAITS::elevation_angle_degree_array();
+
+    return timing;
+}
+
+const vlp16_sensor_model_timing_t VLP16_SENSOR_MODEL_TIMING[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET] =
+    { make_vlp16_sensor_model_timing<hdl_32e_sensor_model_traits_t>(),
+      make_vlp16_sensor_model_timing<vlp16_sensor_model_traits_t>(),
+      make_vlp16_sensor_model_timing<vlp_32c_sensor_model_traits_t>(),
+      make_vlp16_sensor_model_timing<puck_hi_res_sensor_model_traits_t>() };
+
+template <class SENSOR_MODEL_TRAITS>
+static vlp16_firing_sequence_decoder_t get_firing_sequence_decoder_of_vlp16_sensor_model(enum VLP16_DECODE_KERNEL_TYPE kernel_type)
+{
+    return get_vlp16_firing_sequence_decoder(kernel_type, SENSOR_MODEL_TRAITS::NUMBER_OF_SPOTS,
+                                             SENSOR_MODEL_TRAITS::NUMBER_OF_SIMULTANEOUS_FIRINGS);
+}
+
 static void clear_communication_status_of_vlp16_handler(vlp16_handler_t *handler)
 {
     handler->communication_status.buffer_error_occurs = false;
@@ -17,13 +61,38 @@ static void clear_communication_status_of_vlp16_handler(vlp16_handler_t *handler
     handler->communication_status.memory_allocated = false;
     handler->communication_status.socket_opened = false;
 
+    handler->communication_status.number_of_received_datagrams = 0;
+    handler->communication_status.number_of_accepted_packets = 0;
+    handler->communication_status.number_of_decode_errors = 0;
+    handler->communication_status.number_of_dropped_datagrams = 0;
+
+    handler->communication_status.number_of_lost_packets = 0;
+    handler->communication_status.number_of_reordered_packets = 0;
+    handler->communication_status.number_of_duplicated_packets = 0;
+    handler->communication_status.number_of_completed_revolutions = 0;
+    handler->communication_status.latest_revolution_completeness_ratio = 0.0;
+    clear_streaming_statistics(&handler->communication_status.revolution_completeness_statistics);
+
+    return;
+}
+
+static void clear_packet_continuity_of_vlp16_handler(vlp16_handler_t *handler)
+{
+    handler->past_packet_timestamp_usec = 0;
+    handler->past_packet_timestamp_available = false;
+    handler->past_packet_azimuthal_angle = 0;
+    handler->received_packet_window = ~0u;
+    handler->azimuthal_angle_advance_per_packet = 0;
+    handler->revolution_start_timestamp_usec = 0;
+    handler->revolution_start_timestamp_available = false;
+    handler->number_of_packets_in_revolution = 0;
+
     return;
 }
 
 static void clear_vlp16_decode_buffer(vlp16_handler_t *handler)
 {
-    memset((void *)handler->decode_buffer, 0,
-           VLP16_PACKET_LENGTH);
+    handler->decoding_packet = NULL;
 
     for (unsigned int i = 0; i < VLP16_PACKET_NUMBER_OF_DATA_BLOCKS; ++i) {
         handler->decoding_data_blocks[i] = NULL;
@@ -39,11 +108,26 @@ static void clear_vlp16_remaining_data_blocks(vlp16_handler_t *handler)
     for (unsigned int i = 0; i < NUMBER_OF_STORING_VLP16_PACKET_DATA_BLOCKS; ++i) {
         memset((void *)handler->remaining_data_block_buffer[i], 0,
                VLP16_PACKET_DATA_BLOCK_LENGTH);
+        handler->remaining_data_blocks[i] = handler->remaining_data_block_buffer[i];
     }
 
     return;
 }
 
+static void clear_calibration_tables_of_vlp16_handler(vlp16_handler_t *handler)
+{
+    memset((void *)handler->spot_azimuthal_angle_offset_array, 0, sizeof(handler->spot_azimuthal_angle_offset_array));
+    memset((void *)handler->spot_distance_offset_array, 0, sizeof(handler->spot_distance_offset_array));
+    memset((void *)handler->spot_horizontal_distance_offset_array, 0, sizeof(handler->spot_horizontal_distance_offset_array));
+    memset((void *)handler->spot_z_component_offset_array, 0, sizeof(handler->spot_z_component_offset_array));
+    memset((void *)handler->spot_horizontal_offset_array, 0, sizeof(handler->spot_horizontal_offset_array));
+
+    handler->minimum_spot_azimuthal_angle_offset = 0.0;
+    handler->maximum_spot_azimuthal_angle_offset = 0.0;
+
+    return;
+}
+
 void clear_vlp16_handler(vlp16_handler_t *handler)
 {
     clear_communication_status_of_vlp16_handler(handler);
@@ -52,7 +136,10 @@ void clear_vlp16_handler(vlp16_handler_t *handler)
     clear_vlp16_decode_buffer(handler);
 
     handler->decoding_packet_timestamp_usec = 0;
-    handler->past_packet_timestamp_usec = 0;
+    handler->decoding_packet_receive_time_usec = 0.0;
+    handler->latest_packet_latency_usec = 0.0;
+    clear_streaming_statistics(&handler->packet_latency_statistics);
+    clear_packet_continuity_of_vlp16_handler(handler);
 
     handler->decoding_packet_return_mode = VLP16_PACKET_INVALID_RETURN_MODE;
     handler->decoding_packet_sensor_model = VLP16_PACKET_INVALID_SENSOR_MODEL;
@@ -66,22 +153,124 @@ void clear_vlp16_handler(vlp16_handler_t *handler)
         handler->elevation_angle_array.clear();
         handler->elevation_angle_array.reserve(VLP16_PACKET_NUMBER_OF_SPOTS[VLP16_PACKET_HDL_32E]);
     }
+    handler->sensor_model_timing = NULL;
+    handler->elevation_angle_cosine_array.clear();
+    handler->elevation_angle_sine_array.clear();
+
+    handler->cartesian_output_enabled = false;
+
+    set_decode_kernel_of_vlp16_handler(handler, detect_fastest_vlp16_decode_kernel());
+    memset((void *)handler->spot_time_offset_usec_array, 0, sizeof(handler->spot_time_offset_usec_array));
+
+    clear_vlp16_calibration(&handler->calibration);
+    handler->calibration_available = false;
+    clear_calibration_tables_of_vlp16_handler(handler);
+
+    handler->data_block_decode_tasks.clear();
+    handler->number_of_reserved_lines = 0;
+    handler->decode_pool = NULL;
+
+    handler->point_block_output = NULL;
+
+    initialize_lidar_frame_assembler(&handler->frame_assembler);
+    handler->past_line_start_azimuthal_angle = 0;
+    handler->past_line_start_azimuthal_angle_available = false;
 
     handler->timer.SetIntervalStart();
     handler->no_reply_interval_timer.SetIntervalStart();
 
     initialize_lidar_line_circular_buffer(&handler->line_data_buffer);
+    handler->number_of_lines_to_store = NUMBER_OF_VLP16_PACKET_LINES_TO_STORE_MEASURED_DATA;
+    handler->line_history_length = VLP16_DEFAULT_LINE_HISTORY_REVOLUTIONS;
+    handler->line_history_unit = VLP16_LINE_HISTORY_REVOLUTIONS;
+    handler->line_data_sensor_model = VLP16_PACKET_INVALID_SENSOR_MODEL;
+
+    handler->packet_slot_buffer = NULL;
+    handler->number_of_packet_slots = 0;
+
+    handler->socket_handler.number_of_dropped_datagrams = 0;
+
+    handler->threaded_receive_mode = false;
+    handler->receive_thread_running = false;
+    initialize_packet_ring_buffer(&handler->packet_ring);
+    handler->held_ring_slot_buffer = NULL;
+    handler->held_ring_slot_received_length = NULL;
+    handler->held_ring_slot_receive_time_usec = NULL;
+
+    handler->packet_source_type = VLP16_PACKET_SOURCE_SOCKET;
+    clear_pcap_file_reader(&handler->pcap_reader);
+    handler->pcap_replay_mode = VLP16_PCAP_REPLAY_INVALID_MODE;
+    handler->pcap_replay_speed_ratio = 1.0;
+    handler->pcap_packet_loaded = false;
+    handler->pcap_first_captured_time_sec = 0;
+    handler->pcap_first_captured_time_usec = 0;
+    handler->pcap_first_packet_replayed = false;
+    handler->number_of_replayed_packets = 0;
+
+    // recording file is closed before recorder is initialized, otherwise its mapping and descriptor leak
+    close_packet_recorder(&handler->packet_recorder);
+    initialize_packet_recorder(&handler->packet_recorder);
+    handler->past_recorded_azimuthal_angle = 0;
+    handler->past_recorded_azimuthal_angle_available = false;
 
     return;
 }
 
-static bool allocate_memory_for_lidar_line_circular_buffer(vlp16_handler_t *vlp16_handler,
-                                                           unsigned int number_of_spots,
-                                                           unsigned int number_of_lines)
+/*!
+  \brief function to calculate number of lines measured in history length of line buffer
+*/
+static unsigned int calculate_number_of_lines_in_line_history_of_vlp16_handler(const vlp16_handler_t *vlp16_handler,
+                                                                               enum VLP16_PACKET_SENSOR_MODEL sensor_model)
 {
+    double history_msec = 0;
+
+    switch (vlp16_handler->line_history_unit) {
+
+        case VLP16_LINE_HISTORY_MSEC:
+            history_msec = vlp16_handler->line_history_length;
+            break;
+
+        case VLP16_LINE_HISTORY_REVOLUTIONS:
+            // one revolution is longest at minimum rotation speed
+            history_msec = vlp16_handler->line_history_length * 360.0 * 1000.0 / VLP16_PACKET_MINIMUM_ROTATION_SPEED;
+            break;
+
+        default:
+            break;
+    }
+
+    // one line is measured on each firing sequence in both single and dual return mode
+    const double number_of_lines =
+        ceil(history_msec * 1000.0 / VLP16_SENSOR_MODEL_TIMING[sensor_model].firing_sequence_usec);
+
+    if (number_of_lines > LIDAR_LINE_CIRCULAR_BUFFER_MAXIMUM_LENGTH) {
+        return LIDAR_LINE_CIRCULAR_BUFFER_MAXIMUM_LENGTH;
+    }
+
+    return (unsigned int)number_of_lines;
+}
+
+/*!
+  \brief function to allocate line buffer to store lines of history length and lines of packets received at once
+  \attention line buffer is not reallocated if its number of spots and length are not changed
+*/
+static bool allocate_line_data_buffer_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                       enum VLP16_PACKET_SENSOR_MODEL sensor_model)
+{
+    const unsigned int number_of_spots = VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model];
+
+    unsigned int number_of_lines =
+        calculate_number_of_lines_in_line_history_of_vlp16_handler(vlp16_handler, sensor_model);
+    if (number_of_lines < vlp16_handler->number_of_lines_to_store) {
+        number_of_lines = vlp16_handler->number_of_lines_to_store;
+    }
+
+    vlp16_handler->line_data_sensor_model = sensor_model;
+
     if (is_allocated_memory_of_lidar_line_circular_buffer(&vlp16_handler->line_data_buffer) == true) {
 
-        if (number_of_spots == VLP16_PACKET_NUMBER_OF_SPOTS[vlp16_handler->decoding_packet_sensor_model]) {
+        if ((number_of_spots == get_number_of_spots_of_lidar_line_circular_buffer(&vlp16_handler->line_data_buffer)) &&
+            (calculate_length_of_lidar_line_circular_buffer(number_of_lines) == vlp16_handler->line_data_buffer.length)) {
             return true;
         }
 
@@ -92,6 +281,52 @@ static bool allocate_memory_for_lidar_line_circular_buffer(vlp16_handler_t *vlp1
                                                           number_of_spots, number_of_lines);
 }
 
+static void release_packet_slots_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    if (vlp16_handler->packet_slot_buffer != NULL) {
+#if defined(WINDOWS_OS)
+        _aligned_free(vlp16_handler->packet_slot_buffer);
+#else
+        free(vlp16_handler->packet_slot_buffer);
+#endif
+        vlp16_handler->packet_slot_buffer = NULL;
+    }
+    vlp16_handler->number_of_packet_slots = 0;
+
+    return;
+}
+
+static bool allocate_packet_slots_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                    unsigned int number_of_packet_slots)
+{
+    release_packet_slots_of_vlp16_handler(vlp16_handler);
+
+    if (number_of_packet_slots == 0) {
+        return false;
+    }
+
+    const unsigned int buffer_length_byte = number_of_packet_slots * VLP16_PACKET_SLOT_LENGTH;
+    void *slot_buffer = NULL;
+
+#if defined(WINDOWS_OS)
+    slot_buffer = _aligned_malloc(buffer_length_byte, VLP16_PACKET_SLOT_ALIGNMENT_BYTE);
+#else
+    if (posix_memalign(&slot_buffer, VLP16_PACKET_SLOT_ALIGNMENT_BYTE, buffer_length_byte) != 0) {
+        slot_buffer = NULL;
+    }
+#endif
+
+    if (slot_buffer == NULL) {
+        return false;
+    }
+    memset(slot_buffer, 0, buffer_length_byte);
+
+    vlp16_handler->packet_slot_buffer = (char *)slot_buffer;
+    vlp16_handler->number_of_packet_slots = number_of_packet_slots;
+
+    return true;
+}
+
 bool allocate_circular_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler, enum VLP16_PACKET_SENSOR_MODEL sensor_model,
                                                 unsigned int buffer_length_byte)
 {
@@ -106,21 +341,23 @@ bool allocate_circular_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
         return false;
     }
 
+    unsigned int number_of_packet_slots = buffer_length_byte / VLP16_PACKET_LENGTH;
+    if (number_of_packet_slots > SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE) {
+        number_of_packet_slots = SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE;
+    }
+
     bool return_bool =
-        allocate_circular_receive_buffer_of_socket_client(&vlp16_handler->socket_handler,
-                                                          buffer_length_byte);
+        allocate_packet_slots_for_vlp16_handler(vlp16_handler, number_of_packet_slots);
     if (return_bool == false) {
         vlp16_handler->communication_status.memory_allocated = false;
         return false;
     }
 
     return_bool =
-        allocate_memory_for_lidar_line_circular_buffer(vlp16_handler,
-                                                       VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model],
-                                                       NUMBER_OF_VLP16_PACKET_LINES_TO_STORE_MEASURED_DATA);
+        allocate_line_data_buffer_of_vlp16_handler(vlp16_handler, sensor_model);
 
     if (return_bool == false) {
-        release_circular_buffer_of_vlp16_handler(vlp16_handler);
+        release_packet_slots_of_vlp16_handler(vlp16_handler);
         return false;
     }
 
@@ -131,12 +368,17 @@ bool allocate_circular_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
 
 bool release_circular_buffer_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
 {
+    if (is_allocated_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler) == true) {
+        release_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler);
+    }
 
     bool return_bool = false;
     if (vlp16_handler->communication_status.memory_allocated == true) {
 
-        return_bool =
-            release_memory_of_circular_buffer(&vlp16_handler->socket_handler.buffer);
+        stop_receive_thread_of_vlp16_handler(vlp16_handler);
+
+        release_packet_slots_of_vlp16_handler(vlp16_handler);
+        return_bool = true;
 
         vlp16_handler->communication_status.memory_allocated = false;
 
@@ -144,12 +386,85 @@ bool release_circular_buffer_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
             release_memory_of_lidar_line_circular_buffer(&vlp16_handler->line_data_buffer);
         }
 
+        clear_vlp16_decode_buffer(vlp16_handler);
+
         return return_bool;
     }
 
     return return_bool;
 }
 
+bool allocate_packet_batch_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                    unsigned int maximum_number_of_packets)
+{
+    if (vlp16_handler->communication_status.memory_allocated == false) {
+        return false;
+    }
+
+    if (maximum_number_of_packets == 0) {
+        return false;
+    }
+
+    if (maximum_number_of_packets > SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE) {
+        maximum_number_of_packets = SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE;
+    }
+
+    if (maximum_number_of_packets > vlp16_handler->number_of_packet_slots) {
+
+        clear_vlp16_decode_buffer(vlp16_handler);
+
+        if (allocate_packet_slots_for_vlp16_handler(vlp16_handler, maximum_number_of_packets) == false) {
+            vlp16_handler->communication_status.buffer_error_occurs = true;
+            return false;
+        }
+
+    }
+
+    // lines of all packets received at once must be kept until they are used
+    const unsigned int number_of_lines =
+        NUMBER_OF_VLP16_PACKET_LINES_TO_STORE_MEASURED_DATA * maximum_number_of_packets;
+
+    if (number_of_lines > vlp16_handler->number_of_lines_to_store) {
+
+        vlp16_handler->number_of_lines_to_store = number_of_lines;
+
+        if (allocate_line_data_buffer_of_vlp16_handler(vlp16_handler,
+                                                       vlp16_handler->line_data_sensor_model) == false) {
+            vlp16_handler->communication_status.buffer_error_occurs = true;
+            return false;
+        }
+
+    }
+
+    return true;
+}
+
+bool set_line_history_of_vlp16_handler(vlp16_handler_t *vlp16_handler, double history_length,
+                                       enum VLP16_LINE_HISTORY_UNIT history_unit)
+{
+    if ((history_unit == VLP16_LINE_HISTORY_INVALID_UNIT) ||
+        (history_unit == NUMBER_OF_VLP16_LINE_HISTORY_UNITS) ||
+        (history_length < 0)) {
+        return false;
+    }
+
+    vlp16_handler->line_history_length = history_length;
+    vlp16_handler->line_history_unit = history_unit;
+
+    // line buffer is sized on allocation of handler if it is not allocated yet
+    if (vlp16_handler->communication_status.memory_allocated == false) {
+        return true;
+    }
+
+    if (allocate_line_data_buffer_of_vlp16_handler(vlp16_handler,
+                                                   vlp16_handler->line_data_sensor_model) == false) {
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return false;
+    }
+
+    return true;
+}
+
 bool open_socket_for_vlp16_handler(const char *destination_ip_address_string,
                                    const char *destination_port_number_string,
                                    const char *reception_ip_address_string,
@@ -181,21 +496,267 @@ bool open_socket_for_vlp16_handler(const char *destination_ip_address_string,
     return true;
 }
 
+bool open_pcap_file_for_vlp16_handler(const char *file_path, unsigned short destination_port,
+                                      enum VLP16_PCAP_REPLAY_MODE replay_mode, double replay_speed_ratio,
+                                      int communication_timeout_usec,
+                                      vlp16_handler_t *vlp16_handler)
+{
+    if (vlp16_handler->communication_status.socket_opened == true) {
+        return false;
+    }
+
+    if ((replay_mode == VLP16_PCAP_REPLAY_INVALID_MODE) ||
+        (replay_mode == NUMBER_OF_VLP16_PCAP_REPLAY_MODES)) {
+        return false;
+    }
+
+    if ((replay_mode == VLP16_PCAP_REPLAY_SCALED_TIMING) && (replay_speed_ratio <= 0.0)) {
+        return false;
+    }
+
+    clear_vlp16_decode_buffer(vlp16_handler);
+    clear_vlp16_remaining_data_blocks(vlp16_handler);
+
+    if (open_pcap_file(file_path, destination_port, &vlp16_handler->pcap_reader) == false) {
+        return false;
+    }
+
+    vlp16_handler->packet_source_type = VLP16_PACKET_SOURCE_PCAP_FILE;
+
+    vlp16_handler->pcap_replay_mode = replay_mode;
+    vlp16_handler->pcap_replay_speed_ratio = 1.0;
+    if (replay_mode == VLP16_PCAP_REPLAY_SCALED_TIMING) {
+        vlp16_handler->pcap_replay_speed_ratio = replay_speed_ratio;
+    }
+
+    vlp16_handler->pcap_packet_loaded = false;
+    vlp16_handler->pcap_first_packet_replayed = false;
+    vlp16_handler->number_of_replayed_packets = 0;
+    vlp16_handler->pcap_replay_timer.SetIntervalStart();
+
+    vlp16_handler->communication_timeout_usec = communication_timeout_usec;
+    vlp16_handler->communication_status.socket_opened = true;
+
+    return true;
+}
+
+bool is_end_of_pcap_file_of_vlp16_handler(const vlp16_handler_t *vlp16_handler)
+{
+    if (vlp16_handler->packet_source_type != VLP16_PACKET_SOURCE_PCAP_FILE) {
+        return false;
+    }
+
+    if (vlp16_handler->pcap_packet_loaded == true) {
+        return false;
+    }
+
+    return vlp16_handler->pcap_reader.end_of_file_reached;
+}
+
+double calculate_replayed_packet_rate_of_vlp16_handler(const vlp16_handler_t *vlp16_handler)
+{
+    const size_t replay_time_usec = vlp16_handler->pcap_replay_timer.TimeInterval();
+
+    if (replay_time_usec == 0) {
+        return 0.0;
+    }
+
+    return (double)vlp16_handler->number_of_replayed_packets * 1000000.0 / (double)replay_time_usec;
+}
+
 void close_socket_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
 {
+    stop_receive_thread_of_vlp16_handler(vlp16_handler);
+
+    stop_recording_packets_of_vlp16_handler(vlp16_handler);
+
+    if (vlp16_handler->packet_source_type == VLP16_PACKET_SOURCE_PCAP_FILE) {
 
-    close_socket_of_client(&vlp16_handler->socket_handler);
+        close_pcap_file(&vlp16_handler->pcap_reader);
+
+        vlp16_handler->packet_source_type = VLP16_PACKET_SOURCE_SOCKET;
+        vlp16_handler->pcap_packet_loaded = false;
+
+    } else {
+        close_socket_of_client(&vlp16_handler->socket_handler);
+    }
 
     vlp16_handler->communication_status.socket_opened = false;
 
     return;
 }
 
+static void *receive_packets_on_receive_thread_of_vlp16_handler(void *argument)
+{
+    vlp16_handler_t *vlp16_handler = (vlp16_handler_t *)argument;
+    packet_ring_buffer_t *ring = &vlp16_handler->packet_ring;
+
+    // slot to receive packets dropped on PACKET_RING_DROP_NEWEST
+    char dropping_slot[VLP16_PACKET_SLOT_LENGTH];
+    int dropping_slot_length = 0;
+
+    unsigned int number_of_reserved_slots = 0;
+    int *received_length_array = NULL;
+    double *receive_time_usec_array = NULL;
+    char *reserved_slots = NULL;
+
+    int number_of_datagrams = 0;
+
+    while (load_shared_bool(&vlp16_handler->receive_thread_running) == true) {
+
+        if (wait_until_socket_client_is_readable(&vlp16_handler->socket_handler,
+                                                 VLP16_RECEIVE_THREAD_WAIT_TIMEOUT_USEC) == false) {
+            continue;
+        }
+
+        reserved_slots =
+            reserve_slots_to_write_packet_ring_buffer(ring, SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE,
+                                                      &number_of_reserved_slots, &received_length_array,
+                                                      &receive_time_usec_array);
+
+        if (reserved_slots == NULL) {
+
+            // ring is full, and new packet is dropped
+            number_of_datagrams =
+                receive_datagrams_using_socket_client(&vlp16_handler->socket_handler,
+                                                      dropping_slot, VLP16_PACKET_SLOT_LENGTH, 1,
+                                                      &dropping_slot_length, NULL, 0);
+            if (number_of_datagrams > 0) {
+                count_dropped_packets_of_packet_ring_buffer(ring, (unsigned int)number_of_datagrams);
+            }
+
+            continue;
+        }
+
+        number_of_datagrams =
+            receive_datagrams_using_socket_client(&vlp16_handler->socket_handler,
+                                                  reserved_slots, VLP16_PACKET_SLOT_LENGTH,
+                                                  number_of_reserved_slots, received_length_array,
+                                                  receive_time_usec_array, 0);
+
+        if (number_of_datagrams > 0) {
+            commit_written_slots_of_packet_ring_buffer(ring, (unsigned int)number_of_datagrams);
+        }
+
+    }
+
+    return NULL;
+}
+
+bool start_receive_thread_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                           unsigned int number_of_ring_packets,
+                                           enum PACKET_RING_OVERFLOW_POLICY overflow_policy,
+                                           int cpu_core_index)
+{
+    if ((vlp16_handler->communication_status.socket_opened == false) ||
+        (vlp16_handler->communication_status.memory_allocated == false)) {
+        return false;
+    }
+
+    if (vlp16_handler->packet_source_type != VLP16_PACKET_SOURCE_SOCKET) {
+        return false;
+    }
+
+    if (vlp16_handler->threaded_receive_mode == true) {
+        return true;
+    }
+
+    pthread_attr_t thread_attribute;
+    pthread_attr_init(&thread_attribute);
+
+#if defined(LINUX_OS)
+    // thread is created on core, so its first receiving also runs there
+    if (cpu_core_index != VLP16_RECEIVE_THREAD_NO_CPU_AFFINITY) {
+
+        if ((cpu_core_index < 0) ||
+            (cpu_core_index >= CPU_SETSIZE)) {
+            pthread_attr_destroy(&thread_attribute);
+            return false;
+        }
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu_core_index, &cpu_set);
+
+        if (pthread_attr_setaffinity_np(&thread_attribute, sizeof(cpu_set_t), &cpu_set) != 0) {
+            pthread_attr_destroy(&thread_attribute);
+            return false;
+        }
+    }
+#endif
+
+    // receive_vlp16_packets holds as many slots as own packet slots at once
+    if (allocate_memory_for_packet_ring_buffer(&vlp16_handler->packet_ring,
+                                               VLP16_PACKET_SLOT_LENGTH, number_of_ring_packets,
+                                               vlp16_handler->number_of_packet_slots,
+                                               overflow_policy) == false) {
+        pthread_attr_destroy(&thread_attribute);
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return false;
+    }
+
+    store_shared_bool(&vlp16_handler->receive_thread_running, true);
+
+    const int create_result =
+        pthread_create(&vlp16_handler->receive_thread, &thread_attribute,
+                       receive_packets_on_receive_thread_of_vlp16_handler, (void *)vlp16_handler);
+    pthread_attr_destroy(&thread_attribute);
+
+    if (create_result != 0) {
+        store_shared_bool(&vlp16_handler->receive_thread_running, false);
+        release_memory_of_packet_ring_buffer(&vlp16_handler->packet_ring);
+        return false;
+    }
+
+    vlp16_handler->threaded_receive_mode = true;
+
+    return true;
+}
+
+/*!
+  \brief function to release ring slots held to decode packets received by receive thread
+  \attention packets are accepted in own packet slots after this function
+*/
+static void release_held_ring_slots_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    if (vlp16_handler->held_ring_slot_buffer == NULL) {
+        return;
+    }
+
+    release_held_slots_of_packet_ring_buffer(&vlp16_handler->packet_ring);
+
+    vlp16_handler->held_ring_slot_buffer = NULL;
+    vlp16_handler->held_ring_slot_received_length = NULL;
+    vlp16_handler->held_ring_slot_receive_time_usec = NULL;
+
+    return;
+}
+
+void stop_receive_thread_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    if (vlp16_handler->threaded_receive_mode == false) {
+        return;
+    }
+
+    store_shared_bool(&vlp16_handler->receive_thread_running, false);
+    pthread_join(vlp16_handler->receive_thread, NULL);
+
+    release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+    release_memory_of_packet_ring_buffer(&vlp16_handler->packet_ring);
+
+    vlp16_handler->threaded_receive_mode = false;
+
+    return;
+}
+
 void erase_all_receiving_and_decoding_data(vlp16_handler_t *handler)
 {
     clear_vlp16_decode_buffer(handler);
     clear_vlp16_remaining_data_blocks(handler);
-    clear_memory_of_circular_buffer(&handler->socket_handler.buffer);
+
+    handler->past_line_start_azimuthal_angle_available = false;
+
+    clear_packet_continuity_of_vlp16_handler(handler);
 
     return;
 }
@@ -234,7 +795,7 @@ static enum VLP16_PACKET_SENSOR_MODEL get_sensor_model_in_vlp16_packet(const cha
 
 static void decode_timestamp_and_return_mode_and_sensor_model_of_vlp16_packet(vlp16_handler_t *handler)
 {
-    const char *packet = handler->decode_buffer;
+    const char *packet = handler->decoding_packet;
 
     handler->decoding_packet_timestamp_usec =
         decode_unsigned_value(packet + VLP16_PACKET_TIMESTAMP_POSITION,
@@ -251,7 +812,7 @@ static void decode_timestamp_and_return_mode_and_sensor_model_of_vlp16_packet(vl
 
 static bool verify_flags_of_data_blocks(const vlp16_handler_t *vlp16_handler)
 {
-    const char *packet_data = vlp16_handler->decode_buffer;
+    const char *packet_data = vlp16_handler->decoding_packet;
 
     for (unsigned int block_index = 0; block_index < VLP16_PACKET_NUMBER_OF_DATA_BLOCKS; ++block_index) {
 
@@ -267,41 +828,361 @@ static bool verify_flags_of_data_blocks(const vlp16_handler_t *vlp16_handler)
     return true;
 }
 
-bool receive_vlp16_packet(vlp16_handler_t *vlp16_handler, int *received_data_length,
-                          unsigned int onetime_receive_length_byte)
+static unsigned int calculate_azimuthal_angle_difference(unsigned int start_angle, unsigned int end_angle)
 {
-    const unsigned awaiting_message_length = VLP16_PACKET_LENGTH;
-    char *copy_destination = vlp16_handler->decode_buffer;
-
-    unsigned int captured_data_length = 0;
-    unsigned int copied_data_length = 0;
+    unsigned int calculation_end_angle = end_angle;
+    if (start_angle > end_angle) {
+        calculation_end_angle = end_angle + VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+    }
 
-    // receive constant length data
-    *received_data_length =
-        receive_constant_length_data(&vlp16_handler->socket_handler, vlp16_handler->communication_timeout_usec,
-                                     awaiting_message_length, copy_destination,
-                                     onetime_receive_length_byte,
-                                     &captured_data_length, &copied_data_length);
+    return calculation_end_angle - start_angle;
+}
 
-    if (copied_data_length != awaiting_message_length) {
-        vlp16_handler->communication_status.decode_error_occurs = true;
+bool start_recording_packets_of_vlp16_handler(vlp16_handler_t *vlp16_handler, const char *file_path,
+                                              unsigned int maximum_number_of_packets)
+{
+    if (is_opened_packet_recorder(&vlp16_handler->packet_recorder) == true) {
         return false;
     }
 
-    if (verify_flags_of_data_blocks(vlp16_handler) == false) {
-        vlp16_handler->communication_status.decode_error_occurs = true;
+    if (open_packet_recorder(file_path, VLP16_PACKET_LENGTH, maximum_number_of_packets,
+                             &vlp16_handler->packet_recorder) == false) {
         return false;
     }
 
-    // reset no reply interval timer
-    vlp16_handler->no_reply_interval_timer.SetIntervalStart();
+    vlp16_handler->past_recorded_azimuthal_angle_available = false;
 
-    // renew packet information
-    decode_timestamp_and_return_mode_and_sensor_model_of_vlp16_packet(vlp16_handler);
+    return true;
+}
+
+void stop_recording_packets_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    close_packet_recorder(&vlp16_handler->packet_recorder);
+
+    return;
+}
+
+static void record_vlp16_packet(vlp16_handler_t *vlp16_handler)
+{
+    // revolution starts in packet if azimuthal angle of last data block wraps around
+    const unsigned int azimuthal_angle =
+        decode_unsigned_value(vlp16_handler->decoding_packet +
+                              VLP16_PACKET_DATA_BLOCK_POSITION[VLP16_PACKET_NUMBER_OF_DATA_BLOCKS - 1] +
+                              VLP16_PACKET_AZIMUTHAL_ANGLE_POSITION_IN_DATA_BLOCK,
+                              VLP16_PACKET_AZIMUTHAL_ANGLE_LENGTH, false);
+
+    bool revolution_start = false;
+
+    if ((vlp16_handler->past_recorded_azimuthal_angle_available == true) &&
+        (azimuthal_angle < VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE)) {
+
+        const unsigned int azimuthal_angle_difference =
+            calculate_azimuthal_angle_difference(vlp16_handler->past_recorded_azimuthal_angle, azimuthal_angle);
+
+        // backward jitter of azimuthal angle is not regarded as wrap around
+        if ((azimuthal_angle_difference < (VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE / 2)) &&
+            (vlp16_handler->past_recorded_azimuthal_angle + azimuthal_angle_difference >= VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE)) {
+            revolution_start = true;
+        }
+
+    }
+
+    if (azimuthal_angle < VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE) {
+        vlp16_handler->past_recorded_azimuthal_angle = azimuthal_angle;
+        vlp16_handler->past_recorded_azimuthal_angle_available = true;
+    }
+
+    append_packet_to_packet_recorder(&vlp16_handler->packet_recorder,
+                                     vlp16_handler->decoding_packet, VLP16_PACKET_LENGTH,
+                                     vlp16_handler->decoding_packet_receive_time_usec, revolution_start);
+
+    return;
+}
+
+double calculate_vlp16_packet_interval_usec(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                            enum VLP16_PACKET_RETURN_MODE return_mode)
+{
+    if ((sensor_model == VLP16_PACKET_INVALID_SENSOR_MODEL) ||
+        (sensor_model == NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET)) {
+        return 0.0;
+    }
+
+    const double one_data_block_usec = VLP16_SENSOR_MODEL_TIMING[sensor_model].data_block_usec;
+
+    switch (return_mode) {
+        case VLP16_PACKET_STRONGEST_RETURN_MODE:
+        case VLP16_PACKET_LAST_RETURN_MODE:
+            return one_data_block_usec * VLP16_PACKET_NUMBER_OF_DATA_BLOCKS;
+        case VLP16_PACKET_DUAL_RETURN_MODE:
+            // two data blocks of same firing
+            return one_data_block_usec * VLP16_PACKET_HALF_NUMBER_OF_DATA_BLOCKS;
+        default:
+            break;
+    }
+
+    return 0.0;
+}
+
+static double calculate_timestamp_difference_of_vlp16_packets(unsigned int past_timestamp_usec,
+                                                              unsigned int timestamp_usec)
+{
+    double difference = (double)timestamp_usec - (double)past_timestamp_usec;
+
+    // timestamp wraps at top of hour
+    if (difference < -0.5 * VLP16_PACKET_MAXIMUM_TIMESTAMP) {
+        difference += (double)VLP16_PACKET_MAXIMUM_TIMESTAMP;
+    } else if (difference > 0.5 * VLP16_PACKET_MAXIMUM_TIMESTAMP) {
+        difference -= (double)VLP16_PACKET_MAXIMUM_TIMESTAMP;
+    }
+
+    return difference;
+}
+
+static void complete_revolution_of_vlp16_handler(vlp16_handler_t *vlp16_handler, double packet_interval_usec)
+{
+    vlp16_communication_status_t *status = &vlp16_handler->communication_status;
+
+    const double revolution_duration_usec =
+        calculate_timestamp_difference_of_vlp16_packets(vlp16_handler->revolution_start_timestamp_usec,
+                                                        vlp16_handler->decoding_packet_timestamp_usec);
+
+    const double expected_number_of_packets = revolution_duration_usec / packet_interval_usec;
+    if (expected_number_of_packets < 1.0) {
+        return;
+    }
+
+    double completeness_ratio = vlp16_handler->number_of_packets_in_revolution / expected_number_of_packets;
+    if (completeness_ratio > 1.0) {
+        completeness_ratio = 1.0;
+    }
+
+    status->latest_revolution_completeness_ratio = completeness_ratio;
+    add_value_to_streaming_statistics(&status->revolution_completeness_statistics, completeness_ratio);
+    ++status->number_of_completed_revolutions;
+
+    return;
+}
+
+//! function to count packets which are not received in reorder window
+static unsigned int count_missing_packets_in_window(unsigned int window)
+{
+    unsigned int number_of_missing_packets = 0;
+
+    for (unsigned int missing_bits = ~window; missing_bits != 0; missing_bits &= missing_bits - 1) {
+        ++number_of_missing_packets;
+    }
+
+    return number_of_missing_packets;
+}
+
+/*!
+  \brief function to advance reorder window to new highest timestamp
+  \return number of missing packets which leave reorder window (they are lost)
+*/
+static unsigned int advance_received_packet_window_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                                   unsigned int number_of_packet_intervals)
+{
+    const unsigned int window = vlp16_handler->received_packet_window;
+
+    if (number_of_packet_intervals >= VLP16_PACKET_REORDER_WINDOW_LENGTH) {
+        vlp16_handler->received_packet_window = 1;
+        return count_missing_packets_in_window(window) +
+            (number_of_packet_intervals - VLP16_PACKET_REORDER_WINDOW_LENGTH);
+    }
+
+    // bits shifted out of window are older than reorder window
+    const unsigned int leaving_bits = ~0u << (VLP16_PACKET_REORDER_WINDOW_LENGTH - number_of_packet_intervals);
+
+    vlp16_handler->received_packet_window = (window << number_of_packet_intervals) | 1;
+
+    return count_missing_packets_in_window(window | ~leaving_bits);
+}
+
+/*!
+  \brief function to confirm number of packet intervals of timestamp gap with advance of azimuthal angle
+  \attention gap is shortened to advance of azimuthal angle if azimuthal angle advances less than timestamp
+*/
+static unsigned int confirm_packet_intervals_with_azimuthal_angle(const vlp16_handler_t *vlp16_handler,
+                                                                  unsigned int number_of_packet_intervals,
+                                                                  unsigned int azimuthal_angle)
+{
+    const unsigned int advance_per_packet = vlp16_handler->azimuthal_angle_advance_per_packet;
+
+    // advance of azimuthal angle is ambiguous if gap is longer than half revolution
+    if ((number_of_packet_intervals <= 1) || (advance_per_packet == 0) ||
+        (azimuthal_angle >= VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE) ||
+        ((double)number_of_packet_intervals * advance_per_packet >= 0.5 * VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE)) {
+        return number_of_packet_intervals;
+    }
+
+    const unsigned int azimuthal_angle_difference =
+        calculate_azimuthal_angle_difference(vlp16_handler->past_packet_azimuthal_angle, azimuthal_angle);
+
+    const unsigned int number_of_azimuthal_angle_intervals =
+        (unsigned int)((double)azimuthal_angle_difference / advance_per_packet + 0.5);
+
+    if (number_of_azimuthal_angle_intervals == 0) {
+        return 1;
+    }
+
+    return (number_of_azimuthal_angle_intervals < number_of_packet_intervals) ?
+        number_of_azimuthal_angle_intervals : number_of_packet_intervals;
+}
+
+/*!
+  \brief function to evaluate continuity of decoding packet with timestamp and azimuthal angle
+  \attention packets missing behind highest timestamp are counted as lost when they leave reorder window of VLP16_PACKET_REORDER_WINDOW_LENGTH packets
+  \attention gap of timestamp is confirmed with advance of azimuthal angle
+  \attention packet at or below highest timestamp is duplicated (already received) or reordered (late), and it does not change lost count
+*/
+static void evaluate_continuity_of_vlp16_packet(vlp16_handler_t *vlp16_handler)
+{
+    const double packet_interval_usec =
+        calculate_vlp16_packet_interval_usec(vlp16_handler->decoding_packet_sensor_model,
+                                             vlp16_handler->decoding_packet_return_mode);
+    if (packet_interval_usec <= 0.0) {
+        return;
+    }
+
+    vlp16_communication_status_t *status = &vlp16_handler->communication_status;
+
+    const unsigned int timestamp_usec = vlp16_handler->decoding_packet_timestamp_usec;
+    const unsigned int azimuthal_angle =
+        decode_unsigned_value(vlp16_handler->decoding_packet +
+                              VLP16_PACKET_DATA_BLOCK_POSITION[0] +
+                              VLP16_PACKET_AZIMUTHAL_ANGLE_POSITION_IN_DATA_BLOCK,
+                              VLP16_PACKET_AZIMUTHAL_ANGLE_LENGTH, false);
+
+    if (vlp16_handler->past_packet_timestamp_available == true) {
+
+        const double timestamp_difference =
+            calculate_timestamp_difference_of_vlp16_packets(vlp16_handler->past_packet_timestamp_usec,
+                                                            timestamp_usec);
+
+        const double timestamp_jump_usec = (double)VLP16_PACKET_TIMESTAMP_JUMP_TO_RESTART_CONTINUITY_USEC;
+        const bool timestamp_jumps =
+            (timestamp_difference > timestamp_jump_usec) || (timestamp_difference < -timestamp_jump_usec);
+
+        // packet intervals from highest timestamp
+        const double packet_position = floor(timestamp_difference / packet_interval_usec + 0.5);
+
+        if (timestamp_jumps == true) {
+            // sequence restarts (sensor restart or replay from other position), and missing packets are lost
+            status->number_of_lost_packets += count_missing_packets_in_window(vlp16_handler->received_packet_window);
+            clear_packet_continuity_of_vlp16_handler(vlp16_handler);
+
+        } else if (packet_position <= 0.0) {
+
+            const unsigned int number_of_packet_intervals_behind = (unsigned int)(-packet_position);
+
+            if ((number_of_packet_intervals_behind < VLP16_PACKET_REORDER_WINDOW_LENGTH) &&
+                ((vlp16_handler->received_packet_window & (1u << number_of_packet_intervals_behind)) != 0)) {
+                // same packet arrives again, and it neither fills missing packet nor counts in revolution
+                ++status->number_of_duplicated_packets;
+                return;
+            }
+
+            // missing packet arrives late (it is already counted as lost if it is older than reorder window)
+            if (number_of_packet_intervals_behind < VLP16_PACKET_REORDER_WINDOW_LENGTH) {
+                vlp16_handler->received_packet_window |= (1u << number_of_packet_intervals_behind);
+            }
+            ++status->number_of_reordered_packets;
+            ++vlp16_handler->number_of_packets_in_revolution;
+            return;
+
+        } else {
+            const unsigned int number_of_packet_intervals =
+                confirm_packet_intervals_with_azimuthal_angle(vlp16_handler, (unsigned int)packet_position,
+                                                              azimuthal_angle);
+
+            status->number_of_lost_packets +=
+                advance_received_packet_window_of_vlp16_handler(vlp16_handler, number_of_packet_intervals);
+
+            if ((number_of_packet_intervals == 1) && (azimuthal_angle < VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE)) {
+                vlp16_handler->azimuthal_angle_advance_per_packet =
+                    calculate_azimuthal_angle_difference(vlp16_handler->past_packet_azimuthal_angle, azimuthal_angle);
+            }
+
+            // revolution starts if azimuthal angle wraps around
+            if ((azimuthal_angle < VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE) &&
+                (azimuthal_angle < vlp16_handler->past_packet_azimuthal_angle)) {
+
+                if (vlp16_handler->revolution_start_timestamp_available == true) {
+                    complete_revolution_of_vlp16_handler(vlp16_handler, packet_interval_usec);
+                }
+
+                vlp16_handler->revolution_start_timestamp_usec = timestamp_usec;
+                vlp16_handler->revolution_start_timestamp_available = true;
+                vlp16_handler->number_of_packets_in_revolution = 0;
+            }
+        }
+    }
+
+    ++vlp16_handler->number_of_packets_in_revolution;
+
+    vlp16_handler->past_packet_timestamp_usec = timestamp_usec;
+    vlp16_handler->past_packet_timestamp_available = true;
+    vlp16_handler->past_packet_azimuthal_angle = azimuthal_angle;
+
+    return;
+}
+
+/*!
+  \brief function to get received length of packet slot
+  \attention held ring slots are used instead of own packet slots while they are held
+*/
+static int get_received_length_of_packet_slot(const vlp16_handler_t *vlp16_handler, unsigned int slot_index)
+{
+    if (vlp16_handler->held_ring_slot_buffer != NULL) {
+        return vlp16_handler->held_ring_slot_received_length[slot_index];
+    }
+
+    return vlp16_handler->packet_slot_received_length[slot_index];
+}
+
+static bool accept_vlp16_packet_in_packet_slot(vlp16_handler_t *vlp16_handler, unsigned int slot_index)
+{
+    if (get_received_length_of_packet_slot(vlp16_handler, slot_index) != VLP16_PACKET_LENGTH) {
+        vlp16_handler->communication_status.decode_error_occurs = true;
+        ++vlp16_handler->communication_status.number_of_decode_errors;
+        return false;
+    }
+
+    // slots of packet ring have same length as own packet slots
+    if (vlp16_handler->held_ring_slot_buffer != NULL) {
+        vlp16_handler->decoding_packet =
+            vlp16_handler->held_ring_slot_buffer + slot_index * VLP16_PACKET_SLOT_LENGTH;
+        vlp16_handler->decoding_packet_receive_time_usec =
+            vlp16_handler->held_ring_slot_receive_time_usec[slot_index];
+    } else {
+        vlp16_handler->decoding_packet =
+            vlp16_handler->packet_slot_buffer + slot_index * VLP16_PACKET_SLOT_LENGTH;
+        vlp16_handler->decoding_packet_receive_time_usec = vlp16_handler->packet_slot_receive_time_usec[slot_index];
+    }
+
+    if (verify_flags_of_data_blocks(vlp16_handler) == false) {
+        vlp16_handler->communication_status.decode_error_occurs = true;
+        ++vlp16_handler->communication_status.number_of_decode_errors;
+        return false;
+    }
+
+    ++vlp16_handler->communication_status.number_of_accepted_packets;
+
+    // reset no reply interval timer
+    vlp16_handler->no_reply_interval_timer.SetIntervalStart();
+
+    if (is_opened_packet_recorder(&vlp16_handler->packet_recorder) == true) {
+        record_vlp16_packet(vlp16_handler);
+    }
+
+    // renew packet information
+    decode_timestamp_and_return_mode_and_sensor_model_of_vlp16_packet(vlp16_handler);
+
+    evaluate_continuity_of_vlp16_packet(vlp16_handler);
 
 
     // renew data block accessor
-    const char *packet_data = vlp16_handler->decode_buffer;
+    const char *packet_data = vlp16_handler->decoding_packet;
 
     for (unsigned int block_index = 0; block_index < VLP16_PACKET_NUMBER_OF_DATA_BLOCKS; ++block_index) {
 
@@ -313,14 +1194,252 @@ bool receive_vlp16_packet(vlp16_handler_t *vlp16_handler, int *received_data_len
     return true;
 }
 
-static unsigned int calculate_azimuthal_angle_difference(unsigned int start_angle, unsigned int end_angle)
+/*!
+  \brief function to hold packets received by receive thread in ring slots
+  \attention held slots are decoded in place, and they should be released as soon as they are decoded
+*/
+static int hold_packets_received_by_receive_thread(vlp16_handler_t *vlp16_handler,
+                                                   unsigned int maximum_number_of_packets)
 {
-    unsigned int calculation_end_angle = end_angle;
-    if (start_angle > end_angle) {
-        calculation_end_angle = end_angle + VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+    packet_ring_buffer_t *ring = &vlp16_handler->packet_ring;
+
+    if (wait_for_packets_in_packet_ring_buffer(ring, vlp16_handler->communication_timeout_usec) == false) {
+        return 0;
     }
 
-    return calculation_end_angle - start_angle;
+    unsigned int number_of_packets = 0;
+    const int *received_length_array = NULL;
+    const double *receive_time_usec_array = NULL;
+
+    const char *held_slots =
+        hold_slots_to_read_packet_ring_buffer(ring, maximum_number_of_packets, &number_of_packets,
+                                              &received_length_array, &receive_time_usec_array);
+    if (held_slots == NULL) {
+        return 0;
+    }
+
+    vlp16_handler->held_ring_slot_buffer = held_slots;
+    vlp16_handler->held_ring_slot_received_length = received_length_array;
+    vlp16_handler->held_ring_slot_receive_time_usec = receive_time_usec_array;
+
+    return (int)number_of_packets;
+}
+
+static double calculate_replay_time_of_loaded_pcap_packet(const vlp16_handler_t *vlp16_handler)
+{
+    const pcap_file_reader_t *reader = &vlp16_handler->pcap_reader;
+
+    const double captured_time_difference_usec =
+        calculate_captured_time_difference_usec(vlp16_handler->pcap_first_captured_time_sec,
+                                                vlp16_handler->pcap_first_captured_time_usec,
+                                                reader->captured_time_sec, reader->captured_time_usec);
+
+    return captured_time_difference_usec / vlp16_handler->pcap_replay_speed_ratio;
+}
+
+static void wait_for_replay_time_of_pcap_packet(const vlp16_handler_t *vlp16_handler, double replay_time_usec)
+{
+    const double waiting_time_usec =
+        replay_time_usec - (double)vlp16_handler->pcap_replay_timer.TimeInterval();
+
+    if (waiting_time_usec <= 0.0) {
+        return;
+    }
+
+    // sleep until shortly before replay time, and spin only for rest (wake-up of sleep is late by timer slack)
+    if (waiting_time_usec > (double)VLP16_PCAP_REPLAY_SPIN_WAIT_USEC) {
+        sleep_microsecond(waiting_time_usec - (double)VLP16_PCAP_REPLAY_SPIN_WAIT_USEC);
+    }
+
+    while ((double)vlp16_handler->pcap_replay_timer.TimeInterval() < replay_time_usec) {
+    }
+
+    return;
+}
+
+static int read_packets_from_pcap_file_in_packet_slots(vlp16_handler_t *vlp16_handler,
+                                                       unsigned int maximum_number_of_packets)
+{
+    pcap_file_reader_t *reader = &vlp16_handler->pcap_reader;
+
+    unsigned int number_of_packets = 0;
+
+    while (number_of_packets < maximum_number_of_packets) {
+
+        if (vlp16_handler->pcap_packet_loaded == false) {
+
+            if (read_next_udp_packet_of_pcap_file(reader) == false) {
+                break;
+            }
+            vlp16_handler->pcap_packet_loaded = true;
+
+            if (vlp16_handler->pcap_first_packet_replayed == false) {
+
+                vlp16_handler->pcap_first_captured_time_sec = reader->captured_time_sec;
+                vlp16_handler->pcap_first_captured_time_usec = reader->captured_time_usec;
+                vlp16_handler->pcap_first_packet_replayed = true;
+
+                vlp16_handler->pcap_replay_timer.SetIntervalStart();
+            }
+        }
+
+        if (vlp16_handler->pcap_replay_mode != VLP16_PCAP_REPLAY_MAXIMUM_SPEED) {
+
+            const double replay_time_usec = calculate_replay_time_of_loaded_pcap_packet(vlp16_handler);
+            const double elapsed_time_usec = (double)vlp16_handler->pcap_replay_timer.TimeInterval();
+            const double waiting_time_usec = replay_time_usec - elapsed_time_usec;
+
+            if (waiting_time_usec > 0.0) {
+
+                // wait only for first packet, and loaded packet is delivered on next call
+                if (number_of_packets > 0) {
+                    break;
+                }
+
+                // packet interval longer than timeout is replayed as timeout
+                if ((vlp16_handler->communication_timeout_usec >= 0) &&
+                    (waiting_time_usec > (double)vlp16_handler->communication_timeout_usec)) {
+                    wait_for_replay_time_of_pcap_packet(vlp16_handler,
+                                                        elapsed_time_usec +
+                                                        (double)vlp16_handler->communication_timeout_usec);
+                    break;
+                }
+
+                wait_for_replay_time_of_pcap_packet(vlp16_handler, replay_time_usec);
+            }
+        }
+
+        if (reader->payload_length > (int)VLP16_PACKET_SLOT_LENGTH) {
+
+            vlp16_handler->packet_slot_received_length[number_of_packets] = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+        } else {
+
+            memcpy((void *)(vlp16_handler->packet_slot_buffer + number_of_packets * VLP16_PACKET_SLOT_LENGTH),
+                   (const void *)reader->payload, reader->payload_length);
+            vlp16_handler->packet_slot_received_length[number_of_packets] = reader->payload_length;
+
+        }
+        // replayed packet is received on replay
+        vlp16_handler->packet_slot_receive_time_usec[number_of_packets] = GetNowRealTimeMicroSec();
+
+        vlp16_handler->pcap_packet_loaded = false;
+        ++vlp16_handler->number_of_replayed_packets;
+        ++number_of_packets;
+    }
+
+    if (number_of_packets == 0) {
+        return SOCKET_CLIENT_INVALID_RETURN_VALUE;
+    }
+
+    return (int)number_of_packets;
+}
+
+static void count_received_datagrams_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                     int number_of_datagrams)
+{
+    vlp16_communication_status_t *status = &vlp16_handler->communication_status;
+
+    if (number_of_datagrams > 0) {
+        status->number_of_received_datagrams += (unsigned int)number_of_datagrams;
+    }
+
+    status->number_of_dropped_datagrams = vlp16_handler->socket_handler.number_of_dropped_datagrams;
+
+    if (vlp16_handler->threaded_receive_mode == true) {
+        status->number_of_dropped_datagrams += vlp16_handler->packet_ring.number_of_dropped_packets;
+    }
+
+    return;
+}
+
+static int receive_packets_in_packet_slots(vlp16_handler_t *vlp16_handler,
+                                           unsigned int maximum_number_of_packets)
+{
+    LATENCY_TRACE_BEGIN(receive_start_time_nsec);
+
+    int number_of_datagrams = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+    // packets decoded on previous receiving are no longer referred
+    release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+
+    if (vlp16_handler->packet_source_type == VLP16_PACKET_SOURCE_PCAP_FILE) {
+
+        number_of_datagrams = read_packets_from_pcap_file_in_packet_slots(vlp16_handler, maximum_number_of_packets);
+
+    } else if (vlp16_handler->threaded_receive_mode == true) {
+
+        number_of_datagrams = hold_packets_received_by_receive_thread(vlp16_handler, maximum_number_of_packets);
+
+    } else {
+
+        number_of_datagrams =
+            receive_datagrams_using_socket_client(&vlp16_handler->socket_handler,
+                                                  vlp16_handler->packet_slot_buffer, VLP16_PACKET_SLOT_LENGTH,
+                                                  maximum_number_of_packets,
+                                                  vlp16_handler->packet_slot_received_length,
+                                                  vlp16_handler->packet_slot_receive_time_usec,
+                                                  vlp16_handler->communication_timeout_usec);
+    }
+
+    count_received_datagrams_of_vlp16_handler(vlp16_handler, number_of_datagrams);
+
+    LATENCY_TRACE_END(receive_start_time_nsec, LATENCY_TRACE_RECEIVE_STAGE);
+
+    return number_of_datagrams;
+}
+
+bool receive_vlp16_packet(vlp16_handler_t *vlp16_handler, int *received_data_length)
+{
+    *received_data_length = SOCKET_CLIENT_INVALID_RETURN_VALUE;
+
+    if (vlp16_handler->packet_slot_buffer == NULL) {
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return false;
+    }
+
+    // receive one datagram directly in first packet slot
+    const int number_of_datagrams =
+        receive_packets_in_packet_slots(vlp16_handler, 1);
+
+    if (number_of_datagrams <= 0) {
+        vlp16_handler->communication_status.decode_error_occurs = true;
+        return false;
+    }
+
+    // packet is decoded after return, so it is copied out of ring not to block receive thread meanwhile
+    if (vlp16_handler->held_ring_slot_buffer != NULL) {
+        memcpy(vlp16_handler->packet_slot_buffer, vlp16_handler->held_ring_slot_buffer, VLP16_PACKET_SLOT_LENGTH);
+        vlp16_handler->packet_slot_received_length[0] = vlp16_handler->held_ring_slot_received_length[0];
+        vlp16_handler->packet_slot_receive_time_usec[0] = vlp16_handler->held_ring_slot_receive_time_usec[0];
+        release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+    }
+    *received_data_length = get_received_length_of_packet_slot(vlp16_handler, 0);
+
+    return accept_vlp16_packet_in_packet_slot(vlp16_handler, 0);
+}
+
+bool receive_vlp16_packet_from_memory(vlp16_handler_t *vlp16_handler, const char *packet, unsigned int packet_length)
+{
+    if (vlp16_handler->packet_slot_buffer == NULL) {
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return false;
+    }
+
+    if (packet_length > VLP16_PACKET_SLOT_LENGTH) {
+        packet_length = VLP16_PACKET_SLOT_LENGTH;
+    }
+
+    release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+
+    // copy packet in first packet slot as received datagram
+    memcpy(vlp16_handler->packet_slot_buffer, packet, packet_length);
+    vlp16_handler->packet_slot_received_length[0] = (int)packet_length;
+    vlp16_handler->packet_slot_receive_time_usec[0] = GetNowRealTimeMicroSec();
+
+    count_received_datagrams_of_vlp16_handler(vlp16_handler, 1);
+
+    return accept_vlp16_packet_in_packet_slot(vlp16_handler, 0);
 }
 
 static void decode_azimuthal_angles_of_single_echo_vlp16_packet(const char **concatenated_data_blocks, unsigned int length_of_concatenated_data_blocks,
@@ -347,6 +1466,8 @@ static void make_default_vlp16_elevation_angle_array(const VLP16_PACKET_SENSOR_M
 
         case VLP16_PACKET_HDL_32E:
         case VLP16_PACKET_VLP16:
+        case VLP16_PACKET_VLP_32C:
+        case VLP16_PACKET_PUCK_HI_RES:
             if (angle_array.size() != VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model]) {
                 angle_array.resize(VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model]);
             }
@@ -358,41 +1479,419 @@ static void make_default_vlp16_elevation_angle_array(const VLP16_PACKET_SENSOR_M
             return;
     }
 
-    if (sensor_model == VLP16_PACKET_VLP16) {
-        *minimum_angle = DBL_MAX;
-        *maximum_angle = -DBL_MAX;
-
-        for (unsigned int spot_index = 0; spot_index < VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model]; ++spot_index) {
-            angle_array.at(spot_index) =
-                VLP16_SPOT_SPECIFIVATION_ELEVATION_ANGLE_DEGREE_ARRAY[spot_index] * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+    const double *elevation_angle_degree_array = VLP16_SENSOR_MODEL_TIMING[sensor_model].elevation_angle_degree_array;
+
+    *minimum_angle = DBL_MAX;
+    *maximum_angle = -DBL_MAX;
+
+    for (unsigned int spot_index = 0; spot_index < VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model]; ++spot_index) {
+        angle_array.at(spot_index) =
+            elevation_angle_degree_array[spot_index] * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+
+        if (angle_array.at(spot_index) < *minimum_angle) {
+            *minimum_angle = angle_array.at(spot_index);
+        }
+        if (angle_array.at(spot_index) > *maximum_angle) {
+            *maximum_angle = angle_array.at(spot_index);
+        }
+
+    }
+
+    return;
+}
+
+/*!
+  \brief function to make elevation angle array of sensor model with vertical corrections of calibration
+  \return true if calibration is applied (calibration is not NULL and it has corrections of all spots)
+*/
+static bool make_calibrated_vlp16_elevation_angle_array(const VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                        const vlp16_calibration_t *calibration,
+                                                        std::vector<double> &angle_array,
+                                                        double *minimum_angle, double *maximum_angle)
+{
+    make_default_vlp16_elevation_angle_array(sensor_model, angle_array, minimum_angle, maximum_angle);
+
+    const unsigned int number_of_spots = angle_array.size();
+
+    if ((calibration == NULL) ||
+        (number_of_spots == 0) ||
+        (calibration->number_of_lasers < number_of_spots)) {
+        return false;
+    }
+
+    *minimum_angle = DBL_MAX;
+    *maximum_angle = -DBL_MAX;
+
+    for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
+        const double elevation_angle = calibration->laser[spot_index].vertical_correction;
+
+        angle_array.at(spot_index) = elevation_angle;
+        if (elevation_angle < *minimum_angle) {
+            *minimum_angle = elevation_angle;
+        }
+        if (elevation_angle > *maximum_angle) {
+            *maximum_angle = elevation_angle;
+        }
+    }
+
+    return true;
+}
+
+static void renew_elevation_angle_tables_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    const bool calibration_applied =
+        make_calibrated_vlp16_elevation_angle_array(vlp16_handler->decoding_packet_sensor_model,
+                                                    (vlp16_handler->calibration_available == true) ?
+                                                    &vlp16_handler->calibration : NULL,
+                                                    vlp16_handler->elevation_angle_array,
+                                                    &vlp16_handler->minimum_elevation_angle,
+                                                    &vlp16_handler->maximum_elevation_angle);
+
+    const unsigned int number_of_spots = vlp16_handler->elevation_angle_array.size();
+
+    vlp16_handler->elevation_angle_cosine_array.resize(number_of_spots);
+    vlp16_handler->elevation_angle_sine_array.resize(number_of_spots);
+
+    for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
+        vlp16_handler->elevation_angle_cosine_array.at(spot_index) =
+            cos(vlp16_handler->elevation_angle_array.at(spot_index));
+        vlp16_handler->elevation_angle_sine_array.at(spot_index) =
+            sin(vlp16_handler->elevation_angle_array.at(spot_index));
+    }
+
+    // corrections are applied to all echoes without branch (offsets are 0 without calibration)
+    clear_calibration_tables_of_vlp16_handler(vlp16_handler);
+    if (calibration_applied == true) {
+        for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
+            const vlp16_laser_calibration_t *laser = &vlp16_handler->calibration.laser[spot_index];
+
+            vlp16_handler->spot_azimuthal_angle_offset_array[spot_index] = -laser->rotational_correction;
+            vlp16_handler->spot_distance_offset_array[spot_index] =
+                (int)floor(laser->distance_correction + 0.5);
+            vlp16_handler->spot_horizontal_distance_offset_array[spot_index] =
+                laser->vertical_offset_correction * vlp16_handler->elevation_angle_sine_array.at(spot_index);
+            vlp16_handler->spot_z_component_offset_array[spot_index] =
+                laser->vertical_offset_correction * vlp16_handler->elevation_angle_cosine_array.at(spot_index);
+            vlp16_handler->spot_horizontal_offset_array[spot_index] = laser->horizontal_offset_correction;
+
+            const double azimuthal_angle_offset = vlp16_handler->spot_azimuthal_angle_offset_array[spot_index];
+            if (azimuthal_angle_offset < vlp16_handler->minimum_spot_azimuthal_angle_offset) {
+                vlp16_handler->minimum_spot_azimuthal_angle_offset = azimuthal_angle_offset;
+            }
+            if (azimuthal_angle_offset > vlp16_handler->maximum_spot_azimuthal_angle_offset) {
+                vlp16_handler->maximum_spot_azimuthal_angle_offset = azimuthal_angle_offset;
+            }
+        }
+    }
+
+    make_vlp16_spot_time_offset_table(vlp16_handler->sensor_model_timing->one_laser_firing_interval_usec, number_of_spots,
+                                      vlp16_handler->sensor_model_timing->number_of_simultaneous_firings,
+                                      vlp16_handler->spot_time_offset_usec_array);
+
+    return;
+}
+
+bool compile_lidar_echo_region_set_for_vlp16_sensor_model(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                          const std::vector<lidar_echo_single_region_t> &regions,
+                                                          unsigned int number_of_azimuth_buckets,
+                                                          lidar_echo_region_set_t *region_set)
+{
+    if ((sensor_model == VLP16_PACKET_INVALID_SENSOR_MODEL) ||
+        (sensor_model == NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET)) {
+        return false;
+    }
+
+    std::vector<double> elevation_angle_array;
+    double minimum_elevation_angle = 0.0;
+    double maximum_elevation_angle = 0.0;
+
+    make_default_vlp16_elevation_angle_array(sensor_model, elevation_angle_array,
+                                             &minimum_elevation_angle, &maximum_elevation_angle);
+
+    return compile_lidar_echo_region_set(regions, elevation_angle_array, number_of_azimuth_buckets, region_set);
+}
+
+bool compile_lidar_echo_region_set_for_vlp16_handler(const vlp16_handler_t *vlp16_handler,
+                                                     const std::vector<lidar_echo_single_region_t> &regions,
+                                                     unsigned int number_of_azimuth_buckets,
+                                                     lidar_echo_region_set_t *region_set)
+{
+    const enum VLP16_PACKET_SENSOR_MODEL sensor_model = vlp16_handler->line_data_sensor_model;
+
+    if ((sensor_model == VLP16_PACKET_INVALID_SENSOR_MODEL) ||
+        (sensor_model == NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET)) {
+        return false;
+    }
+
+    // same elevation angles as renew_elevation_angle_tables_of_vlp16_handler (tables may not be renewed before first packet)
+    std::vector<double> elevation_angle_array;
+    double minimum_elevation_angle = 0.0;
+    double maximum_elevation_angle = 0.0;
+
+    make_calibrated_vlp16_elevation_angle_array(sensor_model,
+                                                (vlp16_handler->calibration_available == true) ?
+                                                &vlp16_handler->calibration : NULL,
+                                                elevation_angle_array,
+                                                &minimum_elevation_angle, &maximum_elevation_angle);
+
+    return compile_lidar_echo_region_set(regions, elevation_angle_array, number_of_azimuth_buckets, region_set);
+}
+
+bool set_decode_kernel_of_vlp16_handler(vlp16_handler_t *vlp16_handler, enum VLP16_DECODE_KERNEL_TYPE kernel_type)
+{
+    const vlp16_firing_sequence_decoder_t firing_sequence_decoder_array[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET] =
+        { get_firing_sequence_decoder_of_vlp16_sensor_model<hdl_32e_sensor_model_traits_t>(kernel_type),
+          get_firing_sequence_decoder_of_vlp16_sensor_model<vlp16_sensor_model_traits_t>(kernel_type),
+          get_firing_sequence_decoder_of_vlp16_sensor_model<vlp_32c_sensor_model_traits_t>(kernel_type),
+          get_firing_sequence_decoder_of_vlp16_sensor_model<puck_hi_res_sensor_model_traits_t>(kernel_type) };
+
+    for (unsigned int i = 0; i < NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET; ++i) {
+        if (firing_sequence_decoder_array[i] == NULL) {
+            return false;
+        }
+    }
+
+    vlp16_handler->decode_kernel_type = kernel_type;
+    for (unsigned int i = 0; i < NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET; ++i) {
+        vlp16_handler->firing_sequence_decoder_array[i] = firing_sequence_decoder_array[i];
+    }
+
+    return true;
+}
+
+bool set_calibration_of_vlp16_handler(vlp16_handler_t *vlp16_handler, const vlp16_calibration_t *calibration)
+{
+    if (calibration == NULL) {
+        clear_vlp16_calibration(&vlp16_handler->calibration);
+        vlp16_handler->calibration_available = false;
+    } else {
+        if (calibration->number_of_lasers == 0) {
+            return false;
+        }
+        vlp16_handler->calibration = *calibration;
+        vlp16_handler->calibration_available = true;
+    }
+
+    // tables are renewed on decoding first packet if sensor model is not decided
+    if (vlp16_handler->sensor_model_timing != NULL) {
+        renew_elevation_angle_tables_of_vlp16_handler(vlp16_handler);
+    }
+
+    return true;
+}
+
+void set_point_block_output_of_vlp16_handler(vlp16_handler_t *vlp16_handler, lidar_point_block_t *point_block)
+{
+    vlp16_handler->point_block_output = point_block;
+
+    return;
+}
+
+bool allocate_frame_assembler_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                unsigned int maximum_number_of_lines)
+{
+    if ((sensor_model == VLP16_PACKET_INVALID_SENSOR_MODEL) ||
+        (sensor_model == NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET)) {
+        return false;
+    }
+
+    if (is_allocated_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler) == true) {
+        release_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler);
+    }
+
+    const unsigned int maximum_number_of_points = maximum_number_of_lines *
+        VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model] * VLP16_MAXIMUM_NUMBER_OF_ECHOES_OF_SPOT_IN_FRAME;
+
+    if (allocate_memory_for_lidar_frame_assembler(&vlp16_handler->frame_assembler,
+                                                  maximum_number_of_lines, maximum_number_of_points) == false) {
+        return false;
+    }
+
+    vlp16_handler->past_line_start_azimuthal_angle_available = false;
+
+    return true;
+}
+
+const lidar_frame_t *get_completed_frame_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    return get_completed_frame_of_lidar_frame_assembler(&vlp16_handler->frame_assembler);
+}
+
+static void start_line_of_frame_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                 unsigned int line_start_azimuthal_angle,
+                                                 unsigned int line_start_timestamp)
+{
+    if (is_allocated_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler) == false) {
+        return;
+    }
+
+    // line start of even firing sequence may exceed one rotation
+    unsigned int azimuthal_angle = line_start_azimuthal_angle;
+    if (azimuthal_angle >= VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE) {
+        azimuthal_angle -= VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+    }
+
+    if (vlp16_handler->past_line_start_azimuthal_angle_available == true) {
+
+        const unsigned int azimuthal_angle_difference =
+            calculate_azimuthal_angle_difference(vlp16_handler->past_line_start_azimuthal_angle, azimuthal_angle);
+
+        // backward jitter of azimuthal angle is not regarded as wrap around
+        if ((azimuthal_angle_difference < (VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE / 2)) &&
+            (vlp16_handler->past_line_start_azimuthal_angle + azimuthal_angle_difference >= VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE)) {
+            complete_frame_of_lidar_frame_assembler(&vlp16_handler->frame_assembler);
+        }
+
+    }
+
+    vlp16_handler->past_line_start_azimuthal_angle = azimuthal_angle;
+    vlp16_handler->past_line_start_azimuthal_angle_available = true;
+
+    start_line_of_lidar_frame_assembler(&vlp16_handler->frame_assembler, line_start_timestamp);
+
+    return;
+}
+
+static void append_vlp16_echo_to_point_block(vlp16_handler_t *vlp16_handler,
+                                             unsigned int spot_index, const lidar_echo_data_t *echo)
+{
+    // points are counted in number_of_dropped_points of point block if it is full
+    if (vlp16_handler->point_block_output != NULL) {
+        append_point_to_lidar_point_block(vlp16_handler->point_block_output,
+                                          echo->horizontal_angle, echo->elevation_angle,
+                                          echo->distance, echo->intensity, spot_index,
+                                          echo->index, echo->number_of_echoes_at_same_time,
+                                          echo->measured_time);
+    }
+
+    if (is_allocated_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler) == true) {
+        append_point_to_lidar_frame_assembler(&vlp16_handler->frame_assembler,
+                                              echo->horizontal_angle, echo->elevation_angle,
+                                              echo->distance, echo->intensity, spot_index,
+                                              echo->index, echo->number_of_echoes_at_same_time,
+                                              echo->measured_time);
+    }
+
+    return;
+}
+
+template <class SENSOR_MODEL_TRAITS>
+static void decode_firing_sequence_of_vlp16_packet(const vlp16_handler_t *vlp16_handler,
+                                                   unsigned int line_start_timestamp, double start_azimuthal_angle,
+                                                   double one_firing_azimuthal_angle_step,
+                                                   const char *data_buffer,
+                                                   vlp16_firing_sequence_lanes_t *lanes)
+{
+    vlp16_firing_sequence_parameter_t parameter;
+
+    parameter.line_start_timestamp = line_start_timestamp;
+    parameter.start_azimuthal_angle = start_azimuthal_angle;
+    parameter.one_firing_azimuthal_angle_step = one_firing_azimuthal_angle_step;
+    parameter.spot_time_offset_usec = vlp16_handler->spot_time_offset_usec_array;
+    parameter.spot_azimuthal_angle_offset = vlp16_handler->spot_azimuthal_angle_offset_array;
+    parameter.spot_distance_offset = vlp16_handler->spot_distance_offset_array;
+
+    // kernel of sensor model is instantiated for its number of spots and simultaneous firings
+    vlp16_handler->firing_sequence_decoder_array[SENSOR_MODEL_TRAITS::SENSOR_MODEL](data_buffer, &parameter, lanes);
+
+    return;
+}
+
+//! structure of cosine and sine of one azimuthal angle
+struct vlp16_azimuthal_angle_trigonometric_value_t {
+
+    //! cosine
+    double cosine;
+
+    //! sine
+    double sine;
+};
+
+//! table of cosine and sine of each azimuthal angle [0.01 degree]
+static vlp16_azimuthal_angle_trigonometric_value_t vlp16_azimuthal_angle_trigonometric_table[VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE];
+
+//! once control of vlp16_azimuthal_angle_trigonometric_table (handlers may enable cartesian output on different threads)
+static pthread_once_t vlp16_azimuthal_angle_trigonometric_table_once = PTHREAD_ONCE_INIT;
+
+static void fill_vlp16_azimuthal_angle_trigonometric_table(void)
+{
+    for (unsigned int i = 0; i < VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE; ++i) {
+        vlp16_azimuthal_angle_trigonometric_table[i].cosine = cos(VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)i);
+        vlp16_azimuthal_angle_trigonometric_table[i].sine = sin(VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)i);
+    }
+
+    return;
+}
+
+/*!
+  \brief function to initialize vlp16_azimuthal_angle_trigonometric_table
+  \attention table is filled only once, and other callers wait until it is filled
+*/
+static void initialize_vlp16_azimuthal_angle_trigonometric_table(void)
+{
+    pthread_once(&vlp16_azimuthal_angle_trigonometric_table_once, fill_vlp16_azimuthal_angle_trigonometric_table);
+
+    return;
+}
+
+void set_cartesian_output_of_vlp16_handler(vlp16_handler_t *vlp16_handler, bool cartesian_output_enabled)
+{
+    if (cartesian_output_enabled == true) {
+        initialize_vlp16_azimuthal_angle_trigonometric_table();
+    }
+
+    vlp16_handler->cartesian_output_enabled = cartesian_output_enabled;
+
+    return;
+}
+
+static void calculate_cartesian_coordinates_of_vlp16_echo(const vlp16_handler_t *vlp16_handler,
+                                                          unsigned int spot_index,
+                                                          lidar_echo_data_t *echo)
+{
+    if (vlp16_handler->cartesian_output_enabled == false) {
+        echo->cartesian_coordinates_available = false;
+        return;
+    }
+
+    // nearest azimuthal angle in table (horizontal angle of interpolated spot may exceed one rotation,
+    // and horizontal angle of calibrated spot may be negative)
+    int azimuthal_angle_index =
+        (int)floor(echo->horizontal_angle * VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE_INVERSE + 0.5) %
+        (int)VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+    if (azimuthal_angle_index < 0) {
+        azimuthal_angle_index += VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+    }
 
-            if (angle_array.at(spot_index) < *minimum_angle) {
-                *minimum_angle = angle_array.at(spot_index);
-            }
-            if (angle_array.at(spot_index) > *maximum_angle) {
-                *maximum_angle = angle_array.at(spot_index);
-            }
+    const vlp16_azimuthal_angle_trigonometric_value_t *azimuthal_angle_value =
+        &vlp16_azimuthal_angle_trigonometric_table[azimuthal_angle_index];
 
-        }
+    // offsets of laser position are 0 without calibration
+    const double horizontal_distance =
+        (double)echo->distance * vlp16_handler->elevation_angle_cosine_array[spot_index] -
+        vlp16_handler->spot_horizontal_distance_offset_array[spot_index];
+    const double horizontal_offset = vlp16_handler->spot_horizontal_offset_array[spot_index];
 
-    } else if (sensor_model == VLP16_PACKET_HDL_32E) {
+    echo->x_component = horizontal_distance * azimuthal_angle_value->cosine + horizontal_offset * azimuthal_angle_value->sine;
+    echo->y_component = horizontal_distance * azimuthal_angle_value->sine - horizontal_offset * azimuthal_angle_value->cosine;
+    echo->z_component = (double)echo->distance * vlp16_handler->elevation_angle_sine_array[spot_index] +
+        vlp16_handler->spot_z_component_offset_array[spot_index];
 
-    }
+    echo->cartesian_coordinates_available = true;
 
     return;
 }
 
-static void decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handler,
+template <class SENSOR_MODEL_TRAITS>
+static void decode_one_line_data_of_single_echo_vlp16_packet(const vlp16_handler_t *vlp16_handler,
+                                                             double receive_time_usec,
                                                              unsigned int line_start_timestamp, double start_azimuthal_angle,
-                                                             double one_spot_azimuthal_angle_step,
-                                                             const char *data_buffer)
+                                                             double one_firing_azimuthal_angle_step,
+                                                             const char *data_buffer,
+                                                             lidar_line_data_t *line_data)
 {
-
-    lidar_line_circular_buffer_t *line_data_buffer = &vlp16_handler->line_data_buffer;
-    lidar_line_data_t *line_data =
-        get_pointer_to_copy_lidar_line_data(line_data_buffer,
-                                            LIDAR_LINE_CIRCULAR_BUFFER_OVERWRITE);
-
+    line_data->receive_time_usec = receive_time_usec;
     line_data->minimum_horizontal_angle = start_azimuthal_angle;
 
     line_data->next_data_index = 0;
@@ -407,21 +1906,23 @@ static void decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler_t *vl
 
     lidar_spot_accessor_t *spot = &line_data->spot[spot_index];
 
-    unsigned int binary_data_index = 0;
-
-    const unsigned int number_of_spots = VLP16_PACKET_NUMBER_OF_SPOTS[vlp16_handler->decoding_packet_sensor_model];
+    // number of spots is compile-time constant of sensor model, and loops of spots can be unrolled
+    const unsigned int number_of_spots = SENSOR_MODEL_TRAITS::NUMBER_OF_SPOTS;
+    // horizontal angle range of line includes rotational corrections of spots
+    line_data->minimum_horizontal_angle += vlp16_handler->minimum_spot_azimuthal_angle_offset;
     line_data->maximum_horizontal_angle =
-        start_azimuthal_angle + one_spot_azimuthal_angle_step * (double)(number_of_spots - 1);
+        start_azimuthal_angle +
+        one_firing_azimuthal_angle_step * (double)((number_of_spots - 1) / SENSOR_MODEL_TRAITS::NUMBER_OF_SIMULTANEOUS_FIRINGS) +
+        vlp16_handler->maximum_spot_azimuthal_angle_offset;
 
-    if (vlp16_handler->elevation_angle_array.size() != number_of_spots) {
-        make_default_vlp16_elevation_angle_array(vlp16_handler->decoding_packet_sensor_model,
-                                                 vlp16_handler->elevation_angle_array,
-                                                 &vlp16_handler->minimum_elevation_angle,
-                                                 &vlp16_handler->maximum_elevation_angle);
-    }
     line_data->minimum_elevation_angle = vlp16_handler->minimum_elevation_angle;
     line_data->maximum_elevation_angle = vlp16_handler->maximum_elevation_angle;
 
+    vlp16_firing_sequence_lanes_t lanes;
+    decode_firing_sequence_of_vlp16_packet<SENSOR_MODEL_TRAITS>(vlp16_handler, line_start_timestamp, start_azimuthal_angle,
+                                                                one_firing_azimuthal_angle_step,
+                                                                data_buffer, &lanes);
+
     // todo set elevation angle
     for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
         spot = &line_data->spot[spot_index];
@@ -434,21 +1935,17 @@ static void decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler_t *vl
         echo->index = echo_index + 1;
         echo->number_of_echoes_at_same_time = spot->number_of_echoes;
 
-        echo->measured_time = VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC * (double)spot_index + (double)line_start_timestamp;
+        echo->measured_time = lanes.measured_time[spot_index];
         echo->calibrated_time = echo->measured_time;
 
-        echo->horizontal_angle = one_spot_azimuthal_angle_step * (double)(spot_index) + start_azimuthal_angle;
+        echo->horizontal_angle = lanes.horizontal_angle[spot_index];
 
-        echo->elevation_angle = vlp16_handler->elevation_angle_array.at(spot_index);
+        echo->elevation_angle = vlp16_handler->elevation_angle_array[spot_index];
 
-        echo->distance = VLP16_PACKET_DISTANCE_SCALE *
-            (double)decode_unsigned_value(data_buffer + binary_data_index,
-                                          VLP16_PACKET_DISTANCE_LENGTH, false);
-        binary_data_index += VLP16_PACKET_DISTANCE_LENGTH;
+        echo->distance = lanes.distance[spot_index];
+        echo->intensity = lanes.intensity[spot_index];
 
-        echo->intensity = (double)decode_unsigned_value(data_buffer + binary_data_index,
-                                                        VLP16_PACKET_REFLECTIVITY_LENGTH, false);
-        binary_data_index += VLP16_PACKET_REFLECTIVITY_LENGTH;
+        calculate_cartesian_coordinates_of_vlp16_echo(vlp16_handler, spot_index, echo);
 
         spot->echo[echo_index] = (int)echo_buffer_index;
         ++echo_buffer_index;
@@ -459,73 +1956,177 @@ static void decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler_t *vl
         }
 
     }
-    move_copy_destination_point(line_data_buffer, 1);
 
     return;
 }
 
-static unsigned int decode_one_data_block_of_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handler,
-                                                                      unsigned int data_block_start_timestamp,
-                                                                      unsigned int start_azimuthal_angle, unsigned int end_azimuthal_angle,
-                                                                      const char *data_buffer)
+template <class SENSOR_MODEL_TRAITS>
+static void decode_one_data_block_of_single_echo_vlp16_packet(const vlp16_handler_t *vlp16_handler,
+                                                              const vlp16_data_block_decode_task_t *task)
 {
-    unsigned int captured_line_count = 0;
+    const double one_firing_azimuthal_angle_step =
+        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * SENSOR_MODEL_TRAITS::one_firing_ratio_to_data_block() * (double)task->azimuthal_angle_difference;
+
+    // VLP-16 and Puck Hi-Res fire two sequences in one data block, and HDL-32E and VLP-32C fire one sequence
+    for (unsigned int sequence_index = 0; sequence_index < SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK; ++sequence_index) {
+
+        decode_one_line_data_of_single_echo_vlp16_packet<SENSOR_MODEL_TRAITS>(vlp16_handler, task->receive_time_usec,
+                                                                              task->line_start_timestamp[sequence_index],
+                                                                              VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)task->line_start_azimuthal_angle[sequence_index],
+                                                                              one_firing_azimuthal_angle_step,
+                                                                              task->first_data_block + VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK +
+                                                                              sequence_index * SENSOR_MODEL_TRAITS::FIRING_SEQUENCE_LENGTH,
+                                                                              task->line_data[sequence_index]);
+    }
 
-    const unsigned int azimuthal_angle_difference =
-        calculate_azimuthal_angle_difference(start_azimuthal_angle, end_azimuthal_angle);
+    return;
+}
 
-    const double one_spot_azimuthal_angle_step =
-        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * VLP16_PACKET_ONE_LASER_FIRING_RATIO_TO_ONE_FIRING_SEQUENCE * (double)azimuthal_angle_difference;
+/*!
+  \brief function to output echoes of lines of decoded data block to frame assembler and point block
+  \attention this function is called in order of data blocks, because frame and point block are filled sequentially
+*/
+static void output_lines_of_vlp16_data_block_decode_task(vlp16_handler_t *vlp16_handler,
+                                                         const vlp16_data_block_decode_task_t *task)
+{
+    if ((vlp16_handler->point_block_output == NULL) &&
+        (is_allocated_memory_of_lidar_frame_assembler(&vlp16_handler->frame_assembler) == false)) {
+        return;
+    }
+
+    const unsigned int number_of_spots = vlp16_handler->sensor_model_timing->number_of_spots;
+
+    for (unsigned int line_index = 0; line_index < task->number_of_lines; ++line_index) {
 
-    const double scaled_start_azimuthal_angle =
-        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)start_azimuthal_angle;
+        start_line_of_frame_of_vlp16_handler(vlp16_handler, task->line_start_azimuthal_angle[line_index],
+                                             task->line_start_timestamp[line_index]);
 
-    // decode first line
-    decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler,
-                                                     data_block_start_timestamp, scaled_start_azimuthal_angle,
-                                                     one_spot_azimuthal_angle_step,
-                                                     data_buffer + VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK);
-    ++captured_line_count;
+        const lidar_line_data_t *line_data = task->line_data[line_index];
 
-    // decode second line
-    if (vlp16_handler->decoding_packet_sensor_model == VLP16_PACKET_VLP16) {
+        for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
 
-        const double start_line_azimuthal_angle_start =
-            VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)(start_azimuthal_angle + (azimuthal_angle_difference / 2));
+            const lidar_spot_accessor_t *spot = &line_data->spot[spot_index];
 
-        decode_one_line_data_of_single_echo_vlp16_packet(vlp16_handler,
-                                                         data_block_start_timestamp + (unsigned int)VLP16_PACKET_LASER_FIRING_SEQUENCE_USEC,
-                                                         start_line_azimuthal_angle_start,
-                                                         one_spot_azimuthal_angle_step,
-                                                         data_buffer + VLP16_PACKET_EVEN_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK);
-        ++captured_line_count;
+            for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+                append_vlp16_echo_to_point_block(vlp16_handler, spot_index,
+                                                 &line_data->echo_buffer[spot->echo[echo_index]]);
+            }
+        }
     }
 
-    return captured_line_count;
+    return;
 }
 
-static unsigned int decode_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handler)
+static void decode_data_block_of_vlp16_data_block_decode_task(void *argument, unsigned int task_index)
 {
-    const unsigned int length_of_concatenated_data_blocks =
-        VLP16_PACKET_NUMBER_OF_DATA_BLOCKS + vlp16_handler->number_of_remaining_data_blocks;
-    const char ** concatenated_data_blocks =
-        (const char**)malloc(length_of_concatenated_data_blocks * sizeof(const char *));
+    const vlp16_handler_t *vlp16_handler = (const vlp16_handler_t *)argument;
+    const vlp16_data_block_decode_task_t *task = &vlp16_handler->data_block_decode_tasks[task_index];
 
-    if (concatenated_data_blocks == NULL) {
-        return 0;
+    task->decoder(vlp16_handler, task);
+
+    return;
+}
+
+/*!
+  \brief function to decode lines of resolved data blocks and to output them in order of data blocks
+  \attention lines are decoded on decode pool if number of data blocks is enough to share among workers
+*/
+static void decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    const unsigned int number_of_tasks = vlp16_handler->data_block_decode_tasks.size();
+    if (number_of_tasks == 0) {
+        return;
+    }
+
+    if ((vlp16_handler->decode_pool != NULL) &&
+        (number_of_tasks >= VLP16_MINIMUM_NUMBER_OF_DATA_BLOCKS_TO_DECODE_IN_PARALLEL)) {
+
+        // each task writes only its preassigned line slots
+        run_tasks_on_work_stealing_pool(vlp16_handler->decode_pool, number_of_tasks,
+                                        decode_data_block_of_vlp16_data_block_decode_task, (void *)vlp16_handler);
+
+        for (unsigned int i = 0; i < number_of_tasks; ++i) {
+            output_lines_of_vlp16_data_block_decode_task(vlp16_handler, &vlp16_handler->data_block_decode_tasks[i]);
+        }
+
+    } else {
+
+        for (unsigned int i = 0; i < number_of_tasks; ++i) {
+            const vlp16_data_block_decode_task_t *task = &vlp16_handler->data_block_decode_tasks[i];
+
+            task->decoder(vlp16_handler, task);
+            output_lines_of_vlp16_data_block_decode_task(vlp16_handler, task);
+        }
+
+    }
+
+    vlp16_handler->data_block_decode_tasks.clear();
+    vlp16_handler->number_of_reserved_lines = 0;
+
+    return;
+}
+
+/*!
+  \brief function to add decode task of data block whose continuity is resolved
+  \attention line slots are reserved in order of data blocks, and resolved data blocks are decoded before reserved slots wrap around
+*/
+template <class SENSOR_MODEL_TRAITS>
+static void add_vlp16_data_block_decode_task(vlp16_handler_t *vlp16_handler, vlp16_data_block_decoder_t decoder,
+                                             unsigned int data_block_start_timestamp,
+                                             unsigned int start_azimuthal_angle, unsigned int end_azimuthal_angle,
+                                             const char *first_data_block, const char *second_data_block)
+{
+    const unsigned int number_of_lines = SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK;
+
+    if (vlp16_handler->number_of_reserved_lines + number_of_lines > vlp16_handler->line_data_buffer.length) {
+        decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler);
+    }
+
+    vlp16_data_block_decode_task_t task;
+
+    task.decoder = decoder;
+    task.first_data_block = first_data_block;
+    task.second_data_block = second_data_block;
+    task.receive_time_usec = vlp16_handler->decoding_packet_receive_time_usec;
+    task.azimuthal_angle_difference =
+        calculate_azimuthal_angle_difference(start_azimuthal_angle, end_azimuthal_angle);
+    task.number_of_lines = number_of_lines;
+
+    for (unsigned int sequence_index = 0; sequence_index < number_of_lines; ++sequence_index) {
+
+        task.line_start_azimuthal_angle[sequence_index] = start_azimuthal_angle +
+            (task.azimuthal_angle_difference * sequence_index) / number_of_lines;
+        task.line_start_timestamp[sequence_index] = data_block_start_timestamp +
+            (unsigned int)(SENSOR_MODEL_TRAITS::firing_sequence_usec() * (double)sequence_index);
+
+        task.line_data[sequence_index] =
+            get_pointer_to_copy_lidar_line_data(&vlp16_handler->line_data_buffer,
+                                                LIDAR_LINE_CIRCULAR_BUFFER_OVERWRITE);
+        move_copy_destination_point(&vlp16_handler->line_data_buffer, 1);
     }
 
+    vlp16_handler->number_of_reserved_lines += number_of_lines;
+    vlp16_handler->data_block_decode_tasks.push_back(task);
+
+    return;
+}
+
+template <class SENSOR_MODEL_TRAITS>
+static unsigned int resolve_data_blocks_of_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handler)
+{
+    const unsigned int length_of_concatenated_data_blocks =
+        VLP16_PACKET_NUMBER_OF_DATA_BLOCKS + vlp16_handler->number_of_remaining_data_blocks;
+    const char *concatenated_data_blocks[VLP16_MAXIMUM_NUMBER_OF_CONCATENATED_DATA_BLOCKS];
+
     for (unsigned int i = 0; i < vlp16_handler->number_of_remaining_data_blocks; ++i) {
-        concatenated_data_blocks[i] = vlp16_handler->remaining_data_block_buffer[i];
+        concatenated_data_blocks[i] = vlp16_handler->remaining_data_blocks[i];
     }
 
     for (unsigned int i = 0; i < VLP16_PACKET_NUMBER_OF_DATA_BLOCKS; ++i) {
         concatenated_data_blocks[i + vlp16_handler->number_of_remaining_data_blocks] = vlp16_handler->decoding_data_blocks[i];
     }
 
-    unsigned int *angle_buffer = NULL;
-    angle_buffer =
-        (unsigned int *) malloc(length_of_concatenated_data_blocks * sizeof(unsigned int));
+    unsigned int angle_buffer[VLP16_MAXIMUM_NUMBER_OF_CONCATENATED_DATA_BLOCKS];
 
     decode_azimuthal_angles_of_single_echo_vlp16_packet(concatenated_data_blocks, length_of_concatenated_data_blocks,
                                                         angle_buffer);
@@ -560,7 +2161,7 @@ static unsigned int decode_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handl
     unsigned int start_data_block_timestamp_usec = vlp16_handler->decoding_packet_timestamp_usec;
     if (start_offset > 0) {
 
-        unsigned int offset_of_timestamp = (unsigned int)(VLP16_PACKET_ONE_DATA_BLOCK_USEC * (double)start_offset);
+        unsigned int offset_of_timestamp = (unsigned int)(SENSOR_MODEL_TRAITS::data_block_usec() * (double)start_offset);
 
         if (start_data_block_timestamp_usec < offset_of_timestamp) {
             start_data_block_timestamp_usec = VLP16_PACKET_MAXIMUM_TIMESTAMP + start_data_block_timestamp_usec - offset_of_timestamp;
@@ -576,12 +2177,14 @@ static unsigned int decode_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handl
     for (unsigned int i = start_data_index; i < end_data_index_out; ++i) {
 
         data_block_start_timestamp = start_data_block_timestamp_usec +
-            (unsigned int)(VLP16_PACKET_ONE_DATA_BLOCK_USEC * (double)i);
+            (unsigned int)(SENSOR_MODEL_TRAITS::data_block_usec() * (double)i);
 
-        number_of_captured_lines += decode_one_data_block_of_single_echo_vlp16_packet(vlp16_handler,
-                                                                                      data_block_start_timestamp,
-                                                                                      angle_buffer[i], angle_buffer[i + 1],
-                                                                                      concatenated_data_blocks[i]);
+        add_vlp16_data_block_decode_task<SENSOR_MODEL_TRAITS>(vlp16_handler,
+                                                              decode_one_data_block_of_single_echo_vlp16_packet<SENSOR_MODEL_TRAITS>,
+                                                              data_block_start_timestamp,
+                                                              angle_buffer[i], angle_buffer[i + 1],
+                                                              concatenated_data_blocks[i], NULL);
+        number_of_captured_lines += SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK;
 
     }
 
@@ -607,16 +2210,13 @@ static unsigned int decode_single_echo_vlp16_packet(vlp16_handler_t *vlp16_handl
         continuous_remaining_start_index = end_data_index_out;
     }
 
+    // remaining data blocks stay in packet slots until they are stored after decoding
     for (unsigned int i = continuous_remaining_start_index; i < length_of_concatenated_data_blocks; ++i) {
-        memcpy(vlp16_handler->remaining_data_block_buffer[i - continuous_remaining_start_index],
-               concatenated_data_blocks[i], VLP16_PACKET_DATA_BLOCK_LENGTH);
+        vlp16_handler->remaining_data_blocks[i - continuous_remaining_start_index] = concatenated_data_blocks[i];
     }
 
     vlp16_handler->number_of_remaining_data_blocks = length_of_concatenated_data_blocks - continuous_remaining_start_index;
 
-    free(angle_buffer);
-    free(concatenated_data_blocks);
-
     return number_of_captured_lines;
 }
 
@@ -638,17 +2238,15 @@ static void decode_azimuthal_angles_of_dual_echo_vlp16_packet(const char **conca
     return;
 }
 
-static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp16_handler,
+template <class SENSOR_MODEL_TRAITS>
+static void decode_one_line_data_of_dual_echo_vlp16_packet(const vlp16_handler_t *vlp16_handler,
+                                                           double receive_time_usec,
                                                            unsigned int line_start_timestamp, double start_azimuthal_angle,
-                                                           double one_spot_azimuthal_angle_step,
-                                                           const char *first_data_buffer, const char *second_data_buffer)
+                                                           double one_firing_azimuthal_angle_step,
+                                                           const char *first_data_buffer, const char *second_data_buffer,
+                                                           lidar_line_data_t *line_data)
 {
-
-    lidar_line_circular_buffer_t *line_data_buffer = &vlp16_handler->line_data_buffer;
-    lidar_line_data_t *line_data =
-        get_pointer_to_copy_lidar_line_data(line_data_buffer,
-                                            LIDAR_LINE_CIRCULAR_BUFFER_OVERWRITE);
-
+    line_data->receive_time_usec = receive_time_usec;
     line_data->minimum_horizontal_angle = start_azimuthal_angle;
     line_data->next_data_index = 0;
 
@@ -662,45 +2260,34 @@ static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp1
 
     lidar_spot_accessor_t *spot = &line_data->spot[spot_index];
 
-    unsigned int binary_data_index = 0;
-
-    const unsigned int number_of_spots = VLP16_PACKET_NUMBER_OF_SPOTS[vlp16_handler->decoding_packet_sensor_model];
+    // number of spots is compile-time constant of sensor model, and loops of spots can be unrolled
+    const unsigned int number_of_spots = SENSOR_MODEL_TRAITS::NUMBER_OF_SPOTS;
+    // horizontal angle range of line includes rotational corrections of spots
+    line_data->minimum_horizontal_angle += vlp16_handler->minimum_spot_azimuthal_angle_offset;
     line_data->maximum_horizontal_angle =
-        start_azimuthal_angle + one_spot_azimuthal_angle_step * (double)(number_of_spots - 1);
+        start_azimuthal_angle +
+        one_firing_azimuthal_angle_step * (double)((number_of_spots - 1) / SENSOR_MODEL_TRAITS::NUMBER_OF_SIMULTANEOUS_FIRINGS) +
+        vlp16_handler->maximum_spot_azimuthal_angle_offset;
 
-    if (vlp16_handler->elevation_angle_array.size() != number_of_spots) {
-        make_default_vlp16_elevation_angle_array(vlp16_handler->decoding_packet_sensor_model,
-                                                 vlp16_handler->elevation_angle_array,
-                                                 &vlp16_handler->minimum_elevation_angle,
-                                                 &vlp16_handler->maximum_elevation_angle);
-    }
     line_data->minimum_elevation_angle = vlp16_handler->minimum_elevation_angle;
     line_data->maximum_elevation_angle = vlp16_handler->maximum_elevation_angle;
 
-    unsigned int last_echo_distance = 0;
-    unsigned int last_echo_intensity = 0;
+    vlp16_firing_sequence_lanes_t last_echo_lanes;
+    decode_firing_sequence_of_vlp16_packet<SENSOR_MODEL_TRAITS>(vlp16_handler, line_start_timestamp, start_azimuthal_angle,
+                                                                one_firing_azimuthal_angle_step,
+                                                                first_data_buffer, &last_echo_lanes);
 
-    unsigned int strongest_echo_distance = 0;
-    unsigned int strongest_echo_intensity = 0;
+    vlp16_firing_sequence_lanes_t strongest_echo_lanes;
+    decode_firing_sequence_of_vlp16_packet<SENSOR_MODEL_TRAITS>(vlp16_handler, line_start_timestamp, start_azimuthal_angle,
+                                                                one_firing_azimuthal_angle_step,
+                                                                second_data_buffer, &strongest_echo_lanes);
 
     // todo set elevation angle
     for (unsigned int spot_index = 0; spot_index < number_of_spots; ++spot_index) {
         spot = &line_data->spot[spot_index];
 
-        last_echo_distance = decode_unsigned_value(first_data_buffer + binary_data_index,
-                                                   VLP16_PACKET_DISTANCE_LENGTH, false);
-
-        strongest_echo_distance = decode_unsigned_value(second_data_buffer + binary_data_index,
-                                                        VLP16_PACKET_DISTANCE_LENGTH, false);
-
-        binary_data_index += VLP16_PACKET_DISTANCE_LENGTH;
-
-        last_echo_intensity = (double)decode_unsigned_value(first_data_buffer + binary_data_index,
-                                                            VLP16_PACKET_REFLECTIVITY_LENGTH, false);
-
-        strongest_echo_intensity = (double)decode_unsigned_value(second_data_buffer + binary_data_index,
-                                                                 VLP16_PACKET_REFLECTIVITY_LENGTH, false);
-        binary_data_index += VLP16_PACKET_REFLECTIVITY_LENGTH;
+        const unsigned int last_echo_distance = last_echo_lanes.distance[spot_index];
+        const unsigned int strongest_echo_distance = strongest_echo_lanes.distance[spot_index];
 
         if (last_echo_distance == strongest_echo_distance) {
 
@@ -712,14 +2299,16 @@ static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp1
             echo->index = echo_index + 1;
             echo->number_of_echoes_at_same_time = spot->number_of_echoes;
 
-            echo->measured_time = VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC * (double)spot_index + (double)line_start_timestamp;
+            echo->measured_time = last_echo_lanes.measured_time[spot_index];
             echo->calibrated_time = echo->measured_time;
 
-            echo->horizontal_angle = one_spot_azimuthal_angle_step * (double)(spot_index) + start_azimuthal_angle;
-            echo->elevation_angle = vlp16_handler->elevation_angle_array.at(spot_index);
+            echo->horizontal_angle = last_echo_lanes.horizontal_angle[spot_index];
+            echo->elevation_angle = vlp16_handler->elevation_angle_array[spot_index];
 
-            echo->distance = VLP16_PACKET_DISTANCE_SCALE * (double)last_echo_distance;
-            echo->intensity = (double)last_echo_intensity;
+            echo->distance = last_echo_distance;
+            echo->intensity = last_echo_lanes.intensity[spot_index];
+
+            calculate_cartesian_coordinates_of_vlp16_echo(vlp16_handler, spot_index, echo);
 
             spot->echo[echo_index] = (int)echo_buffer_index;
             ++echo_buffer_index;
@@ -736,14 +2325,16 @@ static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp1
             echo->index = echo_index + 1;
             echo->number_of_echoes_at_same_time = spot->number_of_echoes;
 
-            echo->measured_time = VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC * (double)spot_index + (double)line_start_timestamp;
+            echo->measured_time = last_echo_lanes.measured_time[spot_index];
             echo->calibrated_time = echo->measured_time;
 
-            echo->horizontal_angle = one_spot_azimuthal_angle_step * (double)(spot_index) + start_azimuthal_angle;
-            echo->elevation_angle = vlp16_handler->elevation_angle_array.at(spot_index);
+            echo->horizontal_angle = last_echo_lanes.horizontal_angle[spot_index];
+            echo->elevation_angle = vlp16_handler->elevation_angle_array[spot_index];
+
+            echo->distance = strongest_echo_distance;
+            echo->intensity = strongest_echo_lanes.intensity[spot_index];
 
-            echo->distance = VLP16_PACKET_DISTANCE_SCALE * (double)strongest_echo_distance;
-            echo->intensity = (double)strongest_echo_intensity;
+            calculate_cartesian_coordinates_of_vlp16_echo(vlp16_handler, spot_index, echo);
 
             spot->echo[echo_index] = (int)echo_buffer_index;
             ++echo_buffer_index;
@@ -754,14 +2345,16 @@ static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp1
             echo->index = echo_index + 1;
             echo->number_of_echoes_at_same_time = spot->number_of_echoes;
 
-            echo->measured_time = VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC * (double)spot_index + (double)line_start_timestamp;
+            echo->measured_time = last_echo_lanes.measured_time[spot_index];
             echo->calibrated_time = echo->measured_time;
 
-            echo->horizontal_angle = one_spot_azimuthal_angle_step * (double)(spot_index) + start_azimuthal_angle;
-            echo->elevation_angle = vlp16_handler->elevation_angle_array.at(spot_index);
+            echo->horizontal_angle = last_echo_lanes.horizontal_angle[spot_index];
+            echo->elevation_angle = vlp16_handler->elevation_angle_array[spot_index];
 
-            echo->distance = VLP16_PACKET_DISTANCE_SCALE * (double)last_echo_distance;
-            echo->intensity = (double)last_echo_intensity;
+            echo->distance = last_echo_distance;
+            echo->intensity = last_echo_lanes.intensity[spot_index];
+
+            calculate_cartesian_coordinates_of_vlp16_echo(vlp16_handler, spot_index, echo);
 
             spot->echo[echo_index] = (int)echo_buffer_index;
             ++echo_buffer_index;
@@ -774,66 +2367,44 @@ static void decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp1
         }
 
     }
-    move_copy_destination_point(line_data_buffer, 1);
 
     return;
 }
 
-static unsigned int decode_one_data_block_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp16_handler,
-                                                                    unsigned int data_block_start_timestamp,
-                                                                    unsigned int start_azimuthal_angle, unsigned int end_azimuthal_angle,
-                                                                    const char *first_data_buffer, const char *second_data_buffer)
+template <class SENSOR_MODEL_TRAITS>
+static void decode_one_data_block_of_dual_echo_vlp16_packet(const vlp16_handler_t *vlp16_handler,
+                                                            const vlp16_data_block_decode_task_t *task)
 {
-    unsigned int captured_line_count = 0;
-
-    const unsigned int azimuthal_angle_difference =
-        calculate_azimuthal_angle_difference(start_azimuthal_angle, end_azimuthal_angle);
-
-    const double one_spot_azimuthal_angle_step =
-        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * VLP16_PACKET_ONE_LASER_FIRING_RATIO_TO_ONE_FIRING_SEQUENCE * (double)azimuthal_angle_difference;
-
-    const double scaled_start_azimuthal_angle =
-        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)start_azimuthal_angle;
-
-    // decode first line
-    decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler,
-                                                     data_block_start_timestamp, scaled_start_azimuthal_angle,
-                                                     one_spot_azimuthal_angle_step,
-                                                     first_data_buffer + VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK,
-                                                     second_data_buffer + VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK);
-
-    ++captured_line_count;
-    // decode second line
-    if (vlp16_handler->decoding_packet_sensor_model == VLP16_PACKET_VLP16) {
-
-        const double start_line_azimuthal_angle_start =
-            VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)(start_azimuthal_angle + (azimuthal_angle_difference / 2));
-
-        decode_one_line_data_of_dual_echo_vlp16_packet(vlp16_handler,
-                                                         data_block_start_timestamp + (unsigned int)VLP16_PACKET_LASER_FIRING_SEQUENCE_USEC,
-                                                         start_line_azimuthal_angle_start,
-                                                         one_spot_azimuthal_angle_step,
-                                                         first_data_buffer + VLP16_PACKET_EVEN_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK,
-                                                       second_data_buffer + VLP16_PACKET_EVEN_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK);
-        ++captured_line_count;
+    const double one_firing_azimuthal_angle_step =
+        VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * SENSOR_MODEL_TRAITS::one_firing_ratio_to_data_block() * (double)task->azimuthal_angle_difference;
+
+    // VLP-16 and Puck Hi-Res fire two sequences in one data block, and HDL-32E and VLP-32C fire one sequence
+    for (unsigned int sequence_index = 0; sequence_index < SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK; ++sequence_index) {
+
+        const unsigned int firing_sequence_position = VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK +
+            sequence_index * SENSOR_MODEL_TRAITS::FIRING_SEQUENCE_LENGTH;
+
+        decode_one_line_data_of_dual_echo_vlp16_packet<SENSOR_MODEL_TRAITS>(vlp16_handler, task->receive_time_usec,
+                                                                            task->line_start_timestamp[sequence_index],
+                                                                            VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE * (double)task->line_start_azimuthal_angle[sequence_index],
+                                                                            one_firing_azimuthal_angle_step,
+                                                                            task->first_data_block + firing_sequence_position,
+                                                                            task->second_data_block + firing_sequence_position,
+                                                                            task->line_data[sequence_index]);
     }
 
-    return captured_line_count;
+    return;
 }
 
-static unsigned int decode_dual_echo_vlp16_packet(vlp16_handler_t * vlp16_handler)
+template <class SENSOR_MODEL_TRAITS>
+static unsigned int resolve_data_blocks_of_dual_echo_vlp16_packet(vlp16_handler_t *vlp16_handler)
 {
     const unsigned int length_of_concatenated_data_blocks =
         VLP16_PACKET_NUMBER_OF_DATA_BLOCKS + vlp16_handler->number_of_remaining_data_blocks;
-    const char ** concatenated_data_blocks =
-        (const char**)malloc(length_of_concatenated_data_blocks * sizeof(const char *));
-
-    if (concatenated_data_blocks == NULL) {
-        return 0;
-    }
+    const char *concatenated_data_blocks[VLP16_MAXIMUM_NUMBER_OF_CONCATENATED_DATA_BLOCKS];
 
     for (unsigned int i = 0; i < vlp16_handler->number_of_remaining_data_blocks; ++i) {
-        concatenated_data_blocks[i] = vlp16_handler->remaining_data_block_buffer[i];
+        concatenated_data_blocks[i] = vlp16_handler->remaining_data_blocks[i];
     }
 
     for (unsigned int i = 0; i < VLP16_PACKET_NUMBER_OF_DATA_BLOCKS; ++i) {
@@ -842,9 +2413,7 @@ static unsigned int decode_dual_echo_vlp16_packet(vlp16_handler_t * vlp16_handle
 
     const unsigned int half_length_of_concatenated_data_blocks = length_of_concatenated_data_blocks / 2;
 
-    unsigned int *angle_buffer = NULL;
-    angle_buffer =
-        (unsigned int *) malloc(half_length_of_concatenated_data_blocks * sizeof(unsigned int));
+    unsigned int angle_buffer[VLP16_MAXIMUM_NUMBER_OF_CONCATENATED_DATA_BLOCKS / 2];
 
     decode_azimuthal_angles_of_dual_echo_vlp16_packet(concatenated_data_blocks, length_of_concatenated_data_blocks,
                                                       angle_buffer);
@@ -881,7 +2450,7 @@ static unsigned int decode_dual_echo_vlp16_packet(vlp16_handler_t * vlp16_handle
     unsigned int start_data_block_timestamp_usec = vlp16_handler->decoding_packet_timestamp_usec;
     if (start_offset > 0) {
 
-        unsigned int offset_of_timestamp = (unsigned int)(VLP16_PACKET_ONE_DATA_BLOCK_USEC * (double)start_offset);
+        unsigned int offset_of_timestamp = (unsigned int)(SENSOR_MODEL_TRAITS::data_block_usec() * (double)start_offset);
 
         if (start_data_block_timestamp_usec < offset_of_timestamp) {
             start_data_block_timestamp_usec = VLP16_PACKET_MAXIMUM_TIMESTAMP + start_data_block_timestamp_usec - offset_of_timestamp;
@@ -899,14 +2468,15 @@ static unsigned int decode_dual_echo_vlp16_packet(vlp16_handler_t * vlp16_handle
     for (unsigned int i = start_data_index; i < end_data_index_out; ++i) {
 
         data_block_start_timestamp = start_data_block_timestamp_usec +
-            (unsigned int)(VLP16_PACKET_ONE_DATA_BLOCK_USEC * (double)i);
-
-        number_of_captured_lines +=
-            decode_one_data_block_of_dual_echo_vlp16_packet(vlp16_handler,
-                                                            data_block_start_timestamp,
-                                                            angle_buffer[i], angle_buffer[i + 1],
-                                                            concatenated_data_blocks[data_block_index],
-                                                            concatenated_data_blocks[data_block_index + 1]);
+            (unsigned int)(SENSOR_MODEL_TRAITS::data_block_usec() * (double)i);
+
+        add_vlp16_data_block_decode_task<SENSOR_MODEL_TRAITS>(vlp16_handler,
+                                                              decode_one_data_block_of_dual_echo_vlp16_packet<SENSOR_MODEL_TRAITS>,
+                                                              data_block_start_timestamp,
+                                                              angle_buffer[i], angle_buffer[i + 1],
+                                                              concatenated_data_blocks[data_block_index],
+                                                              concatenated_data_blocks[data_block_index + 1]);
+        number_of_captured_lines += SENSOR_MODEL_TRAITS::NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK;
         data_block_index += 2;
 
     }
@@ -934,27 +2504,68 @@ static unsigned int decode_dual_echo_vlp16_packet(vlp16_handler_t * vlp16_handle
         continuous_remaining_start_index = end_data_index_out;
     }
 
+    // remaining data blocks stay in packet slots until they are stored after decoding
     for (unsigned int i = 2 * continuous_remaining_start_index; i < length_of_concatenated_data_blocks; ++i) {
-        memcpy(vlp16_handler->remaining_data_block_buffer[i - 2 * continuous_remaining_start_index],
-               concatenated_data_blocks[i], VLP16_PACKET_DATA_BLOCK_LENGTH);
+        vlp16_handler->remaining_data_blocks[i - 2 * continuous_remaining_start_index] = concatenated_data_blocks[i];
     }
 
     vlp16_handler->number_of_remaining_data_blocks = length_of_concatenated_data_blocks - 2 * continuous_remaining_start_index;
 
-    free(angle_buffer);
-    free(concatenated_data_blocks);
-
     return number_of_captured_lines;
 }
 
-unsigned int decode_vlp16_packet(vlp16_handler_t *vlp16_handler)
+//! type of function to resolve continuity of data blocks of one packet of sensor model
+typedef unsigned int (*vlp16_packet_resolver_t)(vlp16_handler_t *vlp16_handler);
+
+//! structure of decoders of one sensor model
+struct vlp16_sensor_model_decoder_t {
+
+    //! resolver of strongest or last return packet
+    vlp16_packet_resolver_t single_echo_packet_resolver;
+
+    //! resolver of dual return packet
+    vlp16_packet_resolver_t dual_echo_packet_resolver;
+
+};
+
+//! jump table of decoders instantiated from traits of each sensor model (in order of VLP16_PACKET_SENSOR_MODEL)
+static const vlp16_sensor_model_decoder_t VLP16_SENSOR_MODEL_DECODER[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET] =
+    { { resolve_data_blocks_of_single_echo_vlp16_packet<hdl_32e_sensor_model_traits_t>,
+        resolve_data_blocks_of_dual_echo_vlp16_packet<hdl_32e_sensor_model_traits_t> },
+      { resolve_data_blocks_of_single_echo_vlp16_packet<vlp16_sensor_model_traits_t>,
+        resolve_data_blocks_of_dual_echo_vlp16_packet<vlp16_sensor_model_traits_t> },
+      { resolve_data_blocks_of_single_echo_vlp16_packet<vlp_32c_sensor_model_traits_t>,
+        resolve_data_blocks_of_dual_echo_vlp16_packet<vlp_32c_sensor_model_traits_t> },
+      { resolve_data_blocks_of_single_echo_vlp16_packet<puck_hi_res_sensor_model_traits_t>,
+        resolve_data_blocks_of_dual_echo_vlp16_packet<puck_hi_res_sensor_model_traits_t> } };
+
+static bool is_decodable_sensor_model_of_vlp16_packet(enum VLP16_PACKET_SENSOR_MODEL sensor_model)
 {
-    if (vlp16_handler->decoding_packet_sensor_model !=
-        vlp16_handler->past_packet_sensor_model) {
+    return ((sensor_model != VLP16_PACKET_INVALID_SENSOR_MODEL) &&
+            (sensor_model != NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET));
+}
+
+/*!
+  \brief function to resolve continuity of data blocks of decoding packet and to add decode tasks of them
+  \return number of lines of added decode tasks
+  \attention this function is called in order of packets, because it carries remaining data blocks to next packet
+*/
+static unsigned int resolve_data_blocks_of_vlp16_packet(vlp16_handler_t *vlp16_handler)
+{
+    // timing model and elevation tables are resolved once on change of sensor model (not on each line)
+    if ((vlp16_handler->decoding_packet_sensor_model !=
+         vlp16_handler->past_packet_sensor_model) ||
+        (vlp16_handler->sensor_model_timing == NULL)) {
+
+        // resolved data blocks are decoded with tables of their sensor model
+        decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler);
 
-        allocate_memory_for_lidar_line_circular_buffer(vlp16_handler,
-                                                       VLP16_PACKET_NUMBER_OF_SPOTS[vlp16_handler->decoding_packet_sensor_model],
-                                                       NUMBER_OF_VLP16_PACKET_LINES_TO_STORE_MEASURED_DATA);
+        vlp16_handler->sensor_model_timing = &VLP16_SENSOR_MODEL_TIMING[vlp16_handler->decoding_packet_sensor_model];
+
+        allocate_line_data_buffer_of_vlp16_handler(vlp16_handler,
+                                                   vlp16_handler->decoding_packet_sensor_model);
+
+        renew_elevation_angle_tables_of_vlp16_handler(vlp16_handler);
 
         clear_vlp16_remaining_data_blocks(vlp16_handler);
     }
@@ -962,23 +2573,28 @@ unsigned int decode_vlp16_packet(vlp16_handler_t *vlp16_handler)
 
     if (vlp16_handler->decoding_packet_return_mode !=
         vlp16_handler->past_packet_return_mode) {
+        decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler);
         clear_vlp16_remaining_data_blocks(vlp16_handler);
     }
     vlp16_handler->past_packet_return_mode = vlp16_handler->decoding_packet_return_mode;
 
     unsigned int number_of_captured_lines = 0;
 
+    // decoder is selected once per packet with sensor model byte
+    const vlp16_sensor_model_decoder_t *decoder =
+        &VLP16_SENSOR_MODEL_DECODER[vlp16_handler->decoding_packet_sensor_model];
+
     switch (vlp16_handler->decoding_packet_return_mode) {
 
         case VLP16_PACKET_STRONGEST_RETURN_MODE:
         case VLP16_PACKET_LAST_RETURN_MODE:
             number_of_captured_lines =
-                decode_single_echo_vlp16_packet(vlp16_handler);
+                decoder->single_echo_packet_resolver(vlp16_handler);
             break;
 
         case VLP16_PACKET_DUAL_RETURN_MODE:
             number_of_captured_lines =
-                decode_dual_echo_vlp16_packet(vlp16_handler);
+                decoder->dual_echo_packet_resolver(vlp16_handler);
             break;
 
         default:
@@ -988,6 +2604,180 @@ unsigned int decode_vlp16_packet(vlp16_handler_t *vlp16_handler)
     return number_of_captured_lines;
 }
 
+/*!
+  \brief function to copy remaining data blocks from packet slots to remaining_data_block_buffer
+  \attention this function is called after all resolved data blocks are decoded, because packet slots are overwritten on next receiving
+*/
+static void store_remaining_data_blocks_of_vlp16_handler(vlp16_handler_t *vlp16_handler)
+{
+    for (unsigned int i = 0; i < vlp16_handler->number_of_remaining_data_blocks; ++i) {
+
+        if (vlp16_handler->remaining_data_blocks[i] != vlp16_handler->remaining_data_block_buffer[i]) {
+            memcpy(vlp16_handler->remaining_data_block_buffer[i], vlp16_handler->remaining_data_blocks[i],
+                   VLP16_PACKET_DATA_BLOCK_LENGTH);
+            vlp16_handler->remaining_data_blocks[i] = vlp16_handler->remaining_data_block_buffer[i];
+        }
+
+    }
+
+    return;
+}
+
+static void add_packet_latency_of_vlp16_handler(vlp16_handler_t *vlp16_handler, double receive_time_usec,
+                                                double decoded_time_usec)
+{
+    vlp16_handler->latest_packet_latency_usec = decoded_time_usec - receive_time_usec;
+    add_value_to_streaming_statistics(&vlp16_handler->packet_latency_statistics,
+                                      vlp16_handler->latest_packet_latency_usec);
+
+    return;
+}
+
+unsigned int decode_vlp16_packet(vlp16_handler_t *vlp16_handler)
+{
+    LATENCY_TRACE_BEGIN(decode_start_time_nsec);
+
+    if (is_decodable_sensor_model_of_vlp16_packet(vlp16_handler->decoding_packet_sensor_model) == false) {
+        return 0;
+    }
+
+    const unsigned int number_of_captured_lines =
+        resolve_data_blocks_of_vlp16_packet(vlp16_handler);
+
+    decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler);
+    store_remaining_data_blocks_of_vlp16_handler(vlp16_handler);
+
+    add_packet_latency_of_vlp16_handler(vlp16_handler, vlp16_handler->decoding_packet_receive_time_usec,
+                                        GetNowRealTimeMicroSec());
+
+    LATENCY_TRACE_END(decode_start_time_nsec, LATENCY_TRACE_DECODE_STAGE);
+
+    return number_of_captured_lines;
+}
+
+/*!
+  \brief function to decode packets in packet slots at once
+  \attention continuity of data blocks is resolved in order of packets, and then lines of data blocks are decoded on decode pool
+*/
+static unsigned int decode_packets_in_packet_slots(vlp16_handler_t *vlp16_handler, int number_of_datagrams,
+                                                   unsigned int *number_of_received_packets)
+{
+    LATENCY_TRACE_BEGIN(decode_start_time_nsec);
+
+    unsigned int number_of_captured_lines = 0;
+    unsigned int number_of_decoded_packets = 0;
+
+    // latency of packets is evaluated after lines of all packets are decoded
+    double receive_time_usec_array[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE];
+
+    for (int i = 0; i < number_of_datagrams; ++i) {
+
+        if (accept_vlp16_packet_in_packet_slot(vlp16_handler, (unsigned int)i) == false) {
+            continue;
+        }
+        ++(*number_of_received_packets);
+
+        if (is_decodable_sensor_model_of_vlp16_packet(vlp16_handler->decoding_packet_sensor_model) == false) {
+            continue;
+        }
+
+        receive_time_usec_array[number_of_decoded_packets] = vlp16_handler->decoding_packet_receive_time_usec;
+        ++number_of_decoded_packets;
+
+        number_of_captured_lines += resolve_data_blocks_of_vlp16_packet(vlp16_handler);
+    }
+
+    if (number_of_decoded_packets == 0) {
+        return 0;
+    }
+
+    decode_resolved_data_blocks_of_vlp16_handler(vlp16_handler);
+    store_remaining_data_blocks_of_vlp16_handler(vlp16_handler);
+
+    const double decoded_time_usec = GetNowRealTimeMicroSec();
+    for (unsigned int i = 0; i < number_of_decoded_packets; ++i) {
+        add_packet_latency_of_vlp16_handler(vlp16_handler, receive_time_usec_array[i], decoded_time_usec);
+    }
+
+    LATENCY_TRACE_END(decode_start_time_nsec, LATENCY_TRACE_DECODE_STAGE);
+
+    return number_of_captured_lines;
+}
+
+unsigned int receive_vlp16_packets(vlp16_handler_t *vlp16_handler, unsigned int maximum_number_of_packets,
+                                   unsigned int *number_of_received_packets)
+{
+    *number_of_received_packets = 0;
+
+    if (vlp16_handler->packet_slot_buffer == NULL) {
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return 0;
+    }
+
+    if (maximum_number_of_packets > vlp16_handler->number_of_packet_slots) {
+        maximum_number_of_packets = vlp16_handler->number_of_packet_slots;
+    }
+
+    const int number_of_datagrams =
+        receive_packets_in_packet_slots(vlp16_handler, maximum_number_of_packets);
+
+    const unsigned int number_of_captured_lines =
+        decode_packets_in_packet_slots(vlp16_handler, number_of_datagrams, number_of_received_packets);
+
+    // ring slots are returned to receive thread as soon as their packets are decoded
+    release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+
+    return number_of_captured_lines;
+}
+
+unsigned int receive_vlp16_packets_from_memory(vlp16_handler_t *vlp16_handler, const char *packets,
+                                               unsigned int number_of_packets,
+                                               unsigned int *number_of_received_packets)
+{
+    *number_of_received_packets = 0;
+
+    if (vlp16_handler->packet_slot_buffer == NULL) {
+        vlp16_handler->communication_status.buffer_error_occurs = true;
+        return 0;
+    }
+
+    release_held_ring_slots_of_vlp16_handler(vlp16_handler);
+
+    unsigned int number_of_captured_lines = 0;
+
+    for (unsigned int packet_index = 0; packet_index < number_of_packets;
+         packet_index += vlp16_handler->number_of_packet_slots) {
+
+        unsigned int number_of_copied_packets = number_of_packets - packet_index;
+        if (number_of_copied_packets > vlp16_handler->number_of_packet_slots) {
+            number_of_copied_packets = vlp16_handler->number_of_packet_slots;
+        }
+
+        // copy packets in packet slots as received datagrams
+        const double receive_time_usec = GetNowRealTimeMicroSec();
+        for (unsigned int i = 0; i < number_of_copied_packets; ++i) {
+            memcpy(vlp16_handler->packet_slot_buffer + i * VLP16_PACKET_SLOT_LENGTH,
+                   packets + (packet_index + i) * VLP16_PACKET_LENGTH, VLP16_PACKET_LENGTH);
+            vlp16_handler->packet_slot_received_length[i] = VLP16_PACKET_LENGTH;
+            vlp16_handler->packet_slot_receive_time_usec[i] = receive_time_usec;
+        }
+
+        count_received_datagrams_of_vlp16_handler(vlp16_handler, (int)number_of_copied_packets);
+
+        number_of_captured_lines +=
+            decode_packets_in_packet_slots(vlp16_handler, (int)number_of_copied_packets, number_of_received_packets);
+    }
+
+    return number_of_captured_lines;
+}
+
+void set_decode_pool_of_vlp16_handler(vlp16_handler_t *vlp16_handler, work_stealing_pool_t *decode_pool)
+{
+    vlp16_handler->decode_pool = decode_pool;
+
+    return;
+}
+
 bool does_no_reply_after_long_waiting_occur(const vlp16_handler_t *vlp16_handler)
 {
 
@@ -1024,6 +2814,10 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
 
     TimeTheInterval timer;
 
+    // pointer array is allocated once (no allocation on each packet)
+    std::vector<const lidar_line_data_t *> captured_lines;
+    captured_lines.reserve(vlp16_handler->line_data_buffer.length);
+
     if (wait_timeout_usec < 0) {
 
         while (1) {
@@ -1037,9 +2831,12 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
                 break;
             }
 
+            if (is_end_of_pcap_file_of_vlp16_handler(vlp16_handler) == true) {
+                break;
+            }
+
             packet_received =
-                receive_vlp16_packet(vlp16_handler, &received_data_byte,
-                                     VLP16_PACKET_LENGTH);
+                receive_vlp16_packet(vlp16_handler, &received_data_byte);
 
             if (packet_received == true) {
 
@@ -1050,7 +2847,6 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
                     continue;
                 }
 
-                std::vector<const lidar_line_data_t *> captured_lines;
                 get_pointers_of_latest_unused_lidar_line_data(&vlp16_handler->line_data_buffer,
                                                               captured_size, captured_lines);
 
@@ -1065,6 +2861,10 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
 
                 }
 
+                // consumed lines are not counted as overwritten unused lines
+                move_used_data_end_out_point(&vlp16_handler->line_data_buffer,
+                                             calculate_number_of_remaining_lidar_lines(&vlp16_handler->line_data_buffer));
+
 
             }
 
@@ -1087,9 +2887,12 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
                 break;
             }
 
+            if (is_end_of_pcap_file_of_vlp16_handler(vlp16_handler) == true) {
+                break;
+            }
+
             packet_received =
-                receive_vlp16_packet(vlp16_handler, &received_data_byte,
-                                     VLP16_PACKET_LENGTH);
+                receive_vlp16_packet(vlp16_handler, &received_data_byte);
 
             if (packet_received == true) {
 
@@ -1100,7 +2903,6 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
                     continue;
                 }
 
-                std::vector<const lidar_line_data_t *> captured_lines;
                 get_pointers_of_latest_unused_lidar_line_data(&vlp16_handler->line_data_buffer,
                                                               captured_size, captured_lines);
 
@@ -1115,6 +2917,10 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
 
                 }
 
+                // consumed lines are not counted as overwritten unused lines
+                move_used_data_end_out_point(&vlp16_handler->line_data_buffer,
+                                             calculate_number_of_remaining_lidar_lines(&vlp16_handler->line_data_buffer));
+
 
             }
 
@@ -1124,3 +2930,110 @@ bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
 
     return return_bool;
 }
+
+void initialize_vlp16_sensor_group(vlp16_sensor_group_t *group)
+{
+    initialize_socket_client_poller(&group->poller);
+
+    for (unsigned int i = 0; i < VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS; ++i) {
+        group->handler[i] = NULL;
+        group->number_of_captured_lines[i] = 0;
+        group->number_of_received_packets[i] = 0;
+    }
+    group->number_of_sensors = 0;
+
+    return;
+}
+
+bool open_vlp16_sensor_group(vlp16_sensor_group_t *group)
+{
+    close_vlp16_sensor_group(group);
+
+    return open_socket_client_poller(&group->poller);
+}
+
+void close_vlp16_sensor_group(vlp16_sensor_group_t *group)
+{
+    close_socket_client_poller(&group->poller);
+
+    initialize_vlp16_sensor_group(group);
+
+    return;
+}
+
+int add_vlp16_handler_to_sensor_group(vlp16_sensor_group_t *group, vlp16_handler_t *vlp16_handler)
+{
+    if ((vlp16_handler->communication_status.socket_opened == false) ||
+        (vlp16_handler->packet_source_type != VLP16_PACKET_SOURCE_SOCKET) ||
+        (vlp16_handler->threaded_receive_mode == true) ||
+        (vlp16_handler->packet_slot_buffer == NULL)) {
+        return VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX;
+    }
+
+    const int sensor_index = add_socket_client_to_poller(&group->poller, &vlp16_handler->socket_handler);
+
+    if (sensor_index < 0) {
+        return VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX;
+    }
+
+    group->handler[sensor_index] = vlp16_handler;
+    group->number_of_captured_lines[sensor_index] = 0;
+    group->number_of_received_packets[sensor_index] = 0;
+    group->number_of_sensors = group->poller.number_of_clients;
+
+    return sensor_index;
+}
+
+unsigned int receive_vlp16_packets_of_sensor_group(vlp16_sensor_group_t *group, int timeout_usec,
+                                                   unsigned int maximum_number_of_packets_per_sensor)
+{
+    for (unsigned int i = 0; i < group->number_of_sensors; ++i) {
+        group->number_of_captured_lines[i] = 0;
+        group->number_of_received_packets[i] = 0;
+    }
+
+    unsigned int readable_sensor_index_array[VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS];
+
+    const int number_of_readable_sensors =
+        wait_for_readable_socket_clients(&group->poller, timeout_usec, readable_sensor_index_array);
+
+    if (number_of_readable_sensors <= 0) {
+        return 0;
+    }
+
+    unsigned int number_of_receiving_sensors = 0;
+
+    for (int i = 0; i < number_of_readable_sensors; ++i) {
+
+        const unsigned int sensor_index = readable_sensor_index_array[i];
+        vlp16_handler_t *vlp16_handler = group->handler[sensor_index];
+
+        unsigned int maximum_number_of_packets = maximum_number_of_packets_per_sensor;
+        if (maximum_number_of_packets > vlp16_handler->number_of_packet_slots) {
+            maximum_number_of_packets = vlp16_handler->number_of_packet_slots;
+        }
+
+        LATENCY_TRACE_BEGIN(receive_start_time_nsec);
+
+        const int number_of_datagrams =
+            receive_ready_datagrams_using_socket_client(&vlp16_handler->socket_handler,
+                                                        vlp16_handler->packet_slot_buffer, VLP16_PACKET_SLOT_LENGTH,
+                                                        maximum_number_of_packets,
+                                                        vlp16_handler->packet_slot_received_length,
+                                                        vlp16_handler->packet_slot_receive_time_usec);
+
+        count_received_datagrams_of_vlp16_handler(vlp16_handler, number_of_datagrams);
+
+        LATENCY_TRACE_END(receive_start_time_nsec, LATENCY_TRACE_RECEIVE_STAGE);
+
+        group->number_of_captured_lines[sensor_index] =
+            decode_packets_in_packet_slots(vlp16_handler, number_of_datagrams,
+                                           &group->number_of_received_packets[sensor_index]);
+
+        if (number_of_datagrams > 0) {
+            ++number_of_receiving_sensors;
+        }
+    }
+
+    return number_of_receiving_sensors;
+}
@@ -11,6 +11,21 @@
 
 #include "lidar_dataCtrl.h"
 
+#include "packet_ringCtrl.h"
+
+#include "vlp16_kernelCtrl.h"
+
+#include "vlp16_calibrationCtrl.h"
+
+#include "work_stealing_poolCtrl.h"
+
+#include "pcap_fileCtrl.h"
+
+#include "packet_recorderCtrl.h"
+
+// for pthread_t
+#include <pthread.h>
+
 //! length constants of vlp packet
 enum LENGTH_CONSTANTS_OF_VLP16_PACKET {
 
@@ -47,6 +62,12 @@ enum LENGTH_CONSTANTS_OF_VLP16_PACKET {
     //! length of one packet (ethernet header byte [42byte] is excluded)
     VLP16_PACKET_LENGTH = 1206,
 
+    //! alignment of packet slot to receive packet
+    VLP16_PACKET_SLOT_ALIGNMENT_BYTE = 64,
+
+    //! length of packet slot (VLP16_PACKET_LENGTH aligned by VLP16_PACKET_SLOT_ALIGNMENT_BYTE)
+    VLP16_PACKET_SLOT_LENGTH = 1216,
+
 };
 
 //! positions in VLP16 packet
@@ -109,6 +130,10 @@ enum VLP16_PACKET_SENSOR_MODEL {
     VLP16_PACKET_HDL_32E = 0,
     //! VLP-16
     VLP16_PACKET_VLP16,
+    //! VLP-32C
+    VLP16_PACKET_VLP_32C,
+    //! Puck Hi-Res
+    VLP16_PACKET_PUCK_HI_RES,
 
     //! number of sensor models
     NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET,
@@ -116,11 +141,15 @@ enum VLP16_PACKET_SENSOR_MODEL {
 
 //! byte value table of sensor model in VLP16 packet
 const char VLP16_PACKET_SENSOR_MODEL_BYTE[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET] =
-    { 0x21, 0x22 };
+    { 0x21, 0x22, 0x28, 0x24 };
+
+//! names of sensor models
+const char VLP16_PACKET_SENSOR_MODEL_NAME[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET][12] =
+    { "HDL-32E", "VLP-16", "VLP-32C", "Puck Hi-Res" };
 
 //! number of spots of each sensor model
 const unsigned int VLP16_PACKET_NUMBER_OF_SPOTS[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET] =
-    { 32, 16 };
+    { 32, 16, 32, 16 };
 
 //! flag bytes of data block in VLP16 packet
 const char VLP16_PACKET_HEADER_FLAG_OF_DATA_BLOCK[VLP16_PACKET_HEADER_FLAG_OF_DATA_BLOCK_LENGTH] =
@@ -141,11 +170,44 @@ struct vlp16_communication_status_t {
     //! flag for socket
     bool socket_opened;
 
+    //! number of received datagrams
+    unsigned int number_of_received_datagrams;
+
+    //! number of packets accepted to decode
+    unsigned int number_of_accepted_packets;
+
+    //! number of datagrams rejected by invalid length or flags
+    unsigned int number_of_decode_errors;
+
+    //! number of datagrams dropped before reception (receive queue overflow of kernel and packet ring)
+    unsigned int number_of_dropped_datagrams;
+
+    //! number of packets missing in timestamp sequence (counted when they do not arrive in reorder window)
+    unsigned int number_of_lost_packets;
+
+    //! number of packets which arrive after newer packet (late packets do not change number_of_lost_packets)
+    unsigned int number_of_reordered_packets;
+
+    //! number of packets whose timestamp is already received (duplicated on network or sensor)
+    unsigned int number_of_duplicated_packets;
+
+    //! number of revolutions of which completeness is evaluated
+    unsigned int number_of_completed_revolutions;
+
+    //! ratio of received packets to expected packets of latest completed revolution
+    double latest_revolution_completeness_ratio;
+
+    //! statistics of completeness ratio of completed revolutions
+    streaming_statistics_t revolution_completeness_statistics;
+
 };
 
 //! azimuthal angle scale factor of VLP16 packet [rad] 0.01 * PI / 180.0
 #define VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE 0.00017453292
 
+//! inverse of azimuthal angle scale factor of VLP16 packet [1/rad] 1.0 / VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE
+#define VLP16_PACKET_AZIMUTHAL_ANGLE_SCALE_INVERSE 5729.57812199
+
 //! distance scale factor of VLP16 [mm]
 #define VLP16_PACKET_DISTANCE_SCALE 2.0
 
@@ -167,6 +229,21 @@ struct vlp16_communication_status_t {
 //! one firing ration to one data block 2.304 / 110.592
 #define VLP16_PACKET_ONE_LASER_FIRING_RATIO_TO_ONE_FIRING_SEQUENCE 0.020833333
 
+//! one laser firing interval of HDL-32E (usec)
+#define VLP16_PACKET_HDL_32E_ONE_LASER_FIRING_INTERVAL_USEC 1.152
+
+//! one data block (one firing sequence of 32 lasers) interval of HDL-32E (usec) 1.152 * 40
+#define VLP16_PACKET_HDL_32E_ONE_DATA_BLOCK_USEC 46.080
+
+//! one firing ration to one data block of HDL-32E 1.152 / 46.08
+#define VLP16_PACKET_HDL_32E_ONE_LASER_FIRING_RATIO_TO_ONE_DATA_BLOCK 0.025
+
+//! one data block (one firing sequence of 16 simultaneous firings of 2 lasers) interval of VLP-32C (usec) 2.304 * 16 + 18.432
+#define VLP16_PACKET_VLP_32C_ONE_DATA_BLOCK_USEC 55.296
+
+//! one firing ration to one data block of VLP-32C (two lasers of one firing share firing time and azimuthal angle) 2.304 / 55.296
+#define VLP16_PACKET_VLP_32C_ONE_LASER_FIRING_RATIO_TO_ONE_DATA_BLOCK 0.041666667
+
 //! elevation angle tables of VLP-16 (specification value) [degree]
 const double VLP16_SPOT_SPECIFIVATION_ELEVATION_ANGLE_DEGREE_ARRAY[] =
     {-15.0, 1.0,
@@ -178,6 +255,88 @@ const double VLP16_SPOT_SPECIFIVATION_ELEVATION_ANGLE_DEGREE_ARRAY[] =
      -3.0, 13.0,
      -1.0, 15.0};
 
+//! elevation angle tables of HDL-32E (specification value in order of laser id) [degree]
+const double HDL_32E_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY[] =
+    {-30.67, -9.33,
+     -29.33, -8.00,
+     -28.00, -6.67,
+     -26.67, -5.33,
+     -25.33, -4.00,
+     -24.00, -2.67,
+     -22.67, -1.33,
+     -21.33, 0.00,
+     -20.00, 1.33,
+     -18.67, 2.67,
+     -17.33, 4.00,
+     -16.00, 5.33,
+     -14.67, 6.67,
+     -13.33, 8.00,
+     -12.00, 9.33,
+     -10.67, 10.67};
+
+//! elevation angle tables of VLP-32C (specification value in order of laser id) [degree]
+const double VLP_32C_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY[] =
+    {-25.000, -1.000,
+     -1.667, -15.639,
+     -11.310, 0.000,
+     -0.667, -8.843,
+     -7.254, 0.333,
+     -0.333, -6.148,
+     -5.333, 1.333,
+     0.667, -4.000,
+     -4.667, 1.667,
+     1.000, -3.667,
+     -3.333, 3.333,
+     2.333, -2.667,
+     -3.000, 7.000,
+     4.667, -2.333,
+     -2.000, 15.000,
+     10.333, -1.333};
+
+//! elevation angle tables of Puck Hi-Res (specification value) [degree]
+const double PUCK_HI_RES_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY[] =
+    {-10.00, 0.67,
+     -8.67, 2.00,
+     -7.33, 3.33,
+     -6.00, 4.67,
+     -4.67, 6.00,
+     -3.33, 7.33,
+     -2.00, 8.67,
+     -0.67, 10.00};
+
+//! structure of firing timing and geometry of sensor model
+struct vlp16_sensor_model_timing_t {
+
+    //! number of spots (lasers)
+    unsigned int number_of_spots;
+
+    //! number of firing sequences in one data block
+    unsigned int number_of_firing_sequences_in_data_block;
+
+    //! number of lasers fired at same time
+    unsigned int number_of_simultaneous_firings;
+
+    //! one laser firing interval [usec]
+    double one_laser_firing_interval_usec;
+
+    //! one firing sequence interval [usec]
+    double firing_sequence_usec;
+
+    //! one data block interval [usec]
+    double data_block_usec;
+
+    //! ratio of azimuthal angle step of one firing to azimuthal angle difference of one data block
+    double one_laser_firing_ratio_to_data_block;
+
+    //! elevation angle of each spot (specification value) [degree]
+    const double *elevation_angle_degree_array;
+
+};
+
+//! firing timing and geometry table of each sensor model
+//! \attention rows are made from traits in vlp16_sensor_model_traitsCtrl.h which instantiate decoders
+extern const vlp16_sensor_model_timing_t VLP16_SENSOR_MODEL_TIMING[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET];
+
 //! constants of VLP16 packet
 enum VLP16_PACKET_CONSTANTS {
     //! maximum azimuthal angle
@@ -193,7 +352,16 @@ enum VLP16_PACKET_CONSTANTS {
     VLP16_PACKET_MAXIMUM_ROTATION_SPEED = 7200,
 
     //! azimuthal angle threshold of continuous data blocks [0.01 degree]
-    VLP16_PACKET_AZIMUTHAL_ANGLE_THRESHOLD_OF_CONTINUOUS_DATA_BLOCKS = 160
+    VLP16_PACKET_AZIMUTHAL_ANGLE_THRESHOLD_OF_CONTINUOUS_DATA_BLOCKS = 160,
+
+    //! timestamp jump to restart continuity evaluation (restart of sensor or replay) [usec]
+    VLP16_PACKET_TIMESTAMP_JUMP_TO_RESTART_CONTINUITY_USEC = 1000 * 1000,
+
+    //! waiting time spun after sleep before replay time of pcap packet (longer than timer slack of kernel) [usec]
+    VLP16_PCAP_REPLAY_SPIN_WAIT_USEC = 200,
+
+    //! number of packet intervals behind latest packet in which late packets fill missing packets (bits of unsigned int)
+    VLP16_PACKET_REORDER_WINDOW_LENGTH = 32
 
 };
 
@@ -203,11 +371,122 @@ enum VLP16_HANDER_CONSTANTS {
     //! number of store buffer of data block
     NUMBER_OF_STORING_VLP16_PACKET_DATA_BLOCKS = 11,
 
+    //! maximum number of data blocks decoded at once (stored data blocks and data blocks of one packet)
+    VLP16_MAXIMUM_NUMBER_OF_CONCATENATED_DATA_BLOCKS = NUMBER_OF_STORING_VLP16_PACKET_DATA_BLOCKS + (int)VLP16_PACKET_NUMBER_OF_DATA_BLOCKS,
+
     //! maximum interval of reply [usec]
     VLP16_COMMUNICATION_HANDLER_MAXIMUM_NO_REPLY_INTERVAL_ON_AWAITING_PACKETS_USEC = 5 * 1000 * 1000,
 
     //! number of lines to store measured data
     NUMBER_OF_VLP16_PACKET_LINES_TO_STORE_MEASURED_DATA = 32,
+
+    //! default history length of line buffer [revolution]
+    VLP16_DEFAULT_LINE_HISTORY_REVOLUTIONS = 1,
+
+    //! wait timeout of receive thread to check stop request [usec]
+    VLP16_RECEIVE_THREAD_WAIT_TIMEOUT_USEC = 100 * 1000,
+
+    //! cpu core index not to pin receive thread
+    VLP16_RECEIVE_THREAD_NO_CPU_AFFINITY = -1,
+
+    //! default number of lines in one frame (1808 lines are measured in one revolution at 600 rpm)
+    VLP16_DEFAULT_NUMBER_OF_LINES_IN_FRAME = 2048,
+
+    //! maximum number of echoes of one spot stored in frame (dual return)
+    VLP16_MAXIMUM_NUMBER_OF_ECHOES_OF_SPOT_IN_FRAME = 2,
+
+    //! maximum number of firing sequences in one data block
+    VLP16_MAXIMUM_NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK = 2,
+
+    //! minimum number of data blocks decoded on decode pool at once (fewer data blocks are decoded in calling thread)
+    VLP16_MINIMUM_NUMBER_OF_DATA_BLOCKS_TO_DECODE_IN_PARALLEL = 4 * VLP16_PACKET_NUMBER_OF_DATA_BLOCKS,
+};
+
+struct vlp16_handler_t;
+struct vlp16_data_block_decode_task_t;
+
+//! type of function to decode lines of one data block
+typedef void (*vlp16_data_block_decoder_t)(const vlp16_handler_t *vlp16_handler,
+                                           const vlp16_data_block_decode_task_t *task);
+
+//! data block whose continuity is resolved (its lines are decoded independently of other data blocks)
+struct vlp16_data_block_decode_task_t {
+
+    //! decoder instantiated for sensor model and return mode
+    vlp16_data_block_decoder_t decoder;
+
+    //! data block (last return data block on dual return)
+    const char *first_data_block;
+
+    //! strongest return data block on dual return (NULL on single return)
+    const char *second_data_block;
+
+    //! host receive time of packet which completes data block [usec from 1970-01-01]
+    double receive_time_usec;
+
+    //! azimuthal angle difference to next data block [0.01 degree]
+    unsigned int azimuthal_angle_difference;
+
+    //! number of lines (firing sequences) in data block
+    unsigned int number_of_lines;
+
+    //! start azimuthal angle of each line [0.01 degree]
+    unsigned int line_start_azimuthal_angle[VLP16_MAXIMUM_NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK];
+
+    //! start timestamp of each line [usec]
+    unsigned int line_start_timestamp[VLP16_MAXIMUM_NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK];
+
+    //! slot of each line reserved in line circular buffer
+    lidar_line_data_t *line_data[VLP16_MAXIMUM_NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK];
+
+};
+
+//! source of packets received by communication handler
+enum VLP16_PACKET_SOURCE_TYPE {
+
+    //! udp socket connected to sensor
+    VLP16_PACKET_SOURCE_SOCKET = 0,
+
+    //! libpcap capture file
+    VLP16_PACKET_SOURCE_PCAP_FILE,
+
+    //! number of packet sources
+    NUMBER_OF_VLP16_PACKET_SOURCE_TYPES,
+};
+
+//! pacing mode of pcap file replay
+enum VLP16_PCAP_REPLAY_MODE {
+
+    //! invalid mode
+    VLP16_PCAP_REPLAY_INVALID_MODE = -1,
+
+    //! packets are replayed on captured timing
+    VLP16_PCAP_REPLAY_ORIGINAL_TIMING = 0,
+
+    //! packets are replayed on captured timing accelerated by speed ratio
+    VLP16_PCAP_REPLAY_SCALED_TIMING,
+
+    //! packets are replayed as fast as possible
+    VLP16_PCAP_REPLAY_MAXIMUM_SPEED,
+
+    //! number of replay modes
+    NUMBER_OF_VLP16_PCAP_REPLAY_MODES,
+};
+
+//! unit of history length of line buffer
+enum VLP16_LINE_HISTORY_UNIT {
+
+    //! invalid unit (line buffer stores lines of packets received at once only)
+    VLP16_LINE_HISTORY_INVALID_UNIT = -1,
+
+    //! history length in milliseconds
+    VLP16_LINE_HISTORY_MSEC = 0,
+
+    //! history length in revolutions at minimum rotation speed (VLP16_PACKET_MINIMUM_ROTATION_SPEED)
+    VLP16_LINE_HISTORY_REVOLUTIONS,
+
+    //! number of units
+    NUMBER_OF_VLP16_LINE_HISTORY_UNITS,
 };
 
 //! communication handler
@@ -228,8 +507,8 @@ struct vlp16_handler_t {
     //! communication timeout [usec]
     int communication_timeout_usec;
 
-    //! buffer to decode one packet
-    char decode_buffer[VLP16_PACKET_LENGTH];
+    //! packet to be decoded (pointer to one of packet slots)
+    const char *decoding_packet;
 
     //! data block accessor
     const char *decoding_data_blocks[VLP16_PACKET_NUMBER_OF_DATA_BLOCKS];
@@ -237,6 +516,15 @@ struct vlp16_handler_t {
     //! timestamp of current decoding packet
     unsigned int decoding_packet_timestamp_usec;
 
+    //! host receive time of current decoding packet [usec from 1970-01-01] (kernel receive timestamp on Linux OS)
+    double decoding_packet_receive_time_usec;
+
+    //! latency from receive to decode complete of latest decoded packet [usec]
+    double latest_packet_latency_usec;
+
+    //! statistics of latency from receive to decode complete of packets [usec]
+    streaming_statistics_t packet_latency_statistics;
+
     //! return mode of current decoding packet
     enum VLP16_PACKET_RETURN_MODE decoding_packet_return_mode;
 
@@ -248,8 +536,22 @@ struct vlp16_handler_t {
     //! sensor model of past decoded packet
     enum VLP16_PACKET_SENSOR_MODEL past_packet_sensor_model;
 
-    //! timestamp of past decoded packet
+    //! highest timestamp in timestamp sequence (packets arriving late are excluded)
     unsigned int past_packet_timestamp_usec;
+    //! flag of past_packet_timestamp_usec
+    bool past_packet_timestamp_available;
+    //! azimuthal angle of first data block of packet of highest timestamp [0.01 degree]
+    unsigned int past_packet_azimuthal_angle;
+    //! received packets behind packet of highest timestamp (bit i is set if packet i intervals before it is received)
+    unsigned int received_packet_window;
+    //! advance of azimuthal angle between consecutive packets [0.01 degree] (0 if it is not measured)
+    unsigned int azimuthal_angle_advance_per_packet;
+    //! timestamp of first packet of current revolution
+    unsigned int revolution_start_timestamp_usec;
+    //! flag of revolution_start_timestamp_usec
+    bool revolution_start_timestamp_available;
+    //! number of packets received in current revolution
+    unsigned int number_of_packets_in_revolution;
 
     //! elevation angle table
     std::vector<double> elevation_angle_array;
@@ -258,23 +560,176 @@ struct vlp16_handler_t {
     //! maximum elevation angle
     double maximum_elevation_angle;
 
+    //! firing timing and geometry of sensor model of decoding packet (renewed when sensor model changes)
+    const vlp16_sensor_model_timing_t *sensor_model_timing;
+
+    //! cosine of elevation angle of each spot
+    std::vector<double> elevation_angle_cosine_array;
+    //! sine of elevation angle of each spot
+    std::vector<double> elevation_angle_sine_array;
+
+    //! flag to calculate cartesian coordinates of echoes on decoding
+    bool cartesian_output_enabled;
+
+    //! type of kernel to decode firing sequence
+    enum VLP16_DECODE_KERNEL_TYPE decode_kernel_type;
+    //! kernel to decode firing sequence of each sensor model (instantiated for its spots)
+    vlp16_firing_sequence_decoder_t firing_sequence_decoder_array[NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET];
+    //! firing time offset of each spot [usec]
+    unsigned int spot_time_offset_usec_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+    //! intrinsic calibration of sensor (valid if calibration_available is true)
+    vlp16_calibration_t calibration;
+    //! flag of calibration
+    bool calibration_available;
+
+    //! horizontal angle offset of each spot [rad] (negative rotational correction, 0 without calibration)
+    double spot_azimuthal_angle_offset_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+    //! minimum of spot_azimuthal_angle_offset_array [rad] (horizontal angle range of line is widened with it)
+    double minimum_spot_azimuthal_angle_offset;
+    //! maximum of spot_azimuthal_angle_offset_array [rad]
+    double maximum_spot_azimuthal_angle_offset;
+    //! distance offset of each spot (distance correction, 0 without calibration)
+    int spot_distance_offset_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+    //! offset of horizontal distance of each spot (vertical offset * sine of elevation angle)
+    double spot_horizontal_distance_offset_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+    //! offset of z component of each spot (vertical offset * cosine of elevation angle)
+    double spot_z_component_offset_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+    //! horizontal offset of each spot (perpendicular to measurement direction)
+    double spot_horizontal_offset_array[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+    //! point block to which decoder appends echoes (NULL if disabled)
+    lidar_point_block_t *point_block_output;
+
+    //! frame assembler of one revolution (disabled if it is not allocated)
+    lidar_frame_assembler_t frame_assembler;
+    //! azimuthal angle of past decoded line start [0.01 degree]
+    unsigned int past_line_start_azimuthal_angle;
+    //! flag of past_line_start_azimuthal_angle
+    bool past_line_start_azimuthal_angle_available;
+
     //! buffer to store last data block, in which data on even firing sequence do not have azimuthal angle.
     char remaining_data_block_buffer[NUMBER_OF_STORING_VLP16_PACKET_DATA_BLOCKS][VLP16_PACKET_DATA_BLOCK_LENGTH];
     //! number of current remaining data blocks
     unsigned int number_of_remaining_data_blocks;
+    //! remaining data blocks (in packet slots while packets are decoded, and in remaining_data_block_buffer after decoding)
+    const char *remaining_data_blocks[NUMBER_OF_STORING_VLP16_PACKET_DATA_BLOCKS];
+
+    //! decode tasks of resolved data blocks (in order of data blocks)
+    std::vector<vlp16_data_block_decode_task_t> data_block_decode_tasks;
+    //! number of lines reserved by data_block_decode_tasks
+    unsigned int number_of_reserved_lines;
+    //! pool to decode data blocks in parallel (owned by caller, NULL to decode in calling thread)
+    work_stealing_pool_t *decode_pool;
 
     //! circular buffer for measured line data
     lidar_line_circular_buffer_t line_data_buffer;
+
+    //! minimum number of lines of line_data_buffer to store lines of packets received at once
+    unsigned int number_of_lines_to_store;
+
+    //! requested history length of line_data_buffer (in line_history_unit)
+    double line_history_length;
+    //! unit of line_history_length
+    enum VLP16_LINE_HISTORY_UNIT line_history_unit;
+    //! sensor model of lines in line_data_buffer (line rate of history is calculated with its timing)
+    enum VLP16_PACKET_SENSOR_MODEL line_data_sensor_model;
+
+    //! aligned slots to receive packets directly (VLP16_PACKET_SLOT_LENGTH byte for each slot)
+    char *packet_slot_buffer;
+    //! received length of each packet slot
+    int packet_slot_received_length[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE];
+    //! receive time of each packet slot [usec from 1970-01-01]
+    double packet_slot_receive_time_usec[SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE];
+    //! number of packet slots
+    unsigned int number_of_packet_slots;
+
+    //! flag of threaded receive mode
+    bool threaded_receive_mode;
+    //! flag to keep receive thread running (loaded and stored with load_shared_bool and store_shared_bool)
+    volatile bool receive_thread_running;
+    //! receive thread
+    pthread_t receive_thread;
+    //! ring of raw packets between receive thread and decode thread
+    packet_ring_buffer_t packet_ring;
+    //! slots of packet_ring held to decode packets in place (NULL unless packets are received by receive thread)
+    const char *held_ring_slot_buffer;
+    //! received length of each held slot
+    const int *held_ring_slot_received_length;
+    //! receive time of each held slot [usec from 1970-01-01]
+    const double *held_ring_slot_receive_time_usec;
+
+    //! source of packets
+    enum VLP16_PACKET_SOURCE_TYPE packet_source_type;
+    //! reader of pcap file (used if packet_source_type == VLP16_PACKET_SOURCE_PCAP_FILE)
+    pcap_file_reader_t pcap_reader;
+    //! pacing mode of pcap file replay
+    enum VLP16_PCAP_REPLAY_MODE pcap_replay_mode;
+    //! speed ratio of pcap file replay (used on VLP16_PCAP_REPLAY_SCALED_TIMING)
+    double pcap_replay_speed_ratio;
+    //! flag of packet which is read from pcap file but not delivered yet
+    bool pcap_packet_loaded;
+    //! captured time of first replayed packet [sec]
+    unsigned int pcap_first_captured_time_sec;
+    //! captured time of first replayed packet [usec]
+    unsigned int pcap_first_captured_time_usec;
+    //! flag of first replayed packet
+    bool pcap_first_packet_replayed;
+    //! timer of pcap file replay
+    TimeTheInterval pcap_replay_timer;
+    //! number of replayed packets
+    unsigned int number_of_replayed_packets;
+
+    //! recorder of raw packets (disabled if it is not opened)
+    packet_recorder_t packet_recorder;
+    //! azimuthal angle of last data block of past recorded packet [0.01 degree]
+    unsigned int past_recorded_azimuthal_angle;
+    //! flag of past_recorded_azimuthal_angle
+    bool past_recorded_azimuthal_angle_available;
+};
+
+//! constants for group of vlp16 sensors
+enum VLP16_SENSOR_GROUP_CONSTANTS {
+
+    //! maximum number of sensors in one group
+    VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS = SOCKET_CLIENT_POLLER_MAXIMUM_NUMBER_OF_CLIENTS,
+
+    //! invalid sensor index
+    VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX = -1,
+
+};
+
+//! structure of group of vlp16 sensors served in one thread
+struct vlp16_sensor_group_t {
+
+    //! poller of sockets of sensors
+    socket_client_poller_t poller;
+
+    //! handlers of sensors (owned by caller)
+    vlp16_handler_t *handler[VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS];
+
+    //! number of lines captured by each sensor on last receiving
+    unsigned int number_of_captured_lines[VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS];
+
+    //! number of packets received by each sensor on last receiving
+    unsigned int number_of_received_packets[VLP16_SENSOR_GROUP_MAXIMUM_NUMBER_OF_SENSORS];
+
+    //! number of sensors
+    unsigned int number_of_sensors;
+
 };
 
 /*!
   \brief function to clear vlp16 handler
+  \attention packet recording started by start_recording_packets_of_vlp16_handler is stopped and its file is closed
 */
 extern void clear_vlp16_handler(vlp16_handler_t *handler);
 
 /*!
   \brief function to allocate circular buffer for communication with VLP16
   \attention if buffer_length_byte < VLP16_PACKET_LENGTH, this function does not work and return false as invalid buffer size.
+  \attention packets are received directly in packet slots, and number of slots is buffer_length_byte / VLP16_PACKET_LENGTH (SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE at most)
+  \attention circular buffer of socket_handler is not used
 */
 extern bool allocate_circular_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
                                                        enum VLP16_PACKET_SENSOR_MODEL sensor_model,
@@ -286,6 +741,26 @@ extern bool allocate_circular_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_ha
 */
 extern bool release_circular_buffer_of_vlp16_handler(vlp16_handler_t *vlp16_handler);
 
+/*!
+  \brief function to allocate buffer to receive packets at once
+  \attention maximum_number_of_packets is limited to SOCKET_CLIENT_MAXIMUM_NUMBER_OF_DATAGRAMS_AT_ONCE
+  \attention this function enlarges packet slots and line_data_buffer to store lines of maximum_number_of_packets packets
+  \attention this function does not work if memory_allocated == false
+*/
+extern bool allocate_packet_batch_buffer_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                           unsigned int maximum_number_of_packets);
+
+/*!
+  \brief function to set history length of line_data_buffer
+  \attention line_data_buffer stores lines measured in history_length at least, and its length is rounded up to power of two
+  \attention history in revolutions is kept at any valid rotation speed, because it is converted at minimum rotation speed
+  \attention line_data_buffer is reallocated if memory_allocated == true (pointers of captured lines are invalidated)
+  \attention unused lines overwritten by new lines are counted in line_data_buffer (get_number_of_overwritten_unused_lidar_lines())
+  \attention history is VLP16_DEFAULT_LINE_HISTORY_REVOLUTIONS revolution after clear_vlp16_handler, and history_length 0 keeps lines of packets received at once only
+*/
+extern bool set_line_history_of_vlp16_handler(vlp16_handler_t *vlp16_handler, double history_length,
+                                              enum VLP16_LINE_HISTORY_UNIT history_unit);
+
 /*!
   \brief function to open socket for communication with VLP16
   \attention this function does not work if socket_opened == true.
@@ -298,8 +773,71 @@ extern bool open_socket_for_vlp16_handler(const char *destination_ip_address_str
                                           int communication_timeout_usec,
                                           vlp16_handler_t *vlp16_handler);
 
+/*!
+  \brief function to open pcap file as packet source of vlp16 communication handler
+  \attention udp packets to destination_port in file are received instead of packets from socket
+  \attention replay_speed_ratio is used only on VLP16_PCAP_REPLAY_SCALED_TIMING (2.0 replays twice as fast)
+  \attention communication_status.socket_opened is set while pcap file is opened, and file is closed by close_socket_of_vlp16_handler
+  \attention receive thread is not available on pcap file replay
+*/
+extern bool open_pcap_file_for_vlp16_handler(const char *file_path, unsigned short destination_port,
+                                             enum VLP16_PCAP_REPLAY_MODE replay_mode, double replay_speed_ratio,
+                                             int communication_timeout_usec,
+                                             vlp16_handler_t *vlp16_handler);
+
+/*!
+  \brief function to evaluate whether all packets in pcap file are replayed
+*/
+extern bool is_end_of_pcap_file_of_vlp16_handler(const vlp16_handler_t *vlp16_handler);
+
+/*!
+  \brief function to calculate replayed packets per second from opening pcap file
+*/
+extern double calculate_replayed_packet_rate_of_vlp16_handler(const vlp16_handler_t *vlp16_handler);
+
+/*!
+  \brief function to start recording raw packets in memory-mapped file
+  \attention accepted packets are recorded with their host receive time (kernel receive timestamp on Linux OS), and revolution starts are indexed
+  \attention file for maximum_number_of_packets packets is allocated on starting, and packets are dropped when it is full
+  \attention file is written back by background thread of recorder (Linux OS only)
+*/
+extern bool start_recording_packets_of_vlp16_handler(vlp16_handler_t *vlp16_handler, const char *file_path,
+                                                     unsigned int maximum_number_of_packets);
+
+/*!
+  \brief function to stop recording raw packets
+  \attention recording is also stopped in close_socket_of_vlp16_handler
+*/
+extern void stop_recording_packets_of_vlp16_handler(vlp16_handler_t *vlp16_handler);
+
+/*!
+  \brief function to start receive thread of vlp16 communication handler
+  \attention receive thread pushes raw packets to packet_ring, and receive_vlp16_packet(s) decode them in ring slots without copy
+  \attention receive_vlp16_packets releases ring slots after decoding them, and receive_vlp16_packet copies one packet out of ring
+  \attention number_of_ring_packets packets are queued, and oldest queued packet is dropped on PACKET_RING_DROP_OLDEST if queue is full
+  \attention receive_vlp16_packet(s) sleep until receive thread wakes them up on packet arrival
+  \attention receive thread is created on cpu_core_index unless cpu_core_index == VLP16_RECEIVE_THREAD_NO_CPU_AFFINITY (Linux OS only)
+  \attention this function returns false if cpu_core_index is invalid or pinning fails
+  \attention overflow_policy decides which packet is dropped if decoding is slower than receiving
+  \attention this function does not work if socket_opened == false or memory_allocated == false
+  \attention this function does not work if packets are replayed from pcap file
+*/
+extern bool start_receive_thread_of_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                  unsigned int number_of_ring_packets,
+                                                  enum PACKET_RING_OVERFLOW_POLICY overflow_policy,
+                                                  int cpu_core_index);
+
+/*!
+  \brief function to stop receive thread of vlp16 communication handler
+  \attention packets remaining in packet_ring are discarded
+*/
+extern void stop_receive_thread_of_vlp16_handler(vlp16_handler_t *vlp16_handler);
+
 /*!
   \brief function to close socket of vlp16 communication handler
+  \attention this function stops receive thread
+  \attention this function closes pcap file if packets are replayed from pcap file
+  \attention this function stops recording packets
 */
 extern void close_socket_of_vlp16_handler(vlp16_handler_t *vlp16_handler);
 
@@ -313,13 +851,122 @@ extern void erase_all_receiving_and_decoding_data(vlp16_handler_t *handler);
   \attention this function returns true if one vlp16 packet is received
   \attention this function does not decode packet
   \attention this function evaluate validations of all header flags
-  \attention this function renew decoding_packet_timestamp_usec, decoding_packet_return_mode, and decoding_packet_sensor_model
+  \attention this function renew decoding_packet_timestamp_usec, decoding_packet_receive_time_usec, decoding_packet_return_mode, and decoding_packet_sensor_model
+  \attention lost, reordered and duplicated packets and completeness of revolutions are evaluated by timestamp and azimuthal angle of packets
+  \attention packet is received directly in packet slot as one datagram, and datagram longer than packet slot is not accepted
+*/
+extern bool receive_vlp16_packet(vlp16_handler_t *vlp16_handler, int *received_data_length);
+
+/*!
+  \brief function to calculate interval of packets of sensor model and return mode [usec]
+  \return 0.0 if sensor model or return mode is invalid
+*/
+extern double calculate_vlp16_packet_interval_usec(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                   enum VLP16_PACKET_RETURN_MODE return_mode);
+
+/*!
+  \brief function to receive vlp16 packet from memory (generated or stored packet) instead of socket
+  \attention packet is copied in first packet slot, and validated as receive_vlp16_packet
+  \attention receive time of packet is stamped with time of host
+*/
+extern bool receive_vlp16_packet_from_memory(vlp16_handler_t *vlp16_handler, const char *packet, unsigned int packet_length);
+
+/*!
+  \brief function to receive and decode vlp16 packets at once
+  \return number of captured lines of all received packets
+  \attention this function receives up to maximum_number_of_packets packets with one system call
+  \attention this function waits only for first packet (communication_timeout_usec)
+  \attention invalid packets are skipped, and decode_error_occurs is set
+  \attention packets are received directly in packet slots, and decoded without copy
+*/
+extern unsigned int receive_vlp16_packets(vlp16_handler_t *vlp16_handler, unsigned int maximum_number_of_packets,
+                                          unsigned int *number_of_received_packets);
+
+/*!
+  \brief function to receive and decode vlp16 packets from memory at once (generated or stored packets)
+  \return number of captured lines of all received packets
+  \attention packets are VLP16_PACKET_LENGTH byte each and continuous in memory
+  \attention packets are copied in packet slots, and decoded as receive_vlp16_packets in units of number of packet slots
 */
-extern bool receive_vlp16_packet(vlp16_handler_t *vlp16_handler, int *received_data_length,
-                                 unsigned int onetime_receive_length_byte);
+extern unsigned int receive_vlp16_packets_from_memory(vlp16_handler_t *vlp16_handler, const char *packets,
+                                                      unsigned int number_of_packets,
+                                                      unsigned int *number_of_received_packets);
+
+/*!
+  \brief function to set pool to decode lines of packets received at once in parallel
+  \attention continuity of data blocks is resolved in order of packets, and then lines of each data block are decoded on pool
+  \attention lines are stored in line buffer, and echoes are output to point block and frame, in order of packets regardless of number of workers
+  \attention pool is owned by caller, and it can be shared among handlers decoded in one thread (e.g. sensor group)
+*/
+extern void set_decode_pool_of_vlp16_handler(vlp16_handler_t *vlp16_handler, work_stealing_pool_t *decode_pool);
+
+/*!
+  \brief function to set whether decoder calculates cartesian coordinates of echoes
+  \attention cartesian coordinates are calculated with azimuthal angle table of 0.01 degree resolution (no trigonometric function on decoding)
+*/
+extern void set_cartesian_output_of_vlp16_handler(vlp16_handler_t *vlp16_handler, bool cartesian_output_enabled);
+
+/*!
+  \brief function to compile regions into region set with default elevation angles of sensor model
+  \attention region set of handler with calibration should be compiled with compile_lidar_echo_region_set_for_vlp16_handler()
+*/
+extern bool compile_lidar_echo_region_set_for_vlp16_sensor_model(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                                 const std::vector<lidar_echo_single_region_t> &regions,
+                                                                 unsigned int number_of_azimuth_buckets,
+                                                                 lidar_echo_region_set_t *region_set);
+
+/*!
+  \brief function to compile regions into region set with elevation angles of lines decoded by handler
+  \attention calibrated elevation angles are used if calibration is set, and sensor model of allocated line buffer is used
+  \attention region set should be compiled again after calibration or sensor model is changed
+*/
+extern bool compile_lidar_echo_region_set_for_vlp16_handler(const vlp16_handler_t *vlp16_handler,
+                                                            const std::vector<lidar_echo_single_region_t> &regions,
+                                                            unsigned int number_of_azimuth_buckets,
+                                                            lidar_echo_region_set_t *region_set);
+
+/*!
+  \brief function to set kernel to decode firing sequence
+  \attention fastest kernel on running cpu is selected in clear_vlp16_handler
+  \attention this function returns false if kernel is not usable on running cpu
+*/
+extern bool set_decode_kernel_of_vlp16_handler(vlp16_handler_t *vlp16_handler, enum VLP16_DECODE_KERNEL_TYPE kernel_type);
+
+/*!
+  \brief function to set intrinsic calibration of sensor
+  \attention elevation angles, horizontal angle offsets, distance offsets and offsets of cartesian coordinates are precomputed for each spot
+  \attention specification values are used if calibration is NULL or it has fewer lasers than spots of decoded sensor model
+  \attention this function returns false if calibration has no laser
+*/
+extern bool set_calibration_of_vlp16_handler(vlp16_handler_t *vlp16_handler, const vlp16_calibration_t *calibration);
+
+/*!
+  \brief function to set point block to which decoder appends echoes
+  \attention decoded echoes are appended to point_block in addition to line buffer, and output is disabled if point_block is NULL
+  \attention echoes are not appended when point block is full, and they are counted in number_of_dropped_points of point block
+  \attention user should erase points of point block after using them
+*/
+extern void set_point_block_output_of_vlp16_handler(vlp16_handler_t *vlp16_handler, lidar_point_block_t *point_block);
+
+/*!
+  \brief function to allocate frame assembler to output points of each revolution
+  \attention frame is completed when azimuthal angle of line start wraps around
+  \attention frame assembler is released in release_circular_buffer_of_vlp16_handler
+*/
+extern bool allocate_frame_assembler_for_vlp16_handler(vlp16_handler_t *vlp16_handler,
+                                                       enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                       unsigned int maximum_number_of_lines);
+
+/*!
+  \brief function to get frame completed after last call
+  \return pointer to completed frame (NULL if no new frame is completed)
+  \attention frames are swapped without copy, so returned frame is valid until next frame is completed
+*/
+extern const lidar_frame_t *get_completed_frame_of_vlp16_handler(vlp16_handler_t *vlp16_handler);
 
 /*!
   \brief function to decode received vlp16 packet
+  \attention latency from receive to end of this function is set to latest_packet_latency_usec, and added to packet_latency_statistics
 */
 extern unsigned int decode_vlp16_packet(vlp16_handler_t *vlp16_handler);
 
@@ -331,6 +978,7 @@ extern bool does_no_reply_after_long_waiting_occur(const vlp16_handler_t *vlp16_
 
 /*!
   \brief function to wait to receive echoes
+  \attention lines in line_data_buffer are marked as used after their echoes are added
 */
 extern bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler,
                                                   int wait_timeout_usec,
@@ -338,4 +986,39 @@ extern bool wait_to_receive_vlp16_measured_echoes(vlp16_handler_t *vlp16_handler
                                                   const lidar_echo_single_region_t *region,
                                                   std::vector<lidar_echo_data_t> &echoes);
 
+/*!
+  \brief function to initialize group of vlp16 sensors
+  \attention this function should be used before opening
+*/
+extern void initialize_vlp16_sensor_group(vlp16_sensor_group_t *group);
+
+/*!
+  \brief function to open group of vlp16 sensors
+  \attention readiness of all sensors is watched by one epoll instance on Linux OS
+*/
+extern bool open_vlp16_sensor_group(vlp16_sensor_group_t *group);
+
+/*!
+  \brief function to close group of vlp16 sensors
+  \attention handlers of sensors are not closed
+*/
+extern void close_vlp16_sensor_group(vlp16_sensor_group_t *group);
+
+/*!
+  \brief function to add vlp16 handler to group
+  \return index of sensor in group (VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX on failure)
+  \attention handler should receive packets from opened socket without receive thread, and its packet slots should be allocated
+*/
+extern int add_vlp16_handler_to_sensor_group(vlp16_sensor_group_t *group, vlp16_handler_t *vlp16_handler);
+
+/*!
+  \brief function to receive and decode packets of readable sensors in group
+  \return number of sensors which receive packets (0 on timeout)
+  \attention this function waits only until one of sensors is readable (timeout_usec < 0 waits without timeout)
+  \attention each readable sensor receives up to maximum_number_of_packets_per_sensor packets, and remaining packets are received on next call
+  \attention captured lines of i-th sensor are number_of_captured_lines[i] latest lines of its line buffer
+*/
+extern unsigned int receive_vlp16_packets_of_sensor_group(vlp16_sensor_group_t *group, int timeout_usec,
+                                                          unsigned int maximum_number_of_packets_per_sensor);
+
 #endif // VLP16_CONTROL_H
@@ -0,0 +1,304 @@
+#include "vlp16_calibrationCtrl.h"
+
+// for FILE, fopen, fread
+#include <stdio.h>
+
+// for strtod, strtol
+#include <stdlib.h>
+
+// for memset, memcpy, strstr, strlen, strncmp
+#include <string.h>
+
+#include <vector>
+
+//! constants for calibration parser
+enum VLP16_CALIBRATION_PARSER_CONSTANT {
+
+    //! maximum length of one key or value
+    VLP16_CALIBRATION_MAXIMUM_TOKEN_LENGTH = 64,
+
+    //! invalid laser id
+    VLP16_CALIBRATION_INVALID_LASER_ID = -1,
+
+};
+
+//! coefficient to convert degree to radian
+#define VLP16_CALIBRATION_DEGREE_TO_RADIAN 0.017453292519943295
+
+//! structure of one laser entry under parsing
+struct vlp16_calibration_entry_t {
+
+    //! laser id
+    int laser_id;
+
+    //! correction of laser
+    vlp16_laser_calibration_t laser;
+
+};
+
+void clear_vlp16_calibration(vlp16_calibration_t *calibration)
+{
+    calibration->number_of_lasers = 0;
+    memset((void *)calibration->laser, 0, sizeof(calibration->laser));
+
+    return;
+}
+
+static void clear_vlp16_calibration_entry(vlp16_calibration_entry_t *entry)
+{
+    entry->laser_id = VLP16_CALIBRATION_INVALID_LASER_ID;
+    memset((void *)&entry->laser, 0, sizeof(entry->laser));
+
+    return;
+}
+
+static bool commit_vlp16_calibration_entry(const vlp16_calibration_entry_t *entry, vlp16_calibration_t *calibration)
+{
+    if ((entry->laser_id < 0) ||
+        (entry->laser_id >= VLP16_CALIBRATION_MAXIMUM_NUMBER_OF_LASERS)) {
+        return false;
+    }
+
+    calibration->laser[entry->laser_id] = entry->laser;
+    if ((unsigned int)entry->laser_id + 1 > calibration->number_of_lasers) {
+        calibration->number_of_lasers = (unsigned int)entry->laser_id + 1;
+    }
+
+    return true;
+}
+
+static bool is_space_character(char character)
+{
+    return (character == ' ') || (character == '\t') || (character == '\r') || (character == '\n');
+}
+
+/*!
+  \brief function to copy token without surrounding spaces
+  \return false if token is empty or too long
+*/
+static bool copy_trimmed_token(const char *begin, const char *end, char *token)
+{
+    while ((begin < end) && (is_space_character(*begin) == true)) {
+        ++begin;
+    }
+    while ((end > begin) && (is_space_character(*(end - 1)) == true)) {
+        --end;
+    }
+
+    const size_t length = (size_t)(end - begin);
+    if ((length == 0) ||
+        (length >= VLP16_CALIBRATION_MAXIMUM_TOKEN_LENGTH)) {
+        return false;
+    }
+
+    memcpy(token, begin, length);
+    token[length] = '\0';
+
+    return true;
+}
+
+/*!
+  \brief function to set one "key: value" field of YAML to laser entry
+  \attention unknown keys are ignored
+*/
+static void set_yaml_field_to_vlp16_calibration_entry(const char *begin, const char *end,
+                                                      vlp16_calibration_entry_t *entry)
+{
+    const char *separator = begin;
+    while ((separator < end) && (*separator != ':')) {
+        ++separator;
+    }
+    if (separator == end) {
+        return;
+    }
+
+    char key[VLP16_CALIBRATION_MAXIMUM_TOKEN_LENGTH];
+    char value_string[VLP16_CALIBRATION_MAXIMUM_TOKEN_LENGTH];
+    if ((copy_trimmed_token(begin, separator, key) == false) ||
+        (copy_trimmed_token(separator + 1, end, value_string) == false)) {
+        return;
+    }
+
+    const double value = strtod(value_string, NULL);
+
+    if (strcmp(key, "laser_id") == 0) {
+        entry->laser_id = (int)strtol(value_string, NULL, 10);
+    } else if (strcmp(key, "rot_correction") == 0) {
+        entry->laser.rotational_correction = value;
+    } else if (strcmp(key, "vert_correction") == 0) {
+        entry->laser.vertical_correction = value;
+    } else if (strcmp(key, "dist_correction") == 0) {
+        entry->laser.distance_correction = value * VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+    } else if (strcmp(key, "vert_offset_correction") == 0) {
+        entry->laser.vertical_offset_correction = value * VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+    } else if (strcmp(key, "horiz_offset_correction") == 0) {
+        entry->laser.horizontal_offset_correction = value * VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+    }
+
+    return;
+}
+
+bool parse_vlp16_calibration_yaml(const char *text, vlp16_calibration_t *calibration)
+{
+    clear_vlp16_calibration(calibration);
+
+    vlp16_calibration_entry_t entry;
+    clear_vlp16_calibration_entry(&entry);
+    bool entry_opened = false;
+
+    const char *line = text;
+    while (*line != '\0') {
+
+        const char *line_end = line;
+        while ((*line_end != '\0') && (*line_end != '\n')) {
+            ++line_end;
+        }
+
+        const char *content = line;
+        while ((content < line_end) && ((*content == ' ') || (*content == '\t'))) {
+            ++content;
+        }
+
+        if ((content == line_end) || (*content == '#') || (*content == '\r')) {
+            // empty line or comment
+
+        } else if (*content == '-') {
+            // item of lasers list starts
+            if ((entry_opened == true) &&
+                (commit_vlp16_calibration_entry(&entry, calibration) == false)) {
+                return false;
+            }
+            clear_vlp16_calibration_entry(&entry);
+            entry_opened = true;
+            ++content;
+
+        } else if (content == line) {
+            // key of top level (lasers, num_lasers, distance_resolution, ...)
+            if ((entry_opened == true) &&
+                (commit_vlp16_calibration_entry(&entry, calibration) == false)) {
+                return false;
+            }
+            entry_opened = false;
+        }
+
+        // fields are separated with ',' and braces of flow style
+        if (entry_opened == true) {
+            const char *field = content;
+            for (const char *position = content; position <= line_end; ++position) {
+                if ((position == line_end) || (*position == ',') || (*position == '{') || (*position == '}')) {
+                    set_yaml_field_to_vlp16_calibration_entry(field, position, &entry);
+                    field = position + 1;
+                }
+            }
+        }
+
+        line = (*line_end == '\0') ? line_end : line_end + 1;
+    }
+
+    if ((entry_opened == true) &&
+        (commit_vlp16_calibration_entry(&entry, calibration) == false)) {
+        return false;
+    }
+
+    return (calibration->number_of_lasers > 0);
+}
+
+/*!
+  \brief function to get value of element in [begin, end) of XML
+  \attention this function returns false if element is not found
+*/
+static bool get_xml_element_value(const char *begin, const char *end, const char *element_name, double *value)
+{
+    char open_tag[VLP16_CALIBRATION_MAXIMUM_TOKEN_LENGTH];
+    const size_t element_name_length = strlen(element_name);
+    if (element_name_length + 3 > sizeof(open_tag)) {
+        return false;
+    }
+
+    open_tag[0] = '<';
+    memcpy(open_tag + 1, element_name, element_name_length);
+    open_tag[element_name_length + 1] = '>';
+    open_tag[element_name_length + 2] = '\0';
+
+    const char *element = strstr(begin, open_tag);
+    if ((element == NULL) ||
+        (element >= end)) {
+        return false;
+    }
+
+    *value = strtod(element + element_name_length + 2, NULL);
+
+    return true;
+}
+
+bool parse_vlp16_calibration_xml(const char *text, vlp16_calibration_t *calibration)
+{
+    clear_vlp16_calibration(calibration);
+
+    const char *point = strstr(text, "<px");
+    while (point != NULL) {
+
+        const char *point_end = strstr(point, "</px>");
+        if (point_end == NULL) {
+            return false;
+        }
+
+        vlp16_calibration_entry_t entry;
+        clear_vlp16_calibration_entry(&entry);
+
+        double value = 0.0;
+        if (get_xml_element_value(point, point_end, "id_", &value) == true) {
+            entry.laser_id = (int)value;
+        }
+        if (get_xml_element_value(point, point_end, "rotCorrection_", &value) == true) {
+            entry.laser.rotational_correction = value * VLP16_CALIBRATION_DEGREE_TO_RADIAN;
+        }
+        if (get_xml_element_value(point, point_end, "vertCorrection_", &value) == true) {
+            entry.laser.vertical_correction = value * VLP16_CALIBRATION_DEGREE_TO_RADIAN;
+        }
+        if (get_xml_element_value(point, point_end, "distCorrection_", &value) == true) {
+            entry.laser.distance_correction = value * VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE;
+        }
+        if (get_xml_element_value(point, point_end, "vertOffsetCorrection_", &value) == true) {
+            entry.laser.vertical_offset_correction = value * VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE;
+        }
+        if (get_xml_element_value(point, point_end, "horizOffsetCorrection_", &value) == true) {
+            entry.laser.horizontal_offset_correction = value * VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE;
+        }
+
+        if (commit_vlp16_calibration_entry(&entry, calibration) == false) {
+            return false;
+        }
+
+        point = strstr(point_end, "<px");
+    }
+
+    return (calibration->number_of_lasers > 0);
+}
+
+bool load_vlp16_calibration_file(const char *file_path, vlp16_calibration_t *calibration)
+{
+    clear_vlp16_calibration(calibration);
+
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    std::vector<char> text(VLP16_CALIBRATION_MAXIMUM_FILE_LENGTH + 1);
+    const size_t text_length = fread(&text[0], 1, VLP16_CALIBRATION_MAXIMUM_FILE_LENGTH, file);
+    fclose(file);
+
+    text[text_length] = '\0';
+
+    const char *content = &text[0];
+    while (is_space_character(*content) == true) {
+        ++content;
+    }
+
+    if (*content == '<') {
+        return parse_vlp16_calibration_xml(content, calibration);
+    }
+
+    return parse_vlp16_calibration_yaml(content, calibration);
+}
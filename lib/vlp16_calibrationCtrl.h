@@ -0,0 +1,85 @@
+#ifndef VLP16_CALIBRATION_CONTROL_H
+#define VLP16_CALIBRATION_CONTROL_H
+/*!
+  \file
+  \brief functions to load intrinsic calibration of Velodyne sensors (YAML of velodyne_pointcloud or db.xml of VeloView)
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+//! constants for calibration
+enum VLP16_CALIBRATION_CONSTANT {
+
+    //! maximum number of lasers
+    VLP16_CALIBRATION_MAXIMUM_NUMBER_OF_LASERS = 32,
+
+    //! maximum length of calibration file [byte]
+    VLP16_CALIBRATION_MAXIMUM_FILE_LENGTH = 1024 * 1024,
+
+};
+
+//! scale of distance in calibration to distance of decoded echo (meter to millimeter)
+#define VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE 1000.0
+
+//! scale of distance in db.xml to distance of decoded echo (centimeter to millimeter)
+#define VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE 10.0
+
+//! correction of one laser
+struct vlp16_laser_calibration_t {
+
+    //! rotational correction [rad] (corrected horizontal angle = horizontal angle - rotational correction)
+    double rotational_correction;
+
+    //! vertical correction (elevation angle) [rad]
+    double vertical_correction;
+
+    //! distance correction [mm] (corrected distance = distance + distance correction)
+    double distance_correction;
+
+    //! vertical offset of laser [mm]
+    double vertical_offset_correction;
+
+    //! horizontal offset of laser [mm]
+    double horizontal_offset_correction;
+
+};
+
+//! structure of intrinsic calibration of sensor
+struct vlp16_calibration_t {
+
+    //! number of calibrated lasers
+    unsigned int number_of_lasers;
+
+    //! correction of each laser (in order of laser id)
+    vlp16_laser_calibration_t laser[VLP16_CALIBRATION_MAXIMUM_NUMBER_OF_LASERS];
+
+};
+
+/*!
+  \brief function to clear calibration
+*/
+extern void clear_vlp16_calibration(vlp16_calibration_t *calibration);
+
+/*!
+  \brief function to parse calibration in YAML of velodyne_pointcloud (angles in radian, distances in meter)
+  \attention lasers list is parsed in both flow style ({key: value, ...}) and block style
+  \attention this function returns false if laser id is out of range or no laser is found
+*/
+extern bool parse_vlp16_calibration_yaml(const char *text, vlp16_calibration_t *calibration);
+
+/*!
+  \brief function to parse calibration in db.xml of VeloView (angles in degree, distances in centimeter)
+  \attention only elements of px are parsed, and XML library is not used
+  \attention this function returns false if laser id is out of range or no laser is found
+*/
+extern bool parse_vlp16_calibration_xml(const char *text, vlp16_calibration_t *calibration);
+
+/*!
+  \brief function to load calibration file
+  \attention format is detected with content (XML if file starts with '<', YAML otherwise)
+*/
+extern bool load_vlp16_calibration_file(const char *file_path, vlp16_calibration_t *calibration);
+
+#endif // VLP16_CALIBRATION_CONTROL_H
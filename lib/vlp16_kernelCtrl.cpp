@@ -0,0 +1,358 @@
+
+#include "vlp16_kernelCtrl.h"
+
+// for NULL
+#include <stddef.h>
+
+#if defined(VLP16_KERNEL_SIMD_AVAILABLE)
+// for SSE4.1 and AVX2 intrinsics
+#include <immintrin.h>
+#endif
+
+void make_vlp16_spot_time_offset_table(double one_laser_firing_interval_usec, unsigned int number_of_spots,
+                                       unsigned int number_of_simultaneous_firings,
+                                       unsigned int *spot_time_offset_usec)
+{
+    if (number_of_simultaneous_firings == 0) {
+        number_of_simultaneous_firings = 1;
+    }
+
+    for (unsigned int i = 0; i < number_of_spots; ++i) {
+        spot_time_offset_usec[i] =
+            (unsigned int)(one_laser_firing_interval_usec * (double)(i / number_of_simultaneous_firings));
+    }
+
+    return;
+}
+
+template <unsigned int NUMBER_OF_SPOTS, unsigned int NUMBER_OF_SIMULTANEOUS_FIRINGS>
+static void decode_vlp16_firing_sequence_from_spot(const char *firing_data,
+                                                   const vlp16_firing_sequence_parameter_t *parameter,
+                                                   unsigned int start_spot_index,
+                                                   vlp16_firing_sequence_lanes_t *lanes)
+{
+    const unsigned char *record = (const unsigned char *)firing_data;
+
+    for (unsigned int i = start_spot_index; i < NUMBER_OF_SPOTS; ++i) {
+
+        const unsigned int record_position = i * VLP16_KERNEL_SPOT_RECORD_LENGTH;
+
+        const unsigned int raw_distance =
+            ((unsigned int)record[record_position] | ((unsigned int)record[record_position + 1] << 8)) << 1;
+
+        // distance of no echo (0) is kept, and corrected distance is not negative (select without branch)
+        int corrected_distance = (int)raw_distance + parameter->spot_distance_offset[i];
+        corrected_distance &= -(int)(raw_distance != 0);
+        lanes->distance[i] = (unsigned int)((corrected_distance > 0) ? corrected_distance : 0);
+
+        lanes->intensity[i] = (unsigned int)record[record_position + 2];
+
+        lanes->measured_time[i] = parameter->line_start_timestamp + parameter->spot_time_offset_usec[i];
+
+        lanes->horizontal_angle[i] =
+            (parameter->one_firing_azimuthal_angle_step * (double)(i / NUMBER_OF_SIMULTANEOUS_FIRINGS) + parameter->start_azimuthal_angle) +
+            parameter->spot_azimuthal_angle_offset[i];
+    }
+
+    return;
+}
+
+template <unsigned int NUMBER_OF_SPOTS, unsigned int NUMBER_OF_SIMULTANEOUS_FIRINGS>
+static void decode_vlp16_firing_sequence_using_scalar(const char *firing_data,
+                                                      const vlp16_firing_sequence_parameter_t *parameter,
+                                                      vlp16_firing_sequence_lanes_t *lanes)
+{
+    decode_vlp16_firing_sequence_from_spot<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>(firing_data, parameter, 0, lanes);
+
+    return;
+}
+
+#if defined(VLP16_KERNEL_SIMD_AVAILABLE)
+
+//! shuffle masks to take distances of four spots (first 4 bytes are skipped on shift 4)
+static const signed char VLP16_KERNEL_DISTANCE_SHUFFLE_MASK[2][16] = {
+    { 0, 1, -1, -1, 3, 4, -1, -1, 6, 7, -1, -1, 9, 10, -1, -1 },
+    { 4, 5, -1, -1, 7, 8, -1, -1, 10, 11, -1, -1, 13, 14, -1, -1 } };
+
+//! shuffle masks to take intensities of four spots (first 4 bytes are skipped on shift 4)
+static const signed char VLP16_KERNEL_INTENSITY_SHUFFLE_MASK[2][16] = {
+    { 2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1 },
+    { 6, -1, -1, -1, 9, -1, -1, -1, 12, -1, -1, -1, 15, -1, -1, -1 } };
+
+/*!
+  \brief function to get load position of 16 byte including records of four spots
+  \attention load position is moved backward not to read over the end of firing sequence
+  \attention this function returns -1 if mask to the shift is not prepared
+*/
+static int get_mask_index_to_load_four_spot_records(unsigned int spot_index, unsigned int record_length,
+                                                    unsigned int *load_position)
+{
+    const unsigned int record_position = spot_index * VLP16_KERNEL_SPOT_RECORD_LENGTH;
+
+    *load_position = record_position;
+    if (record_position + 16 > record_length) {
+        *load_position = record_length - 16;
+    }
+
+    switch (record_position - *load_position) {
+        case 0:
+            return 0;
+        case 4:
+            return 1;
+        default:
+            break;
+    }
+
+    return -1;
+}
+
+template <unsigned int NUMBER_OF_SPOTS, unsigned int NUMBER_OF_SIMULTANEOUS_FIRINGS>
+__attribute__((target("sse4.1")))
+static void decode_vlp16_firing_sequence_using_sse4_1(const char *firing_data,
+                                                      const vlp16_firing_sequence_parameter_t *parameter,
+                                                      vlp16_firing_sequence_lanes_t *lanes)
+{
+    const unsigned int record_length = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH;
+
+    unsigned int spot_index = 0;
+
+    if (record_length >= 16) {
+
+        const __m128i start_time = _mm_set1_epi32((int)parameter->line_start_timestamp);
+        const __m128d angle_step = _mm_set1_pd(parameter->one_firing_azimuthal_angle_step);
+        const __m128d start_angle = _mm_set1_pd(parameter->start_azimuthal_angle);
+        const __m128i zero = _mm_setzero_si128();
+
+        // firing indices of two spots (simultaneous firings divide 2)
+        const __m128d two_spots = _mm_set1_pd((double)(2 / NUMBER_OF_SIMULTANEOUS_FIRINGS));
+        __m128d spot_index_value = _mm_set_pd((double)(1 / NUMBER_OF_SIMULTANEOUS_FIRINGS), 0.0);
+
+        unsigned int load_position = 0;
+
+        for (; spot_index + 4 <= NUMBER_OF_SPOTS; spot_index += 4) {
+
+            const int mask_index =
+                get_mask_index_to_load_four_spot_records(spot_index, record_length, &load_position);
+            if (mask_index < 0) {
+                break;
+            }
+
+            const __m128i records = _mm_loadu_si128((const __m128i *)(firing_data + load_position));
+
+            const __m128i distance_mask = _mm_loadu_si128((const __m128i *)VLP16_KERNEL_DISTANCE_SHUFFLE_MASK[mask_index]);
+            const __m128i intensity_mask = _mm_loadu_si128((const __m128i *)VLP16_KERNEL_INTENSITY_SHUFFLE_MASK[mask_index]);
+
+            const __m128i raw_distance = _mm_slli_epi32(_mm_shuffle_epi8(records, distance_mask), 1);
+            const __m128i distance_offset = _mm_loadu_si128((const __m128i *)&parameter->spot_distance_offset[spot_index]);
+            _mm_storeu_si128((__m128i *)&lanes->distance[spot_index],
+                             _mm_andnot_si128(_mm_cmpeq_epi32(raw_distance, zero),
+                                              _mm_max_epi32(_mm_add_epi32(raw_distance, distance_offset), zero)));
+            _mm_storeu_si128((__m128i *)&lanes->intensity[spot_index],
+                             _mm_shuffle_epi8(records, intensity_mask));
+
+            const __m128i time_offset = _mm_loadu_si128((const __m128i *)&parameter->spot_time_offset_usec[spot_index]);
+            _mm_storeu_si128((__m128i *)&lanes->measured_time[spot_index],
+                             _mm_add_epi32(start_time, time_offset));
+
+            // multiply and add are not fused to keep output equal to scalar kernel
+            _mm_storeu_pd(&lanes->horizontal_angle[spot_index],
+                          _mm_add_pd(_mm_add_pd(_mm_mul_pd(angle_step, spot_index_value), start_angle),
+                                     _mm_loadu_pd(&parameter->spot_azimuthal_angle_offset[spot_index])));
+            spot_index_value = _mm_add_pd(spot_index_value, two_spots);
+
+            _mm_storeu_pd(&lanes->horizontal_angle[spot_index + 2],
+                          _mm_add_pd(_mm_add_pd(_mm_mul_pd(angle_step, spot_index_value), start_angle),
+                                     _mm_loadu_pd(&parameter->spot_azimuthal_angle_offset[spot_index + 2])));
+            spot_index_value = _mm_add_pd(spot_index_value, two_spots);
+        }
+
+    }
+
+    decode_vlp16_firing_sequence_from_spot<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>(firing_data, parameter, spot_index, lanes);
+
+    return;
+}
+
+template <unsigned int NUMBER_OF_SPOTS, unsigned int NUMBER_OF_SIMULTANEOUS_FIRINGS>
+__attribute__((target("avx2")))
+static void decode_vlp16_firing_sequence_using_avx2(const char *firing_data,
+                                                    const vlp16_firing_sequence_parameter_t *parameter,
+                                                    vlp16_firing_sequence_lanes_t *lanes)
+{
+    const unsigned int record_length = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH;
+
+    unsigned int spot_index = 0;
+
+    if (record_length >= 16) {
+
+        const __m256i start_time = _mm256_set1_epi32((int)parameter->line_start_timestamp);
+        const __m256d angle_step = _mm256_set1_pd(parameter->one_firing_azimuthal_angle_step);
+        const __m256d start_angle = _mm256_set1_pd(parameter->start_azimuthal_angle);
+        const __m256i zero = _mm256_setzero_si256();
+
+        // firing indices of four spots (simultaneous firings divide 4)
+        const __m256d four_spots = _mm256_set1_pd((double)(4 / NUMBER_OF_SIMULTANEOUS_FIRINGS));
+        __m256d spot_index_value = _mm256_set_pd((double)(3 / NUMBER_OF_SIMULTANEOUS_FIRINGS), (double)(2 / NUMBER_OF_SIMULTANEOUS_FIRINGS),
+                                                 (double)(1 / NUMBER_OF_SIMULTANEOUS_FIRINGS), 0.0);
+
+        unsigned int low_load_position = 0;
+        unsigned int high_load_position = 0;
+
+        for (; spot_index + 8 <= NUMBER_OF_SPOTS; spot_index += 8) {
+
+            const int low_mask_index =
+                get_mask_index_to_load_four_spot_records(spot_index, record_length, &low_load_position);
+            const int high_mask_index =
+                get_mask_index_to_load_four_spot_records(spot_index + 4, record_length, &high_load_position);
+            if ((low_mask_index < 0) ||
+                (high_mask_index < 0)) {
+                break;
+            }
+
+            // records of spots [0, 4) in low lane and [4, 8) in high lane (shuffle works in each lane)
+            const __m256i records =
+                _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(firing_data + low_load_position))),
+                                        _mm_loadu_si128((const __m128i *)(firing_data + high_load_position)), 1);
+
+            const __m256i distance_mask =
+                _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)VLP16_KERNEL_DISTANCE_SHUFFLE_MASK[low_mask_index])),
+                                        _mm_loadu_si128((const __m128i *)VLP16_KERNEL_DISTANCE_SHUFFLE_MASK[high_mask_index]), 1);
+            const __m256i intensity_mask =
+                _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)VLP16_KERNEL_INTENSITY_SHUFFLE_MASK[low_mask_index])),
+                                        _mm_loadu_si128((const __m128i *)VLP16_KERNEL_INTENSITY_SHUFFLE_MASK[high_mask_index]), 1);
+
+            const __m256i raw_distance = _mm256_slli_epi32(_mm256_shuffle_epi8(records, distance_mask), 1);
+            const __m256i distance_offset = _mm256_loadu_si256((const __m256i *)&parameter->spot_distance_offset[spot_index]);
+            _mm256_storeu_si256((__m256i *)&lanes->distance[spot_index],
+                                _mm256_andnot_si256(_mm256_cmpeq_epi32(raw_distance, zero),
+                                                    _mm256_max_epi32(_mm256_add_epi32(raw_distance, distance_offset), zero)));
+            _mm256_storeu_si256((__m256i *)&lanes->intensity[spot_index],
+                                _mm256_shuffle_epi8(records, intensity_mask));
+
+            const __m256i time_offset = _mm256_loadu_si256((const __m256i *)&parameter->spot_time_offset_usec[spot_index]);
+            _mm256_storeu_si256((__m256i *)&lanes->measured_time[spot_index],
+                                _mm256_add_epi32(start_time, time_offset));
+
+            // multiply and add are not fused to keep output equal to scalar kernel
+            _mm256_storeu_pd(&lanes->horizontal_angle[spot_index],
+                             _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(angle_step, spot_index_value), start_angle),
+                                           _mm256_loadu_pd(&parameter->spot_azimuthal_angle_offset[spot_index])));
+            spot_index_value = _mm256_add_pd(spot_index_value, four_spots);
+
+            _mm256_storeu_pd(&lanes->horizontal_angle[spot_index + 4],
+                             _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(angle_step, spot_index_value), start_angle),
+                                           _mm256_loadu_pd(&parameter->spot_azimuthal_angle_offset[spot_index + 4])));
+            spot_index_value = _mm256_add_pd(spot_index_value, four_spots);
+        }
+
+        // upper halves of ymm registers are cleared before SSE code (gcc does not insert vzeroupper in target function)
+        _mm256_zeroupper();
+    }
+
+    decode_vlp16_firing_sequence_from_spot<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>(firing_data, parameter, spot_index, lanes);
+
+    return;
+}
+
+#endif
+
+bool is_usable_vlp16_decode_kernel(enum VLP16_DECODE_KERNEL_TYPE kernel_type)
+{
+    switch (kernel_type) {
+
+        case VLP16_SCALAR_DECODE_KERNEL:
+            return true;
+
+#if defined(VLP16_KERNEL_SIMD_AVAILABLE)
+        case VLP16_SSE4_1_DECODE_KERNEL:
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("sse4.1")) {
+                return true;
+            }
+            break;
+
+        case VLP16_AVX2_DECODE_KERNEL:
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return true;
+            }
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+enum VLP16_DECODE_KERNEL_TYPE detect_fastest_vlp16_decode_kernel(void)
+{
+    for (int i = NUMBER_OF_VLP16_DECODE_KERNELS - 1; i > VLP16_SCALAR_DECODE_KERNEL; --i) {
+
+        if (is_usable_vlp16_decode_kernel((enum VLP16_DECODE_KERNEL_TYPE)i) == true) {
+            return (enum VLP16_DECODE_KERNEL_TYPE)i;
+        }
+
+    }
+
+    return VLP16_SCALAR_DECODE_KERNEL;
+}
+
+template <unsigned int NUMBER_OF_SPOTS, unsigned int NUMBER_OF_SIMULTANEOUS_FIRINGS>
+static vlp16_firing_sequence_decoder_t get_vlp16_firing_sequence_decoder_of_spots(enum VLP16_DECODE_KERNEL_TYPE kernel_type)
+{
+    switch (kernel_type) {
+
+        case VLP16_SCALAR_DECODE_KERNEL:
+            return decode_vlp16_firing_sequence_using_scalar<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>;
+
+#if defined(VLP16_KERNEL_SIMD_AVAILABLE)
+        case VLP16_SSE4_1_DECODE_KERNEL:
+            return decode_vlp16_firing_sequence_using_sse4_1<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>;
+
+        case VLP16_AVX2_DECODE_KERNEL:
+            return decode_vlp16_firing_sequence_using_avx2<NUMBER_OF_SPOTS, NUMBER_OF_SIMULTANEOUS_FIRINGS>;
+#endif
+
+        default:
+            break;
+    }
+
+    return NULL;
+}
+
+vlp16_firing_sequence_decoder_t get_vlp16_firing_sequence_decoder(enum VLP16_DECODE_KERNEL_TYPE kernel_type,
+                                                                  unsigned int number_of_spots,
+                                                                  unsigned int number_of_simultaneous_firings)
+{
+    if (is_usable_vlp16_decode_kernel(kernel_type) == false) {
+        return NULL;
+    }
+
+    switch (number_of_simultaneous_firings) {
+
+        case 1:
+            if (number_of_spots == 16) {
+                return get_vlp16_firing_sequence_decoder_of_spots<16, 1>(kernel_type);
+            }
+            if (number_of_spots == 32) {
+                return get_vlp16_firing_sequence_decoder_of_spots<32, 1>(kernel_type);
+            }
+            break;
+
+        case 2:
+            if (number_of_spots == 16) {
+                return get_vlp16_firing_sequence_decoder_of_spots<16, 2>(kernel_type);
+            }
+            if (number_of_spots == 32) {
+                return get_vlp16_firing_sequence_decoder_of_spots<32, 2>(kernel_type);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,128 @@
+#ifndef VLP16_KERNEL_CONTROL_H
+#define VLP16_KERNEL_CONTROL_H
+/*!
+  \file
+  \brief kernels to decode one firing sequence of VLP16 packet
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+// SIMD kernels need target attribute and cpu feature detection of gcc 4.9 or later
+#if defined(BUILDING_X86_64_SYSTEM) && defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define VLP16_KERNEL_SIMD_AVAILABLE
+#endif
+
+//! constants of decode kernel
+enum VLP16_KERNEL_CONSTANTS {
+
+    //! length of one spot record (distance [2 byte] and reflectivity [1 byte])
+    VLP16_KERNEL_SPOT_RECORD_LENGTH = 3,
+
+    //! maximum number of spots in one firing sequence
+    VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS = 32,
+
+};
+
+//! types of decode kernel
+enum VLP16_DECODE_KERNEL_TYPE {
+
+    //! invalid kernel
+    VLP16_INVALID_DECODE_KERNEL = -1,
+
+    //! scalar kernel
+    VLP16_SCALAR_DECODE_KERNEL = 0,
+
+    //! SSE4.1 kernel
+    VLP16_SSE4_1_DECODE_KERNEL,
+
+    //! AVX2 kernel
+    VLP16_AVX2_DECODE_KERNEL,
+
+    //! number of kernels
+    NUMBER_OF_VLP16_DECODE_KERNELS,
+};
+
+//! names of decode kernels
+const char VLP16_DECODE_KERNEL_NAME[NUMBER_OF_VLP16_DECODE_KERNELS][8] =
+    { "scalar", "sse4.1", "avx2" };
+
+//! parameters to decode one firing sequence
+struct vlp16_firing_sequence_parameter_t {
+
+    //! measured time of first spot [usec]
+    unsigned int line_start_timestamp;
+
+    //! horizontal angle of first spot [rad]
+    double start_azimuthal_angle;
+
+    //! horizontal angle step of one firing [rad] (simultaneously fired spots share one horizontal angle)
+    double one_firing_azimuthal_angle_step;
+
+    //! firing time offset of each spot [usec] (truncated firing interval * firing index of spot)
+    const unsigned int *spot_time_offset_usec;
+
+    //! horizontal angle offset of each spot [rad] (rotational correction of calibration, 0 without calibration)
+    const double *spot_azimuthal_angle_offset;
+
+    //! distance offset of each spot (distance correction of calibration, 0 without calibration)
+    const int *spot_distance_offset;
+
+};
+
+//! decoded values of one firing sequence
+struct vlp16_firing_sequence_lanes_t {
+
+    //! scaled distance of each spot
+    unsigned int distance[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+    //! intensity of each spot
+    unsigned int intensity[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+    //! measured time of each spot [usec]
+    unsigned int measured_time[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+    //! horizontal angle of each spot [rad]
+    double horizontal_angle[VLP16_KERNEL_MAXIMUM_NUMBER_OF_SPOTS];
+
+};
+
+//! type of kernel to decode one firing sequence
+typedef void (*vlp16_firing_sequence_decoder_t)(const char *firing_data,
+                                                const vlp16_firing_sequence_parameter_t *parameter,
+                                                vlp16_firing_sequence_lanes_t *lanes);
+
+/*!
+  \brief function to detect fastest decode kernel on running cpu
+*/
+extern enum VLP16_DECODE_KERNEL_TYPE detect_fastest_vlp16_decode_kernel(void);
+
+/*!
+  \brief function to evaluate whether decode kernel is usable on running cpu
+*/
+extern bool is_usable_vlp16_decode_kernel(enum VLP16_DECODE_KERNEL_TYPE kernel_type);
+
+/*!
+  \brief function to get kernel to decode one firing sequence
+  \attention kernels are instantiated for each number of spots (16 or 32) and number of simultaneous firings (1 or 2), and loops of spots are unrolled
+  \attention this function returns NULL if kernel is not usable or firing sequence of the spots is not supported
+  \attention all kernels output bit-identical values
+  \attention distance is scaled by 2 (VLP16_PACKET_DISTANCE_SCALE), and offset of spot is added to distance except no echo (0)
+  \attention horizontal angle is (step * firing index of spot i + start angle) + offset of spot, and corrections do not add branches
+  \attention firing index of spot i is i / number_of_simultaneous_firings
+  \attention measured time is line_start_timestamp + spot_time_offset_usec[i], which equals truncation of (firing interval * firing index of spot i + line_start_timestamp) in double precision, because fractional part of firing interval * i (i < 32) is not close to 1.
+*/
+extern vlp16_firing_sequence_decoder_t get_vlp16_firing_sequence_decoder(enum VLP16_DECODE_KERNEL_TYPE kernel_type,
+                                                                         unsigned int number_of_spots,
+                                                                         unsigned int number_of_simultaneous_firings);
+
+/*!
+  \brief function to make time offset table of spots
+  \attention number_of_simultaneous_firings lasers share one firing time (2 for VLP-32C, 1 for others)
+*/
+extern void make_vlp16_spot_time_offset_table(double one_laser_firing_interval_usec, unsigned int number_of_spots,
+                                              unsigned int number_of_simultaneous_firings,
+                                              unsigned int *spot_time_offset_usec);
+
+#endif // VLP16_KERNEL_CONTROL_H
@@ -0,0 +1,214 @@
+#include "vlp16_packet_generatorCtrl.h"
+
+// for memset
+#include <string.h>
+
+static void write_unsigned_short_to_vlp16_packet(char *packet, unsigned int position, unsigned int value)
+{
+    packet[position] = (char)(value & 0xff);
+    packet[position + 1] = (char)((value >> 8) & 0xff);
+
+    return;
+}
+
+static void write_unsigned_int_to_vlp16_packet(char *packet, unsigned int position, unsigned int value)
+{
+    for (unsigned int i = 0; i < 4; ++i) {
+        packet[position + i] = (char)((value >> (8 * i)) & 0xff);
+    }
+
+    return;
+}
+
+static double generate_random_value_of_vlp16_packet_generator(vlp16_packet_generator_t *generator)
+{
+    // xorshift32
+    unsigned int state = generator->random_state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    generator->random_state = state;
+
+    return (double)state / 4294967296.0;
+}
+
+bool initialize_vlp16_packet_generator(vlp16_packet_generator_t *generator,
+                                       enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                       enum VLP16_PACKET_RETURN_MODE return_mode,
+                                       double rotation_speed_rpm)
+{
+    if ((sensor_model < 0) ||
+        (sensor_model >= NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET) ||
+        (return_mode < 0) ||
+        (return_mode >= NUMBER_OF_RETURN_MODES_IN_VLP16_PACKET)) {
+        return false;
+    }
+
+    const double rotation_speed_degree_per_second = rotation_speed_rpm * 6.0;
+    if ((rotation_speed_degree_per_second < (double)VLP16_PACKET_MINIMUM_ROTATION_SPEED) ||
+        (rotation_speed_degree_per_second > (double)VLP16_PACKET_MAXIMUM_ROTATION_SPEED)) {
+        return false;
+    }
+
+    generator->sensor_model = sensor_model;
+    generator->return_mode = return_mode;
+    generator->rotation_speed_rpm = rotation_speed_rpm;
+
+    generator->data_block_duration_usec = VLP16_SENSOR_MODEL_TIMING[sensor_model].data_block_usec;
+
+    // [0.01 degree / usec] * [usec]
+    generator->azimuthal_angle_step =
+        rotation_speed_degree_per_second * 100.0 * 0.000001 * generator->data_block_duration_usec;
+
+    generator->azimuthal_angle = 0.0;
+    generator->timestamp_usec = 0.0;
+    generator->number_of_generated_packets = 0;
+
+    set_impairments_of_vlp16_packet_generator(generator, 0.0, 0.0, VLP16_PACKET_GENERATOR_DEFAULT_SEED);
+
+    return true;
+}
+
+static void generate_data_block_of_vlp16_packet(const vlp16_packet_generator_t *generator,
+                                                unsigned int azimuthal_angle, unsigned int echo_index,
+                                                char *data_block)
+{
+    data_block[VLP16_PACKET_HEADER_FLAG_POSITION_IN_DATA_BLOCK] = VLP16_PACKET_HEADER_FLAG_OF_DATA_BLOCK[0];
+    data_block[VLP16_PACKET_HEADER_FLAG_POSITION_IN_DATA_BLOCK + 1] = VLP16_PACKET_HEADER_FLAG_OF_DATA_BLOCK[1];
+
+    write_unsigned_short_to_vlp16_packet(data_block, VLP16_PACKET_AZIMUTHAL_ANGLE_POSITION_IN_DATA_BLOCK,
+                                         azimuthal_angle);
+
+    const unsigned int number_of_spots = VLP16_PACKET_NUMBER_OF_SPOTS[generator->sensor_model];
+
+    for (unsigned int i = 0; i < VLP16_PACKET_GENERATOR_NUMBER_OF_DATA_IN_DATA_BLOCK; ++i) {
+
+        const unsigned int spot_index = i % number_of_spots;
+        const unsigned int position = VLP16_PACKET_ODD_FIRING_SEQUENCE_POSITION_IN_DATA_BLOCK + i * VLP16_PACKET_GENERATOR_ONE_DATA_LENGTH;
+
+        // smooth surface which changes with azimuthal angle and laser
+        unsigned int raw_distance =
+            VLP16_PACKET_GENERATOR_MINIMUM_RAW_DISTANCE +
+            (spot_index * 131 + azimuthal_angle / 10) % VLP16_PACKET_GENERATOR_RAW_DISTANCE_RANGE +
+            echo_index * VLP16_PACKET_GENERATOR_DUAL_RETURN_RAW_DISTANCE_DIFFERENCE;
+
+        if ((spot_index + azimuthal_angle) % VLP16_PACKET_GENERATOR_NO_ECHO_SPOT_INTERVAL == 0) {
+            raw_distance = 0;
+        }
+
+        write_unsigned_short_to_vlp16_packet(data_block, position, raw_distance);
+        data_block[position + VLP16_PACKET_DISTANCE_LENGTH] = (char)((spot_index * 7 + azimuthal_angle + echo_index * 64) & 0xff);
+    }
+
+    return;
+}
+
+void generate_vlp16_packet(vlp16_packet_generator_t *generator, char *packet)
+{
+    memset((void *)packet, 0, VLP16_PACKET_LENGTH);
+
+    const bool dual_return = (generator->return_mode == VLP16_PACKET_DUAL_RETURN_MODE);
+
+    // two data blocks of same firing are sent on dual return
+    const unsigned int number_of_firings =
+        dual_return ? VLP16_PACKET_HALF_NUMBER_OF_DATA_BLOCKS : VLP16_PACKET_NUMBER_OF_DATA_BLOCKS;
+    const unsigned int number_of_echoes = dual_return ? 2 : 1;
+
+    write_unsigned_int_to_vlp16_packet(packet, VLP16_PACKET_TIMESTAMP_POSITION,
+                                       (unsigned int)generator->timestamp_usec);
+
+    for (unsigned int firing_index = 0; firing_index < number_of_firings; ++firing_index) {
+
+        const unsigned int azimuthal_angle = (unsigned int)generator->azimuthal_angle;
+
+        for (unsigned int echo_index = 0; echo_index < number_of_echoes; ++echo_index) {
+
+            const unsigned int block_index = firing_index * number_of_echoes + echo_index;
+            generate_data_block_of_vlp16_packet(generator, azimuthal_angle, echo_index,
+                                                packet + VLP16_PACKET_DATA_BLOCK_POSITION[block_index]);
+        }
+
+        generator->azimuthal_angle += generator->azimuthal_angle_step;
+        if (generator->azimuthal_angle >= (double)VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE) {
+            generator->azimuthal_angle -= (double)VLP16_PACKET_MAXIMUM_AZIMUTHAL_ANGLE;
+        }
+    }
+
+    packet[VLP16_PACKET_RETURN_MODE_BYTE_POSITION] = VLP16_PACKET_RETURN_MODE_BYTE[generator->return_mode];
+    packet[VLP16_PACKET_SENSOR_MODEL_BYTE_POSITION] = VLP16_PACKET_SENSOR_MODEL_BYTE[generator->sensor_model];
+
+    generator->timestamp_usec += calculate_packet_interval_of_vlp16_packet_generator(generator);
+    if (generator->timestamp_usec >= (double)VLP16_PACKET_MAXIMUM_TIMESTAMP) {
+        generator->timestamp_usec -= (double)VLP16_PACKET_MAXIMUM_TIMESTAMP;
+    }
+
+    ++generator->number_of_generated_packets;
+
+    return;
+}
+
+double calculate_packet_interval_of_vlp16_packet_generator(const vlp16_packet_generator_t *generator)
+{
+    return calculate_vlp16_packet_interval_usec(generator->sensor_model, generator->return_mode);
+}
+
+bool set_impairments_of_vlp16_packet_generator(vlp16_packet_generator_t *generator,
+                                               double loss_ratio, double reorder_ratio,
+                                               unsigned int seed)
+{
+    // negated comparison rejects NaN too
+    if ((!(loss_ratio >= 0.0) || !(loss_ratio <= 1.0)) ||
+        (!(reorder_ratio >= 0.0) || !(reorder_ratio <= 1.0))) {
+        return false;
+    }
+
+    generator->loss_ratio = loss_ratio;
+    generator->reorder_ratio = reorder_ratio;
+
+    // state of xorshift should not be zero
+    generator->random_state = (seed != 0) ? seed : (unsigned int)VLP16_PACKET_GENERATOR_DEFAULT_SEED;
+
+    generator->packet_held = false;
+    generator->number_of_lost_packets = 0;
+    generator->number_of_reordered_packets = 0;
+
+    return true;
+}
+
+unsigned int emit_vlp16_packets_of_generator(vlp16_packet_generator_t *generator, char *packets)
+{
+    generate_vlp16_packet(generator, packets);
+
+    if (generate_random_value_of_vlp16_packet_generator(generator) < generator->loss_ratio) {
+        ++generator->number_of_lost_packets;
+        return 0;
+    }
+
+    // held packet is emitted after generated packet
+    if (generator->packet_held == true) {
+        memcpy(packets + VLP16_PACKET_LENGTH, generator->held_packet, VLP16_PACKET_LENGTH);
+        generator->packet_held = false;
+        return 2;
+    }
+
+    if (generate_random_value_of_vlp16_packet_generator(generator) < generator->reorder_ratio) {
+        memcpy(generator->held_packet, packets, VLP16_PACKET_LENGTH);
+        generator->packet_held = true;
+        ++generator->number_of_reordered_packets;
+        return 0;
+    }
+
+    return 1;
+}
+
+unsigned int flush_held_packet_of_vlp16_packet_generator(vlp16_packet_generator_t *generator, char *packet)
+{
+    if (generator->packet_held == false) {
+        return 0;
+    }
+
+    memcpy(packet, generator->held_packet, VLP16_PACKET_LENGTH);
+    generator->packet_held = false;
+
+    return 1;
+}
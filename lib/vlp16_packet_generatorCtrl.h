@@ -0,0 +1,138 @@
+#ifndef VLP16_PACKET_GENERATOR_CONTROL_H
+#define VLP16_PACKET_GENERATOR_CONTROL_H
+/*!
+  \file
+  \brief functions to generate synthetic VLP16 and HDL-32E packets
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "vlp16Ctrl.h"
+
+//! constants for packet generator
+enum VLP16_PACKET_GENERATOR_CONSTANT {
+
+    //! default rotation speed [rpm]
+    VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM = 600,
+
+    //! minimum raw distance of generated echoes (2 mm unit)
+    VLP16_PACKET_GENERATOR_MINIMUM_RAW_DISTANCE = 500,
+
+    //! range of raw distance of generated echoes (2 mm unit)
+    VLP16_PACKET_GENERATOR_RAW_DISTANCE_RANGE = 4000,
+
+    //! difference of raw distance between strongest and last echoes on dual return (2 mm unit)
+    VLP16_PACKET_GENERATOR_DUAL_RETURN_RAW_DISTANCE_DIFFERENCE = 150,
+
+    //! length of distance and reflectivity of one spot [byte]
+    VLP16_PACKET_GENERATOR_ONE_DATA_LENGTH = VLP16_PACKET_DISTANCE_LENGTH + VLP16_PACKET_REFLECTIVITY_LENGTH,
+
+    //! number of distance and reflectivity data in one data block (32 data of VLP16 two firings or HDL-32E one firing)
+    VLP16_PACKET_GENERATOR_NUMBER_OF_DATA_IN_DATA_BLOCK = 32,
+
+    //! interval of spots without echo
+    VLP16_PACKET_GENERATOR_NO_ECHO_SPOT_INTERVAL = 23,
+
+    //! default seed of pseudo random sequence of loss and reorder
+    VLP16_PACKET_GENERATOR_DEFAULT_SEED = 2463534242U,
+
+    //! maximum number of packets emitted at once (reordered packet and held packet)
+    VLP16_PACKET_GENERATOR_MAXIMUM_NUMBER_OF_EMITTED_PACKETS = 2,
+};
+
+//! structure of generator of synthetic packets
+struct vlp16_packet_generator_t {
+
+    //! sensor model of generated packets
+    enum VLP16_PACKET_SENSOR_MODEL sensor_model;
+
+    //! return mode of generated packets
+    enum VLP16_PACKET_RETURN_MODE return_mode;
+
+    //! rotation speed [rpm]
+    double rotation_speed_rpm;
+
+    //! azimuthal angle of next data block [0.01 degree]
+    double azimuthal_angle;
+
+    //! azimuthal angle step of one data block (one firing cycle of all lasers) [0.01 degree]
+    double azimuthal_angle_step;
+
+    //! timestamp of next packet [usec from top of hour]
+    double timestamp_usec;
+
+    //! duration of one data block (one firing cycle of all lasers) [usec]
+    double data_block_duration_usec;
+
+    //! number of generated packets
+    unsigned int number_of_generated_packets;
+
+    //! ratio of packets which are lost [0.0, 1.0]
+    double loss_ratio;
+
+    //! ratio of packets which are swapped with next packet [0.0, 1.0]
+    double reorder_ratio;
+
+    //! state of pseudo random sequence (xorshift)
+    unsigned int random_state;
+
+    //! packet held to be emitted after next packet
+    char held_packet[VLP16_PACKET_LENGTH];
+
+    //! flag of held packet
+    bool packet_held;
+
+    //! number of lost packets
+    unsigned int number_of_lost_packets;
+
+    //! number of reordered packets
+    unsigned int number_of_reordered_packets;
+
+};
+
+/*!
+  \brief function to initialize packet generator
+  \attention this function returns false if sensor model or return mode is invalid, or rotation speed is out of sensor range
+*/
+extern bool initialize_vlp16_packet_generator(vlp16_packet_generator_t *generator,
+                                              enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                              enum VLP16_PACKET_RETURN_MODE return_mode,
+                                              double rotation_speed_rpm);
+
+/*!
+  \brief function to generate next packet
+  \attention VLP16_PACKET_LENGTH byte are written to packet
+  \attention azimuthal angle and timestamp advance as real sensor, and wrap at 36000 and top of hour
+*/
+extern void generate_vlp16_packet(vlp16_packet_generator_t *generator, char *packet);
+
+/*!
+  \brief function to set loss and reorder of emitted packets
+  \attention loss and reorder are decided by pseudo random sequence of seed (same sequence for same seed)
+  \attention this function returns false and keeps impairments if loss_ratio or reorder_ratio is out of [0, 1]
+*/
+extern bool set_impairments_of_vlp16_packet_generator(vlp16_packet_generator_t *generator,
+                                                      double loss_ratio, double reorder_ratio,
+                                                      unsigned int seed);
+
+/*!
+  \brief function to generate next packet and emit packets with loss and reorder
+  \return number of emitted packets (0 to VLP16_PACKET_GENERATOR_MAXIMUM_NUMBER_OF_EMITTED_PACKETS)
+  \attention emitted packets are written to packets in order of sending (VLP16_PACKET_LENGTH byte each)
+  \attention reordered packet is held, and emitted after next packet which is not lost
+*/
+extern unsigned int emit_vlp16_packets_of_generator(vlp16_packet_generator_t *generator, char *packets);
+
+/*!
+  \brief function to emit packet held for reorder without generating next packet
+  \return number of emitted packets (0 or 1)
+  \attention this function should be called at end of finite emission, otherwise last reordered packet is not sent
+*/
+extern unsigned int flush_held_packet_of_vlp16_packet_generator(vlp16_packet_generator_t *generator, char *packet);
+
+/*!
+  \brief function to calculate interval of generated packets [usec]
+*/
+extern double calculate_packet_interval_of_vlp16_packet_generator(const vlp16_packet_generator_t *generator);
+
+#endif // VLP16_PACKET_GENERATOR_CONTROL_H
@@ -0,0 +1,168 @@
+#ifndef VLP16_SENSOR_MODEL_TRAITS_CONTROL_H
+#define VLP16_SENSOR_MODEL_TRAITS_CONTROL_H
+/*!
+  \file
+  \brief compile-time traits of sensor models to instantiate packet decoders
+  \author Kiyoshi MATSUO
+  $Id$
+
+  To add a sensor model, append it to VLP16_PACKET_SENSOR_MODEL with its model byte and spots
+  (vlp16Ctrl.h), define its traits here, and register the traits in VLP16_SENSOR_MODEL_TIMING
+  and decoder table of vlp16Ctrl.cpp.
+*/
+
+#include "vlp16Ctrl.h"
+
+//! traits of HDL-32E (one firing sequence of 32 lasers in one data block)
+struct hdl_32e_sensor_model_traits_t {
+
+    //! integral traits
+    enum {
+        //! sensor model
+        SENSOR_MODEL = VLP16_PACKET_HDL_32E,
+
+        //! number of spots
+        NUMBER_OF_SPOTS = 32,
+
+        //! number of firing sequences in one data block
+        NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK = 1,
+
+        //! number of lasers fired at same time
+        NUMBER_OF_SIMULTANEOUS_FIRINGS = 1,
+
+        //! length of one firing sequence in data block [byte]
+        FIRING_SEQUENCE_LENGTH = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH,
+    };
+
+    //! one laser firing interval [usec]
+    static double one_laser_firing_interval_usec(void) { return VLP16_PACKET_HDL_32E_ONE_LASER_FIRING_INTERVAL_USEC; }
+
+    //! one firing sequence interval [usec]
+    static double firing_sequence_usec(void) { return VLP16_PACKET_HDL_32E_ONE_DATA_BLOCK_USEC; }
+
+    //! one data block interval [usec]
+    static double data_block_usec(void) { return VLP16_PACKET_HDL_32E_ONE_DATA_BLOCK_USEC; }
+
+    //! ratio of azimuthal angle step of one firing to azimuthal angle difference of one data block
+    static double one_firing_ratio_to_data_block(void) { return VLP16_PACKET_HDL_32E_ONE_LASER_FIRING_RATIO_TO_ONE_DATA_BLOCK; }
+
+    //! elevation angle of each spot (specification value) [degree]
+    static const double *elevation_angle_degree_array(void) { return HDL_32E_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY; }
+
+};
+
+//! traits of VLP-16 (two firing sequences of 16 lasers in one data block)
+struct vlp16_sensor_model_traits_t {
+
+    //! integral traits
+    enum {
+        //! sensor model
+        SENSOR_MODEL = VLP16_PACKET_VLP16,
+
+        //! number of spots
+        NUMBER_OF_SPOTS = 16,
+
+        //! number of firing sequences in one data block
+        NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK = 2,
+
+        //! number of lasers fired at same time
+        NUMBER_OF_SIMULTANEOUS_FIRINGS = 1,
+
+        //! length of one firing sequence in data block [byte]
+        FIRING_SEQUENCE_LENGTH = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH,
+    };
+
+    //! one laser firing interval [usec]
+    static double one_laser_firing_interval_usec(void) { return VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC; }
+
+    //! one firing sequence interval [usec]
+    static double firing_sequence_usec(void) { return VLP16_PACKET_LASER_FIRING_SEQUENCE_USEC; }
+
+    //! one data block interval [usec]
+    static double data_block_usec(void) { return VLP16_PACKET_ONE_DATA_BLOCK_USEC; }
+
+    //! ratio of azimuthal angle step of one firing to azimuthal angle difference of one data block
+    static double one_firing_ratio_to_data_block(void) { return VLP16_PACKET_ONE_LASER_FIRING_RATIO_TO_ONE_FIRING_SEQUENCE; }
+
+    //! elevation angle of each spot (specification value) [degree]
+    static const double *elevation_angle_degree_array(void) { return VLP16_SPOT_SPECIFIVATION_ELEVATION_ANGLE_DEGREE_ARRAY; }
+
+};
+
+//! traits of VLP-32C (one firing sequence of 16 simultaneous firings of 2 lasers in one data block)
+struct vlp_32c_sensor_model_traits_t {
+
+    //! integral traits
+    enum {
+        //! sensor model
+        SENSOR_MODEL = VLP16_PACKET_VLP_32C,
+
+        //! number of spots
+        NUMBER_OF_SPOTS = 32,
+
+        //! number of firing sequences in one data block
+        NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK = 1,
+
+        //! number of lasers fired at same time
+        NUMBER_OF_SIMULTANEOUS_FIRINGS = 2,
+
+        //! length of one firing sequence in data block [byte]
+        FIRING_SEQUENCE_LENGTH = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH,
+    };
+
+    //! one laser firing interval [usec]
+    static double one_laser_firing_interval_usec(void) { return VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC; }
+
+    //! one firing sequence interval [usec]
+    static double firing_sequence_usec(void) { return VLP16_PACKET_VLP_32C_ONE_DATA_BLOCK_USEC; }
+
+    //! one data block interval [usec]
+    static double data_block_usec(void) { return VLP16_PACKET_VLP_32C_ONE_DATA_BLOCK_USEC; }
+
+    //! ratio of azimuthal angle step of one firing to azimuthal angle difference of one data block
+    static double one_firing_ratio_to_data_block(void) { return VLP16_PACKET_VLP_32C_ONE_LASER_FIRING_RATIO_TO_ONE_DATA_BLOCK; }
+
+    //! elevation angle of each spot (specification value) [degree]
+    static const double *elevation_angle_degree_array(void) { return VLP_32C_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY; }
+
+};
+
+//! traits of Puck Hi-Res (same firing timing as VLP-16 with narrower elevation angles)
+struct puck_hi_res_sensor_model_traits_t {
+
+    //! integral traits
+    enum {
+        //! sensor model
+        SENSOR_MODEL = VLP16_PACKET_PUCK_HI_RES,
+
+        //! number of spots
+        NUMBER_OF_SPOTS = 16,
+
+        //! number of firing sequences in one data block
+        NUMBER_OF_FIRING_SEQUENCES_IN_DATA_BLOCK = 2,
+
+        //! number of lasers fired at same time
+        NUMBER_OF_SIMULTANEOUS_FIRINGS = 1,
+
+        //! length of one firing sequence in data block [byte]
+        FIRING_SEQUENCE_LENGTH = NUMBER_OF_SPOTS * VLP16_KERNEL_SPOT_RECORD_LENGTH,
+    };
+
+    //! one laser firing interval [usec]
+    static double one_laser_firing_interval_usec(void) { return VLP16_PACKET_ONE_LASER_FIRING_INTERVAL_USEC; }
+
+    //! one firing sequence interval [usec]
+    static double firing_sequence_usec(void) { return VLP16_PACKET_LASER_FIRING_SEQUENCE_USEC; }
+
+    //! one data block interval [usec]
+    static double data_block_usec(void) { return VLP16_PACKET_ONE_DATA_BLOCK_USEC; }
+
+    //! ratio of azimuthal angle step of one firing to azimuthal angle difference of one data block
+    static double one_firing_ratio_to_data_block(void) { return VLP16_PACKET_ONE_LASER_FIRING_RATIO_TO_ONE_FIRING_SEQUENCE; }
+
+    //! elevation angle of each spot (specification value) [degree]
+    static const double *elevation_angle_degree_array(void) { return PUCK_HI_RES_SPOT_SPECIFICATION_ELEVATION_ANGLE_DEGREE_ARRAY; }
+
+};
+
+#endif // VLP16_SENSOR_MODEL_TRAITS_CONTROL_H
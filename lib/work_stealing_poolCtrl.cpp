@@ -0,0 +1,284 @@
+#include "work_stealing_poolCtrl.h"
+
+#if defined(LINUX_OS)
+// for sysconf
+#include <unistd.h>
+#endif
+
+void initialize_work_stealing_pool(work_stealing_pool_t *pool)
+{
+    pool->number_of_workers = 0;
+
+    for (unsigned int i = 0; i < WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS; ++i) {
+        pool->worker[i].pool = pool;
+        pool->worker[i].worker_index = i;
+        pool->worker[i].finished_generation = 0;
+        pool->worker[i].next_task_index = 0;
+        pool->worker[i].end_task_index = 0;
+    }
+
+    pool->task_function = NULL;
+    pool->task_argument = NULL;
+
+    pool->generation = 0;
+    pool->number_of_finished_threads = 0;
+    pool->stop_requested = false;
+    pool->started = false;
+
+    pool->number_of_steals = 0;
+
+    return;
+}
+
+static unsigned int detect_number_of_online_cpu_cores(void)
+{
+#if defined(LINUX_OS)
+    const long number_of_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (number_of_cores > 0) {
+        return (unsigned int)number_of_cores;
+    }
+#endif
+
+    return 1;
+}
+
+static bool take_task_from_own_queue(work_stealing_worker_t *worker, unsigned int *task_index)
+{
+    bool taken = false;
+
+    pthread_mutex_lock(&worker->mutex);
+    if (worker->next_task_index < worker->end_task_index) {
+        *task_index = worker->next_task_index;
+        ++worker->next_task_index;
+        taken = true;
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return taken;
+}
+
+/*!
+  \brief function to steal back half of tasks of other worker to own queue
+  \return false if queues of all other workers are empty
+*/
+static bool steal_tasks_from_other_worker(work_stealing_worker_t *worker)
+{
+    work_stealing_pool_t *pool = worker->pool;
+
+    for (unsigned int i = 1; i < pool->number_of_workers; ++i) {
+
+        work_stealing_worker_t *victim =
+            &pool->worker[(worker->worker_index + i) % pool->number_of_workers];
+
+        pthread_mutex_lock(&victim->mutex);
+
+        if (victim->next_task_index >= victim->end_task_index) {
+            pthread_mutex_unlock(&victim->mutex);
+            continue;
+        }
+
+        // tasks far from victim's current task are stolen (victim keeps locality of its range)
+        const unsigned int number_of_stolen_tasks =
+            (victim->end_task_index - victim->next_task_index + 1) / 2;
+        victim->end_task_index -= number_of_stolen_tasks;
+        const unsigned int stolen_task_index = victim->end_task_index;
+
+        pthread_mutex_unlock(&victim->mutex);
+
+        // own queue is empty, and other workers only shrink it
+        pthread_mutex_lock(&worker->mutex);
+        worker->next_task_index = stolen_task_index;
+        worker->end_task_index = stolen_task_index + number_of_stolen_tasks;
+        pthread_mutex_unlock(&worker->mutex);
+
+        __sync_fetch_and_add(&pool->number_of_steals, 1);
+
+        return true;
+    }
+
+    return false;
+}
+
+static void run_tasks_of_worker(work_stealing_worker_t *worker)
+{
+    work_stealing_pool_t *pool = worker->pool;
+    unsigned int task_index = 0;
+
+    while (1) {
+
+        if (take_task_from_own_queue(worker, &task_index) == true) {
+            pool->task_function(pool->task_argument, task_index);
+            continue;
+        }
+
+        if (steal_tasks_from_other_worker(worker) == false) {
+            break;
+        }
+    }
+
+    return;
+}
+
+static void *run_thread_of_work_stealing_pool(void *argument)
+{
+    work_stealing_worker_t *worker = (work_stealing_worker_t *)argument;
+    work_stealing_pool_t *pool = worker->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (1) {
+
+        while ((pool->generation == worker->finished_generation) &&
+               (pool->stop_requested == false)) {
+            pthread_cond_wait(&pool->start_condition, &pool->mutex);
+        }
+
+        if (pool->stop_requested == true) {
+            break;
+        }
+
+        const unsigned int generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        run_tasks_of_worker(worker);
+
+        pthread_mutex_lock(&pool->mutex);
+
+        worker->finished_generation = generation;
+        ++pool->number_of_finished_threads;
+        if (pool->number_of_finished_threads + 1 == pool->number_of_workers) {
+            pthread_cond_signal(&pool->finish_condition);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+bool start_work_stealing_pool(work_stealing_pool_t *pool, unsigned int number_of_workers)
+{
+    if (pool->started == true) {
+        return true;
+    }
+
+    if (number_of_workers == WORK_STEALING_POOL_AUTOMATIC_NUMBER_OF_WORKERS) {
+        number_of_workers = detect_number_of_online_cpu_cores();
+    }
+    if (number_of_workers > WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS) {
+        number_of_workers = WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS;
+    }
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start_condition, NULL);
+    pthread_cond_init(&pool->finish_condition, NULL);
+
+    for (unsigned int i = 0; i < number_of_workers; ++i) {
+        pthread_mutex_init(&pool->worker[i].mutex, NULL);
+        pool->worker[i].finished_generation = pool->generation;
+        pool->worker[i].next_task_index = 0;
+        pool->worker[i].end_task_index = 0;
+    }
+
+    pool->number_of_workers = number_of_workers;
+    pool->stop_requested = false;
+
+    // worker 0 is calling thread of run_tasks_on_work_stealing_pool()
+    for (unsigned int i = 1; i < number_of_workers; ++i) {
+
+        if (pthread_create(&pool->thread[i], NULL,
+                           run_thread_of_work_stealing_pool, (void *)&pool->worker[i]) != 0) {
+
+            // created threads are stopped
+            pool->number_of_workers = i;
+            pool->started = true;
+            stop_work_stealing_pool(pool);
+            return false;
+        }
+    }
+
+    pool->started = true;
+
+    return true;
+}
+
+void stop_work_stealing_pool(work_stealing_pool_t *pool)
+{
+    if (pool->started == false) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop_requested = true;
+    pthread_cond_broadcast(&pool->start_condition);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (unsigned int i = 1; i < pool->number_of_workers; ++i) {
+        pthread_join(pool->thread[i], NULL);
+    }
+
+    for (unsigned int i = 0; i < pool->number_of_workers; ++i) {
+        pthread_mutex_destroy(&pool->worker[i].mutex);
+    }
+
+    pthread_cond_destroy(&pool->finish_condition);
+    pthread_cond_destroy(&pool->start_condition);
+    pthread_mutex_destroy(&pool->mutex);
+
+    pool->number_of_workers = 0;
+    pool->started = false;
+
+    return;
+}
+
+bool is_started_work_stealing_pool(const work_stealing_pool_t *pool)
+{
+    return pool->started;
+}
+
+void run_tasks_on_work_stealing_pool(work_stealing_pool_t *pool, unsigned int number_of_tasks,
+                                     work_stealing_task_function_t task_function, void *task_argument)
+{
+    if ((pool == NULL) ||
+        (pool->started == false) ||
+        (pool->number_of_workers < 2) ||
+        (number_of_tasks < 2)) {
+
+        for (unsigned int i = 0; i < number_of_tasks; ++i) {
+            task_function(task_argument, i);
+        }
+
+        return;
+    }
+
+    // continuous range of tasks is assigned to each worker first
+    for (unsigned int i = 0; i < pool->number_of_workers; ++i) {
+        work_stealing_worker_t *worker = &pool->worker[i];
+
+        pthread_mutex_lock(&worker->mutex);
+        worker->next_task_index =
+            (unsigned int)(((unsigned long long)number_of_tasks * i) / pool->number_of_workers);
+        worker->end_task_index =
+            (unsigned int)(((unsigned long long)number_of_tasks * (i + 1)) / pool->number_of_workers);
+        pthread_mutex_unlock(&worker->mutex);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->task_function = task_function;
+    pool->task_argument = task_argument;
+    pool->number_of_finished_threads = 0;
+    ++pool->generation;
+    pthread_cond_broadcast(&pool->start_condition);
+    pthread_mutex_unlock(&pool->mutex);
+
+    run_tasks_of_worker(&pool->worker[0]);
+
+    // results of tasks are visible after all threads report finish under mutex
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->number_of_finished_threads + 1 < pool->number_of_workers) {
+        pthread_cond_wait(&pool->finish_condition, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return;
+}
@@ -0,0 +1,135 @@
+#ifndef WORK_STEALING_POOL_CONTROL_H
+#define WORK_STEALING_POOL_CONTROL_H
+/*!
+  \file
+  \brief functions to run indexed tasks on pool of threads which steal tasks from each other
+  \author Kiyoshi MATSUO
+  $Id$
+*/
+
+#include "environmentCtrl.h"
+
+#include <pthread.h>
+
+//! constants for work stealing pool
+enum WORK_STEALING_POOL_CONSTANT {
+
+    //! maximum number of workers (including calling thread)
+    WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS = 64,
+
+    //! number of workers detected with number of online cpu cores
+    WORK_STEALING_POOL_AUTOMATIC_NUMBER_OF_WORKERS = 0,
+
+    //! size of cache line to separate task queues [byte]
+    WORK_STEALING_POOL_CACHE_LINE_SIZE = 64,
+
+};
+
+//! type of task function (task_index is in [0, number_of_tasks))
+typedef void (*work_stealing_task_function_t)(void *argument, unsigned int task_index);
+
+struct work_stealing_pool_t;
+
+//! worker of pool with its queue of task indices (owner takes front, thieves take back half)
+struct work_stealing_worker_t {
+
+    //! pool of worker
+    work_stealing_pool_t *pool;
+
+    //! index of worker in pool
+    unsigned int worker_index;
+
+    //! generation of tasks finished by worker
+    unsigned int finished_generation;
+
+    //! mutex of queue
+    pthread_mutex_t mutex;
+
+    //! index of next task in queue
+    unsigned int next_task_index;
+
+    //! end index of tasks in queue (not included)
+    unsigned int end_task_index;
+
+    //! padding not to share cache line with next worker
+    char padding[WORK_STEALING_POOL_CACHE_LINE_SIZE];
+
+};
+
+//! structure of work stealing pool
+struct work_stealing_pool_t {
+
+    //! number of workers (calling thread is worker 0)
+    unsigned int number_of_workers;
+
+    //! threads of workers 1 to number_of_workers - 1
+    pthread_t thread[WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS];
+
+    //! workers
+    work_stealing_worker_t worker[WORK_STEALING_POOL_MAXIMUM_NUMBER_OF_WORKERS];
+
+    //! function of current tasks
+    work_stealing_task_function_t task_function;
+
+    //! argument of current tasks
+    void *task_argument;
+
+    //! mutex to start and finish tasks
+    pthread_mutex_t mutex;
+
+    //! condition to notify start of tasks (or stop of pool) to workers
+    pthread_cond_t start_condition;
+
+    //! condition to notify finish of workers to calling thread
+    pthread_cond_t finish_condition;
+
+    //! generation of tasks (incremented on each run)
+    unsigned int generation;
+
+    //! number of pool threads which finished current tasks
+    unsigned int number_of_finished_threads;
+
+    //! flag to stop pool threads
+    bool stop_requested;
+
+    //! flag of started pool
+    bool started;
+
+    //! number of steals (for evaluation of load balance)
+    volatile unsigned int number_of_steals;
+
+};
+
+/*!
+  \brief function to initialize work stealing pool
+  \attention this function should be used before start_work_stealing_pool()
+*/
+extern void initialize_work_stealing_pool(work_stealing_pool_t *pool);
+
+/*!
+  \brief function to start threads of work stealing pool
+  \attention number_of_workers includes calling thread, and number of online cpu cores is used on WORK_STEALING_POOL_AUTOMATIC_NUMBER_OF_WORKERS
+  \attention this function returns false if threads cannot be created
+*/
+extern bool start_work_stealing_pool(work_stealing_pool_t *pool, unsigned int number_of_workers);
+
+/*!
+  \brief function to stop threads of work stealing pool
+*/
+extern void stop_work_stealing_pool(work_stealing_pool_t *pool);
+
+/*!
+  \brief function to evaluate whether work stealing pool is started
+*/
+extern bool is_started_work_stealing_pool(const work_stealing_pool_t *pool);
+
+/*!
+  \brief function to run tasks on work stealing pool and to wait for finish of all tasks
+  \attention calling thread also runs tasks, and tasks run in calling thread in order of index if pool is not started
+  \attention tasks are divided into continuous ranges of workers, and idle worker steals back half of range of other worker
+  \attention only one thread can run tasks on one pool at a time
+*/
+extern void run_tasks_on_work_stealing_pool(work_stealing_pool_t *pool, unsigned int number_of_tasks,
+                                            work_stealing_task_function_t task_function, void *task_argument);
+
+#endif // WORK_STEALING_POOL_CONTROL_H
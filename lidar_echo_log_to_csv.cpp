@@ -0,0 +1,38 @@
+/*!
+  \file
+  \brief program to convert binary lidar echo log to text (csv)
+  \author Kiyoshi MATSUO
+*/
+
+#include "lidar_echo_logCtrl.h"
+
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " [lidar echo log file]\n";
+        return 1;
+    }
+
+    lidar_echo_log_reader_t reader;
+    clear_lidar_echo_log_reader(&reader);
+
+    if (open_lidar_echo_log_reader(argv[1], LIDAR_ECHO_LOG_DEFAULT_BUFFER_LENGTH,
+                                   &reader) == false) {
+        cerr << "Open " << argv[1] << " failed.\n";
+        return 1;
+    }
+
+    // same layout as output_lidar_echo_data_array_to_stream (angle unit is degree)
+    const unsigned int number_of_echoes =
+        convert_lidar_echo_log_to_stream(&reader, cout, ',', '\n', true);
+
+    close_lidar_echo_log_reader(&reader);
+
+    cerr << number_of_echoes << " echoes are converted.\n";
+
+    return 0;
+}
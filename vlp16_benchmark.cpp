@@ -0,0 +1,672 @@
+/*!
+  \file
+  \brief benchmark program of decode, region filter and statistics of lidar echoes
+  \author Kiyoshi MATSUO
+*/
+
+#include "vlp16_packet_generatorCtrl.h"
+
+#include "timeCtrl.h"
+
+// hooks of heap allocators (included in one source file of program)
+#include "heap_allocation_counterCtrl.h"
+
+// for memset
+#include <string.h>
+
+#include <iostream>
+
+#include <fstream>
+
+#include <sstream>
+
+#if defined(LINUX_OS)
+// for perf_event_open
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//! constants for benchmark
+enum CONSTANT_FOR_VLP16_BENCHMARK {
+
+    //! number of generated packets for decode benchmark
+    NUMBER_OF_BENCHMARK_PACKETS = 4096,
+
+    //! number of repetitions of decode benchmark
+    NUMBER_OF_DECODE_REPETITIONS = 8,
+
+    //! number of packets received at once in parallel decode benchmark
+    NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH = 64,
+
+    //! number of workers of pool in parallel decode benchmark (more than one even on single core)
+    NUMBER_OF_BENCHMARK_PARALLEL_WORKERS = 4,
+
+    //! number of lines for region filter benchmark
+    NUMBER_OF_REGION_FILTER_LINES = 2048,
+
+    //! number of repetitions of region filter benchmark
+    NUMBER_OF_REGION_FILTER_REPETITIONS = 50,
+
+    //! number of repetitions of statistics benchmark
+    NUMBER_OF_STATISTICS_REPETITIONS = 20,
+
+    //! number of data of histogram benchmark
+    NUMBER_OF_HISTOGRAM_DATA = 1000 * 1000,
+
+    //! number of repetitions of histogram benchmark
+    NUMBER_OF_HISTOGRAM_REPETITIONS = 10,
+
+    //! length of receive buffer of handler [byte]
+    BENCHMARK_RECEIVE_BUFFER_LENGTH = 10240,
+
+    //! invalid counter value (counter is not available)
+    BENCHMARK_INVALID_COUNTER = -1,
+
+};
+
+//! measured result of one benchmark case
+struct benchmark_result_t {
+
+    //! name of function
+    const char *function_name;
+
+    //! parameters of case (json object members)
+    std::string parameters;
+
+    //! number of processed packets (0 if packets are not processed)
+    unsigned long number_of_packets;
+
+    //! number of processed echoes or data
+    unsigned long number_of_echoes;
+
+    //! elapsed time [nsec]
+    double elapsed_time_nsec;
+
+    //! number of heap allocations (BENCHMARK_INVALID_COUNTER if not available)
+    long number_of_heap_allocations;
+
+    //! number of cache misses (BENCHMARK_INVALID_COUNTER if not available)
+    long long number_of_cache_misses;
+
+};
+
+//! structure of counters of one measurement
+struct benchmark_counter_t {
+
+    //! file descriptor of cache miss counter (-1 if not available)
+    int cache_miss_counter;
+
+    //! timer
+    TimeTheInterval timer;
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+    //! number of heap allocations at start
+    unsigned long number_of_heap_allocations_at_start;
+#endif
+
+};
+
+static void open_benchmark_counter(benchmark_counter_t *counter)
+{
+    counter->cache_miss_counter = -1;
+
+#if defined(LINUX_OS)
+    struct perf_event_attr attribute;
+    memset(&attribute, 0, sizeof(attribute));
+    attribute.type = PERF_TYPE_HARDWARE;
+    attribute.size = sizeof(attribute);
+    attribute.config = PERF_COUNT_HW_CACHE_MISSES;
+    attribute.disabled = 1;
+    attribute.exclude_kernel = 1;
+    attribute.exclude_hv = 1;
+
+    // counter of this thread on any cpu (fails on virtual machine or restricted perf_event_paranoid)
+    counter->cache_miss_counter = (int)syscall(__NR_perf_event_open, &attribute, 0, -1, -1, 0);
+#endif
+
+    return;
+}
+
+static void close_benchmark_counter(benchmark_counter_t *counter)
+{
+#if defined(LINUX_OS)
+    if (counter->cache_miss_counter >= 0) {
+        close(counter->cache_miss_counter);
+    }
+#endif
+    counter->cache_miss_counter = -1;
+
+    return;
+}
+
+static void start_benchmark_counter(benchmark_counter_t *counter)
+{
+#if defined(LINUX_OS)
+    if (counter->cache_miss_counter >= 0) {
+        ioctl(counter->cache_miss_counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter->cache_miss_counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+    counter->number_of_heap_allocations_at_start = number_of_heap_allocations;
+#endif
+
+    counter->timer.SetIntervalStart();
+
+    return;
+}
+
+static void stop_benchmark_counter(benchmark_counter_t *counter, benchmark_result_t *result)
+{
+    result->elapsed_time_nsec = counter->timer.TimeIntervalNanoSec();
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+    result->number_of_heap_allocations =
+        (long)(number_of_heap_allocations - counter->number_of_heap_allocations_at_start);
+#else
+    result->number_of_heap_allocations = BENCHMARK_INVALID_COUNTER;
+#endif
+
+    result->number_of_cache_misses = BENCHMARK_INVALID_COUNTER;
+
+#if defined(LINUX_OS)
+    if (counter->cache_miss_counter >= 0) {
+        ioctl(counter->cache_miss_counter, PERF_EVENT_IOC_DISABLE, 0);
+
+        long long number_of_cache_misses = 0;
+        if (read(counter->cache_miss_counter, &number_of_cache_misses, sizeof(number_of_cache_misses)) ==
+            (ssize_t)sizeof(number_of_cache_misses)) {
+            result->number_of_cache_misses = number_of_cache_misses;
+        }
+    }
+#endif
+
+    return;
+}
+
+static void clear_benchmark_result(const char *function_name, const std::string &parameters,
+                                   benchmark_result_t *result)
+{
+    result->function_name = function_name;
+    result->parameters = parameters;
+    result->number_of_packets = 0;
+    result->number_of_echoes = 0;
+    result->elapsed_time_nsec = 0.0;
+    result->number_of_heap_allocations = BENCHMARK_INVALID_COUNTER;
+    result->number_of_cache_misses = BENCHMARK_INVALID_COUNTER;
+
+    return;
+}
+
+static std::string make_decode_parameters(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                          enum VLP16_PACKET_RETURN_MODE return_mode)
+{
+    std::string parameters = "\"sensor_model\": \"";
+    parameters += VLP16_PACKET_SENSOR_MODEL_NAME[sensor_model];
+    parameters += "\"";
+    parameters += ", \"return_mode\": ";
+    parameters += (return_mode == VLP16_PACKET_DUAL_RETURN_MODE) ? "\"dual\"" : "\"strongest\"";
+
+    return parameters;
+}
+
+static std::string make_number_parameter(const char *name, double value)
+{
+    std::ostringstream stream;
+    stream << "\"" << name << "\": " << value;
+
+    return stream.str();
+}
+
+/*!
+  \brief function to allocate handler and generate packets of sensor model and return mode
+*/
+static bool prepare_benchmark_packets(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                      enum VLP16_PACKET_RETURN_MODE return_mode,
+                                      unsigned int number_of_packets,
+                                      vlp16_handler_t *handler, std::vector<char> &packets)
+{
+    vlp16_packet_generator_t generator;
+    if (initialize_vlp16_packet_generator(&generator, sensor_model, return_mode,
+                                          VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM) == false) {
+        return false;
+    }
+
+    clear_vlp16_handler(handler);
+    if (allocate_circular_buffer_for_vlp16_handler(handler, sensor_model,
+                                                   BENCHMARK_RECEIVE_BUFFER_LENGTH) == false) {
+        return false;
+    }
+
+    packets.resize(number_of_packets * VLP16_PACKET_LENGTH);
+    for (unsigned int i = 0; i < number_of_packets; ++i) {
+        generate_vlp16_packet(&generator, &packets[i * VLP16_PACKET_LENGTH]);
+    }
+
+    return true;
+}
+
+static bool benchmark_decode_vlp16_packet(benchmark_counter_t *counter,
+                                          enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                          enum VLP16_PACKET_RETURN_MODE return_mode,
+                                          benchmark_result_t *result)
+{
+    clear_benchmark_result("decode_vlp16_packet", make_decode_parameters(sensor_model, return_mode), result);
+
+    vlp16_handler_t handler;
+    std::vector<char> packets;
+    if (prepare_benchmark_packets(sensor_model, return_mode, NUMBER_OF_BENCHMARK_PACKETS,
+                                  &handler, packets) == false) {
+        return false;
+    }
+
+    const unsigned int number_of_echoes_of_one_line =
+        VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model] * ((return_mode == VLP16_PACKET_DUAL_RETURN_MODE) ? 2 : 1);
+
+    // warm up (buffers of handler are allocated on first packet)
+    for (unsigned int i = 0; i < NUMBER_OF_BENCHMARK_PACKETS; ++i) {
+        if (receive_vlp16_packet_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH],
+                                             VLP16_PACKET_LENGTH) == true) {
+            decode_vlp16_packet(&handler);
+        }
+    }
+
+    unsigned long number_of_lines = 0;
+
+    start_benchmark_counter(counter);
+    for (unsigned int repetition = 0; repetition < NUMBER_OF_DECODE_REPETITIONS; ++repetition) {
+        for (unsigned int i = 0; i < NUMBER_OF_BENCHMARK_PACKETS; ++i) {
+
+            if (receive_vlp16_packet_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH],
+                                                 VLP16_PACKET_LENGTH) == false) {
+                continue;
+            }
+            ++result->number_of_packets;
+
+            number_of_lines += decode_vlp16_packet(&handler);
+        }
+    }
+    stop_benchmark_counter(counter, result);
+
+    result->number_of_echoes = number_of_lines * number_of_echoes_of_one_line;
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return true;
+}
+
+/*!
+  \brief function to measure decode of packets received at once, whose lines are decoded on work stealing pool
+  \attention pool is not used if number_of_workers == 1
+*/
+static bool benchmark_receive_vlp16_packets_from_memory(benchmark_counter_t *counter,
+                                                        enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                                        enum VLP16_PACKET_RETURN_MODE return_mode,
+                                                        unsigned int number_of_workers,
+                                                        benchmark_result_t *result)
+{
+    work_stealing_pool_t pool;
+    initialize_work_stealing_pool(&pool);
+    if ((number_of_workers != 1) && (start_work_stealing_pool(&pool, number_of_workers) == false)) {
+        return false;
+    }
+
+    std::string parameters = make_decode_parameters(sensor_model, return_mode);
+    parameters += ", ";
+    parameters += make_number_parameter("number_of_workers",
+                                        is_started_work_stealing_pool(&pool) ? pool.number_of_workers : 1);
+    clear_benchmark_result("receive_vlp16_packets_from_memory", parameters, result);
+
+    vlp16_handler_t handler;
+    std::vector<char> packets;
+    if ((prepare_benchmark_packets(sensor_model, return_mode, NUMBER_OF_BENCHMARK_PACKETS,
+                                   &handler, packets) == false) ||
+        (allocate_packet_batch_buffer_for_vlp16_handler(&handler, NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH) == false)) {
+        stop_work_stealing_pool(&pool);
+        return false;
+    }
+    set_decode_pool_of_vlp16_handler(&handler, &pool);
+
+    const unsigned int number_of_echoes_of_one_line =
+        VLP16_PACKET_NUMBER_OF_SPOTS[sensor_model] * ((return_mode == VLP16_PACKET_DUAL_RETURN_MODE) ? 2 : 1);
+
+    unsigned int number_of_received_packets = 0;
+
+    // warm up (buffers of handler are allocated on first packet)
+    for (unsigned int i = 0; i < NUMBER_OF_BENCHMARK_PACKETS; i += NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH) {
+        receive_vlp16_packets_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH],
+                                          NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH, &number_of_received_packets);
+    }
+
+    unsigned long number_of_lines = 0;
+
+    start_benchmark_counter(counter);
+    for (unsigned int repetition = 0; repetition < NUMBER_OF_DECODE_REPETITIONS; ++repetition) {
+        for (unsigned int i = 0; i < NUMBER_OF_BENCHMARK_PACKETS; i += NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH) {
+
+            number_of_lines +=
+                receive_vlp16_packets_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH],
+                                                  NUMBER_OF_BENCHMARK_PACKETS_IN_BATCH, &number_of_received_packets);
+            result->number_of_packets += number_of_received_packets;
+        }
+    }
+    stop_benchmark_counter(counter, result);
+
+    result->number_of_echoes = number_of_lines * number_of_echoes_of_one_line;
+
+    set_decode_pool_of_vlp16_handler(&handler, NULL);
+    release_circular_buffer_of_vlp16_handler(&handler);
+    stop_work_stealing_pool(&pool);
+
+    return true;
+}
+
+/*!
+  \brief function to decode generated packets and get pointers of latest lines
+  \attention this function returns false if latest NUMBER_OF_REGION_FILTER_LINES lines are not captured
+*/
+static bool capture_benchmark_lines(vlp16_handler_t *handler,
+                                    std::vector<const lidar_line_data_t *> &lines)
+{
+    std::vector<char> packets;
+    if (prepare_benchmark_packets(VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                  NUMBER_OF_BENCHMARK_PACKETS, handler, packets) == false) {
+        return false;
+    }
+
+    // line ring keeps history of captured lines (one line per firing sequence)
+    const double history_msec = (double)NUMBER_OF_REGION_FILTER_LINES *
+        VLP16_SENSOR_MODEL_TIMING[VLP16_PACKET_VLP16].firing_sequence_usec * 0.001;
+    if (set_line_history_of_vlp16_handler(handler, history_msec, VLP16_LINE_HISTORY_MSEC) == false) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < NUMBER_OF_BENCHMARK_PACKETS; ++i) {
+        if (receive_vlp16_packet_from_memory(handler, &packets[i * VLP16_PACKET_LENGTH],
+                                             VLP16_PACKET_LENGTH) == true) {
+            decode_vlp16_packet(handler);
+        }
+    }
+
+    lines.reserve(NUMBER_OF_REGION_FILTER_LINES);
+    get_pointers_of_latest_unused_lidar_line_data(&handler->line_data_buffer,
+                                                  NUMBER_OF_REGION_FILTER_LINES, lines);
+
+    return (lines.size() == NUMBER_OF_REGION_FILTER_LINES);
+}
+
+/*!
+  \brief function to set regions which divide horizontal angle range of lines
+*/
+static void set_regions_dividing_lines(const std::vector<const lidar_line_data_t *> &lines,
+                                       unsigned int number_of_regions,
+                                       std::vector<lidar_echo_single_region_t> &regions)
+{
+    double minimum_horizontal_angle = lines.front()->minimum_horizontal_angle;
+    double maximum_horizontal_angle = lines.front()->maximum_horizontal_angle;
+
+    for (unsigned int i = 1; i < lines.size(); ++i) {
+        if (lines.at(i)->minimum_horizontal_angle < minimum_horizontal_angle) {
+            minimum_horizontal_angle = lines.at(i)->minimum_horizontal_angle;
+        }
+        if (lines.at(i)->maximum_horizontal_angle > maximum_horizontal_angle) {
+            maximum_horizontal_angle = lines.at(i)->maximum_horizontal_angle;
+        }
+    }
+
+    const double horizontal_width = (maximum_horizontal_angle - minimum_horizontal_angle) / number_of_regions;
+    const double elevation_angle_limit = 30.0 * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+
+    regions.resize(number_of_regions);
+    for (unsigned int i = 0; i < number_of_regions; ++i) {
+        set_lidar_echo_single_region_using_direction(minimum_horizontal_angle + i * horizontal_width,
+                                                     minimum_horizontal_angle + (i + 1) * horizontal_width,
+                                                     -elevation_angle_limit, elevation_angle_limit,
+                                                     &regions.at(i));
+    }
+
+    return;
+}
+
+static void benchmark_add_lidar_echo_data_in_each_single_region(benchmark_counter_t *counter,
+                                                                const std::vector<const lidar_line_data_t *> &lines,
+                                                                unsigned int number_of_regions,
+                                                                benchmark_result_t *result)
+{
+    clear_benchmark_result("add_lidar_echo_data_in_each_single_region",
+                           make_number_parameter("number_of_regions", number_of_regions), result);
+
+    // regions divide horizontal angles of lines and all elevation angles
+    std::vector<lidar_echo_single_region_t> regions;
+    set_regions_dividing_lines(lines, number_of_regions, regions);
+
+    const unsigned int number_of_spots = lines.front()->number_of_spots;
+
+    // buffers are reserved before measurement (no heap allocation on filtering)
+    std::vector< std::vector<lidar_echo_data_t> > echoes_in_region(number_of_regions);
+    for (unsigned int i = 0; i < number_of_regions; ++i) {
+        echoes_in_region.at(i).reserve(lines.size() * number_of_spots * LIDAR_SPOT_ACCESSOR_MAXIMUM_NUMBER_OF_ECHOES);
+    }
+
+    start_benchmark_counter(counter);
+    for (unsigned int repetition = 0; repetition < NUMBER_OF_REGION_FILTER_REPETITIONS; ++repetition) {
+
+        for (unsigned int i = 0; i < number_of_regions; ++i) {
+            echoes_in_region.at(i).clear();
+        }
+
+        add_lidar_echo_data_in_each_single_region(lines, regions, echoes_in_region);
+    }
+    stop_benchmark_counter(counter, result);
+
+    // echoes of all spots are examined on each repetition
+    result->number_of_echoes =
+        (unsigned long)NUMBER_OF_REGION_FILTER_REPETITIONS * lines.size() * number_of_spots;
+
+    return;
+}
+
+static void benchmark_calculate_statistics_of_lidar_echoes(benchmark_counter_t *counter,
+                                                           const std::vector<lidar_echo_data_t> &echoes,
+                                                           double one_step_distance_value,
+                                                           benchmark_result_t *result)
+{
+    clear_benchmark_result("calculate_statistics_of_lidar_echoes",
+                           make_number_parameter("one_step_distance", one_step_distance_value), result);
+
+    const double one_step_angle_value = 0.1 * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+    const double one_step_intensity_value = 1.0;
+    const int small_bin_threshold = 1;
+
+    lidar_echo_statistics_t statistics;
+
+    start_benchmark_counter(counter);
+    for (unsigned int repetition = 0; repetition < NUMBER_OF_STATISTICS_REPETITIONS; ++repetition) {
+        calculate_statistics_of_lidar_echoes(echoes, one_step_angle_value,
+                                             one_step_distance_value, one_step_intensity_value,
+                                             small_bin_threshold, 0.0, 0.0, statistics);
+    }
+    stop_benchmark_counter(counter, result);
+
+    result->number_of_echoes = (unsigned long)NUMBER_OF_STATISTICS_REPETITIONS * echoes.size();
+
+    return;
+}
+
+static void benchmark_make_histogram(benchmark_counter_t *counter, const std::vector<double> &data_array,
+                                     unsigned int number_of_bins, benchmark_result_t *result)
+{
+    clear_benchmark_result("make_histogram", make_number_parameter("number_of_bins", number_of_bins), result);
+
+    histogram_t histogram;
+    set_parameters_of_histogram(&histogram, 0.0, 100.0, number_of_bins);
+
+    start_benchmark_counter(counter);
+    for (unsigned int repetition = 0; repetition < NUMBER_OF_HISTOGRAM_REPETITIONS; ++repetition) {
+        make_histogram(&histogram, data_array);
+    }
+    stop_benchmark_counter(counter, result);
+
+    result->number_of_echoes = (unsigned long)NUMBER_OF_HISTOGRAM_REPETITIONS * data_array.size();
+
+    return;
+}
+
+static void output_counter_to_stream(std::ostream &stream, long long value)
+{
+    if (value == BENCHMARK_INVALID_COUNTER) {
+        stream << "null";
+    } else {
+        stream << value;
+    }
+
+    return;
+}
+
+static void output_benchmark_results_to_stream(std::ostream &stream,
+                                               const std::vector<benchmark_result_t> &results)
+{
+    stream << "{\n  \"benchmarks\": [\n";
+
+    for (unsigned int i = 0; i < results.size(); ++i) {
+
+        const benchmark_result_t &result = results.at(i);
+        const double elapsed_time_sec = result.elapsed_time_nsec * 0.000000001;
+
+        stream << "    {\"function\": \"" << result.function_name << "\", "
+               << result.parameters << ", ";
+
+        if (result.number_of_packets > 0) {
+            stream << "\"packets\": " << result.number_of_packets << ", "
+                   << "\"packets_per_sec\": " << ((elapsed_time_sec > 0.0) ? result.number_of_packets / elapsed_time_sec : 0.0) << ", ";
+        }
+
+        stream << "\"echoes\": " << result.number_of_echoes << ", "
+               << "\"ns_per_echo\": " << ((result.number_of_echoes > 0) ? result.elapsed_time_nsec / result.number_of_echoes : 0.0) << ", "
+               << "\"elapsed_time_nsec\": " << result.elapsed_time_nsec << ", "
+               << "\"heap_allocations\": ";
+        output_counter_to_stream(stream, result.number_of_heap_allocations);
+        stream << ", \"cache_misses\": ";
+        output_counter_to_stream(stream, result.number_of_cache_misses);
+        stream << "}" << ((i + 1 < results.size()) ? "," : "") << "\n";
+    }
+
+    stream << "  ]\n}\n";
+
+    return;
+}
+
+static void output_usage_of_benchmark(const char *program_name)
+{
+    cerr << "usage: " << program_name << " [json file]\n"
+         << "  results are output to standard output if json file is not given\n";
+
+    return;
+}
+
+int main(int argc, char **argv)
+{
+    // results are output to file if file path is given (vlp16_benchmark [json file])
+    if ((argc > 2) || ((argc > 1) && (argv[1][0] == '-'))) {
+        output_usage_of_benchmark(argv[0]);
+        return ((argc == 2) && ((strcmp(argv[1], "-h") == 0) || (strcmp(argv[1], "--help") == 0))) ? 0 : 1;
+    }
+
+    std::vector<benchmark_result_t> results;
+    benchmark_result_t result;
+
+    benchmark_counter_t counter;
+    open_benchmark_counter(&counter);
+
+    // decode
+    const enum VLP16_PACKET_SENSOR_MODEL sensor_models[] =
+        { VLP16_PACKET_VLP16, VLP16_PACKET_HDL_32E, VLP16_PACKET_VLP_32C, VLP16_PACKET_PUCK_HI_RES };
+    const enum VLP16_PACKET_RETURN_MODE return_modes[] = { VLP16_PACKET_STRONGEST_RETURN_MODE, VLP16_PACKET_DUAL_RETURN_MODE };
+
+    for (unsigned int model_index = 0; model_index < sizeof(sensor_models) / sizeof(sensor_models[0]); ++model_index) {
+        for (unsigned int mode_index = 0; mode_index < 2; ++mode_index) {
+            if (benchmark_decode_vlp16_packet(&counter, sensor_models[model_index], return_modes[mode_index],
+                                              &result) == false) {
+                cerr << "Decode benchmark failed.\n";
+                close_benchmark_counter(&counter);
+                return 1;
+            }
+            results.push_back(result);
+        }
+    }
+
+    // decode of lines on pool (one worker is serial decode of batch)
+    const unsigned int numbers_of_workers[] = { 1, NUMBER_OF_BENCHMARK_PARALLEL_WORKERS };
+    for (unsigned int i = 0; i < sizeof(numbers_of_workers) / sizeof(numbers_of_workers[0]); ++i) {
+        if (benchmark_receive_vlp16_packets_from_memory(&counter, VLP16_PACKET_VLP_32C, VLP16_PACKET_DUAL_RETURN_MODE,
+                                                        numbers_of_workers[i], &result) == false) {
+            cerr << "Parallel decode benchmark failed.\n";
+            close_benchmark_counter(&counter);
+            return 1;
+        }
+        results.push_back(result);
+    }
+
+    // region filter
+    vlp16_handler_t handler;
+    std::vector<const lidar_line_data_t *> lines;
+    if (capture_benchmark_lines(&handler, lines) == false) {
+        cerr << "Capturing lines failed.\n";
+        close_benchmark_counter(&counter);
+        return 1;
+    }
+
+    const unsigned int numbers_of_regions[] = { 1, 4, 16, 64 };
+    for (unsigned int i = 0; i < sizeof(numbers_of_regions) / sizeof(numbers_of_regions[0]); ++i) {
+        benchmark_add_lidar_echo_data_in_each_single_region(&counter, lines, numbers_of_regions[i], &result);
+        results.push_back(result);
+    }
+
+    // statistics of all echoes of lines
+    std::vector<lidar_echo_single_region_t> whole_region;
+    set_regions_dividing_lines(lines, 1, whole_region);
+
+    std::vector< std::vector<lidar_echo_data_t> > whole_echoes(1);
+    add_lidar_echo_data_in_each_single_region(lines, whole_region, whole_echoes);
+
+    const double one_step_distance_values[] = { 1.0, 0.1, 0.01 };
+    for (unsigned int i = 0; i < sizeof(one_step_distance_values) / sizeof(one_step_distance_values[0]); ++i) {
+        benchmark_calculate_statistics_of_lidar_echoes(&counter, whole_echoes.at(0), one_step_distance_values[i],
+                                                       &result);
+        results.push_back(result);
+    }
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    // histogram of uniform data
+    std::vector<double> data_array(NUMBER_OF_HISTOGRAM_DATA);
+    for (unsigned int i = 0; i < data_array.size(); ++i) {
+        data_array.at(i) = (double)((i * 2654435761U) % 100000U) * 0.001;
+    }
+
+    const unsigned int numbers_of_bins[] = { 16, 256, 4096 };
+    for (unsigned int i = 0; i < sizeof(numbers_of_bins) / sizeof(numbers_of_bins[0]); ++i) {
+        benchmark_make_histogram(&counter, data_array, numbers_of_bins[i], &result);
+        results.push_back(result);
+    }
+
+    close_benchmark_counter(&counter);
+
+    if (argc > 1) {
+        std::ofstream json_file(argv[1]);
+        if (json_file.is_open() == false) {
+            cerr << "Open " << argv[1] << " failed.\n";
+            return 1;
+        }
+        output_benchmark_results_to_stream(json_file, results);
+    } else {
+        output_benchmark_results_to_stream(cout, results);
+    }
+
+    return 0;
+}
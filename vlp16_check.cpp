@@ -0,0 +1,1935 @@
+/*!
+  \file
+  \brief check program of calibration, decode, packet continuity, decode kernels, line, point block and region functions, echo log, packet recorder, packet ring, threaded receive, sensor group, and heap allocations after warm-up (make check)
+  \author Kiyoshi MATSUO
+  \attention this program returns non-zero exit status if any check fails
+*/
+
+#include "vlp16_packet_generatorCtrl.h"
+
+#include "lidar_echo_logCtrl.h"
+
+// hooks of heap allocators (included in one source file of program)
+#include "heap_allocation_counterCtrl.h"
+
+// for snprintf, FILE, fopen
+#include <stdio.h>
+
+// for memcpy
+#include <string.h>
+
+// for mkstemp, close, unlink, pwrite
+#include <stdlib.h>
+#include <unistd.h>
+
+// for open
+#include <fcntl.h>
+
+// for fabs
+#include <math.h>
+
+// for std::min
+#include <algorithm>
+
+#include <iostream>
+
+#include <string>
+
+using namespace std;
+
+//! ip address of loopback socket in threaded receive check
+const char CHECK_LOOPBACK_IP_ADDRESS[] = "127.0.0.1";
+
+//! reception ip address of sockets in threaded receive check
+const char CHECK_RECEPTION_IP_ADDRESS[] = "0.0.0.0";
+
+//! port number of handler in threaded receive check
+const char CHECK_LOOPBACK_HANDLER_PORT_NUMBER[] = "23680";
+
+//! port number of sender in threaded receive check
+const char CHECK_LOOPBACK_SENDER_PORT_NUMBER[] = "23681";
+
+//! port numbers of handlers of sensors in sensor group check
+const char *const CHECK_GROUP_HANDLER_PORT_NUMBER[] = { "23682", "23683" };
+
+//! port numbers of senders of sensors in sensor group check
+const char *const CHECK_GROUP_SENDER_PORT_NUMBER[] = { "23684", "23685" };
+
+//! sensor models of sensors in sensor group check (packets of each sensor are decoded differently)
+const enum VLP16_PACKET_SENSOR_MODEL CHECK_GROUP_SENSOR_MODEL[] = { VLP16_PACKET_VLP16, VLP16_PACKET_HDL_32E };
+
+//! constants for check program
+enum CONSTANT_FOR_VLP16_CHECK {
+
+    //! number of lasers of calibration sample
+    NUMBER_OF_CHECK_CALIBRATION_LASERS = 32,
+
+    //! length of text buffer of one laser in calibration sample [byte]
+    CHECK_CALIBRATION_LINE_LENGTH = 512,
+
+    //! receive buffer length of handler [byte]
+    CHECK_RECEIVE_BUFFER_LENGTH = 10240,
+
+    //! number of packets generated for decode checks
+    NUMBER_OF_CHECK_PACKETS = 2048,
+
+    //! number of packets received at once in parallel decode check
+    NUMBER_OF_CHECK_PACKETS_IN_BATCH = 64,
+
+    //! number of workers of pool in parallel decode check (more than one)
+    NUMBER_OF_CHECK_PARALLEL_WORKERS = 4,
+
+    //! capacity of point block in parallel decode check
+    CHECK_POINT_BLOCK_CAPACITY = 64 * 1024,
+
+    //! maximum number of lines of frame in parallel decode check
+    CHECK_FRAME_MAXIMUM_NUMBER_OF_LINES = 4096,
+
+    //! capacity of point block which overflows in point block check
+    CHECK_SMALL_POINT_BLOCK_CAPACITY = 1000,
+
+    //! number of packets decoded in point block check
+    NUMBER_OF_CHECK_POINT_BLOCK_PACKETS = 100,
+
+    //! number of generated packets in packet continuity checks
+    NUMBER_OF_CHECK_CONTINUITY_PACKETS = 200,
+
+    //! seed of loss and reorder of generated packets
+    CHECK_IMPAIRMENT_SEED = 7,
+
+    //! number of packets decoded before heap allocations are counted
+    NUMBER_OF_CHECK_WARM_UP_PACKETS = 100,
+
+    //! maximum number of records of packet record file in recorder check
+    CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS = 64,
+
+    //! number of packets appended to recorder in recorder check (more than maximum number of records)
+    NUMBER_OF_CHECK_RECORDER_PACKETS = 66,
+
+    //! number of packets recorded before gap of receive time in recorder check
+    NUMBER_OF_CHECK_RECORDER_PACKETS_BEFORE_GAP = 20,
+
+    //! number of packets of one revolution in recorder check
+    NUMBER_OF_CHECK_RECORDER_PACKETS_IN_REVOLUTION = 10,
+
+    //! interval of receive time of packets in recorder check [usec]
+    CHECK_RECORDER_PACKET_INTERVAL_USEC = 1000,
+
+    //! gap of receive time in recorder check [usec]
+    CHECK_RECORDER_GAP_USEC = 5 * 1000 * 1000,
+
+    //! number of queued packets of packet ring in ring checks
+    NUMBER_OF_CHECK_RING_SLOTS = 4,
+
+    //! maximum number of held slots of packet ring in ring checks
+    CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS = 2,
+
+    //! number of packets passed through packet ring in wrap-around check
+    NUMBER_OF_CHECK_RING_WRAP_AROUND_PACKETS = 40,
+
+    //! number of packets sent through loopback socket in threaded receive check
+    NUMBER_OF_CHECK_LOOPBACK_PACKETS = 256,
+
+    //! number of packets sent at once in threaded receive check (less than queued packets of ring)
+    NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE = 16,
+
+    //! number of queued packets of receive thread in threaded receive check
+    NUMBER_OF_CHECK_LOOPBACK_RING_PACKETS = 64,
+
+    //! number of sensors in sensor group check
+    NUMBER_OF_CHECK_GROUP_SENSORS = sizeof(CHECK_GROUP_SENSOR_MODEL) / sizeof(CHECK_GROUP_SENSOR_MODEL[0]),
+
+    //! communication timeout of handler in threaded receive check [usec]
+    CHECK_LOOPBACK_TIMEOUT_USEC = 500000,
+
+};
+
+//! number of failed checks
+static unsigned int number_of_failed_checks = 0;
+
+static void report_check_result(const char *check_name, bool passed)
+{
+    cout << (passed ? "OK " : "NG ") << check_name << "\n";
+
+    if (passed == false) {
+        ++number_of_failed_checks;
+    }
+
+    return;
+}
+
+/*!
+  \brief function to make calibration whose all values are different from each other
+*/
+static void make_check_calibration(vlp16_calibration_t *calibration)
+{
+    clear_vlp16_calibration(calibration);
+
+    calibration->number_of_lasers = NUMBER_OF_CHECK_CALIBRATION_LASERS;
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_CALIBRATION_LASERS; ++i) {
+        vlp16_laser_calibration_t *laser = &calibration->laser[i];
+
+        laser->rotational_correction = ((double)i - 15.5) * 1.25e-3;
+        laser->vertical_correction = (-15.0 + (double)i) * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+        laser->distance_correction = 10.0 + 1.5 * (double)i;
+        laser->vertical_offset_correction = 0.5 * (double)i;
+        laser->horizontal_offset_correction = -0.25 * (double)i;
+    }
+
+    return;
+}
+
+/*!
+  \brief function to write calibration in YAML of velodyne_pointcloud (even lasers in flow style, odd lasers in block style)
+*/
+static std::string make_calibration_yaml_text(const vlp16_calibration_t *calibration)
+{
+    std::string text = "lasers:\n";
+    char line[CHECK_CALIBRATION_LINE_LENGTH];
+
+    for (unsigned int i = 0; i < calibration->number_of_lasers; ++i) {
+        const vlp16_laser_calibration_t *laser = &calibration->laser[i];
+
+        const double distance_correction = laser->distance_correction / VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+        const double vertical_offset_correction = laser->vertical_offset_correction / VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+        const double horizontal_offset_correction = laser->horizontal_offset_correction / VLP16_CALIBRATION_METER_TO_DISTANCE_SCALE;
+
+        if ((i % 2) == 0) {
+            snprintf(line, sizeof(line),
+                     "- {dist_correction: %.17g, dist_correction_x: 0.0, focal_distance: 0.0,\n"
+                     "  horiz_offset_correction: %.17g, laser_id: %u, rot_correction: %.17g,\n"
+                     "  vert_correction: %.17g, vert_offset_correction: %.17g}\n",
+                     distance_correction, horizontal_offset_correction, i,
+                     laser->rotational_correction, laser->vertical_correction, vertical_offset_correction);
+        } else {
+            snprintf(line, sizeof(line),
+                     "- dist_correction: %.17g\n"
+                     "  horiz_offset_correction: %.17g\n"
+                     "  laser_id: %u\n"
+                     "  rot_correction: %.17g\n"
+                     "  vert_correction: %.17g\n"
+                     "  vert_offset_correction: %.17g\n",
+                     distance_correction, horizontal_offset_correction, i,
+                     laser->rotational_correction, laser->vertical_correction, vertical_offset_correction);
+        }
+        text += line;
+    }
+
+    snprintf(line, sizeof(line), "num_lasers: %u\ndistance_resolution: 0.002\n", calibration->number_of_lasers);
+    text += line;
+
+    return text;
+}
+
+/*!
+  \brief function to write calibration in db.xml of VeloView (angles in degree, distances in centimeter)
+*/
+static std::string make_calibration_xml_text(const vlp16_calibration_t *calibration)
+{
+    std::string text = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>\n"
+        "<boost_serialization signature=\"serialization::archive\" version=\"4\">\n"
+        "<DB class_id=\"0\" tracking_level=\"0\" version=\"0\">\n";
+    char line[CHECK_CALIBRATION_LINE_LENGTH];
+
+    snprintf(line, sizeof(line), "<points_ class_id=\"1\" tracking_level=\"0\" version=\"0\">\n<count>%u</count>\n",
+             calibration->number_of_lasers);
+    text += line;
+
+    for (unsigned int i = 0; i < calibration->number_of_lasers; ++i) {
+        const vlp16_laser_calibration_t *laser = &calibration->laser[i];
+
+        snprintf(line, sizeof(line),
+                 "<item class_id=\"2\" tracking_level=\"0\" version=\"0\">\n"
+                 "<px class_id=\"3\" tracking_level=\"1\" version=\"1\" object_id=\"_%u\">\n"
+                 "<id_>%u</id_>\n"
+                 "<rotCorrection_>%.17g</rotCorrection_>\n"
+                 "<vertCorrection_>%.17g</vertCorrection_>\n"
+                 "<distCorrection_>%.17g</distCorrection_>\n"
+                 "<distCorrectionX_>0</distCorrectionX_>\n"
+                 "<vertOffsetCorrection_>%.17g</vertOffsetCorrection_>\n"
+                 "<horizOffsetCorrection_>%.17g</horizOffsetCorrection_>\n"
+                 "</px>\n</item>\n",
+                 i, i,
+                 laser->rotational_correction / LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN,
+                 laser->vertical_correction / LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN,
+                 laser->distance_correction / VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE,
+                 laser->vertical_offset_correction / VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE,
+                 laser->horizontal_offset_correction / VLP16_CALIBRATION_CENTIMETER_TO_DISTANCE_SCALE);
+        text += line;
+    }
+
+    text += "</points_>\n</DB>\n</boost_serialization>\n";
+
+    return text;
+}
+
+static bool are_equal_calibrations(const vlp16_calibration_t *expected, const vlp16_calibration_t *actual)
+{
+    // values are written in 17 significant digits (only conversion of units is rounded)
+    const double tolerance = 1.0e-9;
+
+    if (expected->number_of_lasers != actual->number_of_lasers) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < expected->number_of_lasers; ++i) {
+        const vlp16_laser_calibration_t *e = &expected->laser[i];
+        const vlp16_laser_calibration_t *a = &actual->laser[i];
+
+        if ((fabs(e->rotational_correction - a->rotational_correction) > tolerance) ||
+            (fabs(e->vertical_correction - a->vertical_correction) > tolerance) ||
+            (fabs(e->distance_correction - a->distance_correction) > tolerance) ||
+            (fabs(e->vertical_offset_correction - a->vertical_offset_correction) > tolerance) ||
+            (fabs(e->horizontal_offset_correction - a->horizontal_offset_correction) > tolerance)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+  \brief function to load text written in temporary file with load_vlp16_calibration_file (format is detected by loader)
+*/
+static bool load_calibration_text_through_file(const std::string &text, vlp16_calibration_t *calibration)
+{
+    char file_path[] = "/tmp/vlp16_check_calibration_XXXXXX";
+    const int file_descriptor = mkstemp(file_path);
+    if (file_descriptor < 0) {
+        return false;
+    }
+
+    const bool written = (write(file_descriptor, text.c_str(), text.size()) == (ssize_t)text.size());
+    close(file_descriptor);
+
+    const bool loaded = written && load_vlp16_calibration_file(file_path, calibration);
+    unlink(file_path);
+
+    return loaded;
+}
+
+static void check_calibration_parsers(void)
+{
+    vlp16_calibration_t expected;
+    make_check_calibration(&expected);
+
+    const std::string yaml_text = make_calibration_yaml_text(&expected);
+    const std::string xml_text = make_calibration_xml_text(&expected);
+
+    vlp16_calibration_t loaded;
+
+    clear_vlp16_calibration(&loaded);
+    report_check_result("calibration YAML values round-trip",
+                        (parse_vlp16_calibration_yaml(yaml_text.c_str(), &loaded) == true) &&
+                        are_equal_calibrations(&expected, &loaded));
+
+    clear_vlp16_calibration(&loaded);
+    report_check_result("calibration db.xml values round-trip",
+                        (parse_vlp16_calibration_xml(xml_text.c_str(), &loaded) == true) &&
+                        are_equal_calibrations(&expected, &loaded));
+
+    clear_vlp16_calibration(&loaded);
+    report_check_result("calibration YAML file is loaded",
+                        (load_calibration_text_through_file(yaml_text, &loaded) == true) &&
+                        are_equal_calibrations(&expected, &loaded));
+
+    clear_vlp16_calibration(&loaded);
+    report_check_result("calibration db.xml file is loaded",
+                        (load_calibration_text_through_file(xml_text, &loaded) == true) &&
+                        are_equal_calibrations(&expected, &loaded));
+
+    return;
+}
+
+/*!
+  \brief function to decode more generated packets in handler
+  \return number of decoded lines
+*/
+static unsigned int decode_more_check_packets(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                              enum VLP16_PACKET_RETURN_MODE return_mode,
+                                              unsigned int number_of_packets,
+                                              vlp16_handler_t *handler)
+{
+    vlp16_packet_generator_t generator;
+    if (initialize_vlp16_packet_generator(&generator, sensor_model, return_mode,
+                                          VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM) == false) {
+        return 0;
+    }
+
+    std::vector<char> packet(VLP16_PACKET_LENGTH);
+    unsigned int number_of_lines = 0;
+
+    for (unsigned int i = 0; i < number_of_packets; ++i) {
+        generate_vlp16_packet(&generator, &packet[0]);
+
+        if (receive_vlp16_packet_from_memory(handler, &packet[0], VLP16_PACKET_LENGTH) == true) {
+            number_of_lines += decode_vlp16_packet(handler);
+        }
+    }
+
+    return number_of_lines;
+}
+
+/*!
+  \brief function to allocate handler and decode generated packets (lines of one revolution are kept in line buffer by default)
+  \return number of decoded lines
+*/
+static unsigned int decode_check_packets(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                         enum VLP16_PACKET_RETURN_MODE return_mode,
+                                         const vlp16_calibration_t *calibration,
+                                         unsigned int number_of_packets,
+                                         vlp16_handler_t *handler)
+{
+    clear_vlp16_handler(handler);
+    if (allocate_circular_buffer_for_vlp16_handler(handler, sensor_model, CHECK_RECEIVE_BUFFER_LENGTH) == false) {
+        return 0;
+    }
+    set_cartesian_output_of_vlp16_handler(handler, true);
+    if (calibration != NULL) {
+        set_calibration_of_vlp16_handler(handler, calibration);
+    }
+
+    return decode_more_check_packets(sensor_model, return_mode, number_of_packets, handler);
+}
+
+static void check_line_history(void)
+{
+    vlp16_handler_t handler;
+    const unsigned int number_of_lines =
+        decode_check_packets(VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE, NULL,
+                             NUMBER_OF_CHECK_PACKETS, &handler);
+
+    // one revolution is longest at minimum rotation speed
+    const double number_of_lines_in_revolution =
+        360.0 * 1000.0 * 1000.0 / VLP16_PACKET_MINIMUM_ROTATION_SPEED /
+        VLP16_SENSOR_MODEL_TIMING[VLP16_PACKET_VLP16].firing_sequence_usec;
+    const unsigned int line_buffer_length = handler.line_data_buffer.length;
+
+    report_check_result("default line history keeps one revolution",
+                        (double)line_buffer_length >= number_of_lines_in_revolution);
+    report_check_result("unused lines overwritten by new lines are counted",
+                        (number_of_lines > line_buffer_length) &&
+                        (get_number_of_overwritten_unused_lidar_lines(&handler.line_data_buffer) ==
+                         number_of_lines - line_buffer_length));
+
+    // consumed lines are not counted
+    move_used_data_end_out_point(&handler.line_data_buffer,
+                                 calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+    const unsigned int number_of_overwritten_lines = get_number_of_overwritten_unused_lidar_lines(&handler.line_data_buffer);
+    const unsigned int number_of_new_lines =
+        decode_more_check_packets(VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                  line_buffer_length / 2 / VLP16_PACKET_NUMBER_OF_DATA_BLOCKS, &handler);
+    report_check_result("used lines are not counted as overwritten",
+                        (number_of_new_lines != 0) &&
+                        (get_number_of_overwritten_unused_lidar_lines(&handler.line_data_buffer) == number_of_overwritten_lines));
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return;
+}
+
+/*!
+  \brief function to decode generated packets to point block
+  \return number of decoded lines
+*/
+static unsigned int decode_check_packets_to_point_block(unsigned int number_of_packets, lidar_point_block_t *point_block)
+{
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+
+    if (allocate_circular_buffer_for_vlp16_handler(&handler, VLP16_PACKET_VLP16, CHECK_RECEIVE_BUFFER_LENGTH) == false) {
+        return 0;
+    }
+    set_point_block_output_of_vlp16_handler(&handler, point_block);
+
+    const unsigned int number_of_lines =
+        decode_more_check_packets(VLP16_PACKET_VLP16, VLP16_PACKET_DUAL_RETURN_MODE, number_of_packets, &handler);
+
+    set_point_block_output_of_vlp16_handler(&handler, NULL);
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return number_of_lines;
+}
+
+static void check_point_block_overflow(void)
+{
+    lidar_point_block_t large_block;
+    lidar_point_block_t small_block;
+    clear_lidar_point_block(&large_block);
+    clear_lidar_point_block(&small_block);
+
+    const bool decoded =
+        (allocate_memory_for_lidar_point_block(&large_block, CHECK_POINT_BLOCK_CAPACITY) == true) &&
+        (allocate_memory_for_lidar_point_block(&small_block, CHECK_SMALL_POINT_BLOCK_CAPACITY) == true) &&
+        (decode_check_packets_to_point_block(NUMBER_OF_CHECK_POINT_BLOCK_PACKETS, &large_block) != 0) &&
+        (decode_check_packets_to_point_block(NUMBER_OF_CHECK_POINT_BLOCK_PACKETS, &small_block) != 0);
+
+    report_check_result("points which do not fit in point block are counted as dropped",
+                        (decoded == true) &&
+                        (large_block.number_of_points > CHECK_SMALL_POINT_BLOCK_CAPACITY) &&
+                        (large_block.number_of_dropped_points == 0) &&
+                        (small_block.number_of_points == CHECK_SMALL_POINT_BLOCK_CAPACITY) &&
+                        (small_block.number_of_points + small_block.number_of_dropped_points ==
+                         large_block.number_of_points));
+
+    erase_all_points_of_lidar_point_block(&small_block);
+    report_check_result("erasing points clears count of dropped points",
+                        (small_block.number_of_points == 0) && (small_block.number_of_dropped_points == 0));
+
+    release_memory_of_lidar_point_block(&large_block);
+    release_memory_of_lidar_point_block(&small_block);
+
+    return;
+}
+
+/*!
+  \brief function to decode generated packets in order of packet indices and get communication status
+  \return false if handler can not be allocated
+*/
+static bool decode_check_packet_sequence(const std::vector<unsigned int> &packet_indices,
+                                         vlp16_communication_status_t *status)
+{
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+    if (allocate_circular_buffer_for_vlp16_handler(&handler, VLP16_PACKET_VLP16, CHECK_RECEIVE_BUFFER_LENGTH) == false) {
+        return false;
+    }
+
+    vlp16_packet_generator_t generator;
+    initialize_vlp16_packet_generator(&generator, VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                      VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+    std::vector<char> packets(NUMBER_OF_CHECK_CONTINUITY_PACKETS * VLP16_PACKET_LENGTH);
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_CONTINUITY_PACKETS; ++i) {
+        generate_vlp16_packet(&generator, &packets[i * VLP16_PACKET_LENGTH]);
+    }
+
+    for (unsigned int i = 0; i < packet_indices.size(); ++i) {
+        if (receive_vlp16_packet_from_memory(&handler, &packets[packet_indices[i] * VLP16_PACKET_LENGTH],
+                                             VLP16_PACKET_LENGTH) == false) {
+            continue;
+        }
+
+        decode_vlp16_packet(&handler);
+        move_used_data_end_out_point(&handler.line_data_buffer,
+                                     calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+    }
+
+    *status = handler.communication_status;
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return true;
+}
+
+//! function to make indices of generated packets in order
+static std::vector<unsigned int> make_ordered_check_packet_sequence(void)
+{
+    std::vector<unsigned int> packet_indices(NUMBER_OF_CHECK_CONTINUITY_PACKETS);
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_CONTINUITY_PACKETS; ++i) {
+        packet_indices[i] = i;
+    }
+
+    return packet_indices;
+}
+
+static void report_packet_continuity_result(const char *check_name, const std::vector<unsigned int> &packet_indices,
+                                            unsigned int expected_lost, unsigned int expected_reordered,
+                                            unsigned int expected_duplicated)
+{
+    vlp16_communication_status_t status;
+    const bool decoded = decode_check_packet_sequence(packet_indices, &status);
+
+    char check_name_with_counts[CHECK_CALIBRATION_LINE_LENGTH];
+    snprintf(check_name_with_counts, sizeof(check_name_with_counts),
+             "%s (lost %u, reordered %u, duplicated %u)", check_name,
+             decoded ? status.number_of_lost_packets : 0,
+             decoded ? status.number_of_reordered_packets : 0,
+             decoded ? status.number_of_duplicated_packets : 0);
+
+    report_check_result(check_name_with_counts,
+                        (decoded == true) &&
+                        (status.number_of_lost_packets == expected_lost) &&
+                        (status.number_of_reordered_packets == expected_reordered) &&
+                        (status.number_of_duplicated_packets == expected_duplicated));
+
+    return;
+}
+
+/*!
+  \brief function to check lost, reordered and duplicated packets counted from timestamp and azimuthal angle
+*/
+static void check_packet_continuity(void)
+{
+    // packet sequence without packet 50 and packets 100 to 102
+    std::vector<unsigned int> loss_indices;
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_CONTINUITY_PACKETS; ++i) {
+        if ((i != 50) && ((i < 100) || (i > 102))) {
+            loss_indices.push_back(i);
+        }
+    }
+    report_packet_continuity_result("missing packets are counted as lost", loss_indices, 4, 0, 0);
+
+    // packet 50 arrives twice, and packet 40 arrives again after packet 60
+    std::vector<unsigned int> duplicate_indices = make_ordered_check_packet_sequence();
+    duplicate_indices.insert(duplicate_indices.begin() + 51, 50);
+    duplicate_indices.insert(duplicate_indices.begin() + 62, 40);
+    report_packet_continuity_result("duplicated packets are not counted as lost", duplicate_indices, 0, 0, 2);
+
+    // packet 50 arrives after packet 51, and packet 70 arrives after packet 80
+    std::vector<unsigned int> reorder_indices = make_ordered_check_packet_sequence();
+    std::swap(reorder_indices[50], reorder_indices[51]);
+    reorder_indices.erase(reorder_indices.begin() + 70);
+    reorder_indices.insert(reorder_indices.begin() + 80, 70);
+    report_packet_continuity_result("late packets are counted as reordered", reorder_indices, 0, 2, 0);
+
+    // packet 50 is lost, and packet 49 arrives again after packet 60 (it does not fill lost packet)
+    std::vector<unsigned int> mixed_indices = loss_indices;
+    mixed_indices.erase(mixed_indices.begin() + 99, mixed_indices.end());
+    mixed_indices.insert(mixed_indices.begin() + 60, 49);
+    report_packet_continuity_result("duplicated old packet does not cancel lost packet", mixed_indices, 1, 0, 1);
+
+    return;
+}
+
+//! digest of decoded lines, points and frames
+struct decode_check_digest_t {
+
+    //! number of decoded lines
+    unsigned long number_of_lines;
+
+    //! number of points output to point block
+    unsigned long number_of_points;
+
+    //! number of completed frames
+    unsigned long number_of_frames;
+
+    //! FNV-1a hash of values of lines, points and frames
+    unsigned long long hash;
+
+};
+
+static void clear_decode_check_digest(decode_check_digest_t *digest)
+{
+    digest->number_of_lines = 0;
+    digest->number_of_points = 0;
+    digest->number_of_frames = 0;
+    digest->hash = 14695981039346656037ULL;
+
+    return;
+}
+
+static void add_to_decode_check_digest(const void *data, size_t length, decode_check_digest_t *digest)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < length; ++i) {
+        digest->hash ^= bytes[i];
+        digest->hash *= 1099511628211ULL;
+    }
+
+    return;
+}
+
+static void add_lines_to_decode_check_digest(const std::vector<const lidar_line_data_t *> &lines,
+                                             decode_check_digest_t *digest)
+{
+    for (unsigned int i = 0; i < lines.size(); ++i) {
+
+        const lidar_line_data_t *line = lines.at(i);
+
+        add_to_decode_check_digest(&line->minimum_horizontal_angle, sizeof(line->minimum_horizontal_angle), digest);
+        add_to_decode_check_digest(&line->maximum_horizontal_angle, sizeof(line->maximum_horizontal_angle), digest);
+
+        for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
+
+            const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+            add_to_decode_check_digest(&spot->number_of_echoes, sizeof(spot->number_of_echoes), digest);
+
+            for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+                const lidar_echo_data_t *echo = &line->echo_buffer[spot->echo[echo_index]];
+
+                add_to_decode_check_digest(&echo->distance, sizeof(echo->distance), digest);
+                add_to_decode_check_digest(&echo->intensity, sizeof(echo->intensity), digest);
+                add_to_decode_check_digest(&echo->measured_time, sizeof(echo->measured_time), digest);
+                add_to_decode_check_digest(&echo->horizontal_angle, sizeof(echo->horizontal_angle), digest);
+                add_to_decode_check_digest(&echo->x_component, sizeof(echo->x_component), digest);
+                add_to_decode_check_digest(&echo->y_component, sizeof(echo->y_component), digest);
+                add_to_decode_check_digest(&echo->z_component, sizeof(echo->z_component), digest);
+            }
+        }
+    }
+
+    digest->number_of_lines += lines.size();
+
+    return;
+}
+
+static void add_points_to_decode_check_digest(const lidar_point_block_t *block, decode_check_digest_t *digest)
+{
+    const unsigned int number_of_points = block->number_of_points;
+
+    add_to_decode_check_digest(block->horizontal_angle, number_of_points * sizeof(block->horizontal_angle[0]), digest);
+    add_to_decode_check_digest(block->distance, number_of_points * sizeof(block->distance[0]), digest);
+    add_to_decode_check_digest(block->laser_id, number_of_points * sizeof(block->laser_id[0]), digest);
+    add_to_decode_check_digest(block->echo_index, number_of_points * sizeof(block->echo_index[0]), digest);
+    add_to_decode_check_digest(block->measured_time, number_of_points * sizeof(block->measured_time[0]), digest);
+
+    digest->number_of_points += number_of_points;
+
+    return;
+}
+
+static void add_frame_to_decode_check_digest(const lidar_frame_t *frame, decode_check_digest_t *digest)
+{
+    add_to_decode_check_digest(&frame->number_of_lines, sizeof(frame->number_of_lines), digest);
+    add_to_decode_check_digest(frame->line_start_time, frame->number_of_lines * sizeof(frame->line_start_time[0]), digest);
+    add_to_decode_check_digest(frame->line_start_point_index,
+                               frame->number_of_lines * sizeof(frame->line_start_point_index[0]), digest);
+    add_points_to_decode_check_digest(&frame->points, digest);
+
+    ++digest->number_of_frames;
+
+    return;
+}
+
+/*!
+  \brief function to decode packets in batches with number of workers and to make digest of lines, points and frames
+  \attention pool is not used if number_of_workers == 1
+*/
+static bool decode_check_packets_in_batches(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                            const std::vector<char> &packets,
+                                            unsigned int number_of_workers,
+                                            decode_check_digest_t *digest)
+{
+    clear_decode_check_digest(digest);
+
+    work_stealing_pool_t pool;
+    initialize_work_stealing_pool(&pool);
+    if ((number_of_workers != 1) && (start_work_stealing_pool(&pool, number_of_workers) == false)) {
+        return false;
+    }
+
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+
+    lidar_point_block_t point_block;
+    clear_lidar_point_block(&point_block);
+
+    if ((allocate_circular_buffer_for_vlp16_handler(&handler, sensor_model, CHECK_RECEIVE_BUFFER_LENGTH) == false) ||
+        (allocate_packet_batch_buffer_for_vlp16_handler(&handler, NUMBER_OF_CHECK_PACKETS_IN_BATCH) == false) ||
+        (allocate_frame_assembler_for_vlp16_handler(&handler, sensor_model, CHECK_FRAME_MAXIMUM_NUMBER_OF_LINES) == false) ||
+        (allocate_memory_for_lidar_point_block(&point_block, CHECK_POINT_BLOCK_CAPACITY) == false)) {
+        release_circular_buffer_of_vlp16_handler(&handler);
+        stop_work_stealing_pool(&pool);
+        return false;
+    }
+    set_cartesian_output_of_vlp16_handler(&handler, true);
+    set_point_block_output_of_vlp16_handler(&handler, &point_block);
+    if (is_started_work_stealing_pool(&pool) == true) {
+        set_decode_pool_of_vlp16_handler(&handler, &pool);
+    }
+
+    const unsigned int number_of_packets = packets.size() / VLP16_PACKET_LENGTH;
+    std::vector<const lidar_line_data_t *> lines;
+    lines.reserve(handler.line_data_buffer.length);
+
+    for (unsigned int i = 0; i < number_of_packets; i += NUMBER_OF_CHECK_PACKETS_IN_BATCH) {
+
+        const unsigned int number_of_packets_in_batch =
+            std::min((unsigned int)NUMBER_OF_CHECK_PACKETS_IN_BATCH, number_of_packets - i);
+
+        unsigned int number_of_received_packets = 0;
+        const unsigned int number_of_lines =
+            receive_vlp16_packets_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH],
+                                              number_of_packets_in_batch, &number_of_received_packets);
+
+        get_pointers_of_latest_unused_lidar_line_data(&handler.line_data_buffer, number_of_lines, lines);
+        add_lines_to_decode_check_digest(lines, digest);
+        move_used_data_end_out_point(&handler.line_data_buffer,
+                                     calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+
+        add_points_to_decode_check_digest(&point_block, digest);
+        erase_all_points_of_lidar_point_block(&point_block);
+
+        const lidar_frame_t *frame = get_completed_frame_of_vlp16_handler(&handler);
+        if (frame != NULL) {
+            add_frame_to_decode_check_digest(frame, digest);
+        }
+    }
+
+    set_point_block_output_of_vlp16_handler(&handler, NULL);
+    set_decode_pool_of_vlp16_handler(&handler, NULL);
+    release_memory_of_lidar_point_block(&point_block);
+    release_circular_buffer_of_vlp16_handler(&handler);
+    stop_work_stealing_pool(&pool);
+
+    return true;
+}
+
+static void check_parallel_decode(void)
+{
+    const enum VLP16_PACKET_RETURN_MODE return_modes[] =
+        { VLP16_PACKET_STRONGEST_RETURN_MODE, VLP16_PACKET_DUAL_RETURN_MODE };
+
+    for (unsigned int model_index = 0; model_index < NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET; ++model_index) {
+        for (unsigned int mode_index = 0; mode_index < sizeof(return_modes) / sizeof(return_modes[0]); ++mode_index) {
+
+            const enum VLP16_PACKET_SENSOR_MODEL sensor_model = (enum VLP16_PACKET_SENSOR_MODEL)model_index;
+
+            // lost and reordered packets are included
+            vlp16_packet_generator_t generator;
+            initialize_vlp16_packet_generator(&generator, sensor_model, return_modes[mode_index],
+                                              VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+            set_impairments_of_vlp16_packet_generator(&generator, 0.01, 0.01, CHECK_IMPAIRMENT_SEED);
+
+            std::vector<char> packets;
+            std::vector<char> emitted_packets(VLP16_PACKET_GENERATOR_MAXIMUM_NUMBER_OF_EMITTED_PACKETS * VLP16_PACKET_LENGTH);
+            while (packets.size() < NUMBER_OF_CHECK_PACKETS * VLP16_PACKET_LENGTH) {
+                const unsigned int number_of_emitted_packets = emit_vlp16_packets_of_generator(&generator, &emitted_packets[0]);
+                packets.insert(packets.end(), emitted_packets.begin(),
+                               emitted_packets.begin() + number_of_emitted_packets * VLP16_PACKET_LENGTH);
+            }
+
+            decode_check_digest_t serial_digest;
+            decode_check_digest_t parallel_digest;
+            const bool decoded =
+                (decode_check_packets_in_batches(sensor_model, packets, 1, &serial_digest) == true) &&
+                (decode_check_packets_in_batches(sensor_model, packets, NUMBER_OF_CHECK_PARALLEL_WORKERS, &parallel_digest) == true);
+
+            char check_name[CHECK_CALIBRATION_LINE_LENGTH];
+            snprintf(check_name, sizeof(check_name),
+                     "%d workers decode same lines, points and frames as 1 worker (%s, %s)",
+                     (int)NUMBER_OF_CHECK_PARALLEL_WORKERS, VLP16_PACKET_SENSOR_MODEL_NAME[model_index],
+                     (return_modes[mode_index] == VLP16_PACKET_DUAL_RETURN_MODE) ? "dual" : "strongest");
+
+            report_check_result(check_name,
+                                (decoded == true) &&
+                                (serial_digest.number_of_lines != 0) &&
+                                (serial_digest.number_of_points != 0) &&
+                                (serial_digest.number_of_frames != 0) &&
+                                (serial_digest.number_of_lines == parallel_digest.number_of_lines) &&
+                                (serial_digest.number_of_points == parallel_digest.number_of_points) &&
+                                (serial_digest.number_of_frames == parallel_digest.number_of_frames) &&
+                                (serial_digest.hash == parallel_digest.hash));
+        }
+    }
+
+    return;
+}
+
+/*!
+  \brief function to decode generated packets packet by packet with decode kernel and to make digest of lines
+  \attention this function returns false if kernel is not usable on running cpu
+*/
+static bool decode_check_packets_with_kernel(enum VLP16_PACKET_SENSOR_MODEL sensor_model,
+                                             enum VLP16_PACKET_RETURN_MODE return_mode,
+                                             enum VLP16_DECODE_KERNEL_TYPE kernel_type,
+                                             const vlp16_calibration_t *calibration,
+                                             decode_check_digest_t *digest)
+{
+    clear_decode_check_digest(digest);
+
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+    if (allocate_circular_buffer_for_vlp16_handler(&handler, sensor_model, CHECK_RECEIVE_BUFFER_LENGTH) == false) {
+        return false;
+    }
+    if (set_decode_kernel_of_vlp16_handler(&handler, kernel_type) == false) {
+        release_circular_buffer_of_vlp16_handler(&handler);
+        return false;
+    }
+    set_cartesian_output_of_vlp16_handler(&handler, true);
+    set_calibration_of_vlp16_handler(&handler, calibration);
+
+    vlp16_packet_generator_t generator;
+    initialize_vlp16_packet_generator(&generator, sensor_model, return_mode,
+                                      VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+    std::vector<char> packet(VLP16_PACKET_LENGTH);
+    std::vector<const lidar_line_data_t *> lines;
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_PACKETS; ++i) {
+        generate_vlp16_packet(&generator, &packet[0]);
+
+        if (receive_vlp16_packet_from_memory(&handler, &packet[0], VLP16_PACKET_LENGTH) == false) {
+            continue;
+        }
+
+        const unsigned int number_of_lines = decode_vlp16_packet(&handler);
+        get_pointers_of_latest_unused_lidar_line_data(&handler.line_data_buffer, number_of_lines, lines);
+        add_lines_to_decode_check_digest(lines, digest);
+        move_used_data_end_out_point(&handler.line_data_buffer,
+                                     calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+    }
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return true;
+}
+
+static void check_decode_kernels_with_calibration(void)
+{
+    vlp16_calibration_t calibration;
+    make_check_calibration(&calibration);
+
+    // negative distance offsets are added, and one of them clamps distances to 0
+    for (unsigned int i = 1; i < calibration.number_of_lasers; i += 2) {
+        calibration.laser[i].distance_correction = -calibration.laser[i].distance_correction;
+    }
+    calibration.laser[5].distance_correction = -1.0e6;
+
+    const enum VLP16_PACKET_RETURN_MODE return_modes[] =
+        { VLP16_PACKET_STRONGEST_RETURN_MODE, VLP16_PACKET_DUAL_RETURN_MODE };
+
+    for (unsigned int model_index = 0; model_index < NUMBER_OF_SENSOR_MODELS_IN_VLP16_PACKET; ++model_index) {
+        for (unsigned int mode_index = 0; mode_index < sizeof(return_modes) / sizeof(return_modes[0]); ++mode_index) {
+
+            const enum VLP16_PACKET_SENSOR_MODEL sensor_model = (enum VLP16_PACKET_SENSOR_MODEL)model_index;
+
+            decode_check_digest_t scalar_digest;
+            const bool scalar_decoded =
+                decode_check_packets_with_kernel(sensor_model, return_modes[mode_index], VLP16_SCALAR_DECODE_KERNEL,
+                                                 &calibration, &scalar_digest);
+
+            for (int kernel_index = VLP16_SCALAR_DECODE_KERNEL + 1; kernel_index < NUMBER_OF_VLP16_DECODE_KERNELS; ++kernel_index) {
+
+                const enum VLP16_DECODE_KERNEL_TYPE kernel_type = (enum VLP16_DECODE_KERNEL_TYPE)kernel_index;
+
+                char check_name[CHECK_CALIBRATION_LINE_LENGTH];
+                snprintf(check_name, sizeof(check_name),
+                         "%s kernel decodes same calibrated lines as scalar kernel (%s, %s)",
+                         VLP16_DECODE_KERNEL_NAME[kernel_index], VLP16_PACKET_SENSOR_MODEL_NAME[model_index],
+                         (return_modes[mode_index] == VLP16_PACKET_DUAL_RETURN_MODE) ? "dual" : "strongest");
+
+                if (is_usable_vlp16_decode_kernel(kernel_type) == false) {
+                    cout << "SKIP " << check_name << " (kernel is not usable on running cpu)\n";
+                    continue;
+                }
+
+                decode_check_digest_t kernel_digest;
+                const bool kernel_decoded =
+                    decode_check_packets_with_kernel(sensor_model, return_modes[mode_index], kernel_type,
+                                                     &calibration, &kernel_digest);
+
+                report_check_result(check_name,
+                                    (scalar_decoded == true) &&
+                                    (kernel_decoded == true) &&
+                                    (scalar_digest.number_of_lines != 0) &&
+                                    (scalar_digest.number_of_lines == kernel_digest.number_of_lines) &&
+                                    (scalar_digest.hash == kernel_digest.hash));
+            }
+        }
+    }
+
+    return;
+}
+
+static void check_region_filters_with_calibration(void)
+{
+    vlp16_calibration_t calibration;
+    make_check_calibration(&calibration);
+
+    // large rotational corrections move echoes of edge spots out of uncorrected line range
+    for (unsigned int i = 0; i < calibration.number_of_lasers; ++i) {
+        calibration.laser[i].rotational_correction = ((i % 2) == 0 ? 1.0 : -1.0) * 3.0e-3 * (double)(i + 1);
+        calibration.laser[i].vertical_correction += 0.3 * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
+    }
+
+    vlp16_handler_t handler;
+    decode_check_packets(VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE, &calibration,
+                         NUMBER_OF_CHECK_PACKETS, &handler);
+
+    std::vector<const lidar_line_data_t *> lines;
+    get_pointers_of_unused_lidar_line_data(&handler.line_data_buffer, lines);
+
+    // narrow regions around calibrated elevation angles (one of them straddles azimuth 0)
+    std::vector<lidar_echo_single_region_t> regions;
+    const double region_azimuths[] = { 0.0, 0.5, 1.7, 3.1, 4.4, 6.2 };
+    for (unsigned int i = 0; i < sizeof(region_azimuths) / sizeof(region_azimuths[0]); ++i) {
+        lidar_echo_single_region_t region;
+        set_lidar_echo_single_region_using_center_direction(region_azimuths[i], 0.01,
+                                                            calibration.laser[(3 * i) % 16].vertical_correction, 0.001,
+                                                            &region);
+        regions.push_back(region);
+    }
+
+    // reference is echo test without line test
+    std::vector<unsigned int> expected_counts(regions.size(), 0);
+    for (unsigned int line_index = 0; line_index < lines.size(); ++line_index) {
+        const lidar_line_data_t *line = lines.at(line_index);
+
+        for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
+            const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+
+            for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+                const lidar_echo_data_t *echo = &line->echo_buffer[spot->echo[echo_index]];
+
+                for (unsigned int region_index = 0; region_index < regions.size(); ++region_index) {
+                    if (is_lidar_echo_in_single_region(echo, &regions.at(region_index)) == true) {
+                        ++expected_counts.at(region_index);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector< std::vector<lidar_echo_data_t> > single_region_echoes(regions.size());
+    add_lidar_echo_data_in_each_single_region(lines, regions, single_region_echoes);
+
+    lidar_echo_region_set_t region_set;
+    const bool compiled =
+        compile_lidar_echo_region_set_for_vlp16_handler(&handler, regions,
+                                                        LIDAR_ECHO_REGION_SET_DEFAULT_NUMBER_OF_AZIMUTH_BUCKETS,
+                                                        &region_set);
+    std::vector< std::vector<lidar_echo_data_t> > region_set_echoes(regions.size());
+    add_lidar_echo_data_in_each_region_of_region_set(lines, &region_set, region_set_echoes);
+
+    bool all_regions_have_echoes = true;
+    bool single_region_filter_agrees = true;
+    bool region_set_filter_agrees = compiled;
+
+    for (unsigned int region_index = 0; region_index < regions.size(); ++region_index) {
+        if (expected_counts.at(region_index) == 0) {
+            all_regions_have_echoes = false;
+        }
+        if (single_region_echoes.at(region_index).size() != expected_counts.at(region_index)) {
+            single_region_filter_agrees = false;
+        }
+        if (region_set_echoes.at(region_index).size() != expected_counts.at(region_index)) {
+            region_set_filter_agrees = false;
+        }
+    }
+
+    report_check_result("calibrated regions contain echoes", (lines.size() != 0) && all_regions_have_echoes);
+    report_check_result("single region filter agrees with echo test on calibrated lines", single_region_filter_agrees);
+    report_check_result("region set filter agrees with echo test on calibrated lines", region_set_filter_agrees);
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return;
+}
+
+/*!
+  \brief function to calculate difference of angles in one revolution [rad]
+*/
+static double calculate_wrapped_angle_difference(double first_angle, double second_angle)
+{
+    const double difference = fmod(fabs(first_angle - second_angle), 2.0 * M_PI);
+
+    return std::min(difference, 2.0 * M_PI - difference);
+}
+
+/*!
+  \brief function to compare echo read from log with written echo
+  \attention distance and angles are compared within quantization of log, and saturated distance is expected for far echo
+*/
+static bool is_lidar_echo_restored_from_log(const lidar_echo_data_t *written, const lidar_echo_data_t *read)
+{
+    // half of angle unit, and half of distance scale rounded up to integer distance
+    const double angle_tolerance = M_PI / LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION + 1.0e-9;
+    const unsigned int saturated_distance =
+        (unsigned int)(LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE * VLP16_PACKET_DISTANCE_SCALE);
+    const unsigned int expected_distance = std::min(written->distance, saturated_distance);
+
+    return (read->index == written->index) &&
+        (read->number_of_echoes_at_same_time == written->number_of_echoes_at_same_time) &&
+        (read->measured_time == written->measured_time) &&
+        (read->calibrated_time == written->calibrated_time) &&
+        (read->intensity == written->intensity) &&
+        (std::max(read->distance, expected_distance) - std::min(read->distance, expected_distance) <= 1) &&
+        (calculate_wrapped_angle_difference(read->horizontal_angle, written->horizontal_angle) <= angle_tolerance) &&
+        (fabs(read->elevation_angle - written->elevation_angle) <= angle_tolerance) &&
+        (read->cartesian_coordinates_available == false);
+}
+
+static void check_lidar_echo_log_round_trip(void)
+{
+    vlp16_handler_t handler;
+    decode_check_packets(VLP16_PACKET_VLP16, VLP16_PACKET_DUAL_RETURN_MODE, NULL, NUMBER_OF_CHECK_PACKETS, &handler);
+
+    std::vector<const lidar_line_data_t *> lines;
+    get_pointers_of_unused_lidar_line_data(&handler.line_data_buffer, lines);
+
+    std::vector<lidar_echo_data_t> echoes;
+    for (unsigned int line_index = 0; line_index < lines.size(); ++line_index) {
+        const lidar_line_data_t *line = lines.at(line_index);
+
+        for (unsigned int spot_index = 0; spot_index < line->number_of_spots; ++spot_index) {
+            const lidar_spot_accessor_t *spot = &line->spot[spot_index];
+
+            for (unsigned int echo_index = 0; echo_index < spot->number_of_echoes; ++echo_index) {
+                echoes.push_back(line->echo_buffer[spot->echo[echo_index]]);
+            }
+        }
+    }
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    // echo beyond range of 16 bit raw distance is saturated
+    unsigned int number_of_far_echoes = 0;
+    if (echoes.empty() == false) {
+        lidar_echo_data_t far_echo = echoes.front();
+        far_echo.distance = (unsigned int)(LIDAR_ECHO_LOG_MAXIMUM_RAW_DISTANCE * VLP16_PACKET_DISTANCE_SCALE) + 10000;
+        echoes.push_back(far_echo);
+        ++number_of_far_echoes;
+    }
+
+    char file_path[] = "/tmp/vlp16_check_echo_log_XXXXXX";
+    const int file_descriptor = mkstemp(file_path);
+    if (file_descriptor < 0) {
+        report_check_result("echo log is created", false);
+        return;
+    }
+    close(file_descriptor);
+
+    // small buffers make writer and reader cross buffer boundaries
+    lidar_echo_log_writer_t writer;
+    clear_lidar_echo_log_writer(&writer);
+    const bool written =
+        (open_lidar_echo_log_writer(file_path, VLP16_PACKET_DISTANCE_SCALE,
+                                    LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION,
+                                    100 * LIDAR_ECHO_LOG_RECORD_LENGTH, &writer) == true) &&
+        (write_lidar_echo_array_to_log(&writer, echoes) == true);
+    const unsigned int number_of_saturated_distances = writer.number_of_saturated_distances;
+    const bool closed = (close_lidar_echo_log_writer(&writer) == true);
+
+    lidar_echo_log_reader_t reader;
+    clear_lidar_echo_log_reader(&reader);
+    const bool opened = open_lidar_echo_log_reader(file_path, 70 * LIDAR_ECHO_LOG_RECORD_LENGTH, &reader);
+
+    unsigned int number_of_read_echoes = 0;
+    bool all_echoes_restored = opened;
+    lidar_echo_data_t echo;
+    while ((opened == true) && (read_lidar_echo_from_log(&reader, &echo) == true)) {
+        if ((number_of_read_echoes >= echoes.size()) ||
+            (is_lidar_echo_restored_from_log(&echoes.at(number_of_read_echoes), &echo) == false)) {
+            all_echoes_restored = false;
+        }
+        ++number_of_read_echoes;
+    }
+    close_lidar_echo_log_reader(&reader);
+    unlink(file_path);
+
+    report_check_result("echo log writer and reader round-trip echoes of generated frames",
+                        (echoes.size() > number_of_far_echoes) && written && closed &&
+                        (number_of_read_echoes == echoes.size()) && all_echoes_restored);
+    report_check_result("echo log counts saturated distances", number_of_saturated_distances == number_of_far_echoes);
+
+    return;
+}
+
+/*!
+  \brief function to calculate receive time of packet of recorder check from first packet [usec]
+*/
+static double calculate_check_recorder_elapsed_time_usec(unsigned int packet_index)
+{
+    const double elapsed_time_usec = (double)packet_index * CHECK_RECORDER_PACKET_INTERVAL_USEC;
+
+    if (packet_index < NUMBER_OF_CHECK_RECORDER_PACKETS_BEFORE_GAP) {
+        return elapsed_time_usec;
+    }
+
+    return elapsed_time_usec + CHECK_RECORDER_GAP_USEC;
+}
+
+/*!
+  \brief function to compare records of packet record file with recorded packets and their receive time
+*/
+static bool are_recorded_packets_read_back(const packet_record_file_reader_t *reader, const std::vector<char> &packets,
+                                           double first_receive_time_usec)
+{
+    for (unsigned int i = 0; i < get_number_of_records_of_packet_record_file(reader); ++i) {
+
+        const char *packet = NULL;
+        unsigned int packet_length = 0;
+        unsigned int receive_time_sec = 0;
+        unsigned int receive_time_usec = 0;
+
+        if ((get_record_of_packet_record_file(reader, i, &packet, &packet_length,
+                                              &receive_time_sec, &receive_time_usec) == false) ||
+            (packet_length != VLP16_PACKET_LENGTH) ||
+            (memcmp(packet, &packets[i * VLP16_PACKET_LENGTH], VLP16_PACKET_LENGTH) != 0) ||
+            ((double)receive_time_sec * 1.0e6 + (double)receive_time_usec !=
+             first_receive_time_usec + calculate_check_recorder_elapsed_time_usec(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+  \brief function to overwrite bytes of file at offset
+*/
+static bool overwrite_check_file(const char *file_path, unsigned long long offset, const void *data, size_t length)
+{
+    const int file_descriptor = open(file_path, O_RDWR);
+    if (file_descriptor < 0) {
+        return false;
+    }
+
+    const bool written = (pwrite(file_descriptor, data, length, (off_t)offset) == (ssize_t)length);
+    close(file_descriptor);
+
+    return written;
+}
+
+static void check_packet_recorder(void)
+{
+#if defined(LINUX_OS)
+    char file_path[] = "/tmp/vlp16_check_packet_record_XXXXXX";
+    const int file_descriptor = mkstemp(file_path);
+    if (file_descriptor < 0) {
+        report_check_result("packet record file is created", false);
+        return;
+    }
+    close(file_descriptor);
+
+    vlp16_packet_generator_t generator;
+    initialize_vlp16_packet_generator(&generator, VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                      VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+    std::vector<char> packets(NUMBER_OF_CHECK_RECORDER_PACKETS * VLP16_PACKET_LENGTH);
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_RECORDER_PACKETS; ++i) {
+        generate_vlp16_packet(&generator, &packets[i * VLP16_PACKET_LENGTH]);
+    }
+
+    // packets are stamped with receive time from 2023-11-14 and gap of receive time is included
+    const double first_receive_time_usec = 1700000000.0 * 1.0e6;
+
+    packet_recorder_t recorder;
+    bool recorded = (open_packet_recorder(file_path, VLP16_PACKET_LENGTH, CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS,
+                                          &recorder) == true);
+    unsigned int number_of_appended_packets = 0;
+
+    for (unsigned int i = 0; (recorded == true) && (i < NUMBER_OF_CHECK_RECORDER_PACKETS); ++i) {
+        if (append_packet_to_packet_recorder(&recorder, &packets[i * VLP16_PACKET_LENGTH], VLP16_PACKET_LENGTH,
+                                             first_receive_time_usec + calculate_check_recorder_elapsed_time_usec(i),
+                                             (i % NUMBER_OF_CHECK_RECORDER_PACKETS_IN_REVOLUTION) == 0) == true) {
+            ++number_of_appended_packets;
+        }
+    }
+    close_packet_recorder(&recorder);
+
+    packet_record_file_reader_t reader;
+    recorded = recorded && (open_packet_record_file(file_path, &reader) == true);
+
+    if (recorded == true) {
+
+        const packet_record_file_header_t *header = reader.header;
+        const double last_elapsed_time_usec =
+            calculate_check_recorder_elapsed_time_usec(CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS - 1);
+
+        report_check_result("packet recorder records packets until file is full and counts dropped packets",
+                            (number_of_appended_packets == CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS) &&
+                            (get_number_of_records_of_packet_record_file(&reader) == CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS) &&
+                            (header->number_of_dropped_packets ==
+                             NUMBER_OF_CHECK_RECORDER_PACKETS - CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS));
+
+        report_check_result("recorded packets and receive time are read back",
+                            are_recorded_packets_read_back(&reader, packets, first_receive_time_usec));
+
+        // gap of receive time does not use entries of time index
+        report_check_result("packet record file is seeked by time across gap of receive time",
+                            (header->number_of_time_index_entries < CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS) &&
+                            (seek_record_index_by_time_of_packet_record_file(&reader, 0.0) == 0) &&
+                            (seek_record_index_by_time_of_packet_record_file(&reader, 5.5 * CHECK_RECORDER_PACKET_INTERVAL_USEC) == 6) &&
+                            (seek_record_index_by_time_of_packet_record_file(&reader, CHECK_RECORDER_GAP_USEC / 2) ==
+                             NUMBER_OF_CHECK_RECORDER_PACKETS_BEFORE_GAP) &&
+                            (seek_record_index_by_time_of_packet_record_file(&reader, last_elapsed_time_usec) ==
+                             CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS - 1) &&
+                            (seek_record_index_by_time_of_packet_record_file(&reader, last_elapsed_time_usec + 1.0) ==
+                             PACKET_RECORDER_INVALID_RECORD_INDEX));
+
+        report_check_result("packet record file is seeked by revolution",
+                            (seek_record_index_by_revolution_of_packet_record_file(&reader, 0) == 0) &&
+                            (seek_record_index_by_revolution_of_packet_record_file(&reader, 3) ==
+                             3 * NUMBER_OF_CHECK_RECORDER_PACKETS_IN_REVOLUTION) &&
+                            (seek_record_index_by_revolution_of_packet_record_file(&reader, 7) ==
+                             PACKET_RECORDER_INVALID_RECORD_INDEX));
+
+        const unsigned long long revolution_index_offset = header->revolution_index_offset;
+        const unsigned long long time_index_offset_position =
+            (const char *)&header->time_index_offset - (const char *)header;
+        const unsigned long long outside_offset = reader.mapped_file_length;
+        close_packet_record_file(&reader);
+
+        // entry of revolution index points outside of records
+        const unsigned int invalid_record_index = CHECK_RECORDER_MAXIMUM_NUMBER_OF_RECORDS;
+        bool seek_rejected =
+            (overwrite_check_file(file_path, revolution_index_offset, &invalid_record_index, sizeof(invalid_record_index)) == true) &&
+            (open_packet_record_file(file_path, &reader) == true);
+        if (seek_rejected == true) {
+            seek_rejected =
+                (seek_record_index_by_revolution_of_packet_record_file(&reader, 0) == PACKET_RECORDER_INVALID_RECORD_INDEX);
+            close_packet_record_file(&reader);
+        }
+        report_check_result("packet record file rejects index entry outside of records", seek_rejected);
+
+        // time index is outside of file
+        report_check_result("packet record file rejects index outside of file",
+                            (overwrite_check_file(file_path, time_index_offset_position, &outside_offset, sizeof(outside_offset)) == true) &&
+                            (open_packet_record_file(file_path, &reader) == false));
+    } else {
+        report_check_result("packet record file is recorded and opened", false);
+    }
+
+    unlink(file_path);
+#else
+    cout << "SKIP packet recorder (recorder works only on Linux OS)\n";
+#endif
+
+    return;
+}
+
+static bool push_check_ring_packet(packet_ring_buffer_t *ring, unsigned int value)
+{
+    return push_packet_to_packet_ring_buffer(ring, (const char *)&value, sizeof(value), (double)value);
+}
+
+/*!
+  \brief function to pop packets of ring and to compare them with first_value, first_value + 1, ...
+  \attention this function returns false if ring is not empty after popping number_of_packets packets
+*/
+static bool pop_check_ring_packets(packet_ring_buffer_t *ring, unsigned int first_value, unsigned int number_of_packets)
+{
+    for (unsigned int i = 0; i < number_of_packets; ++i) {
+
+        unsigned int value = 0;
+        int packet_length = 0;
+        double receive_time_usec = 0.0;
+
+        if ((pop_packet_from_packet_ring_buffer(ring, (char *)&value, sizeof(value), &packet_length,
+                                                &receive_time_usec) == false) ||
+            (packet_length != (int)sizeof(value)) ||
+            (value != first_value + i) ||
+            (receive_time_usec != (double)(first_value + i))) {
+            return false;
+        }
+    }
+
+    return (calculate_number_of_packets_in_packet_ring_buffer(ring) == 0);
+}
+
+/*!
+  \brief function to hold slots of ring and to compare them with first_value, first_value + 1, ...
+*/
+static bool hold_check_ring_packets(packet_ring_buffer_t *ring, unsigned int first_value, unsigned int number_of_packets)
+{
+    unsigned int number_of_held_slots = 0;
+    const int *data_length = NULL;
+    const double *receive_time_usec = NULL;
+
+    const char *slots = hold_slots_to_read_packet_ring_buffer(ring, number_of_packets, &number_of_held_slots,
+                                                              &data_length, &receive_time_usec);
+    if ((slots == NULL) || (number_of_held_slots != number_of_packets)) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < number_of_held_slots; ++i) {
+
+        unsigned int value = 0;
+        memcpy(&value, slots + i * ring->slot_length_byte, sizeof(value));
+
+        if ((data_length[i] != (int)sizeof(value)) || (value != first_value + i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+  \brief function to check that packets pass through ring in order across end of slots
+*/
+static bool check_packet_ring_wrap_around(void)
+{
+    packet_ring_buffer_t ring;
+    initialize_packet_ring_buffer(&ring);
+    if (allocate_memory_for_packet_ring_buffer(&ring, sizeof(unsigned int), NUMBER_OF_CHECK_RING_SLOTS,
+                                               CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS,
+                                               PACKET_RING_DROP_NEWEST) == false) {
+        return false;
+    }
+
+    bool passed = true;
+    unsigned int next_written_value = 1;
+    unsigned int next_read_value = 1;
+    unsigned int number_of_short_holds = 0;
+
+    while ((passed == true) && (next_read_value <= NUMBER_OF_CHECK_RING_WRAP_AROUND_PACKETS)) {
+
+        // three packets are written, and they are read by holding two slots at most
+        for (unsigned int i = 0; (i < 3) && (next_written_value <= NUMBER_OF_CHECK_RING_WRAP_AROUND_PACKETS); ++i) {
+            passed = passed && (push_check_ring_packet(&ring, next_written_value++) == true);
+        }
+
+        while (passed == true) {
+
+            unsigned int number_of_held_slots = 0;
+            const int *data_length = NULL;
+            const double *receive_time_usec = NULL;
+
+            const char *slots =
+                hold_slots_to_read_packet_ring_buffer(&ring, CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS,
+                                                      &number_of_held_slots, &data_length, &receive_time_usec);
+            if (slots == NULL) {
+                break;
+            }
+
+            // held slots are continuous, so hold is cut at end of slots
+            if ((number_of_held_slots < CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS) &&
+                (calculate_number_of_packets_in_packet_ring_buffer(&ring) != 0)) {
+                ++number_of_short_holds;
+            }
+
+            for (unsigned int i = 0; i < number_of_held_slots; ++i) {
+                unsigned int value = 0;
+                memcpy(&value, slots + i * ring.slot_length_byte, sizeof(value));
+                passed = passed && (value == next_read_value++);
+            }
+
+            release_held_slots_of_packet_ring_buffer(&ring);
+        }
+    }
+
+    passed = passed &&
+        (next_read_value == NUMBER_OF_CHECK_RING_WRAP_AROUND_PACKETS + 1) &&
+        (number_of_short_holds != 0) &&
+        (ring.number_of_held_slots == 0) &&
+        (ring.number_of_overflows == 0) &&
+        (ring.number_of_dropped_packets == 0);
+
+    release_memory_of_packet_ring_buffer(&ring);
+
+    return passed;
+}
+
+/*!
+  \brief function to check that oldest queued packets are dropped while slots are held on PACKET_RING_DROP_OLDEST
+*/
+static bool check_packet_ring_drop_oldest_with_held_slots(void)
+{
+    packet_ring_buffer_t ring;
+    initialize_packet_ring_buffer(&ring);
+    if (allocate_memory_for_packet_ring_buffer(&ring, sizeof(unsigned int), NUMBER_OF_CHECK_RING_SLOTS,
+                                               CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS,
+                                               PACKET_RING_DROP_OLDEST) == false) {
+        return false;
+    }
+
+    bool passed = true;
+    for (unsigned int value = 1; value <= NUMBER_OF_CHECK_RING_SLOTS; ++value) {
+        passed = passed && (push_check_ring_packet(&ring, value) == true);
+    }
+
+    // packets 1 and 2 are held, and packets 3 and 4 are dropped for packets 7 and 8
+    passed = passed &&
+        (hold_check_ring_packets(&ring, 1, CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS) == true) &&
+        (push_check_ring_packet(&ring, 5) == true) &&
+        (push_check_ring_packet(&ring, 6) == true) &&
+        (push_check_ring_packet(&ring, 7) == true) &&
+        (push_check_ring_packet(&ring, 8) == true) &&
+        (ring.number_of_dropped_packets == 2);
+
+    // next slot is held, so packet 9 is dropped without dropping queued packets
+    passed = passed &&
+        (push_check_ring_packet(&ring, 9) == false) &&
+        (ring.number_of_dropped_packets == 3) &&
+        (calculate_number_of_packets_in_packet_ring_buffer(&ring) == NUMBER_OF_CHECK_RING_SLOTS);
+
+    // released slots are reused, and packet 5 is dropped for packet 9
+    release_held_slots_of_packet_ring_buffer(&ring);
+    passed = passed &&
+        (ring.number_of_held_slots == 0) &&
+        (push_check_ring_packet(&ring, 9) == true) &&
+        (ring.number_of_dropped_packets == 4) &&
+        (pop_check_ring_packets(&ring, 6, NUMBER_OF_CHECK_RING_SLOTS) == true);
+
+    release_memory_of_packet_ring_buffer(&ring);
+
+    return passed;
+}
+
+/*!
+  \brief function to check that new packets are dropped while slots are held on PACKET_RING_DROP_NEWEST
+*/
+static bool check_packet_ring_drop_newest_with_held_slots(void)
+{
+    packet_ring_buffer_t ring;
+    initialize_packet_ring_buffer(&ring);
+    if (allocate_memory_for_packet_ring_buffer(&ring, sizeof(unsigned int), NUMBER_OF_CHECK_RING_SLOTS,
+                                               CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS,
+                                               PACKET_RING_DROP_NEWEST) == false) {
+        return false;
+    }
+
+    bool passed = true;
+    for (unsigned int value = 1; value <= NUMBER_OF_CHECK_RING_SLOTS; ++value) {
+        passed = passed && (push_check_ring_packet(&ring, value) == true);
+    }
+
+    // packets 1 and 2 are held, and packet 7 is dropped
+    passed = passed &&
+        (hold_check_ring_packets(&ring, 1, CHECK_RING_MAXIMUM_NUMBER_OF_HELD_SLOTS) == true) &&
+        (push_check_ring_packet(&ring, 5) == true) &&
+        (push_check_ring_packet(&ring, 6) == true) &&
+        (push_check_ring_packet(&ring, 7) == false) &&
+        (ring.number_of_dropped_packets == 1);
+
+    release_held_slots_of_packet_ring_buffer(&ring);
+    passed = passed &&
+        (ring.number_of_held_slots == 0) &&
+        (pop_check_ring_packets(&ring, 3, NUMBER_OF_CHECK_RING_SLOTS) == true);
+
+    release_memory_of_packet_ring_buffer(&ring);
+
+    return passed;
+}
+
+static void check_packet_ring(void)
+{
+    report_check_result("packet ring passes packets in order across end of slots",
+                        check_packet_ring_wrap_around());
+    report_check_result("packet ring drops oldest queued packets while slots are held (drop oldest)",
+                        check_packet_ring_drop_oldest_with_held_slots());
+    report_check_result("packet ring drops new packets while slots are held (drop newest)",
+                        check_packet_ring_drop_newest_with_held_slots());
+
+    return;
+}
+
+/*!
+  \brief function to receive generated packets through loopback socket with receive thread and to make digest of lines
+  \attention number_of_received_packets is less than number of packets if packets are lost in socket or ring
+  \attention number_of_bursts_with_heap_allocations counts bursts of packets which allocate heap after NUMBER_OF_CHECK_WARM_UP_PACKETS packets (NULL is ignored)
+*/
+static bool receive_check_packets_through_loopback(const std::vector<char> &packets, bool threaded,
+                                                   decode_check_digest_t *digest,
+                                                   unsigned int *number_of_received_packets,
+                                                   unsigned int *number_of_bursts_with_heap_allocations = NULL)
+{
+    clear_decode_check_digest(digest);
+    *number_of_received_packets = 0;
+    if (number_of_bursts_with_heap_allocations != NULL) {
+        *number_of_bursts_with_heap_allocations = 0;
+    }
+
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+
+    if (open_socket_for_vlp16_handler(CHECK_LOOPBACK_IP_ADDRESS, CHECK_LOOPBACK_SENDER_PORT_NUMBER,
+                                      CHECK_RECEPTION_IP_ADDRESS, CHECK_LOOPBACK_HANDLER_PORT_NUMBER,
+                                      CHECK_LOOPBACK_TIMEOUT_USEC, &handler) == false) {
+        return false;
+    }
+
+    socket_client_t sender;
+    if ((allocate_circular_buffer_for_vlp16_handler(&handler, VLP16_PACKET_VLP16, CHECK_RECEIVE_BUFFER_LENGTH) == false) ||
+        (allocate_packet_batch_buffer_for_vlp16_handler(&handler, NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE) == false) ||
+        ((threaded == true) &&
+         (start_receive_thread_of_vlp16_handler(&handler, NUMBER_OF_CHECK_LOOPBACK_RING_PACKETS, PACKET_RING_DROP_NEWEST,
+                                                VLP16_RECEIVE_THREAD_NO_CPU_AFFINITY) == false)) ||
+        (open_socket_for_client(CHECK_LOOPBACK_IP_ADDRESS, CHECK_LOOPBACK_HANDLER_PORT_NUMBER,
+                                CHECK_RECEPTION_IP_ADDRESS, CHECK_LOOPBACK_SENDER_PORT_NUMBER,
+                                SOCKET_PROTOCOL_UDP, &sender) == false)) {
+        close_socket_of_vlp16_handler(&handler);
+        release_circular_buffer_of_vlp16_handler(&handler);
+        return false;
+    }
+
+    const unsigned int number_of_packets = packets.size() / VLP16_PACKET_LENGTH;
+    std::vector<const lidar_line_data_t *> lines;
+    lines.reserve(handler.line_data_buffer.length);
+
+    for (unsigned int i = 0; i < number_of_packets; i += NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE) {
+
+        const unsigned int number_of_sent_packets =
+            std::min((unsigned int)NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE, number_of_packets - i);
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+        const unsigned long number_of_heap_allocations_before_burst = number_of_heap_allocations;
+#endif
+
+        for (unsigned int j = 0; j < number_of_sent_packets; ++j) {
+            send_data_using_socket_client(&sender, &packets[(i + j) * VLP16_PACKET_LENGTH], VLP16_PACKET_LENGTH,
+                                          CHECK_LOOPBACK_TIMEOUT_USEC);
+        }
+
+        // packets are received until all sent packets arrive or communication times out
+        unsigned int number_of_packets_in_burst = 0;
+        while (number_of_packets_in_burst < number_of_sent_packets) {
+
+            unsigned int number_of_received_packets_at_once = 0;
+            const unsigned int number_of_lines =
+                receive_vlp16_packets(&handler, number_of_sent_packets - number_of_packets_in_burst,
+                                      &number_of_received_packets_at_once);
+            if (number_of_received_packets_at_once == 0) {
+                break;
+            }
+            number_of_packets_in_burst += number_of_received_packets_at_once;
+
+            get_pointers_of_latest_unused_lidar_line_data(&handler.line_data_buffer, number_of_lines, lines);
+            add_lines_to_decode_check_digest(lines, digest);
+            move_used_data_end_out_point(&handler.line_data_buffer,
+                                         calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+        }
+        *number_of_received_packets += number_of_packets_in_burst;
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+        // allocations of receive thread are also counted while burst is received
+        if ((number_of_bursts_with_heap_allocations != NULL) && (i >= NUMBER_OF_CHECK_WARM_UP_PACKETS) &&
+            (number_of_heap_allocations != number_of_heap_allocations_before_burst)) {
+            ++(*number_of_bursts_with_heap_allocations);
+        }
+#endif
+    }
+
+    close_socket_of_client(&sender);
+    close_socket_of_vlp16_handler(&handler);
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return true;
+}
+
+/*!
+  \brief function to check that receive thread passes packets of loopback socket to decoder as direct receive
+  \attention this check is skipped if loopback socket can not be opened
+*/
+static void check_threaded_receive_through_loopback(void)
+{
+    vlp16_packet_generator_t generator;
+    initialize_vlp16_packet_generator(&generator, VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                      VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+    std::vector<char> packets(NUMBER_OF_CHECK_LOOPBACK_PACKETS * VLP16_PACKET_LENGTH);
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_LOOPBACK_PACKETS; ++i) {
+        generate_vlp16_packet(&generator, &packets[i * VLP16_PACKET_LENGTH]);
+    }
+
+    decode_check_digest_t direct_digest;
+    decode_check_digest_t threaded_digest;
+    unsigned int number_of_direct_packets = 0;
+    unsigned int number_of_threaded_packets = 0;
+
+    if ((receive_check_packets_through_loopback(packets, false, &direct_digest, &number_of_direct_packets) == false) ||
+        (receive_check_packets_through_loopback(packets, true, &threaded_digest, &number_of_threaded_packets) == false)) {
+        cout << "SKIP threaded receive through loopback socket (socket can not be opened)\n";
+        return;
+    }
+
+    report_check_result("receive thread decodes same lines as direct receive through loopback socket",
+                        (number_of_direct_packets == NUMBER_OF_CHECK_LOOPBACK_PACKETS) &&
+                        (number_of_threaded_packets == NUMBER_OF_CHECK_LOOPBACK_PACKETS) &&
+                        (direct_digest.number_of_lines != 0) &&
+                        (direct_digest.number_of_lines == threaded_digest.number_of_lines) &&
+                        (direct_digest.hash == threaded_digest.hash));
+
+    return;
+}
+
+/*!
+  \brief function to decode packets in memory as reference of packets received through socket
+*/
+static void decode_check_packets_in_memory(enum VLP16_PACKET_SENSOR_MODEL sensor_model, const std::vector<char> &packets,
+                                           decode_check_digest_t *digest)
+{
+    clear_decode_check_digest(digest);
+
+    vlp16_handler_t handler;
+    clear_vlp16_handler(&handler);
+    if (allocate_circular_buffer_for_vlp16_handler(&handler, sensor_model, CHECK_RECEIVE_BUFFER_LENGTH) == false) {
+        return;
+    }
+
+    std::vector<const lidar_line_data_t *> lines;
+
+    for (unsigned int i = 0; i < packets.size() / VLP16_PACKET_LENGTH; ++i) {
+        if (receive_vlp16_packet_from_memory(&handler, &packets[i * VLP16_PACKET_LENGTH], VLP16_PACKET_LENGTH) == false) {
+            continue;
+        }
+
+        const unsigned int number_of_lines = decode_vlp16_packet(&handler);
+        get_pointers_of_latest_unused_lidar_line_data(&handler.line_data_buffer, number_of_lines, lines);
+        add_lines_to_decode_check_digest(lines, digest);
+        move_used_data_end_out_point(&handler.line_data_buffer,
+                                     calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+    }
+
+    release_circular_buffer_of_vlp16_handler(&handler);
+
+    return;
+}
+
+/*!
+  \brief function to receive packets of sensors through loopback sockets with sensor group
+  \return false if sockets or group can not be opened
+*/
+static bool receive_check_packets_with_sensor_group(const std::vector<char> packets[NUMBER_OF_CHECK_GROUP_SENSORS],
+                                                    decode_check_digest_t digest[NUMBER_OF_CHECK_GROUP_SENSORS],
+                                                    unsigned int number_of_received_packets[NUMBER_OF_CHECK_GROUP_SENSORS])
+{
+    vlp16_handler_t handler[NUMBER_OF_CHECK_GROUP_SENSORS];
+    socket_client_t sender[NUMBER_OF_CHECK_GROUP_SENSORS];
+    int sensor_index[NUMBER_OF_CHECK_GROUP_SENSORS];
+
+    vlp16_sensor_group_t group;
+    initialize_vlp16_sensor_group(&group);
+    bool opened = open_vlp16_sensor_group(&group);
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_GROUP_SENSORS; ++i) {
+        clear_decode_check_digest(&digest[i]);
+        number_of_received_packets[i] = 0;
+
+        clear_vlp16_handler(&handler[i]);
+        sender[i].file_descriptor = SOCKET_CLIENT_INVALID_FILE_DESCRIPTOR;
+
+        opened = opened &&
+            open_socket_for_vlp16_handler(CHECK_LOOPBACK_IP_ADDRESS, CHECK_GROUP_SENDER_PORT_NUMBER[i],
+                                          CHECK_RECEPTION_IP_ADDRESS, CHECK_GROUP_HANDLER_PORT_NUMBER[i],
+                                          CHECK_LOOPBACK_TIMEOUT_USEC, &handler[i]) &&
+            allocate_circular_buffer_for_vlp16_handler(&handler[i], CHECK_GROUP_SENSOR_MODEL[i],
+                                                       CHECK_RECEIVE_BUFFER_LENGTH) &&
+            allocate_packet_batch_buffer_for_vlp16_handler(&handler[i], NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE) &&
+            open_socket_for_client(CHECK_LOOPBACK_IP_ADDRESS, CHECK_GROUP_HANDLER_PORT_NUMBER[i],
+                                   CHECK_RECEPTION_IP_ADDRESS, CHECK_GROUP_SENDER_PORT_NUMBER[i],
+                                   SOCKET_PROTOCOL_UDP, &sender[i]);
+
+        sensor_index[i] = opened ? add_vlp16_handler_to_sensor_group(&group, &handler[i]) :
+            VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX;
+        opened = opened && (sensor_index[i] != VLP16_SENSOR_GROUP_INVALID_SENSOR_INDEX);
+    }
+
+    const unsigned int number_of_packets = NUMBER_OF_CHECK_LOOPBACK_PACKETS;
+    std::vector<const lidar_line_data_t *> lines;
+
+    for (unsigned int i = 0; (opened == true) && (i < number_of_packets); i += NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE) {
+
+        const unsigned int number_of_sent_packets =
+            std::min((unsigned int)NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE, number_of_packets - i);
+
+        // packets of sensors are interleaved
+        for (unsigned int j = 0; j < number_of_sent_packets; ++j) {
+            for (unsigned int k = 0; k < NUMBER_OF_CHECK_GROUP_SENSORS; ++k) {
+                send_data_using_socket_client(&sender[k], &packets[k][(i + j) * VLP16_PACKET_LENGTH],
+                                              VLP16_PACKET_LENGTH, CHECK_LOOPBACK_TIMEOUT_USEC);
+            }
+        }
+
+        // packets are received until all sent packets arrive or all sensors time out
+        while (receive_vlp16_packets_of_sensor_group(&group, CHECK_LOOPBACK_TIMEOUT_USEC,
+                                                     NUMBER_OF_CHECK_LOOPBACK_PACKETS_AT_ONCE) != 0) {
+
+            bool all_packets_received = true;
+
+            for (unsigned int k = 0; k < NUMBER_OF_CHECK_GROUP_SENSORS; ++k) {
+                vlp16_handler_t *sensor_handler = group.handler[sensor_index[k]];
+
+                get_pointers_of_latest_unused_lidar_line_data(&sensor_handler->line_data_buffer,
+                                                              group.number_of_captured_lines[sensor_index[k]], lines);
+                add_lines_to_decode_check_digest(lines, &digest[k]);
+                move_used_data_end_out_point(&sensor_handler->line_data_buffer,
+                                             calculate_number_of_remaining_lidar_lines(&sensor_handler->line_data_buffer));
+
+                number_of_received_packets[k] += group.number_of_received_packets[sensor_index[k]];
+                all_packets_received = all_packets_received && (number_of_received_packets[k] == i + number_of_sent_packets);
+            }
+
+            if (all_packets_received == true) {
+                break;
+            }
+        }
+    }
+
+    close_vlp16_sensor_group(&group);
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_GROUP_SENSORS; ++i) {
+        close_socket_of_client(&sender[i]);
+        close_socket_of_vlp16_handler(&handler[i]);
+        release_circular_buffer_of_vlp16_handler(&handler[i]);
+    }
+
+    return opened;
+}
+
+/*!
+  \brief function to check that sensor group passes packets of each sensor to its own handler
+  \attention this check is skipped if loopback sockets can not be opened
+*/
+static void check_sensor_group_through_loopback(void)
+{
+    std::vector<char> packets[NUMBER_OF_CHECK_GROUP_SENSORS];
+    decode_check_digest_t expected_digest[NUMBER_OF_CHECK_GROUP_SENSORS];
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_GROUP_SENSORS; ++i) {
+        vlp16_packet_generator_t generator;
+        initialize_vlp16_packet_generator(&generator, CHECK_GROUP_SENSOR_MODEL[i], VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                          VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+        packets[i].resize(NUMBER_OF_CHECK_LOOPBACK_PACKETS * VLP16_PACKET_LENGTH);
+        for (unsigned int j = 0; j < NUMBER_OF_CHECK_LOOPBACK_PACKETS; ++j) {
+            generate_vlp16_packet(&generator, &packets[i][j * VLP16_PACKET_LENGTH]);
+        }
+
+        decode_check_packets_in_memory(CHECK_GROUP_SENSOR_MODEL[i], packets[i], &expected_digest[i]);
+    }
+
+    decode_check_digest_t digest[NUMBER_OF_CHECK_GROUP_SENSORS];
+    unsigned int number_of_received_packets[NUMBER_OF_CHECK_GROUP_SENSORS];
+
+    if (receive_check_packets_with_sensor_group(packets, digest, number_of_received_packets) == false) {
+        cout << "SKIP sensor group through loopback sockets (sockets can not be opened)\n";
+        return;
+    }
+
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_GROUP_SENSORS; ++i) {
+        char check_name[CHECK_CALIBRATION_LINE_LENGTH];
+        snprintf(check_name, sizeof(check_name),
+                 "sensor group decodes same lines of sensor %u as memory receive (%s, %u packets)",
+                 i, VLP16_PACKET_SENSOR_MODEL_NAME[CHECK_GROUP_SENSOR_MODEL[i]], number_of_received_packets[i]);
+
+        report_check_result(check_name,
+                            (number_of_received_packets[i] == NUMBER_OF_CHECK_LOOPBACK_PACKETS) &&
+                            (expected_digest[i].number_of_lines != 0) &&
+                            (digest[i].number_of_lines == expected_digest[i].number_of_lines) &&
+                            (digest[i].hash == expected_digest[i].hash));
+    }
+
+    return;
+}
+
+/*!
+  \brief function to check that receive, decode and region filter do not allocate heap after warm-up
+  \attention this check is skipped if heap allocators can not be hooked
+*/
+static void check_heap_allocations_after_warm_up(void)
+{
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+    const enum VLP16_PACKET_RETURN_MODE return_modes[] =
+        { VLP16_PACKET_STRONGEST_RETURN_MODE, VLP16_PACKET_DUAL_RETURN_MODE };
+
+    for (unsigned int mode_index = 0; mode_index < sizeof(return_modes) / sizeof(return_modes[0]); ++mode_index) {
+
+        vlp16_handler_t handler;
+        decode_check_packets(VLP16_PACKET_VLP16, return_modes[mode_index], NULL, NUMBER_OF_CHECK_WARM_UP_PACKETS, &handler);
+
+        std::vector<lidar_echo_single_region_t> regions(1);
+        set_lidar_echo_single_region_using_center_direction(0.0, M_PI / 4.0, 0.0, M_PI / 8.0, &regions.at(0));
+
+        // buffers are reserved for lines of whole line buffer as vlp16_control_test
+        std::vector<const lidar_line_data_t *> captured_lines;
+        captured_lines.reserve(handler.line_data_buffer.length);
+        std::vector< std::vector<lidar_echo_data_t> > region_echoes(regions.size());
+        region_echoes.at(0).reserve(handler.line_data_buffer.length *
+                                    get_number_of_spots_of_lidar_line_circular_buffer(&handler.line_data_buffer) *
+                                    LIDAR_SPOT_ACCESSOR_MAXIMUM_NUMBER_OF_ECHOES);
+
+        vlp16_packet_generator_t generator;
+        initialize_vlp16_packet_generator(&generator, VLP16_PACKET_VLP16, return_modes[mode_index],
+                                          VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+        std::vector<char> packet(VLP16_PACKET_LENGTH);
+
+        unsigned int number_of_packets_with_heap_allocations = 0;
+        unsigned int number_of_filtered_echoes = 0;
+
+        for (unsigned int i = 0; i < NUMBER_OF_CHECK_PACKETS; ++i) {
+            generate_vlp16_packet(&generator, &packet[0]);
+
+            const unsigned long number_of_heap_allocations_before_receive = number_of_heap_allocations;
+
+            if (receive_vlp16_packet_from_memory(&handler, &packet[0], VLP16_PACKET_LENGTH) == true) {
+                const unsigned int number_of_lines = decode_vlp16_packet(&handler);
+
+                get_pointers_of_latest_unused_lidar_line_data(&handler.line_data_buffer, number_of_lines, captured_lines);
+                region_echoes.at(0).clear();
+                add_lidar_echo_data_in_each_single_region(captured_lines, regions, region_echoes);
+                number_of_filtered_echoes += region_echoes.at(0).size();
+
+                move_used_data_end_out_point(&handler.line_data_buffer,
+                                             calculate_number_of_remaining_lidar_lines(&handler.line_data_buffer));
+            }
+
+            if (number_of_heap_allocations != number_of_heap_allocations_before_receive) {
+                ++number_of_packets_with_heap_allocations;
+            }
+        }
+
+        release_circular_buffer_of_vlp16_handler(&handler);
+
+        char check_name[CHECK_CALIBRATION_LINE_LENGTH];
+        snprintf(check_name, sizeof(check_name),
+                 "receive, decode and region filter do not allocate heap after warm-up (%s, %u packets with allocations)",
+                 (return_modes[mode_index] == VLP16_PACKET_DUAL_RETURN_MODE) ? "dual" : "strongest",
+                 number_of_packets_with_heap_allocations);
+
+        report_check_result(check_name, (number_of_filtered_echoes != 0) && (number_of_packets_with_heap_allocations == 0));
+    }
+
+    // receive with recvmmsg from socket, and receive from ring filled by receive thread
+    vlp16_packet_generator_t generator;
+    initialize_vlp16_packet_generator(&generator, VLP16_PACKET_VLP16, VLP16_PACKET_STRONGEST_RETURN_MODE,
+                                      VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM);
+
+    std::vector<char> packets(NUMBER_OF_CHECK_LOOPBACK_PACKETS * VLP16_PACKET_LENGTH);
+    for (unsigned int i = 0; i < NUMBER_OF_CHECK_LOOPBACK_PACKETS; ++i) {
+        generate_vlp16_packet(&generator, &packets[i * VLP16_PACKET_LENGTH]);
+    }
+
+    for (unsigned int threaded_index = 0; threaded_index < 2; ++threaded_index) {
+
+        const bool threaded = (threaded_index == 1);
+
+        decode_check_digest_t digest;
+        unsigned int number_of_received_packets = 0;
+        unsigned int number_of_bursts_with_heap_allocations = 0;
+
+        if (receive_check_packets_through_loopback(packets, threaded, &digest, &number_of_received_packets,
+                                                   &number_of_bursts_with_heap_allocations) == false) {
+            cout << "SKIP heap allocations of socket receive after warm-up (socket can not be opened)\n";
+            break;
+        }
+
+        char check_name[CHECK_CALIBRATION_LINE_LENGTH];
+        snprintf(check_name, sizeof(check_name),
+                 "socket receive and decode do not allocate heap after warm-up (%s, %u bursts with allocations)",
+                 threaded ? "receive thread" : "recvmmsg", number_of_bursts_with_heap_allocations);
+
+        report_check_result(check_name,
+                            (number_of_received_packets == NUMBER_OF_CHECK_LOOPBACK_PACKETS) &&
+                            (number_of_bursts_with_heap_allocations == 0));
+    }
+#else
+    cout << "SKIP heap allocations after warm-up (heap allocators can not be hooked)\n";
+#endif
+
+    return;
+}
+
+int main(void)
+{
+    check_calibration_parsers();
+    check_line_history();
+    check_point_block_overflow();
+    check_packet_continuity();
+    check_parallel_decode();
+    check_decode_kernels_with_calibration();
+    check_region_filters_with_calibration();
+    check_lidar_echo_log_round_trip();
+    check_packet_recorder();
+    check_packet_ring();
+    check_threaded_receive_through_loopback();
+    check_sensor_group_through_loopback();
+    check_heap_allocations_after_warm_up();
+
+    if (number_of_failed_checks != 0) {
+        cout << number_of_failed_checks << " checks failed.\n";
+        return 1;
+    }
+
+    cout << "All checks passed.\n";
+
+    return 0;
+}
@@ -6,12 +6,22 @@
 
 #include "vlp16Ctrl.h"
 
+#include "lidar_echo_logCtrl.h"
+
+#include "latency_traceCtrl.h"
+
+// hooks of heap allocators (included in one source file of program)
+#include "heap_allocation_counterCtrl.h"
+
 // for memset
 #include <string.h>
 
 // for cos/sin
 #include <math.h>
 
+// for atof
+#include <stdlib.h>
+
 #include <iostream>
 
 using namespace std;
@@ -24,6 +34,9 @@ const char DEFAULT_SENSOR_PORT_NUMBER[] = "2368";
 //! default reception ip address
 const char DEFAULT_RECEPTION_IP_ADDRESS[] = "0.0.0.0";
 
+//! binary log of echoes in middle region (converted to text by lidar_echo_log_to_csv)
+const char MIDDLE_REGION_ECHO_LOG_FILE[] = "middle_region_echoes.log";
+
 //! constants for scip command test
 enum CONSTANT_FOR_VLP_COMMAND_TEST {
 
@@ -39,6 +52,9 @@ enum CONSTANT_FOR_VLP_COMMAND_TEST {
     //! wait timeout to receive echoes
     WAIT_TIMEOUT_TO_RECEIVE_ECHOES = 48 * 1000 * 1000,
 
+    //! number of packets to warm up (heap allocations are allowed)
+    NUMBER_OF_WARM_UP_PACKETS = 100,
+
 };
 
 static bool open_socket_for_vlp16_handler(unsigned int communication_timeout_usec,
@@ -62,6 +78,27 @@ static bool open_socket_for_vlp16_handler(unsigned int communication_timeout_use
 
     return true;
 }
+static bool open_pcap_file_for_vlp16_handler(const char *file_path, double replay_speed_ratio,
+                                             unsigned int communication_timeout_usec,
+                                             vlp16_handler_t *handler)
+{
+    // replay speed ratio 0.0 means as fast as possible
+    enum VLP16_PCAP_REPLAY_MODE replay_mode = VLP16_PCAP_REPLAY_SCALED_TIMING;
+    if (replay_speed_ratio <= 0.0) {
+        replay_mode = VLP16_PCAP_REPLAY_MAXIMUM_SPEED;
+    }
+
+    if (open_pcap_file_for_vlp16_handler(file_path, (unsigned short)atoi(DEFAULT_SENSOR_PORT_NUMBER),
+                                         replay_mode, replay_speed_ratio,
+                                         communication_timeout_usec, handler) == false) {
+        cout << "fails.\n";
+        return false;
+    }
+    cout << "success.\n";
+
+    return true;
+}
+
 static void close_socket_and_release_memory_of_vlp16_handler(vlp16_handler_t *handler)
 {
 
@@ -86,10 +123,25 @@ int main(int argc, char **argv)
     vlp16_handler_t sensor;
     clear_vlp16_handler(&sensor);
 
-    cout << "Open socket for VLP-16 ";
-    if (open_socket_for_vlp16_handler(RECEIVE_TIMEOUT_USEC,
-                                      &sensor) == false) {
-        return 1;
+    // packets are replayed from pcap file if file path is given (vlp16_control_test [pcap file] [speed ratio])
+    if (argc > 1) {
+
+        const double replay_speed_ratio = (argc > 2) ? atof(argv[2]) : 1.0;
+
+        cout << "Open pcap file " << argv[1] << " ";
+        if (open_pcap_file_for_vlp16_handler(argv[1], replay_speed_ratio,
+                                             RECEIVE_TIMEOUT_USEC, &sensor) == false) {
+            return 1;
+        }
+
+    } else {
+
+        cout << "Open socket for VLP-16 ";
+        if (open_socket_for_vlp16_handler(RECEIVE_TIMEOUT_USEC,
+                                          &sensor) == false) {
+            return 1;
+        }
+
     }
 
     cout << "Allocate memory ";
@@ -102,6 +154,22 @@ int main(int argc, char **argv)
     }
     cout << "success.\n";
 
+    // intrinsic calibration is loaded if file path is given (vlp16_control_test [pcap file] [speed ratio] [calibration file])
+    if (argc > 3) {
+
+        vlp16_calibration_t calibration;
+
+        cout << "Load calibration " << argv[3] << " ";
+        if ((load_vlp16_calibration_file(argv[3], &calibration) == false) ||
+            (set_calibration_of_vlp16_handler(&sensor, &calibration) == false)) {
+
+            cout << "failed.\n";
+            close_socket_and_release_memory_of_vlp16_handler(&sensor);
+            return 1;
+        }
+        cout << "success (" << calibration.number_of_lasers << " lasers).\n";
+    }
+
     // set parameters of intereset region (frontal-middle, frontal-lowest, frontal-highest)
     const double frontal_angle = 0.0 * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
     const double frontal_angle_torelance = 0.8 * LIDAR_DATA_ANGLE_COEFFICIENT_TO_CONVERT_DEGREE_TO_RADIAN;
@@ -139,6 +207,31 @@ int main(int argc, char **argv)
     // buffer for echoes in each interest region
     std::vector< std::vector<lidar_echo_data_t> > interest_echo_table(interest_regions.size());
 
+    // buffers of each packet are allocated before receiving (no heap allocation on each packet)
+    std::vector<const lidar_line_data_t *> captured_lines;
+    captured_lines.reserve(sensor.line_data_buffer.length);
+
+    std::vector< std::vector<lidar_echo_data_t> > temporal_interest_echoes(interest_regions.size());
+    for (unsigned int i = 0; i < temporal_interest_echoes.size(); ++i) {
+        temporal_interest_echoes.at(i).reserve(sensor.line_data_buffer.length *
+                                               get_number_of_spots_of_lidar_line_circular_buffer(&sensor.line_data_buffer) *
+                                               LIDAR_SPOT_ACCESSOR_MAXIMUM_NUMBER_OF_ECHOES);
+    }
+
+    // echoes in middle region are logged in binary (text output is too expensive on each packet)
+    lidar_echo_log_writer_t middle_region_echo_log;
+    clear_lidar_echo_log_writer(&middle_region_echo_log);
+
+    if (open_lidar_echo_log_writer(MIDDLE_REGION_ECHO_LOG_FILE, VLP16_PACKET_DISTANCE_SCALE,
+                                   LIDAR_ECHO_LOG_DEFAULT_ANGLE_UNITS_PER_REVOLUTION,
+                                   LIDAR_ECHO_LOG_DEFAULT_BUFFER_LENGTH,
+                                   &middle_region_echo_log) == false) {
+        cout << "Open " << MIDDLE_REGION_ECHO_LOG_FILE << " failed.\n";
+    }
+
+    // number of packets on which receive, decode and filter allocate heap after warm-up
+    unsigned int number_of_packets_with_heap_allocations = 0;
+
     int received_data_byte = 0;
     unsigned int receive_count = 0;
     while (1) {
@@ -153,9 +246,18 @@ int main(int argc, char **argv)
             break;
         }
 
+        if (is_end_of_pcap_file_of_vlp16_handler(&sensor) == true) {
+            cout << "End of pcap file (" << receive_count << " packets, "
+                 << calculate_replayed_packet_rate_of_vlp16_handler(&sensor) << " packets/s).\n";
+            break;
+        }
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+        const unsigned long number_of_heap_allocations_before_receive = number_of_heap_allocations;
+#endif
+
         const bool packet_received =
-            receive_vlp16_packet(&sensor, &received_data_byte,
-                                 VLP16_PACKET_LENGTH);
+            receive_vlp16_packet(&sensor, &received_data_byte);
 
         if (packet_received == true) {
 
@@ -168,29 +270,37 @@ int main(int argc, char **argv)
             ++receive_count;
 
             // capture buffer pointers of latest echoes
-            std::vector<const lidar_line_data_t *> captured_lines;
             get_pointers_of_latest_unused_lidar_line_data(&sensor.line_data_buffer,
                                                           captured_size, captured_lines);
 
             // copy echoes in each interest region to temporal buffer
-            std::vector< std::vector<lidar_echo_data_t> > temporal_interest_echoes(interest_regions.size());
+            for (unsigned int i = 0; i < temporal_interest_echoes.size(); ++i) {
+                temporal_interest_echoes.at(i).clear();
+            }
 
             add_lidar_echo_data_in_each_single_region(captured_lines,
                                                       interest_regions,
                                                       temporal_interest_echoes);
 
-            // print added echoes
-            for (unsigned int i = 0; i < temporal_interest_echoes.at(1).size(); ++i) {
-
-                output_lidar_echo_data_to_stream(cout, ',',
-                                                 true, &temporal_interest_echoes.at(1).at(i));
-                cout << "\n";
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+            if ((receive_count > NUMBER_OF_WARM_UP_PACKETS) &&
+                (number_of_heap_allocations != number_of_heap_allocations_before_receive)) {
+                ++number_of_packets_with_heap_allocations;
             }
+#endif
+
+            // log added echoes
+            write_lidar_echo_array_to_log(&middle_region_echo_log,
+                                          temporal_interest_echoes.at(1));
 
             // copy to total buffer
             add_lidar_echo_data_in_each_single_region(captured_lines,
                                                       interest_regions, interest_echo_table);
 
+            // captured lines are used (unused lines overwritten by decoder are counted in line buffer)
+            move_used_data_end_out_point(&sensor.line_data_buffer,
+                                         calculate_number_of_remaining_lidar_lines(&sensor.line_data_buffer));
+
         }
 
     }
@@ -198,6 +308,39 @@ int main(int argc, char **argv)
     cout << "Number of interest echoes in middle region "
          <<  interest_echo_table.at(1).size() << "\n";
 
+    cout << middle_region_echo_log.number_of_records << " echoes are logged in "
+         << MIDDLE_REGION_ECHO_LOG_FILE << " (saturated distances "
+         << middle_region_echo_log.number_of_saturated_distances << ")\n";
+    close_lidar_echo_log_writer(&middle_region_echo_log);
+
+    cout << "Latency from receive to decode complete [usec] average "
+         << sensor.packet_latency_statistics.average
+         << ", maximum " << sensor.packet_latency_statistics.maximum << "\n";
+
+    const vlp16_communication_status_t *status = &sensor.communication_status;
+    cout << "Lost packets " << status->number_of_lost_packets
+         << ", reordered packets " << status->number_of_reordered_packets
+         << ", duplicated packets " << status->number_of_duplicated_packets
+         << ", dropped datagrams " << status->number_of_dropped_datagrams << "\n";
+    cout << "Overwritten unused lines " << get_number_of_overwritten_unused_lidar_lines(&sensor.line_data_buffer)
+         << " (line buffer length " << sensor.line_data_buffer.length << ")\n";
+    cout << "Completeness of " << status->number_of_completed_revolutions << " revolutions average "
+         << status->revolution_completeness_statistics.average
+         << ", minimum " << status->revolution_completeness_statistics.minimum << "\n";
+
+#if defined(LATENCY_TRACE_ENABLED)
+    cout << "Latency of stages (stage, count, average, p50, p99, p999, maximum [usec])\n";
+    output_latency_trace_to_stream(cout, ',');
+#endif
+
+#if defined(HEAP_ALLOCATION_COUNTER_AVAILABLE)
+    cout << "Number of packets with heap allocations after warm-up "
+         << number_of_packets_with_heap_allocations << "\n";
+    if (number_of_packets_with_heap_allocations != 0) {
+        cout << "Heap allocation check failed.\n";
+    }
+#endif
+
     for (unsigned int i = 0; i < interest_echo_table.at(1).size(); ++i) {
         /*
         output_lidar_echo_data_to_stream(cerr, ',', true,
@@ -251,5 +394,9 @@ int main(int argc, char **argv)
     close_socket_and_release_memory_of_vlp16_handler(&sensor);
     cout << "end.\n";
 
+    if (number_of_packets_with_heap_allocations != 0) {
+        return 1;
+    }
+
     return 0;
 }
@@ -0,0 +1,244 @@
+/*!
+  \file
+  \brief program to emulate VLP-16, HDL-32E, VLP-32C or Puck Hi-Res by sending synthetic packets over UDP
+  \author Kiyoshi MATSUO
+*/
+
+#include "vlp16_packet_generatorCtrl.h"
+
+#include "timeCtrl.h"
+
+// for strcmp
+#include <string.h>
+
+// for snprintf
+#include <stdio.h>
+
+// for atof, atoi, strtoul
+#include <stdlib.h>
+
+#include <iostream>
+
+using namespace std;
+
+//! default destination ip address (loopback)
+const char DEFAULT_DESTINATION_IP_ADDRESS[] = "127.0.0.1";
+//! default destination port number
+const char DEFAULT_DESTINATION_PORT_NUMBER[] = "2368";
+
+//! ip address for reception of sending socket
+const char SENDING_SOCKET_RECEPTION_IP_ADDRESS[] = "0.0.0.0";
+
+//! constants for emulator
+enum CONSTANT_FOR_VLP16_EMULATOR {
+
+    //! default number of packets (0 means endless)
+    DEFAULT_NUMBER_OF_EMULATED_PACKETS = 0,
+
+    //! minimum speed ratio to real packet rate
+    MINIMUM_EMULATION_SPEED_RATIO = 1,
+
+    //! maximum speed ratio to real packet rate
+    MAXIMUM_EMULATION_SPEED_RATIO = 100,
+
+    //! send timeout [usec]
+    EMULATOR_SEND_TIMEOUT_USEC = 100 * 1000,
+
+    //! waiting time longer than this is spent in sleep [usec]
+    EMULATOR_SLEEP_THRESHOLD_USEC = 2000,
+
+    //! offset of reception port number of sending socket from destination port number
+    SENDING_SOCKET_RECEPTION_PORT_NUMBER_OFFSET = 1000,
+
+    //! interval of progress report [packets]
+    EMULATOR_REPORT_INTERVAL_PACKETS = 10000,
+
+};
+
+static void output_usage_of_emulator(const char *program_name)
+{
+    cerr << "usage: " << program_name
+         << " [vlp16|hdl32e|vlp32c|puckhires] [strongest|last|dual] [rpm] [speed ratio (1-100)]"
+         << " [loss ratio] [reorder ratio] [number of packets (0: endless)] [seed]"
+         << " [destination ip address] [destination port number]\n";
+
+    return;
+}
+
+static enum VLP16_PACKET_SENSOR_MODEL decode_sensor_model_string(const char *sensor_model_string)
+{
+    if (strcmp(sensor_model_string, "vlp16") == 0) {
+        return VLP16_PACKET_VLP16;
+    }
+    if (strcmp(sensor_model_string, "hdl32e") == 0) {
+        return VLP16_PACKET_HDL_32E;
+    }
+    if (strcmp(sensor_model_string, "vlp32c") == 0) {
+        return VLP16_PACKET_VLP_32C;
+    }
+    if (strcmp(sensor_model_string, "puckhires") == 0) {
+        return VLP16_PACKET_PUCK_HI_RES;
+    }
+
+    return VLP16_PACKET_INVALID_SENSOR_MODEL;
+}
+
+static enum VLP16_PACKET_RETURN_MODE decode_return_mode_string(const char *return_mode_string)
+{
+    if (strcmp(return_mode_string, "strongest") == 0) {
+        return VLP16_PACKET_STRONGEST_RETURN_MODE;
+    }
+    if (strcmp(return_mode_string, "last") == 0) {
+        return VLP16_PACKET_LAST_RETURN_MODE;
+    }
+    if (strcmp(return_mode_string, "dual") == 0) {
+        return VLP16_PACKET_DUAL_RETURN_MODE;
+    }
+
+    return VLP16_PACKET_INVALID_RETURN_MODE;
+}
+
+/*!
+  \brief function to wait until send time
+  \attention long waiting is spent in sleep, and short waiting is spent in busy loop (for 100 times speed)
+*/
+static void wait_until_send_time(const TimeTheInterval &timer, double send_time_usec)
+{
+    while (1) {
+        const double remaining_time_usec = send_time_usec - (double)timer.TimeInterval();
+        if (remaining_time_usec <= 0.0) {
+            break;
+        }
+
+        if (remaining_time_usec > EMULATOR_SLEEP_THRESHOLD_USEC) {
+            sleep_milisecond(1);
+        }
+    }
+
+    return;
+}
+
+/*!
+  \brief function to send emitted packets
+*/
+static void send_emitted_packets(socket_client_t *sender, const char *packets, unsigned int number_of_emitted_packets,
+                                 unsigned int *number_of_sent_packets, unsigned int *number_of_send_errors)
+{
+    for (unsigned int i = 0; i < number_of_emitted_packets; ++i) {
+        if (send_data_using_socket_client(sender, packets + i * VLP16_PACKET_LENGTH, VLP16_PACKET_LENGTH,
+                                          EMULATOR_SEND_TIMEOUT_USEC) != VLP16_PACKET_LENGTH) {
+            ++(*number_of_send_errors);
+            continue;
+        }
+        ++(*number_of_sent_packets);
+    }
+
+    return;
+}
+
+int main(int argc, char **argv)
+{
+    // emulator [model] [return mode] [rpm] [speed ratio] [loss ratio] [reorder ratio] [number of packets] [seed] [ip] [port]
+    if ((argc > 1) && (strcmp(argv[1], "-h") == 0)) {
+        output_usage_of_emulator(argv[0]);
+        return 0;
+    }
+
+    const enum VLP16_PACKET_SENSOR_MODEL sensor_model =
+        (argc > 1) ? decode_sensor_model_string(argv[1]) : VLP16_PACKET_VLP16;
+    const enum VLP16_PACKET_RETURN_MODE return_mode =
+        (argc > 2) ? decode_return_mode_string(argv[2]) : VLP16_PACKET_STRONGEST_RETURN_MODE;
+    const double rotation_speed_rpm =
+        (argc > 3) ? atof(argv[3]) : (double)VLP16_PACKET_GENERATOR_DEFAULT_ROTATION_SPEED_RPM;
+    const double speed_ratio = (argc > 4) ? atof(argv[4]) : (double)MINIMUM_EMULATION_SPEED_RATIO;
+    const double loss_ratio = (argc > 5) ? atof(argv[5]) : 0.0;
+    const double reorder_ratio = (argc > 6) ? atof(argv[6]) : 0.0;
+    const unsigned int number_of_packets =
+        (argc > 7) ? (unsigned int)atoi(argv[7]) : (unsigned int)DEFAULT_NUMBER_OF_EMULATED_PACKETS;
+    const unsigned int seed =
+        (argc > 8) ? (unsigned int)strtoul(argv[8], NULL, 10) : (unsigned int)VLP16_PACKET_GENERATOR_DEFAULT_SEED;
+    const char *destination_ip_address = (argc > 9) ? argv[9] : DEFAULT_DESTINATION_IP_ADDRESS;
+    const char *destination_port_number = (argc > 10) ? argv[10] : DEFAULT_DESTINATION_PORT_NUMBER;
+
+    if ((speed_ratio < MINIMUM_EMULATION_SPEED_RATIO) || (speed_ratio > MAXIMUM_EMULATION_SPEED_RATIO)) {
+        cerr << "Speed ratio should be in [" << MINIMUM_EMULATION_SPEED_RATIO << ", "
+             << MAXIMUM_EMULATION_SPEED_RATIO << "].\n";
+        return 1;
+    }
+
+    vlp16_packet_generator_t generator;
+    if (initialize_vlp16_packet_generator(&generator, sensor_model, return_mode, rotation_speed_rpm) == false) {
+        cerr << "Invalid sensor model, return mode or rotation speed.\n";
+        output_usage_of_emulator(argv[0]);
+        return 1;
+    }
+    if (set_impairments_of_vlp16_packet_generator(&generator, loss_ratio, reorder_ratio, seed) == false) {
+        cerr << "Loss ratio and reorder ratio should be in [0, 1].\n";
+        return 1;
+    }
+
+    // reception port of sending socket is not used, and differs on each destination port (emulators of sensor group)
+    char reception_port_number[SOCKET_CLIENT_DESTINATION_PORT_STRING_LENGTH];
+    snprintf(reception_port_number, sizeof(reception_port_number), "%u",
+             (unsigned int)(atoi(destination_port_number) + SENDING_SOCKET_RECEPTION_PORT_NUMBER_OFFSET) & 0xffff);
+
+    socket_client_t sender;
+
+    cout << "Open socket to " << destination_ip_address << ":" << destination_port_number << " ";
+    if (open_socket_for_client(destination_ip_address, destination_port_number,
+                               SENDING_SOCKET_RECEPTION_IP_ADDRESS, reception_port_number,
+                               SOCKET_PROTOCOL_UDP, &sender) == false) {
+        cout << "fails.\n";
+        release_winsock2_dynamic_link_library();
+        return 1;
+    }
+    cout << "success.\n";
+
+    const double packet_interval_usec =
+        calculate_packet_interval_of_vlp16_packet_generator(&generator) / speed_ratio;
+
+    char packets[VLP16_PACKET_GENERATOR_MAXIMUM_NUMBER_OF_EMITTED_PACKETS * VLP16_PACKET_LENGTH];
+
+    unsigned int number_of_sent_packets = 0;
+    unsigned int number_of_send_errors = 0;
+
+    TimeTheInterval timer;
+    timer.SetIntervalStart();
+
+    while ((number_of_packets == 0) || (generator.number_of_generated_packets < number_of_packets)) {
+
+        // packets are sent on schedule of real sensor (lost packets keep their time slots)
+        wait_until_send_time(timer, generator.number_of_generated_packets * packet_interval_usec);
+
+        const unsigned int number_of_emitted_packets =
+            emit_vlp16_packets_of_generator(&generator, packets);
+
+        send_emitted_packets(&sender, packets, number_of_emitted_packets,
+                             &number_of_sent_packets, &number_of_send_errors);
+
+        if ((generator.number_of_generated_packets % EMULATOR_REPORT_INTERVAL_PACKETS) == 0) {
+            cout << generator.number_of_generated_packets << " packets are generated ("
+                 << number_of_sent_packets * 1000000.0 / timer.TimeInterval() << " packets/s).\n";
+        }
+    }
+
+    // reordered packet held at end of finite emission is sent in time slot of next packet
+    wait_until_send_time(timer, generator.number_of_generated_packets * packet_interval_usec);
+    send_emitted_packets(&sender, packets, flush_held_packet_of_vlp16_packet_generator(&generator, packets),
+                         &number_of_sent_packets, &number_of_send_errors);
+
+    const double elapsed_time_usec = (double)timer.TimeInterval();
+
+    cout << "Generated packets " << generator.number_of_generated_packets << "\n"
+         << "Sent packets " << number_of_sent_packets << "\n"
+         << "Lost packets " << generator.number_of_lost_packets << "\n"
+         << "Reordered packets " << generator.number_of_reordered_packets << "\n"
+         << "Send errors " << number_of_send_errors << "\n"
+         << "Packet rate " << ((elapsed_time_usec > 0.0) ? number_of_sent_packets * 1000000.0 / elapsed_time_usec : 0.0)
+         << " packets/s\n";
+
+    close_socket_of_client(&sender);
+    release_winsock2_dynamic_link_library();
+
+    return 0;
+}